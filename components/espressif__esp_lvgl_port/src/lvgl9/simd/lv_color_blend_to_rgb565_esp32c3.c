@@ -0,0 +1,182 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// This is LVGL RGB565 color fill for ESP32C3 processor (SWAR, two pixels per 32-bit word)
+
+#include "lv_macro_swar_rgb565.h"
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Convert the lv_color_t pointed by the descriptor to RGB565
+ */
+static inline uint32_t fill_color16(const asm_dsc_t *asm_dsc);
+
+/**
+ * @brief Blend a row with a mask and a constant opacity
+ *
+ * @param opa Constant opacity, LV_OPA_COVER when only the mask is used
+ */
+SWAR_ALWAYS_INLINE void fill_row_mask(uint16_t *dest, const uint8_t *mask, int32_t w, uint32_t color16, uint32_t opa);
+
+// ------------------------------------------------ Public functions ---------------------------------------------------
+
+int lv_color_blend_to_rgb565_esp(asm_dsc_t *asm_dsc)
+{
+    const uint32_t w = asm_dsc->dst_w;
+    const uint32_t h = asm_dsc->dst_h;
+    const uint32_t dest_stride = asm_dsc->dst_stride;
+    uint8_t *dest = (uint8_t *)asm_dsc->dst_buf;
+    uint32_t color16 = fill_color16(asm_dsc);
+    uint32_t c32 = color16 | (color16 << 16);
+
+    for (uint32_t y = 0; y < h; y++) {
+        swar_memset16(dest, c32, w * sizeof(uint16_t));
+        dest += dest_stride;
+    }
+
+    return SWAR_RESULT_OK;
+}
+
+int lv_color_blend_to_rgb565_with_opa_esp(asm_dsc_t *asm_dsc)
+{
+    const int32_t w = asm_dsc->dst_w;
+    const int32_t h = asm_dsc->dst_h;
+    const uint32_t dest_stride = asm_dsc->dst_stride;
+    uint8_t *dest = (uint8_t *)asm_dsc->dst_buf;
+
+    // 16-bit accesses are used, let the ANSI implementation handle odd addresses
+    if (((uintptr_t)dest | dest_stride) & 0x1) {
+        return SWAR_RESULT_INVALID;
+    }
+
+    const uint32_t color16 = fill_color16(asm_dsc);
+    const uint32_t mix = swar_mix_factor(asm_dsc->opa);
+    const uint32_t inv_mix = 32 - mix;
+    const uint32_t fg_mix = ((color16 | (color16 << 16)) & SWAR_SPREAD_MASK) * mix;
+
+    // Backgrounds are often uniform, so remember the last result
+    uint32_t last_bg = 0;
+    uint32_t last_res = swar_mix_2px_const(fg_mix, last_bg, inv_mix);
+
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t *row = (uint16_t *)dest;
+        int32_t x = 0;
+        if (w > 0 && ((uintptr_t)row & 0x2)) {
+            row[0] = swar_mix_1px(color16, row[0], mix);
+            x = 1;
+        }
+
+        swar_word_t *row32 = (swar_word_t *)&row[x];
+        for (; x < w - 1; x += 2) {
+            uint32_t bg = *row32;
+            if (bg != last_bg) {
+                last_bg = bg;
+                last_res = swar_mix_2px_const(fg_mix, bg, inv_mix);
+            }
+            *row32++ = last_res;
+        }
+
+        if (x < w) {
+            row[x] = swar_mix_1px(color16, row[x], mix);
+        }
+        dest += dest_stride;
+    }
+
+    return SWAR_RESULT_OK;
+}
+
+int lv_color_blend_to_rgb565_with_mask_esp(asm_dsc_t *asm_dsc)
+{
+    const int32_t w = asm_dsc->dst_w;
+    const int32_t h = asm_dsc->dst_h;
+    const uint32_t dest_stride = asm_dsc->dst_stride;
+    const uint32_t mask_stride = asm_dsc->mask_stride;
+    uint8_t *dest = (uint8_t *)asm_dsc->dst_buf;
+    const uint8_t *mask = asm_dsc->mask_buf;
+
+    if (((uintptr_t)dest | dest_stride) & 0x1) {
+        return SWAR_RESULT_INVALID;
+    }
+
+    const uint32_t color16 = fill_color16(asm_dsc);
+    for (int32_t y = 0; y < h; y++) {
+        fill_row_mask((uint16_t *)dest, mask, w, color16, 0xFF);
+        dest += dest_stride;
+        mask += mask_stride;
+    }
+
+    return SWAR_RESULT_OK;
+}
+
+int lv_color_blend_to_rgb565_mix_mask_opa_esp(asm_dsc_t *asm_dsc)
+{
+    const int32_t w = asm_dsc->dst_w;
+    const int32_t h = asm_dsc->dst_h;
+    const uint32_t dest_stride = asm_dsc->dst_stride;
+    const uint32_t mask_stride = asm_dsc->mask_stride;
+    uint8_t *dest = (uint8_t *)asm_dsc->dst_buf;
+    const uint8_t *mask = asm_dsc->mask_buf;
+
+    if (((uintptr_t)dest | dest_stride) & 0x1) {
+        return SWAR_RESULT_INVALID;
+    }
+
+    const uint32_t color16 = fill_color16(asm_dsc);
+    for (int32_t y = 0; y < h; y++) {
+        fill_row_mask((uint16_t *)dest, mask, w, color16, asm_dsc->opa);
+        dest += dest_stride;
+        mask += mask_stride;
+    }
+
+    return SWAR_RESULT_OK;
+}
+
+// ------------------------------------------------ Static functions ---------------------------------------------------
+
+static inline uint32_t fill_color16(const asm_dsc_t *asm_dsc)
+{
+    // lv_color_t is stored as blue, green, red
+    const uint8_t *c = (const uint8_t *)asm_dsc->src_buf;
+    return ((uint32_t)(c[2] & 0xF8) << 8) | ((uint32_t)(c[1] & 0xFC) << 3) | (c[0] >> 3);
+}
+
+SWAR_ALWAYS_INLINE void fill_row_mask(uint16_t *dest, const uint8_t *mask, int32_t w, uint32_t color16, uint32_t opa)
+{
+    const uint32_t c32 = color16 | (color16 << 16);
+    int32_t x = 0;
+
+    if (w > 0 && ((uintptr_t)dest & 0x2)) {
+        dest[0] = swar_mix_1px(color16, dest[0], swar_mix_factor(swar_mask_opa(mask[0], opa)));
+        x = 1;
+    }
+
+    for (; x < w - 1; x += 2) {
+        uint32_t m0 = mask[x];
+        uint32_t m1 = mask[x + 1];
+        if ((m0 & m1) == 0xFF && opa == 0xFF) {
+            *(swar_word_t *)&dest[x] = c32;
+            continue;
+        }
+        if ((m0 | m1) == 0) {
+            continue;
+        }
+
+        m0 = swar_mix_factor(swar_mask_opa(m0, opa));
+        m1 = swar_mix_factor(swar_mask_opa(m1, opa));
+        if (m0 == m1) {
+            swar_word_t *dest32 = (swar_word_t *)&dest[x];
+            *dest32 = swar_mix_2px(c32, *dest32, m0);
+        } else {
+            dest[x] = swar_mix_1px(color16, dest[x], m0);
+            dest[x + 1] = swar_mix_1px(color16, dest[x + 1], m1);
+        }
+    }
+
+    if (x < w) {
+        dest[x] = swar_mix_1px(color16, dest[x], swar_mix_factor(swar_mask_opa(mask[x], opa)));
+    }
+}
@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Helpers of the SWAR (SIMD within a register) RGB565 blend kernels
+//
+// The kernels are plain C, they are meant for cores without a SIMD unit (like the RV32IMC core of esp32c3).
+// Two RGB565 pixels are processed in one 32-bit word. The results are bit-exact with LVGL's ANSI C implementation.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+/**
+ * @brief Descriptor passed by esp_lvgl_port_lv_blend.h
+ *
+ * @note Must match asm_dsc_t in esp_lvgl_port_lv_blend.h
+ */
+typedef struct {
+    uint32_t opa;
+    void *dst_buf;
+    uint32_t dst_w;
+    uint32_t dst_h;
+    uint32_t dst_stride;
+    const void *src_buf;
+    uint32_t src_stride;
+    const uint8_t *mask_buf;
+    uint32_t mask_stride;
+} asm_dsc_t;
+
+#define SWAR_RESULT_INVALID     0           // Same as LV_RESULT_INVALID, the ANSI C implementation is used instead
+#define SWAR_RESULT_OK          1           // Same as LV_RESULT_OK
+
+/**
+ * @brief Channel mask used by lv_color_16_16_mix()
+ *
+ * Applied on a word holding two pixels, it keeps blue and red of the low pixel and green of the high pixel.
+ * The fields have enough space between them to hold the products of a 5 bit mix factor.
+ */
+#define SWAR_SPREAD_MASK        0x07E0F81FUL
+
+/**
+ * @brief A word of two pixels
+ *
+ * The pixel buffers are accessed as uint16_t (lv_color16_t) by LVGL, the word accesses must not break strict aliasing.
+ */
+typedef uint32_t __attribute__((may_alias)) swar_word_t;
+
+#define SWAR_LOAD32(p)          (*(const swar_word_t *)(p))
+
+// The row kernels are specialized by their constant arguments (opacity, mask, alignment), so they must be inlined
+#define SWAR_ALWAYS_INLINE      static inline __attribute__((always_inline))
+
+// ------------------------------------------------- Inline functions --------------------------------------------------
+
+/**
+ * @brief Swap the two pixels of a word
+ */
+static inline uint32_t swar_swap_px(uint32_t v)
+{
+    return (v >> 16) | (v << 16);
+}
+
+/**
+ * @brief Reduce an 8 bit opacity to the 0..32 mix factor used by lv_color_16_16_mix()
+ */
+static inline uint32_t swar_mix_factor(uint32_t opa)
+{
+    return (opa + 4) >> 3;
+}
+
+/**
+ * @brief Apply a constant opacity on a mask value, same as LV_OPA_MIX2()
+ *
+ * @param opa Constant opacity, LV_OPA_COVER (0xFF) when only the mask is used
+ */
+static inline uint32_t swar_mask_opa(uint32_t mask, uint32_t opa)
+{
+    return opa == 0xFF ? mask : (mask * opa) >> 8;
+}
+
+/**
+ * @brief Mix one pixel, same as lv_color_16_16_mix() but with a precomputed mix factor
+ */
+static inline uint16_t swar_mix_1px(uint32_t fg, uint32_t bg, uint32_t mix)
+{
+    uint32_t f = (fg | (fg << 16)) & SWAR_SPREAD_MASK;
+    uint32_t b = (bg | (bg << 16)) & SWAR_SPREAD_MASK;
+    uint32_t res = ((((f - b) * mix) >> 5) + b) & SWAR_SPREAD_MASK;
+    return (uint16_t)((res >> 16) | res);
+}
+
+/**
+ * @brief Mix the two pixels of a word with the same mix factor
+ *
+ * The word is split to two spread words instead of two pixels:
+ * the first one is blue and red of the low pixel with green of the high pixel,
+ * the second one is the same for the pixels swapped. This way no unpacking is needed.
+ */
+static inline uint32_t swar_mix_2px(uint32_t fg, uint32_t bg, uint32_t mix)
+{
+    uint32_t fa = fg & SWAR_SPREAD_MASK;
+    uint32_t ba = bg & SWAR_SPREAD_MASK;
+    uint32_t fb = swar_swap_px(fg) & SWAR_SPREAD_MASK;
+    uint32_t bb = swar_swap_px(bg) & SWAR_SPREAD_MASK;
+    uint32_t ra = ((((fa - ba) * mix) >> 5) + ba) & SWAR_SPREAD_MASK;
+    uint32_t rb = ((((fb - bb) * mix) >> 5) + bb) & SWAR_SPREAD_MASK;
+    return ra | swar_swap_px(rb);
+}
+
+/**
+ * @brief Mix the two pixels of a word with a constant color
+ *
+ * @param fg_mix Spread color multiplied by the mix factor
+ * @param inv_mix 32 - mix factor
+ */
+static inline uint32_t swar_mix_2px_const(uint32_t fg_mix, uint32_t bg, uint32_t inv_mix)
+{
+    uint32_t ra = ((fg_mix + (bg & SWAR_SPREAD_MASK) * inv_mix) >> 5) & SWAR_SPREAD_MASK;
+    uint32_t rb = ((fg_mix + (swar_swap_px(bg) & SWAR_SPREAD_MASK) * inv_mix) >> 5) & SWAR_SPREAD_MASK;
+    return ra | swar_swap_px(rb);
+}
+
+/**
+ * @brief Fill a row with a 16 bit pattern, any alignment is allowed
+ *
+ * @param dst Destination
+ * @param c32 The color repeated on both halves of the word
+ * @param len Length in bytes
+ */
+static inline void swar_memset16(void *dst, uint32_t c32, size_t len)
+{
+    uint8_t *d8 = (uint8_t *)dst;
+
+    // Write single bytes until 4-byte aligned, rotating the pattern so it stays in phase
+    while (((uintptr_t)d8 & 0x3) && len) {
+        *d8++ = (uint8_t)c32;
+        c32 = (c32 >> 8) | (c32 << 24);
+        len--;
+    }
+
+    swar_word_t *d32 = (swar_word_t *)d8;
+    while (len >= 32) {
+        d32[0] = c32;
+        d32[1] = c32;
+        d32[2] = c32;
+        d32[3] = c32;
+        d32[4] = c32;
+        d32[5] = c32;
+        d32[6] = c32;
+        d32[7] = c32;
+        d32 += 8;
+        len -= 32;
+    }
+    while (len >= 4) {
+        *d32++ = c32;
+        len -= 4;
+    }
+
+    d8 = (uint8_t *)d32;
+    while (len) {
+        *d8++ = (uint8_t)c32;
+        c32 >>= 8;
+        len--;
+    }
+}
+
+/**
+ * @brief Copy a row, any alignment is allowed
+ *
+ * Word copies are used when the source and the destination have the same 4-byte phase,
+ * or when they differ by a halfword (the words are merged from two aligned loads).
+ *
+ * @param dst Destination
+ * @param src Source
+ * @param len Length in bytes
+ */
+static inline void swar_memcpy16(void *dst, const void *src, size_t len)
+{
+    uint8_t *d8 = (uint8_t *)dst;
+    const uint8_t *s8 = (const uint8_t *)src;
+    uintptr_t phase = ((uintptr_t)d8 ^ (uintptr_t)s8) & 0x3;
+
+    if (phase & 0x1) {
+        memcpy(d8, s8, len);
+        return;
+    }
+
+    while (((uintptr_t)d8 & 0x3) && len) {
+        *d8++ = *s8++;
+        len--;
+    }
+
+    swar_word_t *d32 = (swar_word_t *)d8;
+    if (phase == 0) {
+        const swar_word_t *s32 = (const swar_word_t *)s8;
+        while (len >= 32) {
+            d32[0] = s32[0];
+            d32[1] = s32[1];
+            d32[2] = s32[2];
+            d32[3] = s32[3];
+            d32[4] = s32[4];
+            d32[5] = s32[5];
+            d32[6] = s32[6];
+            d32[7] = s32[7];
+            d32 += 8;
+            s32 += 8;
+            len -= 32;
+        }
+        while (len >= 4) {
+            *d32++ = *s32++;
+            len -= 4;
+        }
+        s8 = (const uint8_t *)s32;
+    } else if (len >= 6) {
+        // The source is 2 bytes off: keep the upper half of the previous aligned word
+        uint32_t carry = *(const uint16_t *)s8;
+        const swar_word_t *s32 = (const swar_word_t *)(s8 + 2);
+        while (len >= 6) {
+            uint32_t w = *s32++;
+            *d32++ = carry | (w << 16);
+            carry = w >> 16;
+            len -= 4;
+        }
+        s8 = (const uint8_t *)s32 - 2;
+    }
+
+    d8 = (uint8_t *)d32;
+    while (len) {
+        *d8++ = *s8++;
+        len--;
+    }
+}
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
@@ -0,0 +1,165 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// This is LVGL RGB565 image blend to RGB565 for ESP32C3 processor (SWAR, two pixels per 32-bit word)
+
+#include <stdbool.h>
+#include "lv_macro_swar_rgb565.h"
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Read two source pixels, starting from a 4-byte aligned destination position
+ *
+ * @param src_aligned The source has the same 4-byte phase as the destination, a word can be loaded
+ */
+static inline uint32_t load_src_2px(const uint16_t *src, bool src_aligned);
+
+/**
+ * @brief Blend a row with a mask and/or a constant opacity
+ *
+ * @param mask Mask of the row, NULL if not used
+ * @param opa Constant opacity, LV_OPA_COVER when only the mask is used
+ */
+SWAR_ALWAYS_INLINE void image_row_blend(uint16_t *dest, const uint16_t *src, const uint8_t *mask, int32_t w, uint32_t opa,
+                                      bool src_aligned);
+
+/**
+ * @brief Blend the whole area with a mask and/or a constant opacity
+ */
+SWAR_ALWAYS_INLINE int image_blend(asm_dsc_t *asm_dsc, const uint8_t *mask, uint32_t opa);
+
+// ------------------------------------------------ Public functions ---------------------------------------------------
+
+int lv_rgb565_blend_normal_to_rgb565_esp(asm_dsc_t *asm_dsc)
+{
+    const uint32_t w = asm_dsc->dst_w;
+    const uint32_t h = asm_dsc->dst_h;
+    const uint32_t dest_stride = asm_dsc->dst_stride;
+    const uint32_t src_stride = asm_dsc->src_stride;
+    uint8_t *dest = (uint8_t *)asm_dsc->dst_buf;
+    const uint8_t *src = (const uint8_t *)asm_dsc->src_buf;
+
+    for (uint32_t y = 0; y < h; y++) {
+        swar_memcpy16(dest, src, w * sizeof(uint16_t));
+        dest += dest_stride;
+        src += src_stride;
+    }
+
+    return SWAR_RESULT_OK;
+}
+
+int lv_rgb565_blend_normal_to_rgb565_with_opa_esp(asm_dsc_t *asm_dsc)
+{
+    return image_blend(asm_dsc, NULL, asm_dsc->opa);
+}
+
+int lv_rgb565_blend_normal_to_rgb565_with_mask_esp(asm_dsc_t *asm_dsc)
+{
+    return image_blend(asm_dsc, asm_dsc->mask_buf, 0xFF);
+}
+
+int lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_esp(asm_dsc_t *asm_dsc)
+{
+    return image_blend(asm_dsc, asm_dsc->mask_buf, asm_dsc->opa);
+}
+
+// ------------------------------------------------ Static functions ---------------------------------------------------
+
+SWAR_ALWAYS_INLINE int image_blend(asm_dsc_t *asm_dsc, const uint8_t *mask, uint32_t opa)
+{
+    const int32_t w = asm_dsc->dst_w;
+    const int32_t h = asm_dsc->dst_h;
+    const uint32_t dest_stride = asm_dsc->dst_stride;
+    const uint32_t src_stride = asm_dsc->src_stride;
+    const uint32_t mask_stride = asm_dsc->mask_stride;
+    uint8_t *dest = (uint8_t *)asm_dsc->dst_buf;
+    const uint8_t *src = (const uint8_t *)asm_dsc->src_buf;
+
+    // 16-bit accesses are used, let the ANSI implementation handle odd addresses
+    if (((uintptr_t)dest | dest_stride | (uintptr_t)src | src_stride) & 0x1) {
+        return SWAR_RESULT_INVALID;
+    }
+
+    // The phase of the rows can't change as the strides are checked too
+    const bool src_aligned = (((uintptr_t)dest ^ (uintptr_t)src) & 0x2) == 0 && ((dest_stride ^ src_stride) & 0x2) == 0;
+
+    for (int32_t y = 0; y < h; y++) {
+        if (src_aligned) {
+            image_row_blend((uint16_t *)dest, (const uint16_t *)src, mask, w, opa, true);
+        } else {
+            image_row_blend((uint16_t *)dest, (const uint16_t *)src, mask, w, opa, false);
+        }
+        dest += dest_stride;
+        src += src_stride;
+        if (mask) {
+            mask += mask_stride;
+        }
+    }
+
+    return SWAR_RESULT_OK;
+}
+
+static inline uint32_t load_src_2px(const uint16_t *src, bool src_aligned)
+{
+    if (src_aligned) {
+        return SWAR_LOAD32(src);
+    }
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 16);
+}
+
+SWAR_ALWAYS_INLINE void image_row_blend(uint16_t *dest, const uint16_t *src, const uint8_t *mask, int32_t w, uint32_t opa,
+                                      bool src_aligned)
+{
+    int32_t x = 0;
+
+    if (mask == NULL) {
+        const uint32_t mix = swar_mix_factor(opa);
+        if (w > 0 && ((uintptr_t)dest & 0x2)) {
+            dest[0] = swar_mix_1px(src[0], dest[0], mix);
+            x = 1;
+        }
+        for (; x < w - 1; x += 2) {
+            swar_word_t *dest32 = (swar_word_t *)&dest[x];
+            *dest32 = swar_mix_2px(load_src_2px(&src[x], src_aligned), *dest32, mix);
+        }
+        if (x < w) {
+            dest[x] = swar_mix_1px(src[x], dest[x], mix);
+        }
+        return;
+    }
+
+    if (w > 0 && ((uintptr_t)dest & 0x2)) {
+        dest[0] = swar_mix_1px(src[0], dest[0], swar_mix_factor(swar_mask_opa(mask[0], opa)));
+        x = 1;
+    }
+
+    for (; x < w - 1; x += 2) {
+        uint32_t m0 = mask[x];
+        uint32_t m1 = mask[x + 1];
+        if ((m0 | m1) == 0) {
+            continue;
+        }
+        swar_word_t *dest32 = (swar_word_t *)&dest[x];
+        if ((m0 & m1) == 0xFF && opa == 0xFF) {
+            *dest32 = load_src_2px(&src[x], src_aligned);
+            continue;
+        }
+
+        m0 = swar_mix_factor(swar_mask_opa(m0, opa));
+        m1 = swar_mix_factor(swar_mask_opa(m1, opa));
+        if (m0 == m1) {
+            *dest32 = swar_mix_2px(load_src_2px(&src[x], src_aligned), *dest32, m0);
+        } else {
+            dest[x] = swar_mix_1px(src[x], dest[x], m0);
+            dest[x + 1] = swar_mix_1px(src[x + 1], dest[x + 1], m1);
+        }
+    }
+
+    if (x < w) {
+        dest[x] = swar_mix_1px(src[x], dest[x], swar_mix_factor(swar_mask_opa(mask[x], opa)));
+    }
+}
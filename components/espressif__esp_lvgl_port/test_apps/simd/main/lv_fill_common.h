@@ -52,6 +52,8 @@ typedef struct {
     unsigned int dest_h;                                    // Destination buffer height
     unsigned int dest_stride;                               // Destination buffer stride
     unsigned int unalign_byte;                              // Destination buffer memory unalignment
+    lv_opa_t opa;                                           // Opacity of the fill
+    bool use_mask;                                          // Blend through a mask buffer
 } func_test_case_params_t;
 
 /**
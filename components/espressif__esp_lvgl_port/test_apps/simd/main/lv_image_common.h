@@ -88,6 +88,8 @@ typedef struct {
     unsigned int src_unalign_byte;                            /*!< Source buffer memory unalignment */
     unsigned int dest_unalign_byte;                           /*!< Destination buffer memory unalignment */
     blend_operation_t operation_type;                         /*!< Type of fundamental blend operation */
+    lv_opa_t opa;                                             /*!< Opacity of the blend */
+    bool use_mask;                                            /*!< Blend through a mask buffer */
 } func_test_case_lv_image_params_t;
 
 
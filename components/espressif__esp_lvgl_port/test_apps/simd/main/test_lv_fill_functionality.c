@@ -125,6 +125,7 @@ TEST_CASE("Test fill functionality ARGB8888", "[fill][functionality][ARGB8888]")
         .blend_api_func = &lv_draw_sw_blend_color_to_argb8888,
         .color_format = LV_COLOR_FORMAT_ARGB8888,
         .data_type_size = sizeof(uint32_t),
+        .opa = LV_OPA_MAX,
     };
 
     ESP_LOGI(TAG_LV_FILL_FUNC, "running test for ARGB8888 color format");
@@ -149,6 +150,7 @@ TEST_CASE("Test fill functionality RGB565", "[fill][functionality][RGB565]")
         .blend_api_func = &lv_draw_sw_blend_color_to_rgb565,
         .color_format = LV_COLOR_FORMAT_RGB565,
         .data_type_size = sizeof(uint16_t),
+        .opa = LV_OPA_MAX,
     };
 
     ESP_LOGI(TAG_LV_FILL_FUNC, "running test for RGB565 color format");
@@ -173,11 +175,44 @@ TEST_CASE("Test fill functionality RGB888", "[fill][functionality][RGB888]")
         .blend_api_px_func = &lv_draw_sw_blend_color_to_rgb888,
         .color_format = LV_COLOR_FORMAT_RGB888,
         .data_type_size = sizeof(uint8_t) * 3,   // 24-bit data length
+        .opa = LV_OPA_MAX,
     };
 
     ESP_LOGI(TAG_LV_FILL_FUNC, "running test for RGB888 color format");
     functionality_test_matrix(&test_matrix, &test_case);
 }
+TEST_CASE("Test fill functionality RGB565 with opa and mask", "[fill][functionality][RGB565]")
+{
+    // Opacity only, mask only, mask with opacity
+    const lv_opa_t opa[] = {LV_OPA_50, LV_OPA_MAX, LV_OPA_50};
+    const bool use_mask[] = {false, true, true};
+
+    for (int i = 0; i < sizeof(opa) / sizeof(opa[0]); i++) {
+        test_matrix_params_t test_matrix = {
+            .min_w = 1,
+            .min_h = 1,
+            .max_w = 24,
+            .max_h = 4,
+            .min_unalign_byte = 0,
+            .max_unalign_byte = 16,
+            .unalign_step = 1,
+            .dest_stride_step = 1,
+            .test_combinations_count = 0,
+        };
+
+        func_test_case_params_t test_case = {
+            .blend_api_func = &lv_draw_sw_blend_color_to_rgb565,
+            .color_format = LV_COLOR_FORMAT_RGB565,
+            .data_type_size = sizeof(uint16_t),
+            .opa = opa[i],
+            .use_mask = use_mask[i],
+        };
+
+        ESP_LOGI(TAG_LV_FILL_FUNC, "running test for RGB565 color format, opa = %d, mask = %d", opa[i], use_mask[i]);
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+}
+
 // ------------------------------------------------ Static test functions ----------------------------------------------
 
 static void functionality_test_matrix(test_matrix_params_t *test_matrix, func_test_case_params_t *test_case)
@@ -209,15 +244,26 @@ static void lv_fill_functionality(func_test_case_params_t *test_case)
 {
     fill_test_bufs(test_case);
 
+    // Mask with fully transparent, fully opaque and partially transparent pixels, common for both APIs
+    lv_opa_t *mask_buf = NULL;
+    if (test_case->use_mask) {
+        mask_buf = malloc(test_case->dest_w * test_case->dest_h);
+        TEST_ASSERT_NOT_NULL_MESSAGE(mask_buf, "Lack of memory");
+        for (int i = 0; i < test_case->dest_w * test_case->dest_h; i++) {
+            mask_buf[i] = (i % 5 == 0) ? LV_OPA_TRANSP : (i % 5 == 1) ? LV_OPA_COVER : (lv_opa_t)(i * 37);
+        }
+    }
+
     // Init structure for LVGL blend API, to call the Assembly API
     _lv_draw_sw_blend_fill_dsc_t dsc_asm = {
         .dest_buf = test_case->buf.p_asm,
         .dest_w = test_case->dest_w,
         .dest_h = test_case->dest_h,
         .dest_stride = test_case->dest_stride * test_case->data_type_size,  // stride * sizeof()
-        .mask_buf = NULL,
+        .mask_buf = mask_buf,
+        .mask_stride = test_case->dest_w,
         .color = test_color,
-        .opa = LV_OPA_MAX,
+        .opa = test_case->opa,
         .use_asm = true,
     };
 
@@ -239,7 +285,7 @@ static void lv_fill_functionality(func_test_case_params_t *test_case)
     test_case->buf.p_ansi -= CANARY_BYTES * test_case->data_type_size;
 
     // Evaluate the results
-    sprintf(test_msg_buf, "Test case: dest_w = %d, dest_h = %d, dest_stride = %d, unalign_byte = %d\n", test_case->dest_w, test_case->dest_h, test_case->dest_stride, test_case->unalign_byte);
+    sprintf(test_msg_buf, "Test case: dest_w = %d, dest_h = %d, dest_stride = %d, unalign_byte = %d, opa = %d, mask = %d\n", test_case->dest_w, test_case->dest_h, test_case->dest_stride, test_case->unalign_byte, test_case->opa, test_case->use_mask);
 
     switch (test_case->color_format) {
     case LV_COLOR_FORMAT_ARGB8888: {
@@ -263,6 +309,7 @@ static void lv_fill_functionality(func_test_case_params_t *test_case)
 
     free(test_case->buf.p_asm_alloc);
     free(test_case->buf.p_ansi_alloc);
+    free(mask_buf);
 
 }
 
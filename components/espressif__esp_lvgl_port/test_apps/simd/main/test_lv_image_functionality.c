@@ -140,6 +140,7 @@ TEST_CASE("LV Image functionality RGB565 blend to RGB565", "[image][functionalit
         .src_data_type_size = sizeof(uint16_t),
         .dest_data_type_size = sizeof(uint16_t),
         .operation_type = OPERATION_FILL,
+        .opa = LV_OPA_MAX,
     };
 
     ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for RGB565 color format");
@@ -158,12 +159,39 @@ TEST_CASE("LV Image functionality RGB888 blend to RGB888", "[image][functionalit
         .src_data_type_size = sizeof(uint8_t) * 3,
         .dest_data_type_size = sizeof(uint8_t) * 3,
         .operation_type = OPERATION_FILL,
+        .opa = LV_OPA_MAX,
     };
 
     ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for RGB888 color format");
     functionality_test_matrix(&test_matrix, &test_case);
 }
 
+TEST_CASE("LV Image functionality RGB565 blend to RGB565 with opa and mask", "[image][functionality][RGB565]")
+{
+    // Opacity only, mask only, mask with opacity
+    const lv_opa_t opa[] = {LV_OPA_50, LV_OPA_MAX, LV_OPA_50};
+    const bool use_mask[] = {false, true, true};
+
+    for (int i = 0; i < sizeof(opa) / sizeof(opa[0]); i++) {
+        test_matrix_lv_image_params_t test_matrix = default_test_matrix_image_blend;
+
+        func_test_case_lv_image_params_t test_case = {
+            .blend_api_func = &lv_draw_sw_blend_image_to_rgb565,
+            .color_format = LV_COLOR_FORMAT_RGB565,
+            .canary_pixels = CANARY_PIXELS_RGB565,
+            .memory_alignment_offset = 0,
+            .src_data_type_size = sizeof(uint16_t),
+            .dest_data_type_size = sizeof(uint16_t),
+            .operation_type = OPERATION_FILL,
+            .opa = opa[i],
+            .use_mask = use_mask[i],
+        };
+
+        ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for RGB565 color format, opa = %d, mask = %d", opa[i], use_mask[i]);
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+}
+
 // ------------------------------------------------ Static test functions ----------------------------------------------
 
 static void functionality_test_matrix(test_matrix_lv_image_params_t *test_matrix, func_test_case_lv_image_params_t *test_case)
@@ -203,17 +231,27 @@ static void lv_image_functionality(func_test_case_lv_image_params_t *test_case)
 {
     fill_test_bufs(test_case);
 
+    // Mask with fully transparent, fully opaque and partially transparent pixels, common for both APIs
+    lv_opa_t *mask_buf = NULL;
+    if (test_case->use_mask) {
+        mask_buf = malloc(test_case->dest_w * test_case->dest_h);
+        TEST_ASSERT_NOT_NULL_MESSAGE(mask_buf, "Lack of memory");
+        for (int i = 0; i < test_case->dest_w * test_case->dest_h; i++) {
+            mask_buf[i] = (i % 5 == 0) ? LV_OPA_TRANSP : (i % 5 == 1) ? LV_OPA_COVER : (lv_opa_t)(i * 37);
+        }
+    }
+
     _lv_draw_sw_blend_image_dsc_t dsc_asm = {
         .dest_buf = test_case->buf.p_dest_asm,
         .dest_w = test_case->dest_w,
         .dest_h = test_case->dest_h,
         .dest_stride = test_case->dest_stride * test_case->dest_data_type_size,  // dest_stride * sizeof(data_type)
-        .mask_buf = NULL,
-        .mask_stride = 0,
+        .mask_buf = mask_buf,
+        .mask_stride = test_case->dest_w,
         .src_buf = test_case->buf.p_src,
         .src_stride = test_case->src_stride * test_case->src_data_type_size,     // src_stride * sizeof(data_type)
         .src_color_format = test_case->color_format,
-        .opa = LV_OPA_MAX,
+        .opa = test_case->opa,
         .blend_mode = LV_BLEND_MODE_NORMAL,
         .use_asm = true,
     };
@@ -238,8 +276,9 @@ static void lv_image_functionality(func_test_case_lv_image_params_t *test_case)
     test_case->buf.p_dest_ansi -= test_case->canary_pixels * test_case->dest_data_type_size;
 
     // Evaluate the results
-    sprintf(test_msg_buf, "Test case: dest_w = %d, dest_h = %d, dest_stride = %d, src_stride = %d, dest_unalign_byte = %d, src_unalign_byte = %d\n",
-            test_case->dest_w, test_case->dest_h, test_case->dest_stride, test_case->src_stride, test_case->dest_unalign_byte, test_case->src_unalign_byte);
+    sprintf(test_msg_buf, "Test case: dest_w = %d, dest_h = %d, dest_stride = %d, src_stride = %d, dest_unalign_byte = %d, src_unalign_byte = %d, opa = %d, mask = %d\n",
+            test_case->dest_w, test_case->dest_h, test_case->dest_stride, test_case->src_stride, test_case->dest_unalign_byte, test_case->src_unalign_byte,
+            test_case->opa, test_case->use_mask);
 #if DBG_PRINT_OUTPUT
     printf("%s\n", test_msg_buf);
 #endif
@@ -259,6 +298,7 @@ static void lv_image_functionality(func_test_case_lv_image_params_t *test_case)
     free(test_case->buf.p_dest_asm_alloc);
     free(test_case->buf.p_dest_ansi_alloc);
     free(test_case->buf.p_src_alloc);
+    free(mask_buf);
 }
 
 static void fill_test_bufs(func_test_case_lv_image_params_t *test_case)
@@ -391,13 +431,16 @@ static void test_eval_image_16bit_data(func_test_case_lv_image_params_t *test_ca
     // dest_buf_asm and dest_buf_ansi must be equal
     TEST_ASSERT_EQUAL_UINT16_ARRAY_MESSAGE((uint16_t *)test_case->buf.p_dest_ansi + canary_pixels, (uint16_t *)test_case->buf.p_dest_asm + canary_pixels, test_case->active_dest_buf_len, test_msg_buf);
 
-    // Data part of the destination buffer and source buffer (not considering matrix padding) must be equal
-    uint16_t *dest_row_begin = (uint16_t *)test_case->buf.p_dest_asm + canary_pixels;
-    uint16_t *src_row_begin = (uint16_t *)test_case->buf.p_src;
-    for (int row = 0; row < test_case->dest_h; row++) {
-        TEST_ASSERT_EQUAL_UINT16_ARRAY_MESSAGE(dest_row_begin, src_row_begin, test_case->dest_w, test_msg_buf);
-        dest_row_begin += test_case->dest_stride;   // Move pointer of the destination buffer to the next row
-        src_row_begin += test_case->src_stride;     // Move pointer of the source buffer to the next row
+    // Data part of the destination buffer and source buffer (not considering matrix padding) must be equal,
+    // only if the image is copied (no opacity, no mask)
+    if (test_case->opa >= LV_OPA_MAX && !test_case->use_mask) {
+        uint16_t *dest_row_begin = (uint16_t *)test_case->buf.p_dest_asm + canary_pixels;
+        uint16_t *src_row_begin = (uint16_t *)test_case->buf.p_src;
+        for (int row = 0; row < test_case->dest_h; row++) {
+            TEST_ASSERT_EQUAL_UINT16_ARRAY_MESSAGE(dest_row_begin, src_row_begin, test_case->dest_w, test_msg_buf);
+            dest_row_begin += test_case->dest_stride;   // Move pointer of the destination buffer to the next row
+            src_row_begin += test_case->src_stride;     // Move pointer of the source buffer to the next row
+        }
     }
 
     // Canary pixels area must stay 0
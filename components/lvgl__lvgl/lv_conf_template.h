@@ -81,8 +81,17 @@
         #undef LV_MEM_POOL_INCLUDE
         #undef LV_MEM_POOL_ALLOC
     #endif
+
+    /** Keep up to this many freed blocks of each 16 byte wide size class up to 128 bytes
+     *  and reuse them for the next allocations of the same size class without calling TLSF.
+     *  The cached blocks are returned to TLSF by `lv_mem_monitor()`. 0: disable */
+    #define LV_MEM_SIZE_CLASS_CACHE_CNT 0
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
+/** 1: Count the live and peak size of the allocations per module (see `lv_mem_set_tag()`)
+ *  and a histogram of the allocation sizes. Adds a 16 byte header to each allocation. */
+#define LV_USE_MEM_STATS 0
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -194,6 +203,18 @@
      *  - > 1 means multiple threads will render the screen in parallel. */
     #define LV_DRAW_SW_DRAW_UNIT_CNT    1
 
+    /** Balance the load between the SW draw units.
+     *  Every render thread gets its own job queue and large fills and images are split
+     *  into row bands which idle threads can steal from the busy ones.
+     *  The displays are not split into tiles by default in this case.
+     *  Requires `LV_DRAW_SW_DRAW_UNIT_CNT > 1`. */
+    #define LV_DRAW_SW_WORK_STEALING    0
+
+    #if LV_DRAW_SW_WORK_STEALING
+        /** Minimum height of a row band in pixels. Draw tasks lower than twice this value are not split. */
+        #define LV_DRAW_SW_WORK_STEALING_MIN_ROWS   32
+    #endif
+
     /** Use Arm-2D to accelerate software (sw) rendering. */
     #define LV_USE_DRAW_ARM2D_SYNC      0
 
@@ -218,6 +239,13 @@
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
 
+    /** Use SIMD accelerated blending:
+     *  - LV_DRAW_SW_ASM_NONE:    plain C
+     *  - LV_DRAW_SW_ASM_NEON:    Arm NEON assembly
+     *  - LV_DRAW_SW_ASM_HELIUM:  Arm Helium assembly
+     *  - LV_DRAW_SW_ASM_SSE2:    x86 SSE2 intrinsics
+     *  - LV_DRAW_SW_ASM_AVX2:    x86 AVX2 intrinsics (the compiler has to target AVX2, e.g. `-mavx2`)
+     *  - LV_DRAW_SW_ASM_CUSTOM:  use LV_DRAW_SW_ASM_CUSTOM_INCLUDE */
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
@@ -459,6 +487,30 @@
  *  The main logic is like `LV_CACHE_DEF_SIZE` but for image headers. */
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/** 1: Evict the images from the cache by decoding time and size (GreedyDual-Size), not only by last use.
+ *  Small images which are slow to decode (e.g. PNG, JPG) are kept longer than large, quick to open ones. */
+#define LV_IMAGE_CACHE_COST_AWARE 0
+
+/** Images larger than this % of `LV_CACHE_DEF_SIZE` are cached only when they are opened the second time,
+ *  so one-off large images don't evict the others. 0: cache all images. */
+#define LV_IMAGE_CACHE_ADMIT_PCT 0
+
+/** Split the image and image header caches into this many independently locked shards,
+ *  so the draw threads (`LV_DRAW_SW_DRAW_UNIT_CNT > 1`) don't wait for each other on cache hits.
+ *  Each shard can hold 1/N of the cache size. 1: no sharding. */
+#define LV_IMAGE_CACHE_SHARD_CNT 1
+
+/** 1: Enable decoding images on a background thread with `lv_image_set_decode_async()`.
+ *  Requires `LV_USE_OS` and the image cache (`LV_CACHE_DEF_SIZE > 0`) to keep the decoded images. */
+#define LV_USE_IMAGE_DECODER_ASYNC 0
+
+/** 1: Convert the cached RGB888, XRGB8888 and ARGB8888 images to the display's RGB565 or RGB565_SWAPPED
+ *  color format (RGB565A8 if the image has transparent pixels) when they are decoded,
+ *  so they can be blended without color conversion. Can be disabled with `lv_image_decoder_set_convert_native()`.
+ *  Variable images which can be drawn directly (e.g. C arrays) are converted only if enabled by
+ *  `lv_image_decoder_set_convert_native_variables()`. */
+#define LV_IMAGE_DECODER_CONVERT_NATIVE 0
+
 /** Number of stops allowed per gradient. Increase this to allow more stops.
  *  This adds (sizeof(lv_color_t) + 1) bytes per additional stop. */
 #define LV_GRADIENT_MAX_STOPS   2
@@ -474,6 +526,29 @@
 /** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/** Cache the resolved style property values of each `lv_obj_t`.
+ *  Number of cached values per object, must be a power of 2. 0: disable.
+ *  The cache is allocated together with the object, each entry takes 8..16 bytes.
+ *  The cached values of an object are dropped when its style list, state or parent changes,
+ *  or lv_obj_report_style_change() reports a change of one of its styles. */
+#define LV_OBJ_STYLE_VALUE_CACHE_CNT    0
+
+/** Keep the properties of the (non-constant) styles sorted to find them with binary search.
+ *  The property buffer of the styles grows geometrically instead of being reallocated on every new property. */
+#define LV_STYLE_SORTED_PROPS   0
+
+/** Keep the timers in a binary heap ordered by their deadlines.
+ *  `lv_timer_handler()` checks only the timers which are ready instead of all of them. */
+#define LV_TIMER_DEADLINE_HEAP  0
+
+/** Index the running animations by their `var` in a hash table.
+ *  Starting and deleting animations doesn't need to scan all the running animations. */
+#define LV_ANIM_HASH_INDEX      0
+
+/** Keep the memory of the deleted objects of the classes set by `lv_obj_class_set_pool_size()`
+ *  and reuse it for the new objects of the same class. */
+#define LV_USE_OBJ_POOL         0
+
 /** Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -636,9 +711,17 @@
  *  A compiler error will be triggered if a font needs it. */
 #define LV_FONT_FMT_TXT_LARGE 0
 
+/** Allow creating tables to get the glyph of a letter and the kerning values without searching.
+ *  See `lv_font_fmt_txt_lookup_create()`. Useful for fonts with many sparse characters, e.g. CJK fonts. */
+#define LV_FONT_FMT_TXT_LOOKUP_TABLE 0
+
 /** Enables/disables support for compressed fonts. */
 #define LV_USE_FONT_COMPRESSED 0
 
+/** Size of the cache for the decompressed glyph bitmaps of compressed fonts [bytes].
+ *  The recently used glyphs are not decompressed again on every draw. 0: disable caching. */
+#define LV_FONT_FMT_TXT_CACHE_SIZE 0
+
 /** Enable drawing placeholders when glyph dsc is not found. */
 #define LV_USE_FONT_PLACEHOLDER 1
 
@@ -745,6 +828,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1   /**< Enable selecting text of the label */
     #define LV_LABEL_LONG_TXT_HINT 1    /**< Store some extra info in labels to speed up drawing of very long text */
+    #define LV_LABEL_LINE_CACHE 0       /**< Store the start and width of the wrapped lines to draw only the visible lines */
     #define LV_LABEL_WAIT_CHAR_COUNT 3  /**< The count of wait chart */
 #endif
 
@@ -828,6 +912,11 @@
 /** A layout similar to Grid in CSS. */
 #define LV_USE_GRID 1
 
+/** Keep the style dependent values of the children measured by Flex and Grid (~40 bytes per child of
+ *  the containers) and the tracks of Grid between the layout updates.
+ *  Adds a 4 bytes style version counter to every widget. */
+#define LV_LAYOUT_MEASURE_CACHE 0
+
 /*====================
  * 3RD PARTS LIBRARIES
  *====================*/
@@ -840,6 +929,10 @@
  *  https://docs.lvgl.io/master/details/main-modules/fs.html#lv-fs-identifier-letters . */
 #define LV_FS_DEFAULT_DRIVER_LETTER '\0'
 
+/** Number of `LV_FS_*_CACHE_SIZE` bytes large blocks cached by `lv_fs_read()` per open file.
+ *  With 2 or more blocks, the next block is also read when a file is read sequentially. */
+#define LV_FS_CACHE_BLOCK_CNT 1
+
 /** API for fopen, fread, etc. */
 #define LV_USE_FS_STDIO 0
 #if LV_USE_FS_STDIO
@@ -907,6 +1000,11 @@
 
 /** LODEPNG decoder library */
 #define LV_USE_LODEPNG 0
+#if LV_USE_LODEPNG
+    /** >0: Decode the images which are not cached in bands of this many rows while drawing,
+     *  instead of decoding the whole image to the memory. */
+    #define LV_LODEPNG_BAND_HEIGHT 0
+#endif
 
 /** PNG decoder(libpng) library */
 #define LV_USE_LIBPNG 0
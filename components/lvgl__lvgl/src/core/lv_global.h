@@ -30,8 +30,9 @@ extern "C" {
 #include "../osal/lv_os.h"
 #include "../others/sysmon/lv_sysmon.h"
 #include "../stdlib/builtin/lv_tlsf.h"
+#include "../stdlib/lv_mem.h"
 
-#if LV_USE_FONT_COMPRESSED
+#if LV_USE_FONT_COMPRESSED || LV_FONT_FMT_TXT_LOOKUP_TABLE
 #include "../font/lv_font_fmt_txt_private.h"
 #endif
 
@@ -49,6 +50,7 @@ extern "C" {
 #include "../tick/lv_tick_private.h"
 #include "../draw/lv_draw_buf_private.h"
 #include "../draw/lv_draw_private.h"
+#include "../draw/lv_image_decoder_private.h"
 #include "../draw/sw/lv_draw_sw_private.h"
 #include "../draw/sw/lv_draw_sw_mask_private.h"
 #include "../stdlib/builtin/lv_tlsf_private.h"
@@ -90,7 +92,13 @@ typedef struct _lv_global_t {
     lv_display_t * disp_default;
 
     lv_ll_t style_trans_ll;
+#if LV_USE_OBJ_POOL
+    lv_ll_t obj_pool_ll;
+#endif
     bool style_refresh;
+#if LV_LAYOUT_MEASURE_CACHE
+    uint32_t style_version_last;
+#endif
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
@@ -105,6 +113,7 @@ typedef struct _lv_global_t {
     uint32_t layout_count;
     lv_layout_dsc_t * layout_list;
     bool layout_update_mutex;
+    uint32_t layout_visit_cnt;      /**< Number of objects visited by the layout updates so far*/
 
     uint32_t memory_zero;
     uint32_t math_rand_seed;
@@ -125,6 +134,14 @@ typedef struct _lv_global_t {
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+    lv_image_cache_admission_t img_cache_admission;
+#if LV_IMAGE_DECODER_CONVERT_NATIVE
+    bool img_convert_native;
+    bool img_convert_native_variables;
+#endif
+#if LV_USE_IMAGE_DECODER_ASYNC
+    lv_image_decoder_async_t image_decoder_async;
+#endif
 
     lv_draw_global_info_t draw_info;
     lv_ll_t draw_sw_blend_handler_ll;
@@ -159,6 +176,11 @@ typedef struct _lv_global_t {
     lv_tlsf_state_t tlsf_state;
 #endif
 
+#if LV_USE_MEM_STATS
+    lv_mem_stats_t mem_stats;
+    lv_mutex_t mem_stats_lock;
+#endif
+
     lv_ll_t fsdrv_ll;
 #if LV_USE_FS_STDIO != '\0'
     lv_fs_drv_t stdio_fs_drv;
@@ -197,6 +219,9 @@ typedef struct _lv_global_t {
 
 #if LV_USE_FONT_COMPRESSED
     lv_font_fmt_rle_t font_fmt_rle;
+#if LV_FONT_FMT_TXT_CACHE_SIZE > 0
+    lv_font_fmt_txt_cache_state_t font_fmt_txt_cache;
+#endif
 #endif
 
 #if LV_USE_SPAN != 0
@@ -26,6 +26,7 @@
 #include "../tick/lv_tick.h"
 #include "../stdlib/lv_string.h"
 #include "lv_obj_draw_private.h"
+#include "../layouts/lv_layout_private.h"
 
 /*********************
  *      DEFINES
@@ -376,7 +377,10 @@ void lv_obj_allocate_spec_attr(lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
     if(obj->spec_attr == NULL) {
+        lv_mem_tag_t mem_tag_prev;
+        LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_OBJ, mem_tag_prev);
         obj->spec_attr = lv_malloc_zeroed(sizeof(lv_obj_spec_attr_t));
+        LV_MEM_STATS_TAG_END(mem_tag_prev);
         LV_ASSERT_MALLOC(obj->spec_attr);
         if(obj->spec_attr == NULL) return;
 
@@ -548,8 +552,9 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
         }
 #endif
 
-        lv_free(obj->spec_attr);
-        obj->spec_attr = NULL;
+        lv_layout_cache_delete(obj);
+
+        /*`spec_attr` itself is freed with the object by `lv_obj_class_free_obj()`*/
     }
 
 #if LV_OBJ_ID_AUTO_ASSIGN
@@ -923,6 +928,7 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
     lv_obj_invalidate(obj);
 
     obj->state = new_state;
+    lv_obj_style_value_cache_invalidate(obj, true);  /*The children might inherit the changed values*/
     lv_obj_update_layer_type(obj);
     lv_obj_style_transition_dsc_t * ts = lv_malloc_zeroed(sizeof(lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     uint32_t tsi = 0;
@@ -8,16 +8,23 @@
  *********************/
 #include "lv_obj_class_private.h"
 #include "lv_obj_private.h"
+#include "lv_obj_style_private.h"
 #include "../themes/lv_theme.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../stdlib/lv_string.h"
+#include "../core/lv_global.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS (&lv_obj_class)
 
+#if LV_USE_OBJ_POOL
+    #define obj_pool_ll_p &(LV_GLOBAL_DEFAULT()->obj_pool_ll)
+#endif
+#define style_version_last LV_GLOBAL_DEFAULT()->style_version_last
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -31,6 +38,10 @@
  **********************/
 static void lv_obj_construct(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static uint32_t get_instance_size(const lv_obj_class_t * class_p);
+#if LV_USE_OBJ_POOL
+    static lv_obj_class_pool_t * pool_find(const lv_obj_class_t * class_p);
+    static lv_obj_t * pool_get(const lv_obj_class_t * class_p, uint32_t instance_size);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -48,8 +59,29 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
 {
     LV_TRACE_OBJ_CREATE("Creating object with %p class on %p parent", (void *)class_p, (void *)parent);
     uint32_t s = get_instance_size(class_p);
-    lv_obj_t * obj = lv_malloc_zeroed(s);
-    if(obj == NULL) return NULL;
+#if LV_OBJ_STYLE_VALUE_CACHE_CNT
+    /*Allocate the style value cache in the same block to not fragment the heap with it*/
+    uint32_t cache_ofs = LV_ALIGN_UP(s, sizeof(lv_style_value_t));
+    s = cache_ofs + LV_OBJ_STYLE_VALUE_CACHE_CNT * sizeof(lv_obj_style_value_cache_t);
+#endif
+    lv_obj_t * obj = NULL;
+#if LV_USE_OBJ_POOL
+    obj = pool_get(class_p, get_instance_size(class_p));
+#endif
+    if(obj == NULL) {
+        lv_mem_tag_t mem_tag_prev;
+        LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_OBJ, mem_tag_prev);
+        obj = lv_malloc_zeroed(s);
+        LV_MEM_STATS_TAG_END(mem_tag_prev);
+        if(obj == NULL) return NULL;
+    }
+#if LV_OBJ_STYLE_VALUE_CACHE_CNT
+    obj->style_value_cache = (lv_obj_style_value_cache_t *)((uint8_t *)obj + cache_ofs);
+#endif
+#if LV_LAYOUT_MEASURE_CACHE
+    /*Not to find the measured values of a deleted widget from the same address*/
+    obj->style_version = ++style_version_last;
+#endif
     obj->class_p = class_p;
     obj->parent = parent;
 
@@ -59,7 +91,7 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         lv_display_t * disp = lv_display_get_default();
         if(!disp) {
             LV_LOG_WARN("No display created yet. No place to assign the new screen");
-            lv_free(obj);
+            lv_obj_class_free_obj(class_p, obj);
             return NULL;
         }
 
@@ -70,7 +102,7 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         lv_obj_t ** screens = lv_realloc(disp->screens, sizeof(lv_obj_t *) * (disp->screen_cnt + 1));
         LV_ASSERT_MALLOC(screens);
         if(screens == NULL) {
-            lv_free(obj);
+            lv_obj_class_free_obj(class_p, obj);
             return NULL;
         }
 
@@ -146,6 +178,77 @@ void lv_obj_destruct(lv_obj_t * obj)
     }
 }
 
+void lv_obj_class_free_obj(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+#if LV_USE_OBJ_POOL
+    lv_obj_class_pool_t * pool = pool_find(class_p);
+    if(pool && pool->cnt < pool->capacity) {
+        obj->parent = pool->free_head;
+        pool->free_head = obj;
+        pool->cnt++;
+        return;
+    }
+#else
+    LV_UNUSED(class_p);
+#endif
+
+    lv_free(obj->spec_attr);
+    lv_free(obj);
+}
+
+#if LV_USE_OBJ_POOL
+
+void lv_obj_class_set_pool_size(const lv_obj_class_t * class_p, uint32_t cnt)
+{
+    LV_ASSERT_NULL(class_p);
+
+    lv_obj_class_pool_t * pool = pool_find(class_p);
+    if(pool == NULL) {
+        if(cnt == 0) return;
+
+        if(lv_ll_get_head(obj_pool_ll_p) == NULL) lv_ll_init(obj_pool_ll_p, sizeof(lv_obj_class_pool_t));
+        pool = lv_ll_ins_head(obj_pool_ll_p);
+        LV_ASSERT_MALLOC(pool);
+        if(pool == NULL) return;
+
+        lv_memzero(pool, sizeof(lv_obj_class_pool_t));
+        pool->class_p = class_p;
+    }
+
+    pool->capacity = cnt;
+
+    /*Free the objects which don't fit anymore*/
+    while(pool->cnt > cnt) {
+        lv_obj_t * obj = pool->free_head;
+        pool->free_head = obj->parent;
+        pool->cnt--;
+        lv_free(obj->spec_attr);
+        lv_free(obj);
+    }
+
+    if(cnt == 0) {
+        lv_ll_remove(obj_pool_ll_p, pool);
+        lv_free(pool);
+    }
+}
+
+uint32_t lv_obj_class_get_pool_cnt(const lv_obj_class_t * class_p)
+{
+    lv_obj_class_pool_t * pool = pool_find(class_p);
+    return pool ? pool->cnt : 0;
+}
+
+void lv_obj_class_pool_deinit(void)
+{
+    lv_obj_class_pool_t * pool = lv_ll_get_head(obj_pool_ll_p);
+    while(pool) {
+        lv_obj_class_set_pool_size(pool->class_p, 0);
+        pool = lv_ll_get_head(obj_pool_ll_p);
+    }
+}
+
+#endif /*LV_USE_OBJ_POOL*/
+
 bool lv_obj_is_editable(lv_obj_t * obj)
 {
     const lv_obj_class_t * class_p = obj->class_p;
@@ -202,3 +305,54 @@ static uint32_t get_instance_size(const lv_obj_class_t * class_p)
 
     return base->instance_size;
 }
+
+#if LV_USE_OBJ_POOL
+
+static lv_obj_class_pool_t * pool_find(const lv_obj_class_t * class_p)
+{
+    lv_obj_class_pool_t * pool;
+    LV_LL_READ(obj_pool_ll_p, pool) {
+        if(pool->class_p == class_p) return pool;
+    }
+
+    return NULL;
+}
+
+/**
+ * Take a kept object from the pool of a class and reset it as if it was just allocated
+ * @param class_p           pointer to a class
+ * @param instance_size     size of the class's instances
+ * @return                  the reset object or NULL if there are no kept objects
+ */
+static lv_obj_t * pool_get(const lv_obj_class_t * class_p, uint32_t instance_size)
+{
+    lv_obj_class_pool_t * pool = pool_find(class_p);
+    if(pool == NULL || pool->free_head == NULL) return NULL;
+
+    lv_obj_t * obj = pool->free_head;
+    pool->free_head = obj->parent;
+    pool->cnt--;
+
+    /*The widgets expect zeroed instances, but the style value cache needs only to be emptied*/
+    lv_obj_spec_attr_t * spec_attr = obj->spec_attr;
+#if LV_OBJ_STYLE_VALUE_CACHE_CNT
+    lv_obj_style_value_cache_t * style_value_cache = obj->style_value_cache;
+    uint32_t i;
+    for(i = 0; i < LV_OBJ_STYLE_VALUE_CACHE_CNT; i++) {
+        style_value_cache[i].prop = LV_STYLE_PROP_INV;
+    }
+#endif
+    lv_memzero(obj, instance_size);
+
+    /*Reset the kept `spec_attr` like `lv_obj_allocate_spec_attr()`*/
+    if(spec_attr) {
+        lv_memzero(spec_attr, sizeof(lv_obj_spec_attr_t));
+        spec_attr->scroll_dir = LV_DIR_ALL;
+        spec_attr->scrollbar_mode = LV_SCROLLBAR_MODE_AUTO;
+        obj->spec_attr = spec_attr;
+    }
+
+    return obj;
+}
+
+#endif /*LV_USE_OBJ_POOL*/
@@ -61,6 +61,25 @@ bool lv_obj_is_editable(lv_obj_t * obj);
 
 bool lv_obj_is_group_def(lv_obj_t * obj);
 
+#if LV_USE_OBJ_POOL
+
+/**
+ * Keep up to `cnt` deleted objects of a class and reuse their memory for the next objects of the class.
+ * The reused objects keep their special attributes (`spec_attr`) too.
+ * @param class_p   pointer to a class, e.g. `&lv_button_class`
+ * @param cnt       max number of kept objects, 0: free the kept objects
+ */
+void lv_obj_class_set_pool_size(const lv_obj_class_t * class_p, uint32_t cnt);
+
+/**
+ * Get the number of deleted objects kept for a class
+ * @param class_p   pointer to a class
+ * @return          number of the kept objects
+ */
+uint32_t lv_obj_class_get_pool_cnt(const lv_obj_class_t * class_p);
+
+#endif /*LV_USE_OBJ_POOL*/
+
 /**********************
  *      MACROS
  **********************/
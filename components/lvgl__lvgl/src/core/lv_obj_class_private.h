@@ -61,12 +61,36 @@ struct _lv_obj_class_t {
 };
 
 
+#if LV_USE_OBJ_POOL
+/** The deleted objects of a class kept to be reused*/
+typedef struct {
+    const lv_obj_class_t * class_p;
+    lv_obj_t * free_head;   /**< The kept objects linked by their `parent` field*/
+    uint32_t cnt;
+    uint32_t capacity;
+} lv_obj_class_pool_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 void lv_obj_destruct(lv_obj_t * obj);
 
+/**
+ * Free a destructed object and its `spec_attr` or keep them in the pool of the object's class
+ * @param class_p   the class the object was created with
+ * @param obj       pointer to a destructed object
+ */
+void lv_obj_class_free_obj(const lv_obj_class_t * class_p, lv_obj_t * obj);
+
+#if LV_USE_OBJ_POOL
+/**
+ * Free the pools of all classes
+ */
+void lv_obj_class_pool_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
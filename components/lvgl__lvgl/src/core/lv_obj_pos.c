@@ -22,6 +22,7 @@
  *********************/
 #define MY_CLASS (&lv_obj_class)
 #define update_layout_mutex LV_GLOBAL_DEFAULT()->layout_update_mutex
+#define layout_visit_cnt LV_GLOBAL_DEFAULT()->layout_visit_cnt
 
 /**********************
  *      TYPEDEFS
@@ -33,6 +34,7 @@
 static int32_t calc_content_width(lv_obj_t * obj);
 static int32_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static lv_obj_t * mark_ancestors_layout_inv(lv_obj_t * obj);
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv);
 static bool is_transformed(const lv_obj_t * obj);
 
@@ -199,6 +201,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     lv_obj_invalidate(obj);
 
     obj->readjust_scroll_after_layout = 1;
+    mark_ancestors_layout_inv(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -283,8 +286,9 @@ void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
 
-    /*Mark the screen as dirty too to mark that there is something to do on this screen*/
-    lv_obj_t * scr = lv_obj_get_screen(obj);
+    /*Mark the ancestors so that the layout update can skip the subtrees without anything to do
+     *and the screen to mark that there is something to do on this screen*/
+    lv_obj_t * scr = mark_ancestors_layout_inv(obj);
     scr->scr_layout_inv = 1;
 
     /*Make the display refreshing*/
@@ -1223,11 +1227,22 @@ static int32_t calc_content_height(lv_obj_t * obj)
 
 static void layout_update_core(lv_obj_t * obj)
 {
+    layout_visit_cnt++;
+
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_count(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+
+    /*Go only into the children which are dirty or have dirty descendants.
+     *Clear the flag first as updating the children might set it again.
+     *Check the children of dirty objects too as they might have been moved here with dirty descendants.*/
+    if(obj->layout_child_inv || obj->layout_inv) {
+        obj->layout_child_inv = 0;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            if(child->layout_inv || child->layout_child_inv || child->readjust_scroll_after_layout) {
+                layout_update_core(child);
+            }
+        }
     }
 
     if(obj->layout_inv) {
@@ -1246,6 +1261,16 @@ static void layout_update_core(lv_obj_t * obj)
     }
 }
 
+static lv_obj_t * mark_ancestors_layout_inv(lv_obj_t * obj)
+{
+    while(obj->parent) {
+        obj = obj->parent;
+        obj->layout_child_inv = 1;
+    }
+
+    return obj;
+}
+
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv)
 {
 #if LV_DRAW_TRANSFORM_USE_MATRIX
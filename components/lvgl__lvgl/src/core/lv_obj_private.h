@@ -37,6 +37,9 @@ struct _lv_obj_spec_attr_t {
     lv_event_list_t event_list;
 #if LV_USE_OBJ_NAME
     const char * name;              /**< Pointer to the name */
+#endif
+#if LV_LAYOUT_MEASURE_CACHE
+    lv_layout_cache_t * layout_cache;   /**< The children measured by the layout*/
 #endif
     lv_point_t scroll;              /**< The current X/Y scroll offset*/
 
@@ -60,6 +63,12 @@ struct _lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_VALUE_CACHE_CNT
+    lv_obj_style_value_cache_t * style_value_cache;  /**< `LV_OBJ_STYLE_VALUE_CACHE_CNT` entries, allocated after the object*/
+#endif
+#if LV_LAYOUT_MEASURE_CACHE
+    uint32_t style_version;         /**< Changes when the style values might have changed, unique among the widgets*/
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
@@ -69,6 +78,7 @@ struct _lv_obj_t {
     lv_obj_flag_t flags;
     lv_state_t state;
     uint16_t layout_inv : 1;
+    uint16_t layout_child_inv : 1;    /**< A descendant has `layout_inv` or `readjust_scroll_after_layout` set*/
     uint16_t readjust_scroll_after_layout : 1;
     uint16_t scr_layout_inv : 1;
     uint16_t skip_trans : 1;
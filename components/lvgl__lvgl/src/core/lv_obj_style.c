@@ -21,9 +21,14 @@
 #define MY_CLASS (&lv_obj_class)
 #define style_refr LV_GLOBAL_DEFAULT()->style_refresh
 #define style_trans_ll_p &(LV_GLOBAL_DEFAULT()->style_trans_ll)
+#define style_version_last LV_GLOBAL_DEFAULT()->style_version_last
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
 
+#if LV_OBJ_STYLE_VALUE_CACHE_CNT & (LV_OBJ_STYLE_VALUE_CACHE_CNT - 1)
+    #error "LV_OBJ_STYLE_VALUE_CACHE_CNT must be a power of 2"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -68,6 +73,9 @@ static void fade_in_anim_completed(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act);
+#if LV_OBJ_STYLE_VALUE_CACHE_CNT
+    static lv_obj_style_value_cache_t * get_value_cache_entry(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -260,7 +268,10 @@ void lv_obj_remove_style_all(lv_obj_t * obj)
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+#if LV_OBJ_STYLE_VALUE_CACHE_CNT == 0
+    /*With the value cache the objects using the style drop their cached values even if refreshing is disabled*/
     if(!style_refr) return;
+#endif
     lv_display_t * d = lv_display_get_next(NULL);
 
     while(d) {
@@ -276,6 +287,11 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE);
+
+    /*The cached values might be outdated. Drop them even if refreshing is disabled.*/
+    lv_obj_style_value_cache_invalidate(obj, prop == LV_STYLE_PROP_ANY || is_inheritable);
+
     if(!style_refr) return;
 
     LV_PROFILER_STYLE_BEGIN;
@@ -286,7 +302,6 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 
     bool is_layout_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYOUT_UPDATE);
     bool is_ext_draw = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_EXT_DRAW_UPDATE);
-    bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE);
     bool is_layer_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYER_UPDATE);
 
     if(is_layout_refr) {
@@ -331,14 +346,36 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
 {
     LV_ASSERT_NULL(obj)
 
+#if LV_OBJ_STYLE_VALUE_CACHE_CNT
+    /*Transitions are skipped only temporarily, don't mix those values with the normal ones*/
+    lv_obj_style_value_cache_t * entry = NULL;
+    if(!obj->skip_trans) {
+        entry = get_value_cache_entry(obj, part, prop);
+        if(entry->prop == prop && entry->part == (part >> 16) && entry->state == obj->state) {
+            return entry->value;
+        }
+    }
+#endif
+
+    LV_PROFILER_STYLE_BEGIN;
     lv_style_selector_t selector = part | obj->state;
     lv_style_value_t value_act = { .ptr = NULL };
     lv_style_res_t found;
 
     found = get_selector_style_prop(obj, selector, prop, &value_act);
-    if(found == LV_STYLE_RES_FOUND) return value_act;
+    if(found != LV_STYLE_RES_FOUND) value_act = lv_style_prop_get_default(prop);
+
+#if LV_OBJ_STYLE_VALUE_CACHE_CNT
+    if(entry) {
+        entry->value = value_act;
+        entry->state = obj->state;
+        entry->prop = prop;
+        entry->part = (uint8_t)(part >> 16);
+    }
+#endif
 
-    return lv_style_prop_get_default(prop);
+    LV_PROFILER_STYLE_END;
+    return value_act;
 }
 
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
@@ -657,6 +694,33 @@ lv_color32_t lv_obj_style_apply_recolor(const lv_obj_t * obj, lv_part_t part, lv
     return color;
 }
 
+void lv_obj_style_value_cache_invalidate(lv_obj_t * obj, bool children)
+{
+#if LV_OBJ_STYLE_VALUE_CACHE_CNT || LV_LAYOUT_MEASURE_CACHE
+    uint32_t i;
+#if LV_OBJ_STYLE_VALUE_CACHE_CNT
+    for(i = 0; i < LV_OBJ_STYLE_VALUE_CACHE_CNT; i++) {
+        obj->style_value_cache[i].prop = LV_STYLE_PROP_INV;
+    }
+#endif
+
+#if LV_LAYOUT_MEASURE_CACHE
+    /*The layout of the parent needs to measure it again*/
+    obj->style_version = ++style_version_last;
+#endif
+
+    if(!children) return;
+
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_style_value_cache_invalidate(obj->spec_attr->children[i], true);
+    }
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(children);
+#endif
+}
+
 lv_color32_t lv_obj_get_style_recolor_recursive(const lv_obj_t * obj, lv_part_t part)
 {
     lv_color32_t result;
@@ -883,6 +947,8 @@ static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, t
                 }
             }
 
+            lv_obj_style_value_cache_invalidate(obj, lv_style_prop_has_flag(tr->prop, LV_STYLE_PROP_FLAG_INHERITABLE));
+
             /*Free the transition descriptor too*/
             lv_anim_delete(tr, NULL);
             lv_ll_remove(style_trans_ll_p, tr);
@@ -1010,6 +1076,7 @@ static void trans_anim_completed_cb(lv_anim_t * a)
 
                 lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop((lv_style_t *)obj_style->style, prop);
+                lv_obj_style_value_cache_invalidate(obj, lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE));
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, (lv_style_t *)obj_style->style, obj_style->selector);
@@ -1191,3 +1258,19 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 
     return LV_STYLE_RES_NOT_FOUND;
 }
+
+#if LV_OBJ_STYLE_VALUE_CACHE_CNT
+/**
+ * Get the slot of a property in the resolved value cache of an object.
+ * @param obj       pointer to an object
+ * @param part      the part of the object
+ * @param prop      the property
+ * @return          pointer to the entry which holds or should hold the value
+ */
+static lv_obj_style_value_cache_t * get_value_cache_entry(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    /*Related properties have consecutive IDs and are read together. Shift the other parts to have less collisions.*/
+    uint32_t idx = (prop + (part >> 16) * (LV_OBJ_STYLE_VALUE_CACHE_CNT / 4 + 1)) & (LV_OBJ_STYLE_VALUE_CACHE_CNT - 1);
+    return &obj->style_value_cache[idx];
+}
+#endif
@@ -40,6 +40,14 @@ struct _lv_obj_style_transition_dsc_t {
     void * user_data;
 };
 
+/** An entry of the resolved style property value cache of an object*/
+struct _lv_obj_style_value_cache_t {
+    lv_style_value_t value;     /**< The resolved value, inherited and default values included*/
+    lv_state_t state;           /**< The state of the object when the value was resolved*/
+    lv_style_prop_t prop;       /**< The cached property, `LV_STYLE_PROP_INV` if the entry is empty*/
+    uint8_t part;               /**< The part as `part >> 16`*/
+};
+
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -77,6 +85,15 @@ void lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t p
  */
 lv_style_state_cmp_t lv_obj_style_state_compare(lv_obj_t * obj, lv_state_t state1, lv_state_t state2);
 
+/**
+ * Drop the resolved style property values cached by an object and
+ * give it a new style version to measure it again in the layout.
+ * Needs to be called when the result of a style lookup might change.
+ * @param obj       pointer to an object
+ * @param children  true: drop the values of the children too, because they might inherit the changed values
+ */
+void lv_obj_style_value_cache_invalidate(lv_obj_t * obj, bool children);
+
 /**
  * Update the layer type of a widget bayed on its current styles.
  * The result will be stored in `obj->spec_attr->layer_type`
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj_private.h"
 #include "lv_obj_class_private.h"
+#include "lv_obj_style_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_private.h"
 #include "../display/lv_display.h"
@@ -190,6 +191,7 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     parent->spec_attr->children[lv_obj_get_child_count(parent) - 1] = obj;
 
     obj->parent = parent;
+    lv_obj_style_value_cache_invalidate(obj, true);  /*Inherited values might be different*/
 
     /*Notify the original parent because one of its children is lost*/
     lv_obj_scrollbar_invalidate(old_parent);
@@ -273,6 +275,8 @@ void lv_obj_swap(lv_obj_t * obj1, lv_obj_t * obj2)
 
     parent2->spec_attr->children[index2] = obj1;
     obj1->parent = parent2;
+    lv_obj_style_value_cache_invalidate(obj1, true);  /*Inherited values might be different*/
+    lv_obj_style_value_cache_invalidate(obj2, true);
 
     lv_obj_send_event(parent, LV_EVENT_CHILD_CHANGED, obj2);
     lv_obj_send_event(parent, LV_EVENT_CHILD_CREATED, obj2);
@@ -719,7 +723,9 @@ static void obj_delete_core(lv_obj_t * obj)
         async_cancel_res = lv_async_call_cancel(lv_obj_delete_async_cb, obj);
     }
 
-    /*All children deleted. Now clean up the object specific data*/
+    /*All children deleted. Now clean up the object specific data.
+     *Save the class as the destructors change it to the base classes.*/
+    const lv_obj_class_t * class_p = obj->class_p;
     lv_obj_destruct(obj);
 
     /*Remove the screen for the screen list*/
@@ -751,7 +757,7 @@ static void obj_delete_core(lv_obj_t * obj)
     }
 
     /*Free the object itself*/
-    lv_free(obj);
+    lv_obj_class_free_obj(class_p, obj);
 }
 
 static lv_obj_tree_walk_res_t walk_core(lv_obj_t * obj, lv_obj_tree_walk_cb_t cb, void * user_data)
@@ -43,6 +43,8 @@ typedef unsigned char cmd_state_t;
  *  STATIC PROTOTYPES
  **********************/
 static uint8_t hex_char_to_num(char hex);
+static int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_draw_label_lines_t * lines, uint32_t line_idx,
+                              uint32_t line_start, uint32_t line_end);
 
 /**********************
  *  STATIC VARIABLES
@@ -200,9 +202,7 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
                                       const lv_area_t * coords,
                                       lv_draw_glyph_cb_t cb)
 {
-    lv_draw_dsc_base_t * base_dsc = t->draw_dsc;
     const lv_font_t * font = dsc->font;
-    int32_t w;
 
     lv_area_t clipped_area;
     bool clip_ok = lv_area_intersect(&clipped_area, coords, &t->clip_area);
@@ -213,22 +213,7 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
 
     lv_bidi_calculate_align(&align, &base_dir, dsc->text);
 
-    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
-        /*Normally use the label's width as width*/
-        w = lv_area_get_width(coords);
-    }
-    else {
-        /*If EXPAND is enabled then not limit the text's width to the object's width*/
-        if(base_dsc->obj && !lv_obj_has_flag(base_dsc->obj, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS)) {
-            w = dsc->text_size.x;
-        }
-        else {
-            lv_point_t p;
-            lv_text_get_size(&p, dsc->text, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX,
-                             dsc->flag);
-            w = p.x;
-        }
-    }
+    int32_t w = lv_draw_label_get_lines_width(dsc, coords);
 
     int32_t line_height_font = lv_font_get_line_height(font);
     int32_t line_height = line_height_font + dsc->line_space;
@@ -247,8 +232,13 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
     uint32_t line_start     = 0;
     int32_t last_line_start = -1;
 
+    /*Use the pre-calculated lines if they belong to this text*/
+    const lv_draw_label_lines_t * lines = dsc->lines;
+    if(lines && (line_height <= 0 || !lv_draw_label_lines_is_valid(lines, dsc, w))) lines = NULL;
+    uint32_t line_idx = 0;
+
     /*Check the hint to use the cached info*/
-    if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
+    if(lines == NULL && dsc->hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             dsc->hint->line_start = -1;
@@ -263,12 +253,27 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
     }
 
     uint32_t remaining_len = dsc->text_length;
-
-    uint32_t line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space,
-                                                           w, NULL, dsc->flag);
+    uint32_t line_end;
+
+    if(lines) {
+        /*Jump to the first visible line*/
+        if(pos.y + line_height_font < t->clip_area.y1) {
+            int32_t skip = (t->clip_area.y1 - line_height_font - pos.y + line_height - 1) / line_height;
+            if((uint32_t)skip >= lines->cnt) return;
+            line_idx = skip;
+            pos.y += skip * line_height;
+        }
+        if(line_idx >= lines->cnt) return;
+        line_start = lines->starts[line_idx];
+        line_end = lines->starts[line_idx + 1];
+    }
+    else {
+        line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space,
+                                                      w, NULL, dsc->flag);
+    }
 
     /*Go the first visible line*/
-    while(pos.y + line_height_font < t->clip_area.y1) {
+    while(lines == NULL && pos.y + line_height_font < t->clip_area.y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space, w, NULL, dsc->flag);
@@ -286,16 +291,14 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space,
-                                                  dsc->flag);
+        line_width = get_line_width(dsc, lines, line_idx, line_start, line_end);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space,
-                                                  dsc->flag);
+        line_width = get_line_width(dsc, lines, line_idx, line_start, line_end);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -514,22 +517,25 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
         /*Go to next line*/
         remaining_len -= line_end - line_start;
         line_start = line_end;
-        if(remaining_len) {
+        if(lines) {
+            line_idx++;
+            if(line_idx >= lines->cnt) break;
+            line_end = lines->starts[line_idx + 1];
+        }
+        else if(remaining_len) {
             line_end += lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space, w, NULL, dsc->flag);
         }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(dsc, lines, line_idx, line_start, line_end);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(dsc, lines, line_idx, line_start, line_end);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -544,10 +550,143 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+void lv_draw_label_lines_update(lv_draw_label_lines_t * lines, const lv_draw_label_dsc_t * dsc, int32_t max_width)
+{
+    LV_ASSERT_NULL(lines);
+    LV_ASSERT_NULL(dsc);
+
+    lines->text = NULL;
+    lines->cnt = 0;
+    if(dsc->text == NULL || dsc->font == NULL) return;
+
+    const char * text = dsc->text;
+    uint32_t remaining_len = dsc->text_length;
+    uint32_t line_start = 0;
+    uint32_t cnt = 0;
+    while(remaining_len && text[line_start] != '\0') {
+        uint32_t len = lv_text_get_next_line(&text[line_start], remaining_len, dsc->font, dsc->letter_space, max_width,
+                                             NULL, dsc->flag);
+        if(len == 0) break;
+
+        if(cnt >= lines->cap) {
+            if(!lv_draw_label_lines_reserve(lines, lines->cap ? lines->cap * 2 : 8)) return;
+        }
+
+        lines->starts[cnt] = line_start;
+        lines->widths[cnt] = lv_text_get_width_with_flags(&text[line_start], len, dsc->font, dsc->letter_space, dsc->flag);
+        cnt++;
+
+        line_start += len;
+        remaining_len -= len;
+    }
+
+    /*Store the parameters only if all the lines are calculated*/
+    if(lines->starts) lines->starts[cnt] = line_start;
+    lines->cnt = cnt;
+    lines->text = text;
+    lines->font = dsc->font;
+    lines->letter_space = dsc->letter_space;
+    lines->max_width = max_width;
+    lines->text_length = dsc->text_length;
+    lines->flag = dsc->flag;
+}
+
+int32_t lv_draw_label_get_lines_width(const lv_draw_label_dsc_t * dsc, const lv_area_t * coords)
+{
+    LV_ASSERT_NULL(dsc);
+    LV_ASSERT_NULL(coords);
+
+    int32_t w;
+    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
+        /*Normally use the label's width as width*/
+        w = lv_area_get_width(coords);
+    }
+    else {
+        /*If EXPAND is enabled then not limit the text's width to the object's width*/
+        if(dsc->base.obj && !lv_obj_has_flag(dsc->base.obj, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS)) {
+            w = dsc->text_size.x;
+        }
+        else {
+            lv_point_t p;
+            lv_text_get_size(&p, dsc->text, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX,
+                             dsc->flag);
+            w = p.x;
+        }
+    }
+
+    return w;
+}
+
+bool lv_draw_label_lines_is_valid(const lv_draw_label_lines_t * lines, const lv_draw_label_dsc_t * dsc,
+                                  int32_t max_width)
+{
+    return lines->text != NULL &&
+           lines->text == dsc->text &&
+           lines->font == dsc->font &&
+           lines->letter_space == dsc->letter_space &&
+           lines->max_width == max_width &&
+           lines->text_length == dsc->text_length &&
+           lines->flag == dsc->flag;
+}
+
+bool lv_draw_label_lines_reserve(lv_draw_label_lines_t * lines, uint32_t cnt)
+{
+    LV_ASSERT_NULL(lines);
+
+    if(cnt <= lines->cap) return true;
+
+    /*`starts` and `widths` share one buffer. +1 start for the end of the last line*/
+    uint32_t * new_starts = lv_malloc((cnt + 1) * sizeof(uint32_t) + cnt * sizeof(int32_t));
+    LV_ASSERT_MALLOC(new_starts);
+    if(new_starts == NULL) return false;
+
+    int32_t * new_widths = (int32_t *)(new_starts + cnt + 1);
+    if(lines->starts) {
+        lv_memcpy(new_starts, lines->starts, (lines->cap + 1) * sizeof(uint32_t));
+        lv_memcpy(new_widths, lines->widths, lines->cap * sizeof(int32_t));
+        lv_free(lines->starts);
+    }
+
+    lines->starts = new_starts;
+    lines->widths = new_widths;
+    lines->cap = cnt;
+    return true;
+}
+
+void lv_draw_label_lines_invalidate(lv_draw_label_lines_t * lines)
+{
+    lines->text = NULL;
+    lines->cnt = 0;
+}
+
+void lv_draw_label_lines_free(lv_draw_label_lines_t * lines)
+{
+    lv_free(lines->starts);
+    lv_memzero(lines, sizeof(lv_draw_label_lines_t));
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the width of a line from the pre-calculated lines or measure it
+ * @param dsc           pointer to the label draw descriptor
+ * @param lines         the valid pre-calculated lines or `NULL`
+ * @param line_idx      index of the line in `lines`
+ * @param line_start    byte index of the start of the line in `dsc->text`
+ * @param line_end      byte index of the end of the line in `dsc->text`
+ * @return              the width of the line
+ */
+static int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_draw_label_lines_t * lines, uint32_t line_idx,
+                              uint32_t line_start, uint32_t line_end)
+{
+    if(lines) return lines->widths[line_idx];
+
+    return lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, dsc->font, dsc->letter_space,
+                                        dsc->flag);
+}
+
 /**
  * Convert a hexadecimal characters to a number (0..15)
  * @param hex Pointer to a hexadecimal character (0..9, A..F)
@@ -104,6 +104,9 @@ typedef struct {
     /**Pointer to an externally stored struct where some data can be cached to speed up rendering*/
     lv_draw_label_hint_t * hint;
 
+    /**Pointer to the pre-calculated lines of the text. Used only if it matches the text, font and width to draw.*/
+    const lv_draw_label_lines_t * lines;
+
     /* Properties of the letter outlines */
     lv_opa_t outline_stroke_opa;
     lv_color_t outline_stroke_color;
@@ -41,6 +41,33 @@ struct _lv_draw_label_hint_t {
     int32_t coord_y;
 };
 
+/** The start and width of the wrapped lines of a text.
+ * With it the first visible line can be found without processing the previous lines
+ * and the lines don't need to be wrapped and measured on every draw.*/
+struct _lv_draw_label_lines_t {
+    /** The text the lines were calculated for. `NULL` if the lines are invalid.*/
+    const char * text;
+
+    /** The parameters used to wrap the text*/
+    const lv_font_t * font;
+    int32_t letter_space;
+    int32_t max_width;
+    uint32_t text_length;
+    lv_text_flag_t flag;
+
+    /** Number of lines*/
+    uint32_t cnt;
+
+    /** Number of lines `starts` and `widths` can store*/
+    uint32_t cap;
+
+    /** Byte index of the start of the lines. `starts[cnt]` is the end of the last line.*/
+    uint32_t * starts;
+
+    /** Width of the lines in pixels. It's in the same buffer as `starts`.*/
+    int32_t * widths;
+};
+
 struct _lv_draw_glyph_dsc_t {
     /** Depends on `format` field, it could be image source or draw buf of bitmap or vector data. */
     const void * glyph_data;
@@ -63,6 +90,52 @@ struct _lv_draw_glyph_dsc_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Wrap the text of a label draw descriptor and store the start and width of its lines
+ * @param lines         pointer to an initialized (e.g. zeroed) lines descriptor
+ * @param dsc           the text, font, letter space, flags and text length are used from here
+ * @param max_width     the width to wrap the text to, the same as the width of the area where the text will be drawn
+ */
+void lv_draw_label_lines_update(lv_draw_label_lines_t * lines, const lv_draw_label_dsc_t * dsc, int32_t max_width);
+
+/**
+ * Get the width to which the text of a label draw descriptor is wrapped when it's drawn to an area
+ * @param dsc           pointer to a label draw descriptor
+ * @param coords        the area where the text will be drawn
+ * @return              the width to use as `max_width` for the lines
+ */
+int32_t lv_draw_label_get_lines_width(const lv_draw_label_dsc_t * dsc, const lv_area_t * coords);
+
+/**
+ * Check if the lines were calculated with the same parameters as the ones of a label draw descriptor
+ * @param lines         pointer to a lines descriptor
+ * @param dsc           pointer to a label draw descriptor
+ * @param max_width     the width to wrap the text to
+ * @return              true: the lines can be used to draw `dsc`
+ */
+bool lv_draw_label_lines_is_valid(const lv_draw_label_lines_t * lines, const lv_draw_label_dsc_t * dsc,
+                                  int32_t max_width);
+
+/**
+ * Allocate space for a given number of lines in advance
+ * @param lines         pointer to a lines descriptor
+ * @param cnt           number of lines to store
+ * @return              true: there is space for `cnt` lines; false: out of memory
+ */
+bool lv_draw_label_lines_reserve(lv_draw_label_lines_t * lines, uint32_t cnt);
+
+/**
+ * Mark the lines as invalid, e.g. because the text has changed
+ * @param lines         pointer to a lines descriptor
+ */
+void lv_draw_label_lines_invalidate(lv_draw_label_lines_t * lines);
+
+/**
+ * Free the buffers of the lines
+ * @param lines         pointer to a lines descriptor
+ */
+void lv_draw_label_lines_free(lv_draw_label_lines_t * lines);
+
 /**********************
  *      MACROS
  **********************/
@@ -11,7 +11,12 @@
 #include "../draw/lv_draw_image.h"
 #include "../misc/lv_ll.h"
 #include "../stdlib/lv_string.h"
+#include "../tick/lv_tick.h"
 #include "../core/lv_global.h"
+#include "../display/lv_display.h"
+#if LV_USE_IMAGE_DECODER_ASYNC
+    #include "../misc/lv_timer.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -20,10 +25,34 @@
 #define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
 #define img_header_cache_p (LV_GLOBAL_DEFAULT()->img_header_cache)
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
+#define async_p (&LV_GLOBAL_DEFAULT()->image_decoder_async)
+#define convert_native (LV_GLOBAL_DEFAULT()->img_convert_native)
+#define convert_native_variables (LV_GLOBAL_DEFAULT()->img_convert_native_variables)
+
+#if LV_USE_IMAGE_DECODER_ASYNC && LV_USE_OS == LV_OS_NONE
+    #error "LV_USE_IMAGE_DECODER_ASYNC requires LV_USE_OS"
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_IMAGE_DECODER_ASYNC
+typedef enum {
+    ASYNC_REQ_QUEUED,
+    ASYNC_REQ_DECODING,
+    ASYNC_REQ_DONE,
+} async_req_state_t;
+
+typedef struct {
+    const void * src;           /**< File paths are copied*/
+    lv_image_src_t src_type;
+    lv_image_decoder_async_cb_t done_cb;
+    void * user_data;
+    lv_result_t res;
+    async_req_state_t state;
+    bool canceled;              /**< Canceled while decoding. Freed when finished without calling `done_cb`*/
+} async_req_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -40,6 +69,20 @@ static uint32_t img_width_to_stride(lv_image_header_t * header);
 static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc, lv_image_header_t * header);
 
 static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc);
+static void use_cache_entry(lv_image_decoder_dsc_t * dsc, lv_cache_entry_t * entry);
+static lv_result_t decoder_open(lv_image_decoder_dsc_t * dsc, const lv_image_decoder_args_t * args);
+
+#if LV_IMAGE_DECODER_CONVERT_NATIVE
+    static lv_draw_buf_t * convert_to_native(lv_draw_buf_t * decoded);
+#endif
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+    static lv_result_t async_init(void);
+    static void async_deinit(void);
+    static void async_req_free(async_req_t * req);
+    static void async_thread_cb(void * user_data);
+    static void async_timer_cb(lv_timer_t * timer);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -63,6 +106,10 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
     /*Initialize the cache*/
     lv_image_cache_init(image_cache_size);
     lv_image_header_cache_init(image_header_count);
+
+#if LV_IMAGE_DECODER_CONVERT_NATIVE
+    convert_native = true;
+#endif
 }
 
 /**
@@ -70,6 +117,10 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void)
 {
+#if LV_USE_IMAGE_DECODER_ASYNC
+    async_deinit();
+#endif
+
     lv_cache_destroy(img_cache_p, NULL);
     lv_cache_destroy(img_header_cache_p, NULL);
 
@@ -108,44 +159,70 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
         }
     }
 
-    /*Find the decoder that can open the image source, and get the header info in the same time.*/
-    dsc->decoder = image_decoder_get_info(dsc, &dsc->header);
-    if(dsc->decoder == NULL) return LV_RESULT_INVALID;
+    return decoder_open(dsc, args);
+}
 
-    /*Make a copy of args*/
-    dsc->args = args ? *args : (lv_image_decoder_args_t) {
-        .stride_align = LV_DRAW_BUF_STRIDE_ALIGN != 1,
-        .premultiply = false,
-        .no_cache = false,
-        .use_indexed = false,
-        .flush_cache = false,
-    };
+#if LV_USE_IMAGE_DECODER_ASYNC
+lv_result_t lv_image_decoder_decode_async(const void * src, lv_image_decoder_async_cb_t done_cb, void * user_data)
+{
+    if(src == NULL || !lv_image_cache_is_enabled()) return LV_RESULT_INVALID;
 
-    /*
-     * We assume that if a decoder can get the info, it can open the image.
-     * If decoder open failed, free the source and return error.
-     * If decoder open succeed, add the image to cache if enabled.
-     * */
-    lv_result_t res = dsc->decoder->open_cb(dsc->decoder, dsc);
+    lv_image_src_t src_type = lv_image_src_get_type(src);
+    if(src_type != LV_IMAGE_SRC_FILE && src_type != LV_IMAGE_SRC_VARIABLE) return LV_RESULT_INVALID;
 
-    if(res == LV_RESULT_OK && dsc->decoded != NULL) {
-        LV_ASSERT_MSG(dsc->decoded->unaligned_data && dsc->decoded->handlers, "Invalid draw buffer");
+    if(!async_p->inited && async_init() != LV_RESULT_OK) return LV_RESULT_INVALID;
 
-        /* Flush the D-Cache if enabled and the image was successfully opened */
-        if(dsc->args.flush_cache) {
-            lv_draw_buf_flush_cache(dsc->decoded, NULL);
-            LV_LOG_INFO("Flushed D-cache: src %p (%s) (W%d x H%d, data: %p cf: %d)",
-                        src,
-                        dsc->src_type == LV_IMAGE_SRC_FILE ? (const char *)src : "c-array",
-                        dsc->decoded->header.w,
-                        dsc->decoded->header.h,
-                        (void *)dsc->decoded->data,
-                        dsc->decoded->header.cf);
-        }
+    const void * src_copy = src_type == LV_IMAGE_SRC_FILE ? lv_strdup(src) : src;
+    if(src_copy == NULL) return LV_RESULT_INVALID;
+
+    lv_mutex_lock(&async_p->lock);
+    async_req_t * req = lv_ll_ins_tail(&async_p->req_ll);
+    if(req) {
+        lv_memzero(req, sizeof(async_req_t));
+        req->src = src_copy;
+        req->src_type = src_type;
+        req->done_cb = done_cb;
+        req->user_data = user_data;
+        req->state = ASYNC_REQ_QUEUED;
     }
+    lv_mutex_unlock(&async_p->lock);
 
-    return res;
+    if(req == NULL) {
+        LV_LOG_WARN("Couldn't allocate the request");
+        if(src_type == LV_IMAGE_SRC_FILE) lv_free((void *)src_copy);
+        return LV_RESULT_INVALID;
+    }
+
+    lv_timer_resume(async_p->timer);
+    lv_thread_sync_signal(&async_p->sync);
+
+    return LV_RESULT_OK;
+}
+
+void lv_image_decoder_cancel_async(void * user_data)
+{
+    if(!async_p->inited) return;
+
+    lv_mutex_lock(&async_p->lock);
+    async_req_t * req = lv_ll_get_head(&async_p->req_ll);
+    while(req) {
+        async_req_t * req_next = lv_ll_get_next(&async_p->req_ll, req);
+        if(req->user_data == user_data) {
+            /*The thread is using the request, it will be freed when it's finished*/
+            if(req->state == ASYNC_REQ_DECODING) {
+                req->canceled = true;
+            }
+            else {
+                lv_ll_remove(&async_p->req_ll, req);
+                async_req_free(req);
+                lv_free(req);
+            }
+        }
+        req = req_next;
+    }
+    lv_mutex_unlock(&async_p->lock);
 }
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
 
 lv_result_t lv_image_decoder_get_area(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
                                       lv_area_t * decoded_area)
@@ -237,6 +314,7 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
     }
     cached_data->user_data = user_data; /*Need to free data on cache invalidate instead of decoder_close*/
     cached_data->decoder = decoder;
+    cached_data->slot.cost = 0;         /*Set when the decoder returns*/
 
     return cache_entry;
 }
@@ -246,6 +324,22 @@ lv_draw_buf_t * lv_image_decoder_post_process(lv_image_decoder_dsc_t * dsc, lv_d
     if(decoded == NULL) return NULL; /*No need to adjust*/
 
     lv_image_decoder_args_t * args = &dsc->args;
+
+#if LV_IMAGE_DECODER_CONVERT_NATIVE
+    /*Convert only the images which will be cached, else the conversion would be repeated on each draw.
+     *The variables used directly would be copied to the RAM and their changes wouldn't be visible
+     *until dropped from the cache, so convert them only if enabled. Modifiable variables (e.g. the
+     *draw buffer of a canvas) are changed without dropping the cache, so never convert them.*/
+    const lv_image_dsc_t * src_var = dsc->src_type == LV_IMAGE_SRC_VARIABLE ? dsc->src : NULL;
+    bool src_used_directly = src_var && src_var->data == decoded->data;
+    bool src_modifiable = src_var && (src_var->header.flags & LV_IMAGE_FLAGS_MODIFIABLE);
+    bool convert_src = !src_used_directly || (convert_native_variables && !src_modifiable);
+    if(convert_native && convert_src && !args->premultiply && !args->no_cache && lv_image_cache_is_enabled()) {
+        lv_draw_buf_t * converted = convert_to_native(decoded);
+        if(converted != decoded) return converted; /*It has the expected stride already*/
+    }
+#endif
+
     if(args->stride_align && decoded->header.cf != LV_COLOR_FORMAT_RGB565A8) {
         uint32_t stride_expect = lv_draw_buf_width_to_stride(decoded->header.w, decoded->header.cf);
         if(decoded->header.stride != stride_expect) {
@@ -290,6 +384,24 @@ lv_draw_buf_t * lv_image_decoder_post_process(lv_image_decoder_dsc_t * dsc, lv_d
     return decoded;
 }
 
+#if LV_IMAGE_DECODER_CONVERT_NATIVE
+void lv_image_decoder_set_convert_native(bool en)
+{
+    if(convert_native == en) return;
+
+    convert_native = en;
+    lv_image_cache_drop(NULL); /*Decode the cached images again in the new format*/
+}
+
+void lv_image_decoder_set_convert_native_variables(bool en)
+{
+    if(convert_native_variables == en) return;
+
+    convert_native_variables = en;
+    lv_image_cache_drop(NULL); /*Decode the cached images again in the new format*/
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -312,12 +424,14 @@ static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc,
     lv_image_decoder_t * decoder;
     bool is_header_cache_enabled = lv_image_header_cache_is_enabled();
 
+    /*Only one thread reads the header of a file, the others wait for it in the header cache*/
+    lv_image_header_cache_data_t claim_key;
+    bool claimed = false;
     if(is_header_cache_enabled && src_type == LV_IMAGE_SRC_FILE) {
-        lv_image_header_cache_data_t search_key;
-        search_key.src_type = src_type;
-        search_key.src = src;
+        claim_key.src_type = src_type;
+        claim_key.src = src;
 
-        lv_cache_entry_t * entry = lv_cache_acquire(img_header_cache_p, &search_key, NULL);
+        lv_cache_entry_t * entry = lv_cache_acquire_or_claim(img_header_cache_p, &claim_key, &claimed, NULL);
 
         if(entry) {
             lv_image_header_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
@@ -334,6 +448,7 @@ static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc,
         lv_fs_res_t fs_res = lv_fs_open(&dsc->file, src, LV_FS_MODE_RD);
         if(fs_res != LV_FS_RES_OK) {
             LV_LOG_ERROR("File open failed: %" LV_PRIu32, (uint32_t)fs_res);
+            if(claimed) lv_cache_unclaim(img_header_cache_p, &claim_key);
             return NULL;
         }
     }
@@ -376,12 +491,15 @@ static lv_image_decoder_t * image_decoder_get_info(lv_image_decoder_dsc_t * dsc,
 
         if(entry == NULL) {
             if(src_type == LV_IMAGE_SRC_FILE) lv_free((void *)search_key.src);
-            return NULL;
+            decoder = NULL;
+        }
+        else {
+            lv_cache_release(img_header_cache_p, entry, NULL);
         }
-
-        lv_cache_release(img_header_cache_p, entry, NULL);
     }
 
+    if(claimed) lv_cache_unclaim(img_header_cache_p, &claim_key);
+
     return decoder;
 }
 
@@ -395,6 +513,88 @@ static uint32_t img_width_to_stride(lv_image_header_t * header)
     }
 }
 
+/**
+ * Find a decoder for the image and open it
+ * @param dsc   the decoder descriptor with the source set
+ * @param args  the arguments of `lv_image_decoder_open()`
+ * @return      LV_RESULT_OK: the image was opened
+ */
+static lv_result_t decoder_open(lv_image_decoder_dsc_t * dsc, const lv_image_decoder_args_t * args)
+{
+    const void * src = dsc->src;
+
+    /*Find the decoder that can open the image source, and get the header info in the same time.*/
+    dsc->decoder = image_decoder_get_info(dsc, &dsc->header);
+    if(dsc->decoder == NULL) return LV_RESULT_INVALID;
+
+    /*Make a copy of args*/
+    dsc->args = args ? *args : (lv_image_decoder_args_t) {
+        .stride_align = LV_DRAW_BUF_STRIDE_ALIGN != 1,
+        .premultiply = false,
+        .no_cache = false,
+        .use_indexed = false,
+        .flush_cache = false,
+    };
+
+    /*Large images might be used only once, don't evict the others for them*/
+    if(dsc->cache && !dsc->args.no_cache) {
+        uint32_t size = lv_draw_buf_width_to_stride(dsc->header.w, dsc->header.cf) * dsc->header.h;
+        if(!lv_image_cache_admit(src, size)) dsc->args.no_cache = true;
+    }
+
+    /*Decode a cached image only in one thread. The others opening the same image
+     *wait for it and use the cached result instead of decoding and adding it again.*/
+    lv_image_cache_data_t search_key;
+    bool claimed = false;
+    if(dsc->cache && !dsc->args.no_cache) {
+        search_key.src_type = dsc->src_type;
+        search_key.src = src;
+        lv_cache_entry_t * entry = lv_cache_acquire_or_claim(dsc->cache, &search_key, &claimed, NULL);
+        if(entry) {
+            use_cache_entry(dsc, entry);
+            return LV_RESULT_OK;
+        }
+    }
+
+    /*
+     * We assume that if a decoder can get the info, it can open the image.
+     * If decoder open failed, free the source and return error.
+     * If decoder open succeed, add the image to cache if enabled.
+     * */
+    uint32_t t_start = lv_tick_get();
+    lv_mem_tag_t mem_tag_prev;
+    LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_IMAGE, mem_tag_prev);
+    lv_result_t res = dsc->decoder->open_cb(dsc->decoder, dsc);
+    LV_MEM_STATS_TAG_END(mem_tag_prev);
+
+    if(claimed) lv_cache_unclaim(dsc->cache, &search_key);
+
+    /*Cost-aware caches keep the images longer which are slow to decode*/
+    if(res == LV_RESULT_OK && dsc->cache_entry) {
+        if(dsc->time_to_open == 0) dsc->time_to_open = lv_tick_elaps(t_start);
+        lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(dsc->cache_entry);
+        cached_data->slot.cost = dsc->time_to_open;
+    }
+
+    if(res == LV_RESULT_OK && dsc->decoded != NULL) {
+        LV_ASSERT_MSG(dsc->decoded->unaligned_data && dsc->decoded->handlers, "Invalid draw buffer");
+
+        /* Flush the D-Cache if enabled and the image was successfully opened */
+        if(dsc->args.flush_cache) {
+            lv_draw_buf_flush_cache(dsc->decoded, NULL);
+            LV_LOG_INFO("Flushed D-cache: src %p (%s) (W%d x H%d, data: %p cf: %d)",
+                        src,
+                        dsc->src_type == LV_IMAGE_SRC_FILE ? (const char *)src : "c-array",
+                        dsc->decoded->header.w,
+                        dsc->decoded->header.h,
+                        (void *)dsc->decoded->data,
+                        dsc->decoded->header.cf);
+        }
+    }
+
+    return res;
+}
+
 static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc)
 {
     lv_cache_t * cache = dsc->cache;
@@ -406,12 +606,212 @@ static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc)
     lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
 
     if(entry) {
-        lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
-        dsc->decoded = cached_data->decoded;
-        dsc->decoder = (lv_image_decoder_t *)cached_data->decoder;
-        dsc->cache_entry = entry;     /*Save the cache to release it in decoder_close*/
+        use_cache_entry(dsc, entry);
         return LV_RESULT_OK;
     }
 
     return LV_RESULT_INVALID;
 }
+
+static void use_cache_entry(lv_image_decoder_dsc_t * dsc, lv_cache_entry_t * entry)
+{
+    lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+    dsc->decoded = cached_data->decoded;
+    dsc->decoder = (lv_image_decoder_t *)cached_data->decoder;
+    dsc->cache_entry = entry;     /*Save the cache to release it in decoder_close*/
+}
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+static lv_result_t async_init(void)
+{
+    lv_ll_init(&async_p->req_ll, sizeof(async_req_t));
+    async_p->exit = false;
+
+    async_p->timer = lv_timer_create(async_timer_cb, LV_DEF_REFR_PERIOD, NULL);
+    LV_ASSERT_MALLOC(async_p->timer);
+    if(async_p->timer == NULL) return LV_RESULT_INVALID;
+    lv_timer_pause(async_p->timer);
+
+    lv_mutex_init(&async_p->lock);
+    lv_thread_sync_init(&async_p->sync);
+    if(lv_thread_init(&async_p->thread, "imgdec", LV_THREAD_PRIO_LOW, async_thread_cb,
+                      LV_DRAW_THREAD_STACK_SIZE, NULL) != LV_RESULT_OK) {
+        LV_LOG_WARN("Couldn't create the image decoder thread");
+        lv_thread_sync_delete(&async_p->sync);
+        lv_mutex_delete(&async_p->lock);
+        lv_timer_delete(async_p->timer);
+        async_p->timer = NULL;
+        return LV_RESULT_INVALID;
+    }
+
+    async_p->inited = true;
+    return LV_RESULT_OK;
+}
+
+static void async_deinit(void)
+{
+    if(!async_p->inited) return;
+
+    /*The thread finishes the image being decoded and exits*/
+    lv_mutex_lock(&async_p->lock);
+    async_p->exit = true;
+    lv_mutex_unlock(&async_p->lock);
+    lv_thread_sync_signal(&async_p->sync);
+    lv_thread_delete(&async_p->thread);
+
+    async_req_t * req;
+    LV_LL_READ(&async_p->req_ll, req) {
+        async_req_free(req);
+    }
+    lv_ll_clear(&async_p->req_ll);
+
+    lv_thread_sync_delete(&async_p->sync);
+    lv_mutex_delete(&async_p->lock);
+    lv_timer_delete(async_p->timer);
+    async_p->timer = NULL;
+    async_p->inited = false;
+}
+
+static void async_req_free(async_req_t * req)
+{
+    if(req->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)req->src);
+}
+
+static void async_thread_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    while(1) {
+        lv_mutex_lock(&async_p->lock);
+        if(async_p->exit) {
+            lv_mutex_unlock(&async_p->lock);
+            break;
+        }
+
+        async_req_t * req;
+        LV_LL_READ(&async_p->req_ll, req) {
+            if(req->state == ASYNC_REQ_QUEUED) break;
+        }
+        if(req) req->state = ASYNC_REQ_DECODING;
+        lv_mutex_unlock(&async_p->lock);
+
+        if(req == NULL) {
+            lv_thread_sync_wait(&async_p->sync);
+            continue;
+        }
+
+        /*Decode the same way as the draw units, the cache stores the decoded image*/
+        lv_image_decoder_dsc_t dsc;
+        lv_result_t res = lv_image_decoder_open(&dsc, req->src, NULL);
+        if(res == LV_RESULT_OK) {
+            if(dsc.cache_entry == NULL) res = LV_RESULT_INVALID;
+            lv_image_decoder_close(&dsc);
+        }
+
+        lv_mutex_lock(&async_p->lock);
+        req->res = res;
+        req->state = ASYNC_REQ_DONE;
+        lv_mutex_unlock(&async_p->lock);
+    }
+}
+
+static void async_timer_cb(lv_timer_t * timer)
+{
+    /*Call the callbacks without the lock as they might request or cancel images*/
+    while(1) {
+        lv_mutex_lock(&async_p->lock);
+        async_req_t * req;
+        LV_LL_READ(&async_p->req_ll, req) {
+            if(req->state == ASYNC_REQ_DONE) break;
+        }
+        if(req == NULL) {
+            if(lv_ll_is_empty(&async_p->req_ll)) lv_timer_pause(timer);
+            lv_mutex_unlock(&async_p->lock);
+            break;
+        }
+
+        async_req_t done = *req;
+        lv_ll_remove(&async_p->req_ll, req);
+        lv_free(req);
+        lv_mutex_unlock(&async_p->lock);
+
+        if(!done.canceled && done.done_cb) done.done_cb(done.res, done.user_data);
+        async_req_free(&done);
+    }
+}
+#endif /*LV_USE_IMAGE_DECODER_ASYNC*/
+
+#if LV_IMAGE_DECODER_CONVERT_NATIVE
+/**
+ * Convert an RGB888, XRGB8888 or ARGB8888 image to the 16 bit color format of the default display,
+ * so that it can be blended without per pixel color conversion.
+ * @param decoded   the decoded image
+ * @return          a new draw buffer with RGB565/RGB565_SWAPPED (opaque image) or RGB565A8 (image with alpha)
+ *                  color format, or `decoded` if it's not converted
+ */
+static lv_draw_buf_t * convert_to_native(lv_draw_buf_t * decoded)
+{
+    lv_display_t * disp = lv_display_get_default();
+    if(disp == NULL) return decoded;
+
+    lv_color_format_t disp_cf = lv_display_get_color_format(disp);
+    if(disp_cf != LV_COLOR_FORMAT_RGB565 && disp_cf != LV_COLOR_FORMAT_RGB565_SWAPPED) return decoded;
+
+    lv_color_format_t cf = decoded->header.cf;
+    if(cf != LV_COLOR_FORMAT_RGB888 && cf != LV_COLOR_FORMAT_XRGB8888 && cf != LV_COLOR_FORMAT_ARGB8888) return decoded;
+    if(lv_draw_buf_has_flag(decoded, LV_IMAGE_FLAGS_PREMULTIPLIED)) return decoded;
+
+    uint32_t w = decoded->header.w;
+    uint32_t h = decoded->header.h;
+    uint32_t src_stride = decoded->header.stride;
+    uint32_t px_size = lv_color_format_get_size(cf);
+    uint32_t x;
+    uint32_t y;
+
+    /*Keep the alpha channel only if there are transparent pixels*/
+    bool opaque = true;
+    if(cf == LV_COLOR_FORMAT_ARGB8888) {
+        for(y = 0; y < h && opaque; y++) {
+            const uint8_t * src = decoded->data + y * src_stride + 3;
+            for(x = 0; x < w; x++) {
+                if(src[x * 4] != LV_OPA_COVER) {
+                    opaque = false;
+                    break;
+                }
+            }
+        }
+    }
+
+#if LV_DRAW_SW_SUPPORT_RGB565A8
+    lv_color_format_t cf_new = opaque ? disp_cf : LV_COLOR_FORMAT_RGB565A8;
+#else
+    if(!opaque) return decoded;
+    lv_color_format_t cf_new = disp_cf;
+#endif
+
+    lv_draw_buf_t * converted = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, w, h, cf_new, LV_STRIDE_AUTO);
+    if(converted == NULL) {
+        LV_LOG_WARN("No memory to convert the image to the display's color format");
+        return decoded;
+    }
+
+    LV_PROFILER_DECODER_BEGIN;
+    uint32_t dest_stride = converted->header.stride;
+    uint8_t * alpha = converted->data + dest_stride * h;  /*The A8 plane of RGB565A8 has half stride*/
+    bool swap = cf_new == LV_COLOR_FORMAT_RGB565_SWAPPED;
+    for(y = 0; y < h; y++) {
+        const uint8_t * src = decoded->data + y * src_stride;
+        uint16_t * dest = (uint16_t *)(converted->data + y * dest_stride);
+        for(x = 0; x < w; x++) {
+            uint16_t c = lv_color_to_u16(lv_color_make(src[2], src[1], src[0]));
+            dest[x] = swap ? lv_color_swap_16(c) : c;
+            if(!opaque) alpha[x] = src[3];
+            src += px_size;
+        }
+        alpha += dest_stride / 2;
+    }
+    LV_PROFILER_DECODER_END;
+
+    return converted;
+}
+#endif /*LV_IMAGE_DECODER_CONVERT_NATIVE*/
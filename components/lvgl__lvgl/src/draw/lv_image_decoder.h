@@ -85,6 +85,16 @@ typedef void (*lv_image_decoder_close_f_t)(lv_image_decoder_t * decoder, lv_imag
  */
 typedef void (*lv_image_decoder_custom_draw_t)(lv_layer_t * layer, const lv_image_decoder_dsc_t * dsc,
                                                const lv_area_t * coords, const lv_draw_image_dsc_t * draw_dsc, const lv_area_t * clip_area);
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+/**
+ * Called when the decoding requested by `lv_image_decoder_decode_async()` is finished.
+ * @param res       LV_RESULT_OK: the decoded image is in the image cache;
+ *                  LV_RESULT_INVALID: it couldn't be decoded or its decoder doesn't cache it
+ * @param user_data the `user_data` of the request
+ */
+typedef void (*lv_image_decoder_async_cb_t)(lv_result_t res, void * user_data);
+#endif
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -115,6 +125,27 @@ lv_result_t lv_image_decoder_get_info(const void * src, lv_image_header_t * head
  */
 lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src, const lv_image_decoder_args_t * args);
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+/**
+ * Decode an image on a background thread and keep it in the image cache,
+ * so that `lv_image_decoder_open()` can take it from there without decoding.
+ * The requests are decoded one by one in the order of arrival.
+ * @param src       the image source. File paths are copied, variables need to be valid until `done_cb` is called.
+ * @param done_cb   called from `lv_timer_handler()` when the decoding is finished
+ * @param user_data passed to `done_cb`, also used to cancel the request
+ * @return          LV_RESULT_OK: the request is queued;
+ *                  LV_RESULT_INVALID: the image cache is disabled or the request couldn't be created
+ */
+lv_result_t lv_image_decoder_decode_async(const void * src, lv_image_decoder_async_cb_t done_cb, void * user_data);
+
+/**
+ * Cancel the not finished requests of `lv_image_decoder_decode_async()` with the given user data.
+ * Their `done_cb` won't be called.
+ * @param user_data the `user_data` of the requests to cancel
+ */
+void lv_image_decoder_cancel_async(void * user_data);
+#endif
+
 /**
  * Decode `full_area` pixels incrementally by calling in a loop. Set `decoded_area` to `LV_COORD_MIN` on first call.
  * @param dsc           image decoder descriptor
@@ -192,6 +223,26 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
  */
 lv_draw_buf_t * lv_image_decoder_post_process(lv_image_decoder_dsc_t * dsc, lv_draw_buf_t * decoded);
 
+#if LV_IMAGE_DECODER_CONVERT_NATIVE
+/**
+ * Enable or disable converting the cached RGB888, XRGB8888 and ARGB8888 images to the color format
+ * of the default display if it's RGB565 or RGB565_SWAPPED. Images with alpha channel are converted to RGB565A8.
+ * Enabled by default. The image cache is dropped on change.
+ * @param en        true: convert the images when they are decoded
+ */
+void lv_image_decoder_set_convert_native(bool en);
+
+/**
+ * Enable or disable converting the variable images (e.g. C arrays) which could be drawn directly.
+ * The converted copy is kept in the image cache, so it takes RAM and the changes of the variable's data
+ * are not visible until it's dropped from the cache with `lv_image_cache_drop()`.
+ * Modifiable images (e.g. the draw buffer of a canvas) are never converted.
+ * Disabled by default. The image cache is dropped on change.
+ * @param en        true: convert the variable images too
+ */
+void lv_image_decoder_set_convert_native_variables(bool en);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -15,6 +15,10 @@ extern "C" {
  *********************/
 #include "lv_image_decoder.h"
 #include "../misc/cache/lv_cache.h"
+#if LV_USE_IMAGE_DECODER_ASYNC
+#include "../misc/lv_ll.h"
+#include "../osal/lv_os.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -39,6 +43,8 @@ struct _lv_image_decoder_args_t {
     bool no_cache;          /**< When set, decoded image won't be put to cache, and decoder open will also ignore cache. */
     bool use_indexed;       /**< Decoded indexed image as is. Convert to ARGB8888 if false. */
     bool flush_cache;       /**< Whether to flush the data cache after decoding */
+    bool full_image;        /**< Decode the whole image in open, not in areas by `get_area_cb`.
+                             *   Set for the transformed images as they are sampled from the whole image. */
 };
 
 struct _lv_image_decoder_t {
@@ -55,7 +61,7 @@ struct _lv_image_decoder_t {
 };
 
 struct _lv_image_cache_data_t {
-    lv_cache_slot_size_t slot;
+    lv_cache_slot_cost_t slot;      /**< `cost` is the time to open the image in ms*/
 
     const void * src;
     lv_image_src_t src_type;
@@ -65,6 +71,13 @@ struct _lv_image_cache_data_t {
     void * user_data;
 };
 
+/** Don't cache large images when they are opened the first time*/
+typedef struct {
+    uint32_t max_pct;                   /**< Larger images than this % of the cache are admitted the 2nd time. 0: admit all*/
+    uint32_t seen[8];                   /**< Hashes of the recently not admitted sources*/
+    uint32_t seen_idx;
+} lv_image_cache_admission_t;
+
 struct _lv_image_header_cache_data_t {
     const void * src;
     lv_image_src_t src_type;
@@ -116,6 +129,18 @@ struct _lv_image_decoder_dsc_t {
     void * user_data;
 };
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+/**Background decoding of the images requested by `lv_image_decoder_decode_async()`*/
+typedef struct {
+    lv_thread_t thread;
+    lv_thread_sync_t sync;      /**< Signaled when a new request is queued or the thread needs to exit*/
+    lv_mutex_t lock;            /**< Protects the requests*/
+    lv_ll_t req_ll;             /**< Requests in the order of arrival*/
+    lv_timer_t * timer;         /**< Calls `done_cb` of the finished requests*/
+    bool inited;
+    bool exit;
+} lv_image_decoder_async_t;
+#endif
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -133,6 +158,14 @@ void lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_coun
  */
 void lv_image_decoder_deinit(void);
 
+/**
+ * Hash an image source for the image caches. The hash is never 0.
+ * @param src       the image source: path or pointer to an `lv_image_dsc_t`
+ * @param src_type  type of the source
+ * @return          hash of the path or the pointer
+ */
+uint32_t lv_image_cache_src_hash(const void * src, lv_image_src_t src_type);
+
 /**********************
  *      MACROS
  **********************/
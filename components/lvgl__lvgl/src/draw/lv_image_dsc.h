@@ -38,7 +38,7 @@ typedef enum _lvimage_flags_t {
     /**
      * The image data is compressed, so decoder needs to decode image firstly.
      * If this flag is set, the whole image will be decompressed upon decode, and
-     * `get_area_cb` won't be necessary.
+     * `get_area_cb` won't be necessary, unless the rows are compressed in blocks.
      */
     LV_IMAGE_FLAGS_COMPRESSED       = 0x0008,
 
@@ -0,0 +1,1019 @@
+/**
+ * @file lv_blend_x86.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_blend_x86.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+
+#include "../lv_draw_sw_blend_private.h"
+#include "../../../../misc/lv_color.h"
+#include "../../../../misc/lv_color_op.h"
+#include "../../../../stdlib/lv_string.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+    #ifndef __AVX2__
+        #error "LV_DRAW_SW_ASM_AVX2 requires AVX2 to be enabled in the compiler (e.g. -mavx2)"
+    #endif
+    #include <immintrin.h>
+#else
+    #if !defined(__SSE2__) && !defined(_M_X64) && !(defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #error "LV_DRAW_SW_ASM_SSE2 requires SSE2 to be enabled in the compiler (e.g. -msse2)"
+    #endif
+    #include <emmintrin.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if defined(__GNUC__)
+    #define X86_ALWAYS_INLINE       static inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+    #define X86_ALWAYS_INLINE       static __forceinline
+#else
+    #define X86_ALWAYS_INLINE       static inline
+#endif
+
+/*The same kernels are compiled for 128 bit (SSE2) and 256 bit (AVX2) registers.
+ *Unpacking and packing work on 128 bit lanes in AVX2 too, so unpack + pack keeps the pixel order.*/
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+
+#define VEC_SIZE                32
+#define VEC_MOVEMASK_ALL        ((int32_t)0xFFFFFFFF)
+
+#define VEC_LOAD(p)             _mm256_loadu_si256((const __m256i *)(const void *)(p))
+#define VEC_STORE(p, v)         _mm256_storeu_si256((__m256i *)(void *)(p), (v))
+#define VEC_ZERO()              _mm256_setzero_si256()
+#define VEC_SET16(x)            _mm256_set1_epi16((int16_t)(x))
+#define VEC_SET32(x)            _mm256_set1_epi32((int32_t)(x))
+#define VEC_AND(a, b)           _mm256_and_si256((a), (b))
+#define VEC_OR(a, b)            _mm256_or_si256((a), (b))
+#define VEC_ANDNOT(a, b)        _mm256_andnot_si256((a), (b))
+#define VEC_ADD16(a, b)         _mm256_add_epi16((a), (b))
+#define VEC_SUB16(a, b)         _mm256_sub_epi16((a), (b))
+#define VEC_MULLO16(a, b)       _mm256_mullo_epi16((a), (b))
+#define VEC_MULHI16(a, b)       _mm256_mulhi_epu16((a), (b))
+#define VEC_SRL16(a, n)         _mm256_srli_epi16((a), (n))
+#define VEC_SLL16(a, n)         _mm256_slli_epi16((a), (n))
+#define VEC_SRL32(a, n)         _mm256_srli_epi32((a), (n))
+#define VEC_SLL32(a, n)         _mm256_slli_epi32((a), (n))
+#define VEC_CMPEQ16(a, b)       _mm256_cmpeq_epi16((a), (b))
+#define VEC_CMPEQ32(a, b)       _mm256_cmpeq_epi32((a), (b))
+#define VEC_CMPGT32(a, b)       _mm256_cmpgt_epi32((a), (b))
+#define VEC_UNPACKLO8(a, b)     _mm256_unpacklo_epi8((a), (b))
+#define VEC_UNPACKHI8(a, b)     _mm256_unpackhi_epi8((a), (b))
+#define VEC_UNPACKLO32(a, b)    _mm256_unpacklo_epi32((a), (b))
+#define VEC_UNPACKHI32(a, b)    _mm256_unpackhi_epi32((a), (b))
+#define VEC_PACKUS16(a, b)      _mm256_packus_epi16((a), (b))
+#define VEC_MOVEMASK(a)         _mm256_movemask_epi8(a)
+/*Pack two vectors of 32 bit lanes to 16 bit lanes in pixel order*/
+#define VEC_PACK32_TO_16(a, b)  _mm256_permute4x64_epi64(_mm256_packs_epi32((a), (b)), 0xD8)
+/*Broadcast the 4th 16 bit lane (alpha) of every 64 bit group*/
+#define VEC_ALPHA16(a)          _mm256_shufflehi_epi16(_mm256_shufflelo_epi16((a), 0xFF), 0xFF)
+#define VEC_LOAD_U8_TO_16(p)    _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(const void *)(p)))
+#define VEC_LOAD_U8_TO_32(p)    _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(const void *)(p)))
+
+#else
+
+#define VEC_SIZE                16
+#define VEC_MOVEMASK_ALL        0xFFFF
+
+#define VEC_LOAD(p)             _mm_loadu_si128((const __m128i *)(const void *)(p))
+#define VEC_STORE(p, v)         _mm_storeu_si128((__m128i *)(void *)(p), (v))
+#define VEC_ZERO()              _mm_setzero_si128()
+#define VEC_SET16(x)            _mm_set1_epi16((int16_t)(x))
+#define VEC_SET32(x)            _mm_set1_epi32((int32_t)(x))
+#define VEC_AND(a, b)           _mm_and_si128((a), (b))
+#define VEC_OR(a, b)            _mm_or_si128((a), (b))
+#define VEC_ANDNOT(a, b)        _mm_andnot_si128((a), (b))
+#define VEC_ADD16(a, b)         _mm_add_epi16((a), (b))
+#define VEC_SUB16(a, b)         _mm_sub_epi16((a), (b))
+#define VEC_MULLO16(a, b)       _mm_mullo_epi16((a), (b))
+#define VEC_MULHI16(a, b)       _mm_mulhi_epu16((a), (b))
+#define VEC_SRL16(a, n)         _mm_srli_epi16((a), (n))
+#define VEC_SLL16(a, n)         _mm_slli_epi16((a), (n))
+#define VEC_SRL32(a, n)         _mm_srli_epi32((a), (n))
+#define VEC_SLL32(a, n)         _mm_slli_epi32((a), (n))
+#define VEC_CMPEQ16(a, b)       _mm_cmpeq_epi16((a), (b))
+#define VEC_CMPEQ32(a, b)       _mm_cmpeq_epi32((a), (b))
+#define VEC_CMPGT32(a, b)       _mm_cmpgt_epi32((a), (b))
+#define VEC_UNPACKLO8(a, b)     _mm_unpacklo_epi8((a), (b))
+#define VEC_UNPACKHI8(a, b)     _mm_unpackhi_epi8((a), (b))
+#define VEC_UNPACKLO32(a, b)    _mm_unpacklo_epi32((a), (b))
+#define VEC_UNPACKHI32(a, b)    _mm_unpackhi_epi32((a), (b))
+#define VEC_PACKUS16(a, b)      _mm_packus_epi16((a), (b))
+#define VEC_MOVEMASK(a)         _mm_movemask_epi8(a)
+#define VEC_PACK32_TO_16(a, b)  _mm_packs_epi32((a), (b))
+#define VEC_ALPHA16(a)          _mm_shufflehi_epi16(_mm_shufflelo_epi16((a), 0xFF), 0xFF)
+#define VEC_LOAD_U8_TO_16(p)    _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(const void *)(p)), _mm_setzero_si128())
+#define VEC_LOAD_U8_TO_32(p)    _mm_set_epi32((p)[3], (p)[2], (p)[1], (p)[0])
+
+#endif
+
+/*Number of pixels in a vector*/
+#define VEC_PX16                (VEC_SIZE / 2)
+#define VEC_PX32                (VEC_SIZE / 4)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+typedef __m256i vec_t;
+#else
+typedef __m128i vec_t;
+#endif
+
+typedef struct {
+    uint8_t * dest_buf;
+    int32_t dest_w;
+    int32_t dest_h;
+    int32_t dest_stride;
+    const uint8_t * src_buf;
+    int32_t src_stride;
+    const lv_opa_t * mask_buf;
+    int32_t mask_stride;
+    lv_color_t color;
+    /*The fill color and opacity repeated on every lane. They are set up once per area
+     *because the stores of the loop might alias the descriptor and force a reload otherwise.*/
+    vec_t color16;
+    vec_t color32;
+    vec_t opa16;
+    vec_t opa32;
+} x86_dsc_t;
+
+/**
+ * Blend a vector of destination pixels.
+ * @param dest      the destination pixels
+ * @param src       the source pixels of the same area (NULL for fills)
+ * @param mask      the mask values of the same area (NULL if there is no mask)
+ * @param dsc       the parameters of the blending
+ * @return          the new destination pixels
+ */
+typedef vec_t (*blend_op_t)(vec_t dest, const uint8_t * src, const lv_opa_t * mask, const x86_dsc_t * dsc);
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void fill_dsc_init(x86_dsc_t * d, const lv_draw_sw_blend_fill_dsc_t * dsc);
+static void image_dsc_init(x86_dsc_t * d, const lv_draw_sw_blend_image_dsc_t * dsc);
+static void blend_tail(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, int32_t px_cnt,
+                       uint32_t dest_px_size, uint32_t src_px_size, const x86_dsc_t * dsc, blend_op_t op);
+static vec_t argb8888_mix_scalar(vec_t fg, vec_t bg);
+static void fill_rgb888(const x86_dsc_t * dsc);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Iterate over the area and call `op` for each vector of pixels.
+ * It's always inlined so that `op` is inlined into the loop too.
+ */
+X86_ALWAYS_INLINE void blend(const x86_dsc_t * dsc, uint32_t dest_px_size, uint32_t src_px_size, blend_op_t op)
+{
+    const int32_t vec_px = VEC_SIZE / dest_px_size;
+    const int32_t w = dsc->dest_w;
+    uint8_t * dest = dsc->dest_buf;
+    const uint8_t * src = dsc->src_buf;
+    const lv_opa_t * mask = dsc->mask_buf;
+
+    int32_t y;
+    for(y = 0; y < dsc->dest_h; y++) {
+        int32_t x;
+        if(src && mask) {
+            for(x = 0; x <= w - vec_px; x += vec_px) {
+                uint8_t * d = dest + x * dest_px_size;
+                VEC_STORE(d, op(VEC_LOAD(d), src + x * src_px_size, mask + x, dsc));
+            }
+        }
+        else if(src) {
+            for(x = 0; x <= w - vec_px; x += vec_px) {
+                uint8_t * d = dest + x * dest_px_size;
+                VEC_STORE(d, op(VEC_LOAD(d), src + x * src_px_size, NULL, dsc));
+            }
+        }
+        else if(mask) {
+            for(x = 0; x <= w - vec_px; x += vec_px) {
+                uint8_t * d = dest + x * dest_px_size;
+                VEC_STORE(d, op(VEC_LOAD(d), NULL, mask + x, dsc));
+            }
+        }
+        else {
+            for(x = 0; x <= w - vec_px; x += vec_px) {
+                uint8_t * d = dest + x * dest_px_size;
+                VEC_STORE(d, op(VEC_LOAD(d), NULL, NULL, dsc));
+            }
+        }
+
+        if(x < w) {
+            blend_tail(dest + x * dest_px_size, src ? src + x * src_px_size : NULL, mask ? mask + x : NULL, w - x,
+                       dest_px_size, src_px_size, dsc, op);
+        }
+
+        dest += dsc->dest_stride;
+        if(src) src += dsc->src_stride;
+        if(mask) mask += dsc->mask_stride;
+    }
+}
+
+/**
+ * Blend the last `px_cnt` (less than a vector) pixels of a line.
+ * The pixels are copied to a temporary buffer, so the same vector code can run on them
+ * without reading or writing outside of the buffers.
+ */
+static void blend_tail(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, int32_t px_cnt,
+                       uint32_t dest_px_size, uint32_t src_px_size, const x86_dsc_t * dsc, blend_op_t op)
+{
+    uint8_t dest_tmp[VEC_SIZE];
+    uint8_t src_tmp[VEC_SIZE * 2];
+    lv_opa_t mask_tmp[VEC_SIZE];
+
+    lv_memzero(dest_tmp, sizeof(dest_tmp));
+    lv_memcpy(dest_tmp, dest, px_cnt * dest_px_size);
+    if(src) {
+        lv_memzero(src_tmp, sizeof(src_tmp));
+        lv_memcpy(src_tmp, src, px_cnt * src_px_size);
+    }
+    if(mask) {
+        lv_memzero(mask_tmp, sizeof(mask_tmp));
+        lv_memcpy(mask_tmp, mask, px_cnt);
+    }
+
+    vec_t res = op(VEC_LOAD(dest_tmp), src ? src_tmp : NULL, mask ? mask_tmp : NULL, dsc);
+    VEC_STORE(dest_tmp, res);
+    lv_memcpy(dest, dest_tmp, px_cnt * dest_px_size);
+}
+
+static void fill_dsc_init(x86_dsc_t * d, const lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    lv_memzero(d, sizeof(x86_dsc_t));
+    d->dest_buf = dsc->dest_buf;
+    d->dest_w = dsc->dest_w;
+    d->dest_h = dsc->dest_h;
+    d->dest_stride = dsc->dest_stride;
+    d->mask_buf = dsc->mask_buf;
+    d->mask_stride = dsc->mask_stride;
+    d->color = dsc->color;
+    d->color16 = VEC_SET16(lv_color_to_u16(dsc->color));
+    d->color32 = VEC_SET32(lv_color_to_u32(dsc->color));
+    d->opa16 = VEC_SET16(dsc->opa);
+    d->opa32 = VEC_SET32(dsc->opa);
+}
+
+static void image_dsc_init(x86_dsc_t * d, const lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    lv_memzero(d, sizeof(x86_dsc_t));
+    d->dest_buf = dsc->dest_buf;
+    d->dest_w = dsc->dest_w;
+    d->dest_h = dsc->dest_h;
+    d->dest_stride = dsc->dest_stride;
+    d->src_buf = dsc->src_buf;
+    d->src_stride = dsc->src_stride;
+    d->mask_buf = dsc->mask_buf;
+    d->mask_stride = dsc->mask_stride;
+    d->opa16 = VEC_SET16(dsc->opa);
+    d->opa32 = VEC_SET32(dsc->opa);
+}
+
+/*`LV_OPA_MIX2(a, b)` on 16 or 32 bit lanes*/
+X86_ALWAYS_INLINE vec_t opa_mix2(vec_t a, vec_t b)
+{
+    return VEC_SRL16(VEC_MULLO16(a, b), 8);
+}
+
+/*`LV_OPA_MIX3(a, b, c)` on 16 or 32 bit lanes. a * b fits into 16 bit so only the upper half is needed*/
+X86_ALWAYS_INLINE vec_t opa_mix3(vec_t a, vec_t b, vec_t c)
+{
+    return VEC_MULHI16(VEC_MULLO16(a, b), c);
+}
+
+/*--------------------
+ * RGB565 destination
+ *--------------------*/
+
+/**
+ * Same as `lv_color_16_16_mix()`. The packed 32 bit trick of the C version is equal
+ * to mixing the channels one by one with (mix + 4) >> 3 in 1/32 steps. This way
+ * mix == 255 gives `fg` and mix == 0 gives `bg` without special cases.
+ * @param fg        RGB565 foreground colors
+ * @param bg        RGB565 background colors
+ * @param mix       the mix ratios (0..255) on 16 bit lanes
+ */
+X86_ALWAYS_INLINE vec_t rgb565_mix(vec_t fg, vec_t bg, vec_t mix)
+{
+    vec_t m = VEC_SRL16(VEC_ADD16(mix, VEC_SET16(4)), 3);
+    vec_t m_inv = VEC_SUB16(VEC_SET16(32), m);
+    vec_t mask5 = VEC_SET16(0x1F);
+    vec_t mask6 = VEC_SET16(0x3F);
+
+    vec_t r = VEC_ADD16(VEC_MULLO16(VEC_SRL16(fg, 11), m), VEC_MULLO16(VEC_SRL16(bg, 11), m_inv));
+    vec_t g = VEC_ADD16(VEC_MULLO16(VEC_AND(VEC_SRL16(fg, 5), mask6), m),
+                        VEC_MULLO16(VEC_AND(VEC_SRL16(bg, 5), mask6), m_inv));
+    vec_t b = VEC_ADD16(VEC_MULLO16(VEC_AND(fg, mask5), m), VEC_MULLO16(VEC_AND(bg, mask5), m_inv));
+
+    r = VEC_SLL16(VEC_SRL16(r, 5), 11);
+    g = VEC_AND(g, VEC_SET16(0x07E0));
+    b = VEC_SRL16(b, 5);
+
+    return VEC_OR(VEC_OR(r, g), b);
+}
+
+/**
+ * Same as `lv_color_24_16_mix()` of the C version.
+ * @param src       pointer to `VEC_PX16` ARGB8888 pixels
+ * @param bg        RGB565 background colors
+ * @param mix       the mix ratios (0..255) on 16 bit lanes
+ */
+X86_ALWAYS_INLINE vec_t rgb565_mix_argb8888(const uint8_t * src, vec_t bg, vec_t mix)
+{
+    vec_t c_lo = VEC_LOAD(src);
+    vec_t c_hi = VEC_LOAD(src + VEC_SIZE);
+    vec_t mask8 = VEC_SET32(0xFF);
+
+    vec_t r = VEC_SRL16(VEC_PACK32_TO_16(VEC_AND(VEC_SRL32(c_lo, 16), mask8), VEC_AND(VEC_SRL32(c_hi, 16), mask8)), 3);
+    vec_t g = VEC_SRL16(VEC_PACK32_TO_16(VEC_AND(VEC_SRL32(c_lo, 8), mask8), VEC_AND(VEC_SRL32(c_hi, 8), mask8)), 2);
+    vec_t b = VEC_SRL16(VEC_PACK32_TO_16(VEC_AND(c_lo, mask8), VEC_AND(c_hi, mask8)), 3);
+
+    vec_t fg = VEC_OR(VEC_OR(VEC_SLL16(r, 11), VEC_SLL16(g, 5)), b);
+
+    vec_t mix_inv = VEC_SUB16(VEC_SET16(255), mix);
+    vec_t res_r = VEC_ADD16(VEC_MULLO16(r, mix), VEC_MULLO16(VEC_SRL16(bg, 11), mix_inv));
+    vec_t res_g = VEC_ADD16(VEC_MULLO16(g, mix), VEC_MULLO16(VEC_AND(VEC_SRL16(bg, 5), VEC_SET16(0x3F)), mix_inv));
+    vec_t res_b = VEC_ADD16(VEC_MULLO16(b, mix), VEC_MULLO16(VEC_AND(bg, VEC_SET16(0x1F)), mix_inv));
+    vec_t res = VEC_OR(VEC_OR(VEC_SLL16(VEC_SRL16(res_r, 8), 11), VEC_SLL16(VEC_SRL16(res_g, 8), 5)),
+                       VEC_SRL16(res_b, 8));
+
+    /*mix == 255 -> truncated source color, mix == 0 -> background*/
+    vec_t sel_fg = VEC_CMPEQ16(mix, VEC_SET16(255));
+    vec_t sel_bg = VEC_CMPEQ16(mix, VEC_ZERO());
+    res = VEC_OR(VEC_AND(sel_fg, fg), VEC_ANDNOT(sel_fg, res));
+    return VEC_OR(VEC_AND(sel_bg, bg), VEC_ANDNOT(sel_bg, res));
+}
+
+/*The alpha channel of `VEC_PX16` ARGB8888 pixels on 16 bit lanes*/
+X86_ALWAYS_INLINE vec_t argb8888_alpha16(const uint8_t * src)
+{
+    return VEC_PACK32_TO_16(VEC_SRL32(VEC_LOAD(src), 24), VEC_SRL32(VEC_LOAD(src + VEC_SIZE), 24));
+}
+
+static inline vec_t op_color_to_rgb565(vec_t dest, const uint8_t * src, const lv_opa_t * mask, const x86_dsc_t * dsc)
+{
+    LV_UNUSED(dest);
+    LV_UNUSED(src);
+    LV_UNUSED(mask);
+    return dsc->color16;
+}
+
+static inline vec_t op_color_to_rgb565_with_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                const x86_dsc_t * dsc)
+{
+    LV_UNUSED(src);
+    LV_UNUSED(mask);
+    return rgb565_mix(dsc->color16, dest, dsc->opa16);
+}
+
+static inline vec_t op_color_to_rgb565_with_mask(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                 const x86_dsc_t * dsc)
+{
+    LV_UNUSED(src);
+    return rgb565_mix(dsc->color16, dest, VEC_LOAD_U8_TO_16(mask));
+}
+
+static inline vec_t op_color_to_rgb565_mix_mask_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                    const x86_dsc_t * dsc)
+{
+    LV_UNUSED(src);
+    vec_t mix = opa_mix2(VEC_LOAD_U8_TO_16(mask), dsc->opa16);
+    return rgb565_mix(dsc->color16, dest, mix);
+}
+
+static inline vec_t op_rgb565_to_rgb565_with_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                 const x86_dsc_t * dsc)
+{
+    LV_UNUSED(mask);
+    return rgb565_mix(VEC_LOAD(src), dest, dsc->opa16);
+}
+
+static inline vec_t op_rgb565_to_rgb565_with_mask(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                  const x86_dsc_t * dsc)
+{
+    LV_UNUSED(dsc);
+    return rgb565_mix(VEC_LOAD(src), dest, VEC_LOAD_U8_TO_16(mask));
+}
+
+static inline vec_t op_rgb565_to_rgb565_mix_mask_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                     const x86_dsc_t * dsc)
+{
+    vec_t mix = opa_mix2(VEC_LOAD_U8_TO_16(mask), dsc->opa16);
+    return rgb565_mix(VEC_LOAD(src), dest, mix);
+}
+
+static inline vec_t op_argb8888_to_rgb565(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                          const x86_dsc_t * dsc)
+{
+    LV_UNUSED(mask);
+    LV_UNUSED(dsc);
+    return rgb565_mix_argb8888(src, dest, argb8888_alpha16(src));
+}
+
+static inline vec_t op_argb8888_to_rgb565_with_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                   const x86_dsc_t * dsc)
+{
+    LV_UNUSED(mask);
+    vec_t mix = opa_mix2(argb8888_alpha16(src), dsc->opa16);
+    return rgb565_mix_argb8888(src, dest, mix);
+}
+
+static inline vec_t op_argb8888_to_rgb565_with_mask(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                    const x86_dsc_t * dsc)
+{
+    LV_UNUSED(dsc);
+    vec_t mix = opa_mix2(argb8888_alpha16(src), VEC_LOAD_U8_TO_16(mask));
+    return rgb565_mix_argb8888(src, dest, mix);
+}
+
+static inline vec_t op_argb8888_to_rgb565_mix_mask_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                       const x86_dsc_t * dsc)
+{
+    vec_t mix = opa_mix3(argb8888_alpha16(src), VEC_LOAD_U8_TO_16(mask), dsc->opa16);
+    return rgb565_mix_argb8888(src, dest, mix);
+}
+
+/*--------------------
+ * XRGB8888 destination
+ *--------------------*/
+
+/**
+ * Same as `lv_color_24_24_mix()`: mix == 0 keeps `bg`, mix >= LV_OPA_MAX copies `fg`
+ * and the X byte of `bg` is never changed.
+ * @param fg        XRGB8888 or ARGB8888 foreground colors
+ * @param bg        XRGB8888 background colors
+ * @param mix       the mix ratios (0..255) on 32 bit lanes
+ */
+X86_ALWAYS_INLINE vec_t rgb888_mix(vec_t fg, vec_t bg, vec_t mix)
+{
+    vec_t zero = VEC_ZERO();
+    vec_t mix_2x = VEC_OR(mix, VEC_SLL32(mix, 16));
+    vec_t m_lo = VEC_UNPACKLO32(mix_2x, mix_2x);
+    vec_t m_hi = VEC_UNPACKHI32(mix_2x, mix_2x);
+    vec_t c255 = VEC_SET16(255);
+
+    vec_t lo = VEC_ADD16(VEC_MULLO16(VEC_UNPACKLO8(fg, zero), m_lo),
+                         VEC_MULLO16(VEC_UNPACKLO8(bg, zero), VEC_SUB16(c255, m_lo)));
+    vec_t hi = VEC_ADD16(VEC_MULLO16(VEC_UNPACKHI8(fg, zero), m_hi),
+                         VEC_MULLO16(VEC_UNPACKHI8(bg, zero), VEC_SUB16(c255, m_hi)));
+    vec_t res = VEC_PACKUS16(VEC_SRL16(lo, 8), VEC_SRL16(hi, 8));
+
+    vec_t sel_fg = VEC_CMPGT32(mix, VEC_SET32(LV_OPA_MAX - 1));
+    vec_t sel_bg = VEC_CMPEQ32(mix, zero);
+    res = VEC_OR(VEC_AND(sel_fg, fg), VEC_ANDNOT(sel_fg, res));
+    res = VEC_OR(VEC_AND(sel_bg, bg), VEC_ANDNOT(sel_bg, res));
+
+    vec_t mask_x = VEC_SET32(0xFF000000);
+    return VEC_OR(VEC_ANDNOT(mask_x, res), VEC_AND(mask_x, bg));
+}
+
+static inline vec_t op_color_to_xrgb8888(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                         const x86_dsc_t * dsc)
+{
+    LV_UNUSED(dest);
+    LV_UNUSED(src);
+    LV_UNUSED(mask);
+    return dsc->color32;
+}
+
+static inline vec_t op_color_to_xrgb8888_with_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                  const x86_dsc_t * dsc)
+{
+    LV_UNUSED(src);
+    LV_UNUSED(mask);
+    return rgb888_mix(dsc->color32, dest, dsc->opa32);
+}
+
+static inline vec_t op_color_to_xrgb8888_with_mask(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                   const x86_dsc_t * dsc)
+{
+    LV_UNUSED(src);
+    return rgb888_mix(dsc->color32, dest, VEC_LOAD_U8_TO_32(mask));
+}
+
+static inline vec_t op_color_to_xrgb8888_mix_mask_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                      const x86_dsc_t * dsc)
+{
+    LV_UNUSED(src);
+    vec_t mix = opa_mix2(VEC_LOAD_U8_TO_32(mask), dsc->opa32);
+    return rgb888_mix(dsc->color32, dest, mix);
+}
+
+static inline vec_t op_xrgb8888_to_xrgb8888_with_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                     const x86_dsc_t * dsc)
+{
+    LV_UNUSED(mask);
+    return rgb888_mix(VEC_LOAD(src), dest, dsc->opa32);
+}
+
+static inline vec_t op_xrgb8888_to_xrgb8888_with_mask(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                      const x86_dsc_t * dsc)
+{
+    LV_UNUSED(dsc);
+    return rgb888_mix(VEC_LOAD(src), dest, VEC_LOAD_U8_TO_32(mask));
+}
+
+static inline vec_t op_xrgb8888_to_xrgb8888_mix_mask_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                         const x86_dsc_t * dsc)
+{
+    vec_t mix = opa_mix2(VEC_LOAD_U8_TO_32(mask), dsc->opa32);
+    return rgb888_mix(VEC_LOAD(src), dest, mix);
+}
+
+static inline vec_t op_argb8888_to_xrgb8888(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                            const x86_dsc_t * dsc)
+{
+    LV_UNUSED(mask);
+    LV_UNUSED(dsc);
+    vec_t c = VEC_LOAD(src);
+    return rgb888_mix(c, dest, VEC_SRL32(c, 24));
+}
+
+static inline vec_t op_argb8888_to_xrgb8888_with_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                     const x86_dsc_t * dsc)
+{
+    LV_UNUSED(mask);
+    vec_t c = VEC_LOAD(src);
+    return rgb888_mix(c, dest, opa_mix2(VEC_SRL32(c, 24), dsc->opa32));
+}
+
+static inline vec_t op_argb8888_to_xrgb8888_with_mask(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                      const x86_dsc_t * dsc)
+{
+    LV_UNUSED(dsc);
+    vec_t c = VEC_LOAD(src);
+    return rgb888_mix(c, dest, opa_mix2(VEC_SRL32(c, 24), VEC_LOAD_U8_TO_32(mask)));
+}
+
+static inline vec_t op_argb8888_to_xrgb8888_mix_mask_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                         const x86_dsc_t * dsc)
+{
+    vec_t c = VEC_LOAD(src);
+    vec_t mix = opa_mix3(VEC_SRL32(c, 24), VEC_LOAD_U8_TO_32(mask), dsc->opa32);
+    return rgb888_mix(c, dest, mix);
+}
+
+/*--------------------
+ * ARGB8888 destination
+ *--------------------*/
+
+/**
+ * Same as `lv_color_32_32_mix()` of the C version. The SIMD path handles opaque and
+ * transparent foregrounds and opaque backgrounds. If both colors are semi-transparent
+ * in any lane, the whole vector is calculated pixel by pixel.
+ * @param fg        ARGB8888 foreground colors (with the final alpha)
+ * @param bg        ARGB8888 background colors
+ */
+X86_ALWAYS_INLINE vec_t argb8888_mix(vec_t fg, vec_t bg)
+{
+    vec_t fg_a = VEC_SRL32(fg, 24);
+    vec_t bg_a = VEC_SRL32(bg, 24);
+    vec_t opa_min = VEC_SET32(LV_OPA_MIN + 1);
+
+    vec_t sel_fg = VEC_OR(VEC_CMPGT32(fg_a, VEC_SET32(LV_OPA_MAX - 1)), VEC_CMPGT32(opa_min, bg_a));
+    if(VEC_MOVEMASK(sel_fg) == VEC_MOVEMASK_ALL) return fg;
+
+    vec_t sel_bg = VEC_ANDNOT(sel_fg, VEC_CMPGT32(opa_min, fg_a));
+    vec_t sel_simple = VEC_OR(sel_fg, sel_bg);
+    vec_t sel_mix = VEC_ANDNOT(sel_simple, VEC_CMPEQ32(bg_a, VEC_SET32(0xFF)));
+    if(VEC_MOVEMASK(VEC_OR(sel_simple, sel_mix)) != VEC_MOVEMASK_ALL) return argb8888_mix_scalar(fg, bg);
+
+    /*LV_UDIV255(fg * a + bg * (255 - a)), where (x * 0x8081) >> 23 == mulhi(x, 0x8081) >> 7*/
+    vec_t zero = VEC_ZERO();
+    vec_t c255 = VEC_SET16(255);
+    vec_t div255 = VEC_SET16(0x8081);
+    vec_t fg_lo = VEC_UNPACKLO8(fg, zero);
+    vec_t fg_hi = VEC_UNPACKHI8(fg, zero);
+    vec_t a_lo = VEC_ALPHA16(fg_lo);
+    vec_t a_hi = VEC_ALPHA16(fg_hi);
+    vec_t lo = VEC_ADD16(VEC_MULLO16(fg_lo, a_lo), VEC_MULLO16(VEC_UNPACKLO8(bg, zero), VEC_SUB16(c255, a_lo)));
+    vec_t hi = VEC_ADD16(VEC_MULLO16(fg_hi, a_hi), VEC_MULLO16(VEC_UNPACKHI8(bg, zero), VEC_SUB16(c255, a_hi)));
+    lo = VEC_SRL16(VEC_MULHI16(lo, div255), 7);
+    hi = VEC_SRL16(VEC_MULHI16(hi, div255), 7);
+    /*The background is opaque so the result is opaque too*/
+    vec_t mixed = VEC_OR(VEC_PACKUS16(lo, hi), VEC_SET32(0xFF000000));
+
+    return VEC_OR(VEC_OR(VEC_AND(sel_fg, fg), VEC_AND(sel_bg, bg)), VEC_AND(sel_mix, mixed));
+}
+
+/*Calculate `lv_color_32_32_mix()` pixel by pixel. Used when both colors are semi-transparent.*/
+static vec_t argb8888_mix_scalar(vec_t fg, vec_t bg)
+{
+    lv_color32_t fg_px[VEC_PX32];
+    lv_color32_t bg_px[VEC_PX32];
+    VEC_STORE(fg_px, fg);
+    VEC_STORE(bg_px, bg);
+
+    int32_t i;
+    for(i = 0; i < VEC_PX32; i++) {
+        lv_color32_t f = fg_px[i];
+        lv_color32_t b = bg_px[i];
+        if(f.alpha >= LV_OPA_MAX || b.alpha <= LV_OPA_MIN) {
+            bg_px[i] = f;
+        }
+        else if(f.alpha <= LV_OPA_MIN) {
+            /*Keep the background*/
+        }
+        else if(b.alpha == 255) {
+            bg_px[i] = lv_color_mix32(f, b);
+        }
+        else {
+            lv_opa_t res_alpha = 255 - LV_OPA_MIX2(255 - f.alpha, 255 - b.alpha);
+            f.alpha = (uint32_t)((uint32_t)f.alpha * 255) / res_alpha;
+            bg_px[i] = lv_color_mix32(f, b);
+            bg_px[i].alpha = res_alpha;
+        }
+    }
+
+    return VEC_LOAD(bg_px);
+}
+
+/*Replace the alpha of ARGB8888 colors with `alpha` (0..255 on 32 bit lanes)*/
+X86_ALWAYS_INLINE vec_t argb8888_set_alpha(vec_t c, vec_t alpha)
+{
+    return VEC_OR(VEC_AND(c, VEC_SET32(0x00FFFFFF)), VEC_SLL32(alpha, 24));
+}
+
+static inline vec_t op_color_to_argb8888_with_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                  const x86_dsc_t * dsc)
+{
+    LV_UNUSED(src);
+    LV_UNUSED(mask);
+    return argb8888_mix(argb8888_set_alpha(dsc->color32, dsc->opa32), dest);
+}
+
+static inline vec_t op_color_to_argb8888_with_mask(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                   const x86_dsc_t * dsc)
+{
+    LV_UNUSED(src);
+    return argb8888_mix(argb8888_set_alpha(dsc->color32, VEC_LOAD_U8_TO_32(mask)), dest);
+}
+
+static inline vec_t op_color_to_argb8888_mix_mask_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                      const x86_dsc_t * dsc)
+{
+    LV_UNUSED(src);
+    vec_t alpha = opa_mix2(VEC_LOAD_U8_TO_32(mask), dsc->opa32);
+    return argb8888_mix(argb8888_set_alpha(dsc->color32, alpha), dest);
+}
+
+static inline vec_t op_argb8888_to_argb8888(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                            const x86_dsc_t * dsc)
+{
+    LV_UNUSED(mask);
+    LV_UNUSED(dsc);
+    return argb8888_mix(VEC_LOAD(src), dest);
+}
+
+static inline vec_t op_argb8888_to_argb8888_with_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                     const x86_dsc_t * dsc)
+{
+    LV_UNUSED(mask);
+    vec_t c = VEC_LOAD(src);
+    vec_t alpha = opa_mix2(VEC_SRL32(c, 24), dsc->opa32);
+    return argb8888_mix(argb8888_set_alpha(c, alpha), dest);
+}
+
+static inline vec_t op_argb8888_to_argb8888_with_mask(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                      const x86_dsc_t * dsc)
+{
+    LV_UNUSED(dsc);
+    vec_t c = VEC_LOAD(src);
+    vec_t alpha = opa_mix2(VEC_SRL32(c, 24), VEC_LOAD_U8_TO_32(mask));
+    return argb8888_mix(argb8888_set_alpha(c, alpha), dest);
+}
+
+static inline vec_t op_argb8888_to_argb8888_mix_mask_opa(vec_t dest, const uint8_t * src, const lv_opa_t * mask,
+                                                         const x86_dsc_t * dsc)
+{
+    vec_t c = VEC_LOAD(src);
+    vec_t alpha = opa_mix3(VEC_SRL32(c, 24), VEC_LOAD_U8_TO_32(mask), dsc->opa32);
+    return argb8888_mix(argb8888_set_alpha(c, alpha), dest);
+}
+
+/*--------------------
+ * RGB888 destination
+ *--------------------*/
+
+/*Fill 3 byte pixels by storing a 3 vector long pattern*/
+static void fill_rgb888(const x86_dsc_t * dsc)
+{
+    uint8_t pattern[VEC_SIZE * 3];
+    int32_t i;
+    for(i = 0; i < VEC_SIZE * 3; i += 3) {
+        pattern[i + 0] = dsc->color.blue;
+        pattern[i + 1] = dsc->color.green;
+        pattern[i + 2] = dsc->color.red;
+    }
+
+    vec_t p0 = VEC_LOAD(pattern);
+    vec_t p1 = VEC_LOAD(pattern + VEC_SIZE);
+    vec_t p2 = VEC_LOAD(pattern + VEC_SIZE * 2);
+
+    const int32_t line_bytes = dsc->dest_w * 3;
+    uint8_t * dest = dsc->dest_buf;
+    int32_t y;
+    for(y = 0; y < dsc->dest_h; y++) {
+        int32_t x;
+        for(x = 0; x <= line_bytes - VEC_SIZE * 3; x += VEC_SIZE * 3) {
+            VEC_STORE(dest + x, p0);
+            VEC_STORE(dest + x + VEC_SIZE, p1);
+            VEC_STORE(dest + x + VEC_SIZE * 2, p2);
+        }
+        if(x < line_bytes) lv_memcpy(dest + x, pattern, line_bytes - x);
+        dest += dsc->dest_stride;
+    }
+}
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_color_blend_to_rgb565_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    fill_dsc_init(&d, dsc);
+    blend(&d, 2, 0, op_color_to_rgb565);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_with_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    fill_dsc_init(&d, dsc);
+    blend(&d, 2, 0, op_color_to_rgb565_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_with_mask_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    fill_dsc_init(&d, dsc);
+    blend(&d, 2, 0, op_color_to_rgb565_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb565_mix_mask_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    fill_dsc_init(&d, dsc);
+    blend(&d, 2, 0, op_color_to_rgb565_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 2, 2, op_rgb565_to_rgb565_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 2, 2, op_rgb565_to_rgb565_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 2, 2, op_rgb565_to_rgb565_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 2, 4, op_argb8888_to_rgb565);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 2, 4, op_argb8888_to_rgb565_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 2, 4, op_argb8888_to_rgb565_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 2, 4, op_argb8888_to_rgb565_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_x86(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    x86_dsc_t d;
+    fill_dsc_init(&d, dsc);
+    if(dst_px_size == 3) fill_rgb888(&d);
+    else blend(&d, 4, 0, op_color_to_xrgb8888);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_with_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    x86_dsc_t d;
+    fill_dsc_init(&d, dsc);
+    blend(&d, 4, 0, op_color_to_xrgb8888_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_with_mask_x86(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    x86_dsc_t d;
+    fill_dsc_init(&d, dsc);
+    blend(&d, 4, 0, op_color_to_xrgb8888_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_rgb888_mix_mask_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    x86_dsc_t d;
+    fill_dsc_init(&d, dsc);
+    blend(&d, 4, 0, op_color_to_xrgb8888_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb888_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size,
+                                                          uint32_t src_px_size)
+{
+    if(dst_px_size != 4 || src_px_size != 4) return LV_RESULT_INVALID;
+
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 4, 4, op_xrgb8888_to_xrgb8888_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb888_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size,
+                                                           uint32_t src_px_size)
+{
+    if(dst_px_size != 4 || src_px_size != 4) return LV_RESULT_INVALID;
+
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 4, 4, op_xrgb8888_to_xrgb8888_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb888_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size,
+                                                              uint32_t src_px_size)
+{
+    if(dst_px_size != 4 || src_px_size != 4) return LV_RESULT_INVALID;
+
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 4, 4, op_xrgb8888_to_xrgb8888_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 4, 4, op_argb8888_to_xrgb8888);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 4, 4, op_argb8888_to_xrgb8888_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 4, 4, op_argb8888_to_xrgb8888_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc,
+                                                                uint32_t dst_px_size)
+{
+    if(dst_px_size != 4) return LV_RESULT_INVALID;
+
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 4, 4, op_argb8888_to_xrgb8888_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    fill_dsc_init(&d, dsc);
+    blend(&d, 4, 0, op_color_to_xrgb8888);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_with_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    fill_dsc_init(&d, dsc);
+    blend(&d, 4, 0, op_color_to_argb8888_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_with_mask_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    fill_dsc_init(&d, dsc);
+    blend(&d, 4, 0, op_color_to_argb8888_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_color_blend_to_argb8888_mix_mask_opa_x86(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    fill_dsc_init(&d, dsc);
+    blend(&d, 4, 0, op_color_to_argb8888_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 4, 4, op_argb8888_to_argb8888);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_with_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 4, 4, op_argb8888_to_argb8888_with_opa);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_with_mask_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 4, 4, op_argb8888_to_argb8888_with_mask);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_x86(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    x86_dsc_t d;
+    image_dsc_init(&d, dsc);
+    blend(&d, 4, 4, op_argb8888_to_argb8888_mix_mask_opa);
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2*/
@@ -34,6 +34,10 @@
     #error "OS support is required when more than one SW rendering units are enabled"
 #endif
 
+#if LV_DRAW_SW_WORK_STEALING && LV_DRAW_SW_DRAW_UNIT_CNT < 2
+    #warning "LV_DRAW_SW_WORK_STEALING has no effect with less than 2 SW rendering units"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -46,10 +50,20 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-#if LV_USE_OS
+#if LV_USE_OS && !LV_DRAW_SW_WORK_STEALING
     static void render_thread_cb(void * ptr);
 #endif
 
+#if LV_USE_OS && LV_DRAW_SW_WORK_STEALING
+    static int32_t dispatch_work_stealing(lv_draw_sw_unit_t * draw_sw_unit, lv_layer_t * layer);
+    static void render_thread_work_stealing_cb(void * ptr);
+    static uint32_t get_split_cnt(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_task_t * t, lv_area_t * draw_area);
+    static void queue_task(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_sw_thread_dsc_t * thread_dsc, lv_draw_task_t * t);
+    static bool get_job(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_sw_thread_dsc_t * thread_dsc, lv_draw_sw_job_t * job);
+    static void execute_job(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_sw_thread_dsc_t * thread_dsc,
+                            lv_draw_sw_job_t * job);
+#endif
+
 static void execute_drawing(lv_draw_task_t * t);
 
 static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
@@ -90,12 +104,22 @@ void lv_draw_sw_init(void)
 #endif
 
 #if LV_USE_OS
+#if LV_DRAW_SW_WORK_STEALING
+    lv_mutex_init(&draw_sw_unit->split_lock);
+    draw_sw_unit->thread_cnt = LV_DRAW_SW_DRAW_UNIT_CNT;
+    void (*thread_cb)(void *) = render_thread_work_stealing_cb;
+#else
+    void (*thread_cb)(void *) = render_thread_cb;
+#endif
     uint32_t i;
     for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
         lv_draw_sw_thread_dsc_t * thread_dsc = &draw_sw_unit->thread_dscs[i];
         thread_dsc->idx = i;
         thread_dsc->draw_unit = (void *) draw_sw_unit;
-        lv_thread_init(&thread_dsc->thread, "swdraw", LV_DRAW_THREAD_PRIO, render_thread_cb,
+#if LV_DRAW_SW_WORK_STEALING
+        lv_mutex_init(&thread_dsc->queue_lock);
+#endif
+        lv_thread_init(&thread_dsc->thread, "swdraw", LV_DRAW_THREAD_PRIO, thread_cb,
                        LV_DRAW_THREAD_STACK_SIZE, thread_dsc);
     }
 #endif
@@ -139,8 +163,15 @@ static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
             lv_thread_sync_signal(&thread_dsc->sync);
         }
         lv_thread_delete(&thread_dsc->thread);
+#if LV_DRAW_SW_WORK_STEALING
+        lv_mutex_delete(&thread_dsc->queue_lock);
+#endif
     }
 
+#if LV_DRAW_SW_WORK_STEALING
+    lv_mutex_delete(&draw_sw_unit->split_lock);
+#endif
+
     return 0;
 #else
     LV_UNUSED(draw_unit);
@@ -201,6 +232,63 @@ lv_draw_sw_blend_handler_t lv_draw_sw_get_blend_handler(lv_color_format_t dest_c
     return NULL;
 }
 
+#if LV_USE_OS && LV_DRAW_SW_WORK_STEALING
+
+lv_result_t lv_draw_sw_get_thread_stats(uint32_t idx, lv_draw_sw_thread_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    if(idx >= LV_DRAW_SW_DRAW_UNIT_CNT) return LV_RESULT_INVALID;
+
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u) {
+        if(u->dispatch_cb == dispatch) {
+            lv_draw_sw_unit_t * draw_sw_unit = (lv_draw_sw_unit_t *) u;
+            lv_draw_sw_thread_dsc_t * thread_dsc = &draw_sw_unit->thread_dscs[idx];
+            lv_mutex_lock(&thread_dsc->queue_lock);
+            *stats = thread_dsc->stats;
+            lv_mutex_unlock(&thread_dsc->queue_lock);
+            return LV_RESULT_OK;
+        }
+        u = u->next;
+    }
+
+    return LV_RESULT_INVALID;
+}
+
+void lv_draw_sw_set_thread_cnt(uint32_t cnt)
+{
+    cnt = LV_CLAMP(1, cnt, LV_DRAW_SW_DRAW_UNIT_CNT);
+
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u) {
+        if(u->dispatch_cb == dispatch) {
+            lv_draw_sw_unit_t * draw_sw_unit = (lv_draw_sw_unit_t *) u;
+            draw_sw_unit->thread_cnt = cnt;
+        }
+        u = u->next;
+    }
+}
+
+void lv_draw_sw_reset_thread_stats(void)
+{
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u) {
+        if(u->dispatch_cb == dispatch) {
+            lv_draw_sw_unit_t * draw_sw_unit = (lv_draw_sw_unit_t *) u;
+            uint32_t i;
+            for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
+                lv_draw_sw_thread_dsc_t * thread_dsc = &draw_sw_unit->thread_dscs[i];
+                lv_mutex_lock(&thread_dsc->queue_lock);
+                lv_memzero(&thread_dsc->stats, sizeof(thread_dsc->stats));
+                lv_mutex_unlock(&thread_dsc->queue_lock);
+            }
+        }
+        u = u->next;
+    }
+}
+
+#endif /*LV_USE_OS && LV_DRAW_SW_WORK_STEALING*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -252,7 +340,11 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
     LV_PROFILER_DRAW_BEGIN;
     lv_draw_sw_unit_t * draw_sw_unit = (lv_draw_sw_unit_t *) draw_unit;
 
-#if LV_USE_OS
+#if LV_USE_OS && LV_DRAW_SW_WORK_STEALING
+    int32_t res = dispatch_work_stealing(draw_sw_unit, layer);
+    LV_PROFILER_DRAW_END;
+    return res;
+#elif LV_USE_OS
     uint32_t i;
     uint32_t taken_cnt = 0;
     /* All idle (couldn't take any tasks): return LV_DRAW_UNIT_IDLE;
@@ -341,7 +433,7 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
 
 }
 
-#if LV_USE_OS
+#if LV_USE_OS && !LV_DRAW_SW_WORK_STEALING
 static void render_thread_cb(void * ptr)
 {
     lv_draw_sw_thread_dsc_t * thread_dsc = ptr;
@@ -380,6 +472,284 @@ static void render_thread_cb(void * ptr)
 }
 #endif
 
+#if LV_USE_OS && LV_DRAW_SW_WORK_STEALING
+
+static inline bool thread_is_busy(lv_draw_sw_thread_dsc_t * thread_dsc)
+{
+    return thread_dsc->job_running || thread_dsc->queue_head != thread_dsc->queue_tail;
+}
+
+static int32_t dispatch_work_stealing(lv_draw_sw_unit_t * draw_sw_unit, lv_layer_t * layer)
+{
+    uint32_t i;
+    uint32_t taken_cnt = 0;
+
+    bool all_idle = true;
+    for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
+        if(thread_is_busy(&draw_sw_unit->thread_dscs[i])) {
+            all_idle = false;
+            break;
+        }
+    }
+
+    lv_draw_task_t * t = NULL;
+    for(i = 0; i < draw_sw_unit->thread_cnt; i++) {
+        lv_draw_sw_thread_dsc_t * thread_dsc = &draw_sw_unit->thread_dscs[i];
+
+        /*Threads having jobs in their queue will share them with the others*/
+        if(thread_is_busy(thread_dsc)) continue;
+
+        t = lv_draw_get_next_available_task(layer, t, DRAW_UNIT_ID_SW);
+        if(t == NULL) break;
+
+        void * buf = lv_draw_layer_alloc_buf(layer);
+        if(buf == NULL) continue;
+
+        all_idle = false;
+        taken_cnt++;
+        t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+        queue_task(draw_sw_unit, thread_dsc, t);
+    }
+
+    if(all_idle) return LV_DRAW_UNIT_IDLE;  /*Couldn't start rendering*/
+    else return taken_cnt;
+}
+
+/**
+ * Get in how many row bands a draw task should be rendered
+ * @param draw_sw_unit  the SW draw unit
+ * @param t             the draw task
+ * @param draw_area     store the area to render here
+ * @return              number of row bands, 1 if the task shouldn't be split
+ */
+static uint32_t get_split_cnt(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_task_t * t, lv_area_t * draw_area)
+{
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL: {
+                /*The complex gradients store their state in the draw descriptor while rendering*/
+                lv_draw_fill_dsc_t * draw_dsc = t->draw_dsc;
+                if(draw_dsc->grad.dir >= LV_GRAD_DIR_LINEAR) return 1;
+            }
+            break;
+        case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+            /*Each band would compute the blurred corner mask again, which is the expensive part of the shadow*/
+            return 1;
+        case LV_DRAW_TASK_TYPE_IMAGE: {
+                /*Tiled images don't use the clip area of the task to limit the rendered tiles and
+                 *the transformed images would be sampled slightly differently at the band edges*/
+                lv_draw_image_dsc_t * draw_dsc = t->draw_dsc;
+                if(draw_dsc->tile) return 1;
+                if(draw_dsc->rotation || draw_dsc->skew_x || draw_dsc->skew_y ||
+                   draw_dsc->scale_x != LV_SCALE_NONE || draw_dsc->scale_y != LV_SCALE_NONE) return 1;
+            }
+            break;
+        default:
+            return 1;
+    }
+
+    if(!lv_area_intersect(draw_area, &t->_real_area, &t->clip_area)) return 1;
+
+    int32_t cnt = lv_area_get_height(draw_area) / LV_DRAW_SW_WORK_STEALING_MIN_ROWS;
+    return (uint32_t)LV_CLAMP(1, cnt, (int32_t)draw_sw_unit->thread_cnt);
+}
+
+static void queue_task(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_sw_thread_dsc_t * thread_dsc, lv_draw_task_t * t)
+{
+    lv_area_t draw_area;
+    uint32_t split_cnt = get_split_cnt(draw_sw_unit, t, &draw_area);
+
+    lv_draw_sw_split_t * split = NULL;
+    if(split_cnt > 1) {
+        split = lv_malloc(sizeof(lv_draw_sw_split_t));
+        LV_ASSERT_MALLOC(split);
+        if(split == NULL) split_cnt = 1;
+        else {
+            split->task = t;
+            split->remaining = split_cnt;
+        }
+    }
+
+    lv_mutex_lock(&thread_dsc->queue_lock);
+    if(split_cnt == 1) {
+        thread_dsc->queue[0].task = t;
+        thread_dsc->queue[0].split = NULL;
+        thread_dsc->queue[0].clip_area = t->clip_area;
+    }
+    else {
+        /*Distribute the rows evenly and put the first band to the tail
+         *as the owner starts from there*/
+        int32_t h = lv_area_get_height(&draw_area);
+        int32_t band_cnt = (int32_t)split_cnt;
+        int32_t y = draw_area.y1;
+        int32_t i;
+        for(i = 0; i < band_cnt; i++) {
+            int32_t band_h = h / band_cnt + (i < h % band_cnt ? 1 : 0);
+            lv_draw_sw_job_t * job = &thread_dsc->queue[band_cnt - 1 - i];
+            job->task = t;
+            job->split = split;
+            job->clip_area = t->clip_area;
+            job->clip_area.y1 = y;
+            job->clip_area.y2 = y + band_h - 1;
+            y += band_h;
+        }
+        thread_dsc->stats.split_cnt++;
+    }
+    thread_dsc->queue_head = 0;
+    thread_dsc->queue_tail = split_cnt;
+    lv_mutex_unlock(&thread_dsc->queue_lock);
+
+    /*Let the owner work and wake up the others to steal the remaining row bands*/
+    if(thread_dsc->inited) lv_thread_sync_signal(&thread_dsc->sync);
+    if(split_cnt > 1) {
+        uint32_t i;
+        for(i = 0; i < draw_sw_unit->thread_cnt; i++) {
+            lv_draw_sw_thread_dsc_t * other_dsc = &draw_sw_unit->thread_dscs[i];
+            if(other_dsc != thread_dsc && other_dsc->inited && !thread_is_busy(other_dsc)) {
+                lv_thread_sync_signal(&other_dsc->sync);
+            }
+        }
+    }
+}
+
+/**
+ * Get a job from the thread's own queue or steal one from an other thread
+ * @param draw_sw_unit  the SW draw unit
+ * @param thread_dsc    the thread looking for a job
+ * @param job           store the job here
+ * @return              true: a job was found
+ */
+static bool get_job(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_sw_thread_dsc_t * thread_dsc, lv_draw_sw_job_t * job)
+{
+    lv_mutex_lock(&thread_dsc->queue_lock);
+    if(thread_dsc->queue_head != thread_dsc->queue_tail) {
+        thread_dsc->queue_tail--;
+        *job = thread_dsc->queue[thread_dsc->queue_tail];
+        thread_dsc->job_running = true;
+        lv_mutex_unlock(&thread_dsc->queue_lock);
+        return true;
+    }
+    lv_mutex_unlock(&thread_dsc->queue_lock);
+
+    /*The disabled threads only finish their own jobs*/
+    if(thread_dsc->idx >= draw_sw_unit->thread_cnt) return false;
+
+    /*Start from the next thread so that the thieves don't fight for the same queue*/
+    uint32_t i;
+    for(i = 1; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
+        lv_draw_sw_thread_dsc_t * victim_dsc = &draw_sw_unit->thread_dscs[(thread_dsc->idx + i) %
+                                                                             LV_DRAW_SW_DRAW_UNIT_CNT];
+        if(victim_dsc->queue_head == victim_dsc->queue_tail) continue;
+
+        bool stolen = false;
+        lv_mutex_lock(&victim_dsc->queue_lock);
+        if(victim_dsc->queue_head != victim_dsc->queue_tail) {
+            *job = victim_dsc->queue[victim_dsc->queue_head];
+            victim_dsc->queue_head++;
+            stolen = true;
+        }
+        lv_mutex_unlock(&victim_dsc->queue_lock);
+
+        lv_mutex_lock(&thread_dsc->queue_lock);
+        if(stolen) {
+            thread_dsc->job_running = true;
+            thread_dsc->stats.steal_cnt++;
+        }
+        else {
+            thread_dsc->stats.steal_fail_cnt++;
+        }
+        lv_mutex_unlock(&thread_dsc->queue_lock);
+
+        if(stolen) return true;
+    }
+
+    return false;
+}
+
+static void execute_job(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_sw_thread_dsc_t * thread_dsc,
+                        lv_draw_sw_job_t * job)
+{
+    LV_UNUSED(thread_dsc);  /*Used only for debugging*/
+    lv_draw_task_t * t = job->task;
+
+    if(job->split == NULL) {
+        execute_drawing(t);
+#if LV_USE_PARALLEL_DRAW_DEBUG
+        parallel_debug_draw(t, thread_dsc->idx);
+#endif
+        t->state = LV_DRAW_TASK_STATE_READY;
+    }
+    else {
+        /*Render only the rows of the band with a copy of the task
+         *as the other threads use the original task too*/
+        lv_draw_task_t t_band = *t;
+        t_band.clip_area = job->clip_area;
+        execute_drawing(&t_band);
+#if LV_USE_PARALLEL_DRAW_DEBUG
+        parallel_debug_draw(&t_band, thread_dsc->idx);
+#endif
+
+        lv_mutex_lock(&draw_sw_unit->split_lock);
+        job->split->remaining--;
+        bool last = job->split->remaining == 0;
+        lv_mutex_unlock(&draw_sw_unit->split_lock);
+
+        if(!last) return;
+
+        lv_free(job->split);
+        t->state = LV_DRAW_TASK_STATE_READY;
+    }
+
+    /*A draw task is ready. Request a new dispatching as there might be new independent tasks*/
+    lv_draw_dispatch_request();
+}
+
+static void render_thread_work_stealing_cb(void * ptr)
+{
+    lv_draw_sw_thread_dsc_t * thread_dsc = ptr;
+    lv_draw_sw_unit_t * draw_sw_unit = (lv_draw_sw_unit_t *) thread_dsc->draw_unit;
+
+    lv_thread_sync_init(&thread_dsc->sync);
+    thread_dsc->inited = true;
+
+    while(1) {
+        lv_draw_sw_job_t job;
+        if(get_job(draw_sw_unit, thread_dsc, &job)) {
+            uint32_t t_start = lv_tick_get();
+            execute_job(draw_sw_unit, thread_dsc, &job);
+            uint32_t busy_time = lv_tick_elaps(t_start);
+
+            lv_mutex_lock(&thread_dsc->queue_lock);
+            thread_dsc->job_running = false;
+            thread_dsc->stats.job_cnt++;
+            thread_dsc->stats.busy_time += busy_time;
+            lv_mutex_unlock(&thread_dsc->queue_lock);
+            continue;
+        }
+
+        if(thread_dsc->exit_status) break;
+
+        /*Nothing to do. Ask for new draw tasks and wait until a job is queued*/
+        lv_draw_dispatch_request();
+
+        uint32_t t_start = lv_tick_get();
+        lv_thread_sync_wait(&thread_dsc->sync);
+        uint32_t idle_time = lv_tick_elaps(t_start);
+
+        lv_mutex_lock(&thread_dsc->queue_lock);
+        thread_dsc->stats.idle_time += idle_time;
+        lv_mutex_unlock(&thread_dsc->queue_lock);
+
+        if(thread_dsc->exit_status) break;
+    }
+
+    LV_LOG_INFO("ready to exit software rendering thread");
+    thread_dsc->inited = false;
+    lv_thread_sync_delete(&thread_dsc->sync);
+    LV_LOG_INFO("exit software rendering thread");
+}
+
+#endif /*LV_USE_OS && LV_DRAW_SW_WORK_STEALING*/
+
 static void execute_drawing(lv_draw_task_t * t)
 {
     LV_PROFILER_DRAW_BEGIN;
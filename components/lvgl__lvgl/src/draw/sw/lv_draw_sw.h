@@ -34,6 +34,22 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_USE_OS && LV_DRAW_SW_WORK_STEALING
+/** Load balancing statistics of a SW render thread*/
+typedef struct {
+    uint32_t job_cnt;           /**< Number of rendered jobs (draw tasks or row bands of them)*/
+    uint32_t split_cnt;         /**< Number of draw tasks split into row bands by this thread's queue*/
+    uint32_t steal_cnt;         /**< Number of jobs stolen from other threads*/
+    uint32_t steal_fail_cnt;    /**< Number of times a non-empty queue was emptied by an other thread before the steal*/
+    uint32_t busy_time;         /**< Time spent with rendering [ms]*/
+    uint32_t idle_time;         /**< Time spent with waiting for jobs [ms]*/
+} lv_draw_sw_thread_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -181,6 +197,28 @@ bool lv_draw_sw_unregister_blend_handler(lv_color_format_t dest_cf);
  */
 lv_draw_sw_blend_handler_t lv_draw_sw_get_blend_handler(lv_color_format_t dest_cf);
 
+#if LV_USE_OS && LV_DRAW_SW_WORK_STEALING
+/**
+ * Get the load balancing statistics of a SW render thread
+ * @param idx       index of the render thread, `0 .. LV_DRAW_SW_DRAW_UNIT_CNT - 1`
+ * @param stats     store the statistics here
+ * @return          LV_RESULT_OK: `stats` is filled; LV_RESULT_INVALID: invalid index or the SW renderer is not initialized
+ */
+lv_result_t lv_draw_sw_get_thread_stats(uint32_t idx, lv_draw_sw_thread_stats_t * stats);
+
+/**
+ * Set how many of the `LV_DRAW_SW_DRAW_UNIT_CNT` render threads take draw tasks, e.g. to measure the scaling.
+ * Should be called when nothing is being rendered.
+ * @param cnt       number of render threads, clamped to `1 .. LV_DRAW_SW_DRAW_UNIT_CNT`
+ */
+void lv_draw_sw_set_thread_cnt(uint32_t cnt);
+
+/**
+ * Clear the load balancing statistics of all SW render threads
+ */
+void lv_draw_sw_reset_thread_stats(void);
+#endif
+
 /***********************
  * GLOBAL VARIABLES
  ***********************/
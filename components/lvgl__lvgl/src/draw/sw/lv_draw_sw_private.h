@@ -31,6 +31,21 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_OS && LV_DRAW_SW_WORK_STEALING
+/** Shared by the row bands of a split draw task to know when the task is ready*/
+typedef struct {
+    lv_draw_task_t * task;
+    volatile uint32_t remaining;    /**< Number of row bands not rendered yet. Protected by `split_lock`*/
+} lv_draw_sw_split_t;
+
+/** A part of a draw task which can be rendered by any render thread*/
+typedef struct {
+    lv_draw_task_t * task;
+    lv_draw_sw_split_t * split;     /**< NULL if the task was not split*/
+    lv_area_t clip_area;            /**< The rows to render if the task was split*/
+} lv_draw_sw_job_t;
+#endif
+
 typedef struct {
     lv_draw_task_t * task_act;
     lv_thread_t thread;
@@ -39,12 +54,26 @@ typedef struct {
     uint32_t idx;
     volatile bool inited;
     volatile bool exit_status;
+#if LV_USE_OS && LV_DRAW_SW_WORK_STEALING
+    /* The owner thread pops jobs from the tail and other threads steal from the head.
+     * Jobs are added only when the queue is empty, so a simple array is enough.*/
+    lv_mutex_t queue_lock;
+    lv_draw_sw_job_t queue[LV_DRAW_SW_DRAW_UNIT_CNT];
+    volatile uint32_t queue_head;
+    volatile uint32_t queue_tail;
+    volatile bool job_running;
+    lv_draw_sw_thread_stats_t stats;
+#endif
 } lv_draw_sw_thread_dsc_t;
 
 struct _lv_draw_sw_unit_t {
     lv_draw_unit_t base_unit;
 #if LV_USE_OS
     lv_draw_sw_thread_dsc_t thread_dscs[LV_DRAW_SW_DRAW_UNIT_CNT];
+#if LV_DRAW_SW_WORK_STEALING
+    lv_mutex_t split_lock;
+    volatile uint32_t thread_cnt;   /**< Number of threads taking draw tasks. See `lv_draw_sw_set_thread_cnt()`*/
+#endif
 #else
     lv_draw_task_t * task_act;
 #endif
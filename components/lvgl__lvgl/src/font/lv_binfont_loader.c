@@ -22,6 +22,12 @@ typedef struct {
     uint8_t byte_value;
 } bit_iterator_t;
 
+typedef struct {
+    lv_font_t font;         /*Must be the first to free it as a font*/
+    lv_fs_file_t file;      /*Kept open while the glyph bitmaps are used from the file mapped to the memory*/
+    bool glyphs_mapped;
+} binfont_t;
+
 typedef struct font_header_bin {
     uint32_t version;
     uint16_t tables_count;
@@ -63,7 +69,7 @@ typedef struct cmap_table_bin {
  *  STATIC PROTOTYPES
  **********************/
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool * glyphs_mapped);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
@@ -97,14 +103,32 @@ lv_font_t * lv_binfont_create(const char * path)
 {
     LV_ASSERT_NULL(path);
 
-    lv_fs_file_t file;
-    lv_fs_res_t fs_res = lv_fs_open(&file, path, LV_FS_MODE_RD);
-    if(fs_res != LV_FS_RES_OK) return NULL;
+    lv_mem_tag_t mem_tag_prev;
+    LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_FONT, mem_tag_prev);
+    binfont_t * binfont = lv_malloc_zeroed(sizeof(binfont_t));
+    LV_ASSERT_MALLOC(binfont);
+    if(binfont == NULL) {
+        LV_MEM_STATS_TAG_END(mem_tag_prev);
+        return NULL;
+    }
+
+    lv_fs_res_t fs_res = lv_fs_open(&binfont->file, path, LV_FS_MODE_RD);
+    if(fs_res != LV_FS_RES_OK) {
+        lv_free(binfont);
+        LV_MEM_STATS_TAG_END(mem_tag_prev);
+        return NULL;
+    }
+
+    /*If the file can be mapped to the memory the driver might read it from there too*/
+    lv_fs_get_mapped_ptr(&binfont->file, NULL);
 
-    lv_font_t * font = lv_malloc_zeroed(sizeof(lv_font_t));
-    LV_ASSERT_MALLOC(font);
+    lv_font_t * font = &binfont->font;
+    bool loaded = lvgl_load_font(&binfont->file, font, &binfont->glyphs_mapped);
 
-    if(!lvgl_load_font(&file, font)) {
+    /*Else `lv_binfont_destroy` closes it*/
+    if(!binfont->glyphs_mapped) lv_fs_close(&binfont->file);
+
+    if(!loaded) {
         LV_LOG_WARN("Error loading font file: %s", path);
         /*
         * When `lvgl_load_font` fails it can leak some pointers.
@@ -115,7 +139,11 @@ lv_font_t * lv_binfont_create(const char * path)
         font = NULL;
     }
 
-    lv_fs_close(&file);
+#if LV_FONT_FMT_TXT_LOOKUP_TABLE
+    /*The font is used as it is if the tables can't be created*/
+    if(font) lv_font_fmt_txt_lookup_create(font);
+#endif
+    LV_MEM_STATS_TAG_END(mem_tag_prev);
 
     return font;
 }
@@ -137,6 +165,14 @@ void lv_binfont_destroy(lv_font_t * font)
     const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
     if(dsc == NULL) return;
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+    lv_font_fmt_txt_cache_drop(font);
+#endif
+
+#if LV_FONT_FMT_TXT_LOOKUP_TABLE
+    lv_font_fmt_txt_lookup_delete(font);
+#endif
+
     if(dsc->kern_classes == 0) {
         const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
         if(NULL != kern_dsc) {
@@ -164,7 +200,10 @@ void lv_binfont_destroy(lv_font_t * font)
         lv_free((void *)cmaps);
     }
 
-    lv_free((void *)dsc->glyph_bitmap);
+    binfont_t * binfont = (binfont_t *)font;
+    if(binfont->glyphs_mapped) lv_fs_close(&binfont->file); /*The bitmaps are in the mapped file*/
+    else lv_free((void *)dsc->glyph_bitmap);
+
     lv_free((void *)dsc->glyph_dsc);
     lv_free((void *)dsc);
     lv_free(font);
@@ -328,13 +367,25 @@ static int32_t load_cmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, u
 }
 
 static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
-                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header)
+                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header,
+                          bool * glyphs_mapped)
 {
     int32_t glyph_length = read_label(fp, start, "glyf");
     if(glyph_length < 0) {
         return -1;
     }
 
+    /*If the file is mapped to the memory and the bitmaps start on whole bytes they can be used from the file.
+     *It's not done for buffers as they might be freed after loading.*/
+    const uint8_t * map = NULL;
+    uint32_t map_size = 0;
+    int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+    if(nbits % 8 == 0 && fp->drv->cache_size != LV_FS_CACHE_FROM_BUFFER) {
+        map = lv_fs_get_mapped_ptr(fp, &map_size);
+        /*`bitmap_index` has 20 bits*/
+        if(map && (start + glyph_length > map_size || glyph_length >= (1 << 20))) map = NULL;
+    }
+
     lv_font_fmt_txt_glyph_dsc_t * glyph_dsc = (lv_font_fmt_txt_glyph_dsc_t *)
                                               lv_malloc(loca_count * sizeof(lv_font_fmt_txt_glyph_dsc_t));
 
@@ -388,7 +439,6 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
             return -1;
         }
 
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
         int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
         int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
 
@@ -400,12 +450,18 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
             gdsc->ofs_y = 0;
         }
 
-        gdsc->bitmap_index = cur_bmp_size;
+        gdsc->bitmap_index = map ? glyph_offset[i] + nbits / 8 : (uint32_t)cur_bmp_size;
         if(gdsc->box_w * gdsc->box_h != 0) {
             cur_bmp_size += bmp_size;
         }
     }
 
+    if(map) {
+        font_dsc->glyph_bitmap = map + start;
+        *glyphs_mapped = true;
+        return glyph_length;
+    }
+
     uint8_t * glyph_bmp = (uint8_t *)lv_malloc(sizeof(uint8_t) * cur_bmp_size);
 
     font_dsc->glyph_bitmap = glyph_bmp;
@@ -419,8 +475,6 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         }
         bit_iterator_t bit_it = init_bit_iterator(fp);
 
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
-
         read_bits(&bit_it, nbits, &res);
         if(res != LV_FS_RES_OK) {
             return -1;
@@ -472,7 +526,7 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  * `lv_binfont_destroy` will assume that all non-null pointers are allocated and
  * should be freed.
  */
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool * glyphs_mapped)
 {
     lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
                                        lv_malloc(sizeof(lv_font_fmt_txt_dsc_t));
@@ -554,7 +608,7 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
     /*glyph*/
     uint32_t glyph_start = loca_start + loca_length;
     int32_t glyph_length = load_glyph(
-                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
+                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header, glyphs_mapped);
 
     lv_free(glyph_offset);
 
@@ -37,7 +37,9 @@ LV_ATTRIBUTE_EXTERN_DATA extern const lv_font_class_t lv_binfont_font_class;
  **********************/
 
 /**
- * Loads a `lv_font_t` object from a binary font file
+ * Loads a `lv_font_t` object from a binary font file.
+ * If the file can be mapped to the memory (see `lv_fs_get_mapped_ptr`) and the glyph bitmaps
+ * start on whole bytes, they are used from the file which remains open until `lv_binfont_destroy`.
  * @param path   path to font file
  * @return  pointer to font where to load
  */
@@ -13,15 +13,27 @@
 #include "../misc/lv_types.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
+#include "../misc/lv_text_private.h"
+#include "../misc/cache/lv_cache.h"
+#include "../misc/cache/lv_cache_private.h"
 #include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
 
 /*********************
  *      DEFINES
  *********************/
 #if LV_USE_FONT_COMPRESSED
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
+    #if LV_FONT_FMT_TXT_CACHE_SIZE > 0
+        #define glyph_cache LV_GLOBAL_DEFAULT()->font_fmt_txt_cache
+    #endif
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_LOOKUP_TABLE
+    /*Don't create kerning class tables larger than this [bytes], search in the kerning pairs instead*/
+    #define LOOKUP_KERN_CLASS_VALUES_MAX_SIZE   (16 * 1024)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -30,11 +42,27 @@ typedef struct {
     uint32_t gid_right;
 } kern_pair_ref_t;
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    /*The key*/
+    const lv_font_t * font;
+    uint32_t gid;
+    uint8_t bpp;
+
+    /*The decompressed A8 bitmap with the stride of the draw buffers*/
+    uint8_t * bitmap;
+} glyph_cache_data_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t search_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
+static int8_t get_kern_class_value(const lv_font_fmt_txt_kern_classes_t * kdsc, uint32_t gid_left, uint32_t gid_right);
 static int unicode_list_compare(const void * ref, const void * element);
 static int kern_pair_8_compare(const void * ref, const void * element);
 static int kern_pair_16_compare(const void * ref, const void * element);
@@ -47,6 +75,23 @@ static int kern_pair_16_compare(const void * ref, const void * element);
     static inline uint8_t rle_next(void);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+    static lv_cache_entry_t * glyph_cache_acquire(const lv_font_t * font, uint32_t gid);
+    static bool glyph_cache_create_cb(glyph_cache_data_t * node, void * user_data);
+    static void glyph_cache_free_cb(glyph_cache_data_t * node, void * user_data);
+    static lv_cache_compare_res_t glyph_cache_compare_cb(const glyph_cache_data_t * lhs, const glyph_cache_data_t * rhs);
+#endif
+
+#if (LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0) || LV_FONT_FMT_TXT_LOOKUP_TABLE
+    static uint32_t get_glyph_cnt(const lv_font_fmt_txt_dsc_t * fdsc);
+#endif
+
+#if LV_FONT_FMT_TXT_LOOKUP_TABLE
+    static bool lookup_create_glyph_ids(lv_font_fmt_txt_lookup_t * lookup, const lv_font_fmt_txt_dsc_t * fdsc);
+    static bool lookup_create_kern_classes(lv_font_fmt_txt_lookup_t * lookup, const lv_font_fmt_txt_dsc_t * fdsc);
+    static void lookup_free(lv_font_fmt_txt_lookup_t * lookup);
+#endif
+
 static lv_font_t * builtin_font_create_cb(const lv_font_info_t * info, const void * src);
 static void builtin_font_delete_cb(lv_font_t * font);
 static void * builtin_font_dup_src_cb(const void * src);
@@ -203,6 +248,17 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
+#if LV_FONT_FMT_TXT_CACHE_SIZE > 0
+        /*Copy the already decompressed bitmap if possible*/
+        lv_cache_entry_t * entry = glyph_cache_acquire(font, gid);
+        if(entry) {
+            glyph_cache_data_t * cached = lv_cache_entry_get_data(entry);
+            lv_memcpy(bitmap_out, cached->bitmap, lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8) * gdsc->box_h);
+            lv_cache_release(glyph_cache.cache, entry, NULL);
+            lv_draw_buf_flush_cache(draw_buf, NULL);
+            return draw_buf;
+        }
+#endif
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
         decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap_out, gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
@@ -271,15 +327,192 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+#if LV_FONT_FMT_TXT_LOOKUP_TABLE
+
+lv_result_t lv_font_fmt_txt_lookup_create(lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+
+    if(font->get_glyph_dsc != lv_font_get_glyph_dsc_fmt_txt) return LV_RESULT_INVALID;
+
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    if(fdsc->lookup) return LV_RESULT_OK;
+
+    lv_font_fmt_txt_lookup_t * lookup = lv_malloc_zeroed(sizeof(lv_font_fmt_txt_lookup_t));
+    LV_ASSERT_MALLOC(lookup);
+    if(lookup == NULL) return LV_RESULT_INVALID;
+
+    lv_mem_tag_t mem_tag_prev;
+    LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_FONT, mem_tag_prev);
+    bool created = lookup_create_glyph_ids(lookup, fdsc) && lookup_create_kern_classes(lookup, fdsc);
+    LV_MEM_STATS_TAG_END(mem_tag_prev);
+    if(!created) {
+        lookup_free(lookup);
+        lv_free(lookup);
+        return LV_RESULT_INVALID;
+    }
+
+    /*Set it only when it's complete, the font might be used by other threads*/
+    fdsc->lookup = lookup;
+
+    return LV_RESULT_OK;
+}
+
+void lv_font_fmt_txt_lookup_delete(lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+
+    if(font->get_glyph_dsc != lv_font_get_glyph_dsc_fmt_txt) return;
+
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    if(fdsc->lookup == NULL) return;
+
+    lookup_free(fdsc->lookup);
+    lv_free(fdsc->lookup);
+    fdsc->lookup = NULL;
+}
+
+#endif /*LV_FONT_FMT_TXT_LOOKUP_TABLE*/
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+
+uint32_t lv_font_fmt_txt_cache_warm_up(const lv_font_t * font, const char * charset)
+{
+    LV_ASSERT_NULL(font);
+    LV_ASSERT_NULL(charset);
+
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    if(font->get_glyph_bitmap != lv_font_get_bitmap_fmt_txt) return 0;
+    if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) return 0;
+
+    uint32_t cnt = 0;
+    uint32_t i = 0;
+    while(charset[i] != '\0') {
+        uint32_t letter = lv_text_encoded_next(charset, &i);
+        uint32_t gid = get_glyph_dsc_id(font, letter);
+        if(gid == 0) continue;
+
+        lv_cache_entry_t * entry = glyph_cache_acquire(font, gid);
+        if(entry) {
+            lv_cache_release(glyph_cache.cache, entry, NULL);
+            cnt++;
+        }
+    }
+
+    return cnt;
+}
+
+void lv_font_fmt_txt_cache_drop(const lv_font_t * font)
+{
+    if(glyph_cache.cache == NULL) return;
+
+    if(font == NULL) {
+        lv_cache_drop_all(glyph_cache.cache, NULL);
+        return;
+    }
+
+    /*Only the compressed fonts are cached*/
+    if(font->get_glyph_bitmap != lv_font_get_bitmap_fmt_txt) return;
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) return;
+
+    /*Drop the glyphs one by one as the cache is ordered by the font, glyph ID and bpp*/
+    uint32_t gid_max = get_glyph_cnt(fdsc);
+
+    glyph_cache_data_t key;
+    lv_memzero(&key, sizeof(key));
+    key.font = font;
+    key.bpp = (uint8_t)fdsc->bpp;
+    for(key.gid = 1; key.gid < gid_max; key.gid++) {
+        lv_cache_drop(glyph_cache.cache, &key, NULL);
+    }
+}
+
+void lv_font_fmt_txt_cache_resize(uint32_t size)
+{
+    if(glyph_cache.cache == NULL) return;
+
+    lv_cache_set_max_size(glyph_cache.cache, size, NULL);
+    lv_cache_reserve(glyph_cache.cache, 0, NULL);
+}
+
+void lv_font_fmt_txt_cache_get_info(lv_font_fmt_txt_cache_info_t * info)
+{
+    LV_ASSERT_NULL(info);
+
+    lv_memzero(info, sizeof(lv_font_fmt_txt_cache_info_t));
+    lv_mutex_lock(&glyph_cache.stats_lock);
+    info->miss_cnt = glyph_cache.miss_cnt;
+    info->hit_cnt = glyph_cache.hit_cnt;
+    lv_mutex_unlock(&glyph_cache.stats_lock);
+    if(glyph_cache.cache) {
+        info->size = lv_cache_get_size(glyph_cache.cache, NULL);
+        info->max_size = lv_cache_get_max_size(glyph_cache.cache, NULL);
+    }
+    else {
+        info->max_size = LV_FONT_FMT_TXT_CACHE_SIZE;
+    }
+}
+
+void lv_font_fmt_txt_cache_init(void)
+{
+    lv_mutex_init(&glyph_cache.stats_lock);
+
+    glyph_cache.cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(glyph_cache_data_t),
+                                        LV_FONT_FMT_TXT_CACHE_SIZE,
+    (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t)glyph_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)glyph_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)glyph_cache_free_cb,
+    });
+    if(glyph_cache.cache == NULL) {
+        LV_LOG_WARN("Couldn't create the glyph cache, the glyphs are decompressed on each draw");
+        return;
+    }
+
+    lv_cache_set_name(glyph_cache.cache, "FONT_FMT_TXT");
+}
+
+void lv_font_fmt_txt_cache_deinit(void)
+{
+    if(glyph_cache.cache) lv_cache_destroy(glyph_cache.cache, NULL);
+    lv_mutex_delete(&glyph_cache.stats_lock);
+    lv_memzero(&glyph_cache, sizeof(glyph_cache));
+}
+
+#endif /*LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
-    if(letter == '\0') return 0;
+#if LV_FONT_FMT_TXT_LOOKUP_TABLE
+    const lv_font_fmt_txt_lookup_t * lookup = ((const lv_font_fmt_txt_dsc_t *)font->dsc)->lookup;
+    if(lookup) {
+        uint32_t page = letter >> 8;
+        if(page >= lookup->page_cnt) return 0;
 
-    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+        uint32_t page_idx = lookup->page_map[page];
+        if(page_idx == 0) return 0;
+
+        return lookup->pages[(page_idx - 1) * 256 + (letter & 0xFF)];
+    }
+#endif
+
+    return search_glyph_dsc_id(font->dsc, letter);
+}
+
+/**
+ * Find the glyph ID of a letter in the character maps of a font
+ * @param fdsc      the font's descriptor
+ * @param letter    a UNICODE letter
+ * @return          the glyph ID or 0 if the letter is not in the font
+ */
+static uint32_t search_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
+    if(letter == '\0') return 0;
 
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
@@ -332,6 +565,16 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+#if LV_FONT_FMT_TXT_LOOKUP_TABLE
+    /*Use the kerning classes made from the pairs instead of searching*/
+    if(fdsc->kern_classes == 0) {
+        const lv_font_fmt_txt_lookup_t * lookup = fdsc->lookup;
+        if(lookup && lookup->kern_classes.class_pair_values) {
+            return get_kern_class_value(&lookup->kern_classes, gid_left, gid_right);
+        }
+    }
+#endif
+
     int8_t value = 0;
 
     if(fdsc->kern_classes == 0) {
@@ -370,20 +613,25 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     }
     else {
         /*Kern classes*/
-        const lv_font_fmt_txt_kern_classes_t * kdsc = fdsc->kern_dsc;
-        uint8_t left_class = kdsc->left_class_mapping[gid_left];
-        uint8_t right_class = kdsc->right_class_mapping[gid_right];
-
-        /*If class = 0, kerning not exist for that glyph
-         *else got the value form `class_pair_values` 2D array*/
-        if(left_class > 0 && right_class > 0) {
-            value = kdsc->class_pair_values[(left_class - 1) * kdsc->right_class_cnt + (right_class - 1)];
-        }
-
+        value = get_kern_class_value(fdsc->kern_dsc, gid_left, gid_right);
     }
     return value;
 }
 
+static int8_t get_kern_class_value(const lv_font_fmt_txt_kern_classes_t * kdsc, uint32_t gid_left, uint32_t gid_right)
+{
+    uint8_t left_class = kdsc->left_class_mapping[gid_left];
+    uint8_t right_class = kdsc->right_class_mapping[gid_right];
+
+    /*If class = 0, kerning not exist for that glyph
+     *else got the value form `class_pair_values` 2D array*/
+    if(left_class > 0 && right_class > 0) {
+        return kdsc->class_pair_values[(left_class - 1) * kdsc->right_class_cnt + (right_class - 1)];
+    }
+
+    return 0;
+}
+
 static int kern_pair_8_compare(const void * ref, const void * element)
 {
     const kern_pair_ref_t * ref8_p = ref;
@@ -599,8 +847,273 @@ static inline uint8_t rle_next(void)
 
     return ret;
 }
+
+#if LV_FONT_FMT_TXT_CACHE_SIZE > 0
+
+/**
+ * Get the decompressed bitmap of a glyph from the cache or decompress and add it
+ * @param font      pointer to a font with compressed bitmaps
+ * @param gid       the glyph ID
+ * @return          the acquired cache entry or NULL if it couldn't be cached
+ */
+static lv_cache_entry_t * glyph_cache_acquire(const lv_font_t * font, uint32_t gid)
+{
+    if(glyph_cache.cache == NULL) return NULL;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    if(gdsc->box_w == 0 || gdsc->box_h == 0) return NULL;
+
+    glyph_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.font = font;
+    search_key.gid = gid;
+    search_key.bpp = (uint8_t)fdsc->bpp;
+    /*The size is needed to evict enough glyphs before the new one is created*/
+    search_key.slot.size = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8) * gdsc->box_h;
+
+    bool created = false;
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(glyph_cache.cache, &search_key, &created);
+    if(entry) {
+        lv_mutex_lock(&glyph_cache.stats_lock);
+        if(created) glyph_cache.miss_cnt++;
+        else glyph_cache.hit_cnt++;
+        lv_mutex_unlock(&glyph_cache.stats_lock);
+    }
+
+    return entry;
+}
+
+static bool glyph_cache_create_cb(glyph_cache_data_t * node, void * user_data)
+{
+    bool * created = user_data;
+    *created = true;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = node->font->dsc;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[node->gid];
+
+    lv_mem_tag_t mem_tag_prev;
+    LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_FONT, mem_tag_prev);
+    node->bitmap = lv_malloc_zeroed(node->slot.size); /*Zero the padding at the end of the lines too*/
+    LV_MEM_STATS_TAG_END(mem_tag_prev);
+    LV_ASSERT_MALLOC(node->bitmap);
+    if(node->bitmap == NULL) return false;
+
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED;
+    decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], node->bitmap, gdsc->box_w, gdsc->box_h,
+               (uint8_t)fdsc->bpp, prefilter);
+    return true;
+}
+
+static void glyph_cache_free_cb(glyph_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(node->bitmap);
+    node->bitmap = NULL;
+}
+
+static lv_cache_compare_res_t glyph_cache_compare_cb(const glyph_cache_data_t * lhs, const glyph_cache_data_t * rhs)
+{
+    if(lhs->font != rhs->font) return lhs->font > rhs->font ? 1 : -1;
+    if(lhs->gid != rhs->gid) return lhs->gid > rhs->gid ? 1 : -1;
+    if(lhs->bpp != rhs->bpp) return lhs->bpp > rhs->bpp ? 1 : -1;
+
+    return 0;
+}
+
+#endif /*LV_FONT_FMT_TXT_CACHE_SIZE > 0*/
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if (LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0) || LV_FONT_FMT_TXT_LOOKUP_TABLE
+
+/**
+ * Get the number of glyphs of a font from its character maps
+ * @param fdsc      the font's descriptor
+ * @return          the largest glyph ID + 1
+ */
+static uint32_t get_glyph_cnt(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    uint32_t gid_max = 0;
+    uint16_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        uint32_t cnt;
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) cnt = cmap->range_length;
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) cnt = 256; /*The offsets are stored on 8 bits*/
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) cnt = cmap->list_length;
+        else {
+            /*The offsets are not ordered, look for the largest*/
+            const uint16_t * gid_ofs_16 = cmap->glyph_id_ofs_list;
+            uint32_t j;
+            cnt = 0;
+            for(j = 0; j < cmap->list_length; j++) cnt = LV_MAX(cnt, (uint32_t)gid_ofs_16[j] + 1);
+        }
+        gid_max = LV_MAX(gid_max, cmap->glyph_id_start + cnt);
+    }
+
+    return gid_max;
+}
+
+#endif
+
+#if LV_FONT_FMT_TXT_LOOKUP_TABLE
+
+/**
+ * Create a two level table to get the glyph ID of letters:
+ * the upper bits of the letter select a page, the lower 8 bits the glyph ID on the page.
+ * Only the pages with glyphs are allocated.
+ * @param lookup    the lookup tables to initialize
+ * @param fdsc      the font's descriptor
+ * @return          true: success; false: out of memory or the glyph IDs are too large
+ */
+static bool lookup_create_glyph_ids(lv_font_fmt_txt_lookup_t * lookup, const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    uint32_t letter_max = 0;
+    uint16_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(cmap->range_length) letter_max = LV_MAX(letter_max, cmap->range_start + cmap->range_length - 1);
+    }
+
+    lookup->page_cnt = (letter_max >> 8) + 1;
+    lookup->page_map = lv_malloc_zeroed(lookup->page_cnt * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(lookup->page_map);
+    if(lookup->page_map == NULL) return false;
+
+    /*Number the pages which might have glyphs*/
+    uint32_t used_page_cnt = 0;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(cmap->range_length == 0) continue;
+
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY || cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+            uint32_t j;
+            for(j = 0; j < cmap->list_length; j++) {
+                uint32_t page = (cmap->range_start + cmap->unicode_list[j]) >> 8;
+                if(lookup->page_map[page] == 0) lookup->page_map[page] = ++used_page_cnt;
+            }
+        }
+        else {
+            uint32_t page;
+            uint32_t page_last = (cmap->range_start + cmap->range_length - 1) >> 8;
+            for(page = cmap->range_start >> 8; page <= page_last; page++) {
+                if(lookup->page_map[page] == 0) lookup->page_map[page] = ++used_page_cnt;
+            }
+        }
+    }
+
+    lookup->pages = lv_malloc(used_page_cnt * 256 * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(lookup->pages);
+    if(lookup->pages == NULL) return false;
+
+    /*Search the glyphs of all letters on the used pages once.
+     *This way the tables give the same result as the character maps, even if the maps overlap.*/
+    uint32_t page;
+    for(page = 0; page < lookup->page_cnt; page++) {
+        if(lookup->page_map[page] == 0) continue;
+
+        uint16_t * page_gids = &lookup->pages[(lookup->page_map[page] - 1) * 256];
+        uint32_t j;
+        for(j = 0; j < 256; j++) {
+            uint32_t gid = search_glyph_dsc_id(fdsc, (page << 8) + j);
+            if(gid > UINT16_MAX) return false;
+            page_gids[j] = (uint16_t)gid;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Convert the kerning pairs of a font to kerning classes, to get the kerning values by indexing instead of searching.
+ * Each glyph which appears in a pair gets its own class.
+ * If there are too many glyphs in the pairs, the pairs are used as they are.
+ * @param lookup    the lookup tables to initialize
+ * @param fdsc      the font's descriptor
+ * @return          true: success, even if the classes were not created; false: out of memory
+ */
+static bool lookup_create_kern_classes(lv_font_fmt_txt_lookup_t * lookup, const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    /*Kerning classes can be already used directly*/
+    if(fdsc->kern_dsc == NULL || fdsc->kern_classes) return true;
+
+    const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
+    if(kdsc->pair_cnt == 0 || kdsc->glyph_ids_size > 1) return true;
+
+    uint32_t glyph_cnt = get_glyph_cnt(fdsc);
+    uint8_t * left_class_mapping = lv_malloc_zeroed(glyph_cnt);
+    uint8_t * right_class_mapping = lv_malloc_zeroed(glyph_cnt);
+    LV_ASSERT_MALLOC(left_class_mapping);
+    LV_ASSERT_MALLOC(right_class_mapping);
+    if(left_class_mapping == NULL || right_class_mapping == NULL) {
+        lv_free(left_class_mapping);
+        lv_free(right_class_mapping);
+        return false;
+    }
+
+    const uint8_t * gids_8 = kdsc->glyph_ids;
+    const uint16_t * gids_16 = kdsc->glyph_ids;
+    uint32_t left_class_cnt = 0;
+    uint32_t right_class_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < kdsc->pair_cnt; i++) {
+        uint32_t gid_left = kdsc->glyph_ids_size == 0 ? gids_8[i * 2] : gids_16[i * 2];
+        uint32_t gid_right = kdsc->glyph_ids_size == 0 ? gids_8[i * 2 + 1] : gids_16[i * 2 + 1];
+        if(gid_left >= glyph_cnt || gid_right >= glyph_cnt) break;
+
+        if(left_class_mapping[gid_left] == 0) {
+            if(left_class_cnt == UINT8_MAX) break;
+            left_class_mapping[gid_left] = ++left_class_cnt;
+        }
+
+        if(right_class_mapping[gid_right] == 0) {
+            if(right_class_cnt == UINT8_MAX) break;
+            right_class_mapping[gid_right] = ++right_class_cnt;
+        }
+    }
+
+    bool use_classes = i == kdsc->pair_cnt && left_class_cnt * right_class_cnt <= LOOKUP_KERN_CLASS_VALUES_MAX_SIZE;
+    int8_t * class_pair_values = NULL;
+    if(use_classes) {
+        class_pair_values = lv_malloc_zeroed(left_class_cnt * right_class_cnt);
+        LV_ASSERT_MALLOC(class_pair_values);
+    }
+
+    if(class_pair_values == NULL) {
+        lv_free(left_class_mapping);
+        lv_free(right_class_mapping);
+        /*Only running out of memory is an error*/
+        return !use_classes;
+    }
+
+    for(i = 0; i < kdsc->pair_cnt; i++) {
+        uint32_t gid_left = kdsc->glyph_ids_size == 0 ? gids_8[i * 2] : gids_16[i * 2];
+        uint32_t gid_right = kdsc->glyph_ids_size == 0 ? gids_8[i * 2 + 1] : gids_16[i * 2 + 1];
+        uint32_t idx = (left_class_mapping[gid_left] - 1) * right_class_cnt + (right_class_mapping[gid_right] - 1);
+        class_pair_values[idx] = kdsc->values[i];
+    }
+
+    lookup->kern_classes.class_pair_values = class_pair_values;
+    lookup->kern_classes.left_class_mapping = left_class_mapping;
+    lookup->kern_classes.right_class_mapping = right_class_mapping;
+    lookup->kern_classes.left_class_cnt = (uint8_t)left_class_cnt;
+    lookup->kern_classes.right_class_cnt = (uint8_t)right_class_cnt;
+
+    return true;
+}
+
+static void lookup_free(lv_font_fmt_txt_lookup_t * lookup)
+{
+    lv_free(lookup->page_map);
+    lv_free(lookup->pages);
+    lv_free((void *)lookup->kern_classes.class_pair_values);
+    lv_free((void *)lookup->kern_classes.left_class_mapping);
+    lv_free((void *)lookup->kern_classes.right_class_mapping);
+}
+
+#endif /*LV_FONT_FMT_TXT_LOOKUP_TABLE*/
+
 /** Code Comparator.
  *
  *  Compares the value of both input arguments.
@@ -191,6 +191,12 @@ typedef struct {
      * 4, 8, 16, 32, 64: each line is padded to the given byte boundaries
      */
     uint8_t stride;
+
+#if LV_FONT_FMT_TXT_LOOKUP_TABLE
+    /** Tables to find the glyphs and the kerning values without searching,
+     * set by `lv_font_fmt_txt_lookup_create`. `NULL` if not created.*/
+    lv_font_fmt_txt_lookup_t * lookup;
+#endif
 } lv_font_fmt_txt_dsc_t;
 
 typedef struct {
@@ -200,6 +206,16 @@ typedef struct {
 
 LV_ATTRIBUTE_EXTERN_DATA extern const lv_font_class_t lv_builtin_font_class;
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+/** Statistics of the decompressed glyph bitmap cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of glyph bitmaps found in the cache*/
+    uint32_t miss_cnt;      /**< Number of glyph bitmaps decompressed into the cache*/
+    uint32_t size;          /**< The current size of the cached bitmaps in bytes*/
+    uint32_t max_size;      /**< The maximal size of the cached bitmaps in bytes*/
+} lv_font_fmt_txt_cache_info_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -224,6 +240,60 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+#if LV_FONT_FMT_TXT_LOOKUP_TABLE
+
+/**
+ * Create tables to get the glyph IDs of letters and the kerning values in constant time,
+ * instead of searching in the character maps and the kerning pairs.
+ * Useful for fonts with many sparse characters, e.g. CJK fonts.
+ * The tables are attached to the font's descriptor, so it needs to be in RAM.
+ * For a constant (e.g. built-in) font use a copy of the font and its descriptor.
+ * The fonts loaded by `lv_binfont_create` get these tables automatically.
+ * @param font          pointer to a font in lvgl's native format with a writable `dsc`
+ * @return              LV_RESULT_OK: the tables are created (or already existed);
+ *                      LV_RESULT_INVALID: not enough memory or the font can't be indexed
+ */
+lv_result_t lv_font_fmt_txt_lookup_create(lv_font_t * font);
+
+/**
+ * Free the lookup tables of a font. Needs to be called before freeing a font.
+ * @param font          pointer to a font
+ */
+void lv_font_fmt_txt_lookup_delete(lv_font_t * font);
+
+#endif
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+
+/**
+ * Decompress the glyphs of some characters into the glyph bitmap cache,
+ * e.g. the digits of a frequently changing value at startup.
+ * @param font          pointer to a compressed font
+ * @param charset       UTF-8 string of the characters to cache
+ * @return              number of glyphs which are in the cache
+ */
+uint32_t lv_font_fmt_txt_cache_warm_up(const lv_font_t * font, const char * charset);
+
+/**
+ * Remove the cached glyph bitmaps of a font. Needs to be called before freeing a font.
+ * @param font          pointer to a font, or `NULL` to remove the glyphs of all fonts
+ */
+void lv_font_fmt_txt_cache_drop(const lv_font_t * font);
+
+/**
+ * Set the maximal size of the glyph bitmap cache.
+ * @param size          the new size in bytes, 0 to disable the cache
+ */
+void lv_font_fmt_txt_cache_resize(uint32_t size);
+
+/**
+ * Get the statistics of the glyph bitmap cache.
+ * @param info          store the result here
+ */
+void lv_font_fmt_txt_cache_get_info(lv_font_fmt_txt_cache_info_t * info);
+
+#endif /*LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0*/
+
 /**********************
  *      MACROS
  **********************/
@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_font_fmt_txt.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -39,12 +40,51 @@ typedef struct {
     uint8_t count;
     lv_font_fmt_rle_state_t state;
 } lv_font_fmt_rle_t;
+
+#if LV_FONT_FMT_TXT_CACHE_SIZE > 0
+typedef struct {
+    lv_cache_t * cache;
+    lv_mutex_t stats_lock;      /**< Protects `hit_cnt` and `miss_cnt` as the glyphs are drawn by several threads*/
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
+} lv_font_fmt_txt_cache_state_t;
+#endif
+#endif
+
+#if LV_FONT_FMT_TXT_LOOKUP_TABLE
+/** Tables to get the glyph ID of a letter and the kerning of two glyphs without searching*/
+struct _lv_font_fmt_txt_lookup_t {
+    /** Number of 256 letter pages up to the last letter of the font*/
+    uint32_t page_cnt;
+
+    /** For each page the index of the page in `pages` + 1. 0: there are no glyphs on the page*/
+    uint16_t * page_map;
+
+    /** The glyph IDs of the letters on the pages, 256 per page*/
+    uint16_t * pages;
+
+    /** Kerning classes made from the kerning pairs of the font.
+     * `class_pair_values` is `NULL` if the font has no kerning pairs.*/
+    lv_font_fmt_txt_kern_classes_t kern_classes;
+};
 #endif
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+/**
+ * Create the glyph bitmap cache of the compressed fonts
+ */
+void lv_font_fmt_txt_cache_init(void);
+
+/**
+ * Free the glyph bitmap cache of the compressed fonts
+ */
+void lv_font_fmt_txt_cache_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
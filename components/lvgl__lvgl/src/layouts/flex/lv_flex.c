@@ -7,7 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_flex.h"
-#include "../lv_layout.h"
+#include "../lv_layout_private.h"
 #include "../../core/lv_obj_private.h"
 
 #if LV_USE_FLEX
@@ -21,6 +21,17 @@
 /**********************
  *      TYPEDEFS
  **********************/
+/*The style properties of an item measured by `get_measure()`*/
+enum {
+    MEASURE_GROW,
+    MEASURE_MIN_SIZE,
+    MEASURE_MAX_SIZE,
+    MEASURE_MARGIN_MAIN_START,
+    MEASURE_MARGIN_MAIN_END,
+    MEASURE_MARGIN_CROSS_START,
+    MEASURE_MARGIN_CROSS_END,
+};
+
 typedef struct {
     lv_flex_align_t main_place;
     lv_flex_align_t cross_place;
@@ -28,6 +39,8 @@ typedef struct {
     uint8_t row : 1;
     uint8_t wrap : 1;
     uint8_t rev : 1;
+    lv_layout_cache_t * cache;
+    lv_layout_measure_t measure_tmp;
 } flex_t;
 
 typedef struct {
@@ -64,8 +77,9 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
 static void place_content(lv_flex_align_t place, int32_t max_size, int32_t content_size, int32_t item_cnt,
                           int32_t * start_pos, int32_t * gap);
 static lv_obj_t * get_next_item(lv_obj_t * cont, bool rev, int32_t * item_id);
-static int32_t lv_obj_get_width_with_margin(const lv_obj_t * obj);
-static int32_t lv_obj_get_height_with_margin(const lv_obj_t * obj);
+static const int32_t * get_measure(flex_t * f, int32_t item_id, lv_obj_t * item);
+static int32_t get_main_size(const flex_t * f, const lv_obj_t * item, const int32_t * m);
+static int32_t get_cross_size(const flex_t * f, const lv_obj_t * item, const int32_t * m);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -136,6 +150,7 @@ static void flex_update(lv_obj_t * cont, void * user_data)
     f.main_place = lv_obj_get_style_flex_main_place(cont, LV_PART_MAIN);
     f.cross_place = lv_obj_get_style_flex_cross_place(cont, LV_PART_MAIN);
     f.track_place = lv_obj_get_style_flex_track_place(cont, LV_PART_MAIN);
+    f.cache = lv_layout_cache_get(cont, LV_LAYOUT_FLEX);
 
     bool rtl = lv_obj_get_style_base_dir(cont, LV_PART_MAIN) == LV_BASE_DIR_RTL;
     int32_t track_gap = !f.row ? lv_obj_get_style_pad_column(cont, LV_PART_MAIN) : lv_obj_get_style_pad_row(cont,
@@ -240,10 +255,6 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
     if(f->wrap && ((f->row && w_set == LV_SIZE_CONTENT) || (!f->row && h_set == LV_SIZE_CONTENT))) {
         f->wrap = false;
     }
-    int32_t(*get_main_size)(const lv_obj_t *) = (f->row ? lv_obj_get_width_with_margin : lv_obj_get_height_with_margin);
-    int32_t(*get_cross_size)(const lv_obj_t *) = (!f->row ? lv_obj_get_width_with_margin :
-                                                  lv_obj_get_height_with_margin);
-
     t->track_main_size = 0;
     t->track_fix_main_size = 0;
     t->grow_item_cnt = 0;
@@ -259,10 +270,10 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
         if(item_id != item_start_id && lv_obj_has_flag(item, LV_OBJ_FLAG_FLEX_IN_NEW_TRACK)) break;
 
         if(!lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) {
-            uint8_t grow_value = lv_obj_get_style_flex_grow(item, LV_PART_MAIN);
+            const int32_t * m = get_measure(f, item_id, item);
+            int32_t grow_value = m[MEASURE_GROW];
             if(grow_value) {
-                int32_t min_size = f->row ? lv_obj_get_style_min_width(item, LV_PART_MAIN)
-                                   : lv_obj_get_style_min_height(item, LV_PART_MAIN);
+                int32_t min_size = m[MEASURE_MIN_SIZE];
 
                 int32_t req_size = min_size;
                 if(item_id != item_start_id) req_size += item_gap; /*No gap before the first item*/
@@ -284,10 +295,8 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
 
 
                     new_dsc[t->grow_item_cnt - 1].item = item;
-                    new_dsc[t->grow_item_cnt - 1].min_size = f->row ? lv_obj_get_style_min_width(item, LV_PART_MAIN)
-                                                             : lv_obj_get_style_min_height(item, LV_PART_MAIN);
-                    new_dsc[t->grow_item_cnt - 1].max_size = f->row ? lv_obj_get_style_max_width(item, LV_PART_MAIN)
-                                                             : lv_obj_get_style_max_height(item, LV_PART_MAIN);
+                    new_dsc[t->grow_item_cnt - 1].min_size = min_size;
+                    new_dsc[t->grow_item_cnt - 1].max_size = m[MEASURE_MAX_SIZE];
                     new_dsc[t->grow_item_cnt - 1].grow_value = grow_value;
                     new_dsc[t->grow_item_cnt - 1].clamped = 0;
 
@@ -295,7 +304,7 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
                 }
             }
             else {
-                int32_t item_size = get_main_size(item);
+                int32_t item_size = get_main_size(f, item, m);
                 int32_t req_size = item_size;
                 if(!first_item) req_size += item_gap; /*No gap before the first item*/
                 if(f->wrap && t->track_fix_main_size + grow_min_size_sum + req_size > max_main_size) break;
@@ -303,7 +312,7 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
             }
 
             first_item = false;
-            t->track_cross_size = LV_MAX(get_cross_size(item), t->track_cross_size);
+            t->track_cross_size = LV_MAX(get_cross_size(f, item, m), t->track_cross_size);
             t->item_cnt++;
         }
 
@@ -318,10 +327,11 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
     /*Have at least one item in a row*/
     if(item && item_id == item_start_id) {
         item = cont->spec_attr->children[item_id];
+        const int32_t * m = get_measure(f, item_id, item);
         get_next_item(cont, f->rev, &item_id);
         if(item) {
-            t->track_cross_size = get_cross_size(item);
-            t->track_main_size = get_main_size(item);
+            t->track_cross_size = get_cross_size(f, item, m);
+            t->track_main_size = get_main_size(f, item, m);
             t->item_cnt = 1;
         }
     }
@@ -339,12 +349,6 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
     int32_t (*area_get_main_size)(const lv_area_t *) = (f->row ? lv_area_get_width : lv_area_get_height);
     int32_t (*area_get_cross_size)(const lv_area_t *) = (!f->row ? lv_area_get_width : lv_area_get_height);
 
-    typedef int32_t (*margin_func_t)(const lv_obj_t *, uint32_t);
-    margin_func_t get_margin_main_start = (f->row ? lv_obj_get_style_margin_left : lv_obj_get_style_margin_top);
-    margin_func_t get_margin_main_end = (f->row ? lv_obj_get_style_margin_right : lv_obj_get_style_margin_bottom);
-    margin_func_t get_margin_cross_start = (!f->row ? lv_obj_get_style_margin_left : lv_obj_get_style_margin_top);
-    margin_func_t get_margin_cross_end = (!f->row ? lv_obj_get_style_margin_right : lv_obj_get_style_margin_bottom);
-
     /*Calculate the size of grow items first*/
     uint32_t i;
     bool grow_reiterate  = true;
@@ -388,6 +392,9 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
     place_content(f->main_place, max_main_size, t->track_main_size, t->item_cnt, &main_pos, &place_gap);
     if(f->row && rtl) main_pos += lv_obj_get_content_width(cont);
 
+    /*The grow items are found in the same order as they were added to `grow_dsc`*/
+    uint32_t grow_id = 0;
+
     lv_obj_t * item = lv_obj_get_child(cont, item_first_id);
     /*Reposition the children*/
     while(item && item_first_id != item_last_id) {
@@ -399,14 +406,17 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
         uint16_t item_w_layout = item->w_layout;
         uint16_t item_h_layout = item->h_layout;
 
-        int32_t grow_size = lv_obj_get_style_flex_grow(item, LV_PART_MAIN);
-        if(grow_size) {
+        const int32_t * m = get_measure(f, item_first_id, item);
+        int32_t margin_main_start = m[MEASURE_MARGIN_MAIN_START];
+        int32_t margin_main_end = m[MEASURE_MARGIN_MAIN_END];
+        int32_t margin_cross_start = m[MEASURE_MARGIN_CROSS_START];
+        int32_t margin_cross_end = m[MEASURE_MARGIN_CROSS_END];
+
+        if(m[MEASURE_GROW]) {
             int32_t s = 0;
-            for(i = 0; i < t->grow_item_cnt; i++) {
-                if(t->grow_dsc[i].item == item) {
-                    s = t->grow_dsc[i].final_size;
-                    break;
-                }
+            if(grow_id < t->grow_item_cnt && t->grow_dsc[grow_id].item == item) {
+                s = t->grow_dsc[grow_id].final_size;
+                grow_id++;
             }
 
             if(f->row) {
@@ -444,14 +454,14 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
                 /*Round up the cross size to avoid rounding error when dividing by 2
                  *The issue comes up e,g, with column direction with center cross direction if an element's width changes*/
                 cross_pos = (((t->track_cross_size + 1) & (~1)) - area_get_cross_size(&item->coords)) / 2;
-                cross_pos += (get_margin_cross_start(item, LV_PART_MAIN) - get_margin_cross_end(item, LV_PART_MAIN)) / 2;
+                cross_pos += (margin_cross_start - margin_cross_end) / 2;
                 break;
             case LV_FLEX_ALIGN_END:
                 cross_pos = t->track_cross_size - area_get_cross_size(&item->coords);
-                cross_pos -= get_margin_cross_end(item, LV_PART_MAIN);
+                cross_pos -= margin_cross_end;
                 break;
             default:
-                cross_pos += get_margin_cross_start(item, LV_PART_MAIN);
+                cross_pos += margin_cross_start;
                 break;
         }
 
@@ -467,8 +477,8 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
 
         int32_t diff_x = abs_x - item->coords.x1 + tr_x;
         int32_t diff_y = abs_y - item->coords.y1 + tr_y;
-        diff_x += f->row ? main_pos + get_margin_main_start(item, LV_PART_MAIN) : cross_pos;
-        diff_y += f->row ? cross_pos : main_pos + get_margin_main_start(item, LV_PART_MAIN);
+        diff_x += f->row ? main_pos + margin_main_start : cross_pos;
+        diff_y += f->row ? cross_pos : main_pos + margin_main_start;
 
         if(diff_x || diff_y) {
             lv_obj_invalidate(item);
@@ -481,8 +491,8 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
         }
 
         if(!(f->row && rtl)) main_pos += area_get_main_size(&item->coords) + item_gap + place_gap
-                                             + get_margin_main_start(item, LV_PART_MAIN)
-                                             + get_margin_main_end(item, LV_PART_MAIN);
+                                             + margin_main_start
+                                             + margin_main_end;
         else main_pos -= item_gap + place_gap;
 
         item = get_next_item(cont, f->rev, &item_first_id);
@@ -545,18 +555,51 @@ static lv_obj_t * get_next_item(lv_obj_t * cont, bool rev, int32_t * item_id)
     }
 }
 
-static int32_t lv_obj_get_width_with_margin(const lv_obj_t * obj)
+/**
+ * Get the style properties of an item from the cache or measure them now
+ * @param f         the flex descriptor of the container
+ * @param item_id   index of the item
+ * @param item      pointer to the item
+ * @return          the values, indexed by `MEASURE_...`, valid until the next call
+ */
+static const int32_t * get_measure(flex_t * f, int32_t item_id, lv_obj_t * item)
+{
+    bool valid;
+    lv_layout_measure_t * measure = lv_layout_cache_get_measure(f->cache, item_id, item, &f->measure_tmp, &valid);
+    int32_t * m = measure->values;
+    if(valid) return m;
+
+    m[MEASURE_GROW] = lv_obj_get_style_flex_grow(item, LV_PART_MAIN);
+    if(f->row) {
+        m[MEASURE_MIN_SIZE] = lv_obj_get_style_min_width(item, LV_PART_MAIN);
+        m[MEASURE_MAX_SIZE] = lv_obj_get_style_max_width(item, LV_PART_MAIN);
+        m[MEASURE_MARGIN_MAIN_START] = lv_obj_get_style_margin_left(item, LV_PART_MAIN);
+        m[MEASURE_MARGIN_MAIN_END] = lv_obj_get_style_margin_right(item, LV_PART_MAIN);
+        m[MEASURE_MARGIN_CROSS_START] = lv_obj_get_style_margin_top(item, LV_PART_MAIN);
+        m[MEASURE_MARGIN_CROSS_END] = lv_obj_get_style_margin_bottom(item, LV_PART_MAIN);
+    }
+    else {
+        m[MEASURE_MIN_SIZE] = lv_obj_get_style_min_height(item, LV_PART_MAIN);
+        m[MEASURE_MAX_SIZE] = lv_obj_get_style_max_height(item, LV_PART_MAIN);
+        m[MEASURE_MARGIN_MAIN_START] = lv_obj_get_style_margin_top(item, LV_PART_MAIN);
+        m[MEASURE_MARGIN_MAIN_END] = lv_obj_get_style_margin_bottom(item, LV_PART_MAIN);
+        m[MEASURE_MARGIN_CROSS_START] = lv_obj_get_style_margin_left(item, LV_PART_MAIN);
+        m[MEASURE_MARGIN_CROSS_END] = lv_obj_get_style_margin_right(item, LV_PART_MAIN);
+    }
+
+    return m;
+}
+
+static int32_t get_main_size(const flex_t * f, const lv_obj_t * item, const int32_t * m)
 {
-    return lv_obj_get_style_margin_left(obj, LV_PART_MAIN)
-           + lv_obj_get_width(obj)
-           + lv_obj_get_style_margin_right(obj, LV_PART_MAIN);
+    int32_t size = f->row ? lv_obj_get_width(item) : lv_obj_get_height(item);
+    return m[MEASURE_MARGIN_MAIN_START] + size + m[MEASURE_MARGIN_MAIN_END];
 }
 
-static int32_t lv_obj_get_height_with_margin(const lv_obj_t * obj)
+static int32_t get_cross_size(const flex_t * f, const lv_obj_t * item, const int32_t * m)
 {
-    return lv_obj_get_style_margin_top(obj, LV_PART_MAIN)
-           + lv_obj_get_height(obj)
-           + lv_obj_get_style_margin_bottom(obj, LV_PART_MAIN);
+    int32_t size = f->row ? lv_obj_get_height(item) : lv_obj_get_width(item);
+    return m[MEASURE_MARGIN_CROSS_START] + size + m[MEASURE_MARGIN_CROSS_END];
 }
 
 #endif /*LV_USE_FLEX*/
@@ -11,7 +11,7 @@
 #if LV_USE_GRID
 
 #include "../../stdlib/lv_string.h"
-#include "../lv_layout.h"
+#include "../lv_layout_private.h"
 #include "../../core/lv_obj_private.h"
 #include "../../core/lv_global.h"
 /*********************
@@ -35,17 +35,57 @@ typedef struct {
     lv_point_t grid_abs;
 } item_repos_hint_t;
 
+/*The values of an item measured by `calc_items()`*/
+enum {
+    MEASURE_COL_POS,
+    MEASURE_ROW_POS,
+    MEASURE_COL_SPAN,
+    MEASURE_ROW_SPAN,
+    MEASURE_X_ALIGN,
+    MEASURE_Y_ALIGN,
+    MEASURE_WIDTH,      /*Not a style property, only to know if the tracks need to be calculated again*/
+    MEASURE_HEIGHT,
+};
+
+/*The cell of an item, read only once per update*/
+typedef struct {
+    uint32_t col_pos;
+    uint32_t row_pos;
+    uint32_t col_span;      /*0 if the item is not positioned by the grid*/
+    uint32_t row_span;
+    lv_grid_align_t x_align;
+    lv_grid_align_t y_align;
+} lv_grid_item_t;
+
 typedef struct {
     int32_t * x;
     int32_t * y;
     int32_t * w;
     int32_t * h;
+    lv_grid_item_t * items;
+    uint32_t item_cnt;
     uint32_t col_num;
     uint32_t row_num;
     int32_t grid_w;
     int32_t grid_h;
+    bool items_changed;     /*An item was measured again or its size has changed since the last update*/
 } lv_grid_calc_t;
 
+#if LV_LAYOUT_MEASURE_CACHE
+/*The tracks of the last update, kept in the layout cache.
+ *Followed by the column and row templates and the x, w, y, h arrays.*/
+typedef struct {
+    uint32_t col_num;
+    uint32_t row_num;
+    int32_t cont_w;
+    int32_t cont_h;
+    int32_t grid_w;
+    int32_t grid_h;
+    bool auto_w;
+    bool auto_h;
+} lv_grid_tracks_t;
+#endif
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -54,11 +94,17 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 static void grid_update(lv_obj_t * cont, void * user_data);
-static void calc(lv_obj_t * obj, lv_grid_calc_t * calc);
+static void calc(lv_obj_t * obj, lv_grid_calc_t * calc, lv_layout_cache_t * cache);
 static void calc_free(lv_grid_calc_t * calc);
+static void calc_items(lv_obj_t * cont, lv_grid_calc_t * c, lv_layout_cache_t * cache);
+#if LV_LAYOUT_MEASURE_CACHE
+    static bool tracks_reuse(lv_obj_t * cont, lv_grid_calc_t * c, lv_layout_cache_t * cache, bool auto_w, bool auto_h);
+    static void tracks_save(lv_obj_t * cont, const lv_grid_calc_t * c, lv_layout_cache_t * cache, bool auto_w,
+                            bool auto_h);
+#endif
 static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c);
 static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c);
-static void item_repos(lv_obj_t * item, lv_grid_calc_t * c, item_repos_hint_t * hint);
+static void item_repos(lv_obj_t * item, const lv_grid_item_t * cell, lv_grid_calc_t * c, item_repos_hint_t * hint);
 static int32_t grid_align(int32_t cont_size, bool auto_size, lv_grid_align_t align, int32_t gap,
                           uint32_t track_num,
                           int32_t * size_array, int32_t * pos_array, bool reverse);
@@ -194,7 +240,7 @@ static void grid_update(lv_obj_t * cont, void * user_data)
     //    if(col_templ == NULL || row_templ == NULL) return;
 
     lv_grid_calc_t c;
-    calc(cont, &c);
+    calc(cont, &c, lv_layout_cache_get(cont, LV_LAYOUT_GRID));
 
     item_repos_hint_t hint;
     lv_memzero(&hint, sizeof(hint));
@@ -206,10 +252,11 @@ static void grid_update(lv_obj_t * cont, void * user_data)
     hint.grid_abs.x = pad_left + cont->coords.x1 - lv_obj_get_scroll_x(cont);
     hint.grid_abs.y = pad_top + cont->coords.y1 - lv_obj_get_scroll_y(cont);
 
+    /*Skip the children created in the events sent while repositioning as they were not measured*/
     uint32_t i;
-    for(i = 0; i < cont->spec_attr->child_cnt; i++) {
+    for(i = 0; i < cont->spec_attr->child_cnt && i < c.item_cnt; i++) {
         lv_obj_t * item = cont->spec_attr->children[i];
-        item_repos(item, &c, &hint);
+        item_repos(item, &c.items[i], &c, &hint);
     }
     calc_free(&c);
 
@@ -228,15 +275,28 @@ static void grid_update(lv_obj_t * cont, void * user_data)
  * Calculate the grid cells coordinates
  * @param cont an object that has a grid
  * @param calc store the calculated cells sizes here
+ * @param cache the layout cache of `cont` to reuse the measured items and tracks from, can be NULL
  * @note `lv_grid_calc_free(calc_out)` needs to be called when `calc_out` is not needed anymore
  */
-static void calc(lv_obj_t * cont, lv_grid_calc_t * calc_out)
+static void calc(lv_obj_t * cont, lv_grid_calc_t * calc_out, lv_layout_cache_t * cache)
 {
     if(lv_obj_get_child(cont, 0) == NULL) {
         lv_memzero(calc_out, sizeof(lv_grid_calc_t));
         return;
     }
 
+    calc_items(cont, calc_out, cache);
+
+    int32_t w_set = lv_obj_get_style_width(cont, LV_PART_MAIN);
+    int32_t h_set = lv_obj_get_style_height(cont, LV_PART_MAIN);
+    bool auto_w = w_set == LV_SIZE_CONTENT && !cont->w_layout;
+    bool auto_h = h_set == LV_SIZE_CONTENT && !cont->h_layout;
+
+#if LV_LAYOUT_MEASURE_CACHE
+    /*If only the position of the grid has changed the tracks are the same*/
+    if(tracks_reuse(cont, calc_out, cache, auto_w, auto_h)) return;
+#endif
+
     calc_rows(cont, calc_out);
     calc_cols(cont, calc_out);
 
@@ -245,18 +305,18 @@ static void calc(lv_obj_t * cont, lv_grid_calc_t * calc_out)
 
     bool rev = lv_obj_get_style_base_dir(cont, LV_PART_MAIN) == LV_BASE_DIR_RTL;
 
-    int32_t w_set = lv_obj_get_style_width(cont, LV_PART_MAIN);
-    int32_t h_set = lv_obj_get_style_height(cont, LV_PART_MAIN);
-    bool auto_w = w_set == LV_SIZE_CONTENT && !cont->w_layout;
     int32_t cont_w = lv_obj_get_content_width(cont);
     calc_out->grid_w = grid_align(cont_w, auto_w, get_grid_col_align(cont), col_gap, calc_out->col_num, calc_out->w,
                                   calc_out->x, rev);
 
-    bool auto_h = h_set == LV_SIZE_CONTENT && !cont->h_layout;
     int32_t cont_h = lv_obj_get_content_height(cont);
     calc_out->grid_h = grid_align(cont_h, auto_h, get_grid_row_align(cont), row_gap, calc_out->row_num, calc_out->h,
                                   calc_out->y, false);
 
+#if LV_LAYOUT_MEASURE_CACHE
+    tracks_save(cont, calc_out, cache, auto_w, auto_h);
+#endif
+
     LV_ASSERT_MEM_INTEGRITY();
 }
 
@@ -270,8 +330,181 @@ static void calc_free(lv_grid_calc_t * calc)
     lv_free(calc->y);
     lv_free(calc->w);
     lv_free(calc->h);
+    lv_free(calc->items);
 }
 
+/**
+ * Read the cell of every child once, so that the tracks and the items can be calculated
+ * without getting the same style properties for every track again.
+ * The cells are read from the layout cache if the style of the child hasn't changed since the last update.
+ * @param cont  pointer to a grid container
+ * @param c     store the cells in `c->items`, indexed by the child index
+ * @param cache the layout cache of `cont`, can be NULL
+ */
+static void calc_items(lv_obj_t * cont, lv_grid_calc_t * c, lv_layout_cache_t * cache)
+{
+    c->item_cnt = lv_obj_get_child_count(cont);
+    c->items = lv_malloc(sizeof(lv_grid_item_t) * c->item_cnt);
+    LV_ASSERT_MALLOC(c->items);
+    c->items_changed = false;
+
+    lv_layout_measure_t measure_tmp;
+    uint32_t i;
+    for(i = 0; i < c->item_cnt; i++) {
+        lv_obj_t * item = cont->spec_attr->children[i];
+        lv_grid_item_t * cell = &c->items[i];
+
+        bool valid;
+        lv_layout_measure_t * measure = lv_layout_cache_get_measure(cache, i, item, &measure_tmp, &valid);
+        int32_t * m = measure->values;
+        if(!valid) {
+            m[MEASURE_COL_POS] = get_col_pos(item);
+            m[MEASURE_ROW_POS] = get_row_pos(item);
+            m[MEASURE_COL_SPAN] = get_col_span(item);
+            m[MEASURE_ROW_SPAN] = get_row_span(item);
+            m[MEASURE_X_ALIGN] = get_cell_col_align(item);
+            m[MEASURE_Y_ALIGN] = get_cell_row_align(item);
+            m[MEASURE_WIDTH] = LV_COORD_MIN;
+            m[MEASURE_HEIGHT] = LV_COORD_MIN;
+            c->items_changed = true;
+        }
+
+        if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) {
+            /*The flags might change without changing the style, so mark the not positioned items too*/
+            if(m[MEASURE_WIDTH] != LV_COORD_MIN) {
+                m[MEASURE_WIDTH] = LV_COORD_MIN;
+                c->items_changed = true;
+            }
+            lv_memzero(cell, sizeof(lv_grid_item_t));
+            continue;
+        }
+
+        int32_t w = lv_obj_get_width(item);
+        int32_t h = lv_obj_get_height(item);
+        if(m[MEASURE_WIDTH] != w || m[MEASURE_HEIGHT] != h) {
+            m[MEASURE_WIDTH] = w;
+            m[MEASURE_HEIGHT] = h;
+            c->items_changed = true;
+        }
+
+        cell->col_pos = m[MEASURE_COL_POS];
+        cell->row_pos = m[MEASURE_ROW_POS];
+        cell->col_span = m[MEASURE_COL_SPAN];
+        cell->row_span = m[MEASURE_ROW_SPAN];
+        cell->x_align = m[MEASURE_X_ALIGN];
+        cell->y_align = m[MEASURE_Y_ALIGN];
+    }
+}
+
+#if LV_LAYOUT_MEASURE_CACHE
+/**
+ * Use the tracks of the last update if nothing has changed which affects them
+ * @param cont      pointer to a grid container
+ * @param c         the calculation with the measured items. Set the tracks here.
+ * @param cache     the layout cache of `cont`, can be NULL
+ * @param auto_w    true: the width of the container is set by the grid
+ * @param auto_h    true: the height of the container is set by the grid
+ * @return          true: the tracks were reused
+ */
+static bool tracks_reuse(lv_obj_t * cont, lv_grid_calc_t * c, lv_layout_cache_t * cache, bool auto_w, bool auto_h)
+{
+    if(cache == NULL || cache->layout_data == NULL || c->items_changed) return false;
+
+    /*The tracks of sub grids depend on the parent's templates too*/
+    const int32_t * col_templ = get_col_dsc(cont);
+    const int32_t * row_templ = get_row_dsc(cont);
+    if(col_templ == NULL || row_templ == NULL) return false;
+
+    const lv_grid_tracks_t * tracks = cache->layout_data;
+    if(tracks->auto_w != auto_w || tracks->auto_h != auto_h) return false;
+    if(tracks->cont_w != lv_obj_get_content_width(cont) || tracks->cont_h != lv_obj_get_content_height(cont)) return false;
+
+    uint32_t col_num = count_tracks(col_templ);
+    uint32_t row_num = count_tracks(row_templ);
+    if(tracks->col_num != col_num || tracks->row_num != row_num) return false;
+
+    /*The templates might be modified in place*/
+    const int32_t * data = (const int32_t *)(tracks + 1);
+    if(lv_memcmp(data, col_templ, col_num * sizeof(int32_t))) return false;
+    data += col_num;
+    if(lv_memcmp(data, row_templ, row_num * sizeof(int32_t))) return false;
+    data += row_num;
+
+    c->col_num = col_num;
+    c->row_num = row_num;
+    c->x = lv_malloc(sizeof(int32_t) * col_num);
+    c->w = lv_malloc(sizeof(int32_t) * col_num);
+    c->y = lv_malloc(sizeof(int32_t) * row_num);
+    c->h = lv_malloc(sizeof(int32_t) * row_num);
+    LV_ASSERT_MALLOC(c->x);
+    LV_ASSERT_MALLOC(c->w);
+    LV_ASSERT_MALLOC(c->y);
+    LV_ASSERT_MALLOC(c->h);
+
+    lv_memcpy(c->x, data, col_num * sizeof(int32_t));
+    data += col_num;
+    lv_memcpy(c->w, data, col_num * sizeof(int32_t));
+    data += col_num;
+    lv_memcpy(c->y, data, row_num * sizeof(int32_t));
+    data += row_num;
+    lv_memcpy(c->h, data, row_num * sizeof(int32_t));
+    c->grid_w = tracks->grid_w;
+    c->grid_h = tracks->grid_h;
+
+    return true;
+}
+
+/**
+ * Keep the calculated tracks in the layout cache
+ * @param cont      pointer to a grid container
+ * @param c         the calculated tracks
+ * @param cache     the layout cache of `cont`, can be NULL
+ * @param auto_w    true: the width of the container is set by the grid
+ * @param auto_h    true: the height of the container is set by the grid
+ */
+static void tracks_save(lv_obj_t * cont, const lv_grid_calc_t * c, lv_layout_cache_t * cache, bool auto_w,
+                        bool auto_h)
+{
+    if(cache == NULL) return;
+
+    const int32_t * col_templ = get_col_dsc(cont);
+    const int32_t * row_templ = get_row_dsc(cont);
+    if(col_templ == NULL || row_templ == NULL || c->x == NULL || c->y == NULL) {
+        lv_free(cache->layout_data);
+        cache->layout_data = NULL;
+        return;
+    }
+
+    uint32_t data_cnt = 3 * c->col_num + 3 * c->row_num;
+    lv_grid_tracks_t * tracks = lv_realloc(cache->layout_data, sizeof(lv_grid_tracks_t) + data_cnt * sizeof(int32_t));
+    LV_ASSERT_MALLOC(tracks);
+    cache->layout_data = tracks;
+    if(tracks == NULL) return;
+
+    tracks->col_num = c->col_num;
+    tracks->row_num = c->row_num;
+    tracks->cont_w = lv_obj_get_content_width(cont);
+    tracks->cont_h = lv_obj_get_content_height(cont);
+    tracks->grid_w = c->grid_w;
+    tracks->grid_h = c->grid_h;
+    tracks->auto_w = auto_w;
+    tracks->auto_h = auto_h;
+
+    int32_t * data = (int32_t *)(tracks + 1);
+    lv_memcpy(data, col_templ, c->col_num * sizeof(int32_t));
+    data += c->col_num;
+    lv_memcpy(data, row_templ, c->row_num * sizeof(int32_t));
+    data += c->row_num;
+    lv_memcpy(data, c->x, c->col_num * sizeof(int32_t));
+    data += c->col_num;
+    lv_memcpy(data, c->w, c->col_num * sizeof(int32_t));
+    data += c->col_num;
+    lv_memcpy(data, c->y, c->row_num * sizeof(int32_t));
+    data += c->row_num;
+    lv_memcpy(data, c->h, c->row_num * sizeof(int32_t));
+}
+#endif
+
 static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c)
 {
 
@@ -302,27 +535,18 @@ static void calc_cols(lv_obj_t * cont, lv_grid_calc_t * c)
     c->x = lv_malloc(sizeof(int32_t) * c->col_num);
     c->w = lv_malloc(sizeof(int32_t) * c->col_num);
 
-    /*Set sizes for CONTENT cells*/
+    /*Set sizes for CONTENT cells from the size of the children in them*/
     uint32_t i;
     for(i = 0; i < c->col_num; i++) {
-        int32_t size = LV_COORD_MIN;
-        if(IS_CONTENT(col_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_count(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t col_span = get_col_span(item);
-                if(col_span != 1) continue;
-
-                uint32_t col_pos = get_col_pos(item);
-                if(col_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_width(item));
-            }
-            if(size >= 0) c->w[i] = size;
-            else c->w[i] = 0;
-        }
+        c->w[i] = 0;
+    }
+
+    for(i = 0; i < c->item_cnt; i++) {
+        const lv_grid_item_t * cell = &c->items[i];
+        if(cell->col_span != 1 || cell->col_pos >= c->col_num) continue;
+        if(!IS_CONTENT(col_templ[cell->col_pos])) continue;
+
+        c->w[cell->col_pos] = LV_MAX(c->w[cell->col_pos], lv_obj_get_width(cont->spec_attr->children[i]));
     }
 
     uint32_t col_fr_cnt = 0;
@@ -391,27 +615,18 @@ static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c)
     c->row_num = count_tracks(row_templ);
     c->y = lv_malloc(sizeof(int32_t) * c->row_num);
     c->h = lv_malloc(sizeof(int32_t) * c->row_num);
-    /*Set sizes for CONTENT cells*/
+    /*Set sizes for CONTENT cells from the size of the children in them*/
     uint32_t i;
     for(i = 0; i < c->row_num; i++) {
-        int32_t size = LV_COORD_MIN;
-        if(IS_CONTENT(row_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_count(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t row_span = get_row_span(item);
-                if(row_span != 1) continue;
-
-                uint32_t row_pos = get_row_pos(item);
-                if(row_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_height(item));
-            }
-            if(size >= 0) c->h[i] = size;
-            else c->h[i] = 0;
-        }
+        c->h[i] = 0;
+    }
+
+    for(i = 0; i < c->item_cnt; i++) {
+        const lv_grid_item_t * cell = &c->items[i];
+        if(cell->row_span != 1 || cell->row_pos >= c->row_num) continue;
+        if(!IS_CONTENT(row_templ[cell->row_pos])) continue;
+
+        c->h[cell->row_pos] = LV_MAX(c->h[cell->row_pos], lv_obj_get_height(cont->spec_attr->children[i]));
     }
 
     uint32_t row_fr_cnt = 0;
@@ -457,21 +672,20 @@ static void calc_rows(lv_obj_t * cont, lv_grid_calc_t * c)
 /**
  * Reposition a grid item in its cell
  * @param item a grid item to reposition
+ * @param cell the cell of the item
  * @param calc the calculated grid of `cont`
- * @param child_id_ext helper value if the ID of the child is know (order from the oldest) else -1
  * @param grid_abs helper value, the absolute position of the grid, NULL if unknown
  */
-static void item_repos(lv_obj_t * item, lv_grid_calc_t * c, item_repos_hint_t * hint)
+static void item_repos(lv_obj_t * item, const lv_grid_item_t * cell, lv_grid_calc_t * c, item_repos_hint_t * hint)
 {
-    if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) return;
-    uint32_t col_span = get_col_span(item);
-    uint32_t row_span = get_row_span(item);
+    uint32_t col_span = cell->col_span;
+    uint32_t row_span = cell->row_span;
     if(row_span == 0 || col_span == 0) return;
 
-    uint32_t col_pos = get_col_pos(item);
-    uint32_t row_pos = get_row_pos(item);
-    lv_grid_align_t col_align = get_cell_col_align(item);
-    lv_grid_align_t row_align = get_cell_row_align(item);
+    uint32_t col_pos = cell->col_pos;
+    uint32_t row_pos = cell->row_pos;
+    lv_grid_align_t col_align = cell->x_align;
+    lv_grid_align_t row_align = cell->y_align;
 
     int32_t col_x1 = c->x[col_pos];
     int32_t col_x2 = c->x[col_pos + col_span - 1] + c->w[col_pos + col_span - 1];
@@ -8,7 +8,7 @@
  *********************/
 #include "lv_layout_private.h"
 #include "../core/lv_global.h"
-#include "../core/lv_obj.h"
+#include "../core/lv_obj_private.h"
 
 /*********************
  *      DEFINES
@@ -74,6 +74,91 @@ void lv_layout_apply(lv_obj_t * obj)
     }
 }
 
+lv_layout_cache_t * lv_layout_cache_get(lv_obj_t * cont, uint32_t layout)
+{
+#if LV_LAYOUT_MEASURE_CACHE
+    if(cont->spec_attr == NULL) return NULL;
+
+    lv_layout_cache_t * cache = cont->spec_attr->layout_cache;
+    if(cache == NULL) {
+        cache = lv_malloc_zeroed(sizeof(lv_layout_cache_t));
+        LV_ASSERT_MALLOC(cache);
+        if(cache == NULL) return NULL;
+        cache->style_version = cont->style_version;
+        cont->spec_attr->layout_cache = cache;
+    }
+
+    /*The measured values might depend on the style of the container too*/
+    if(cache->layout != layout || cache->style_version != cont->style_version) {
+        if(cache->items) lv_memzero(cache->items, cache->item_cnt * sizeof(lv_layout_measure_t));
+        lv_free(cache->layout_data);
+        cache->layout_data = NULL;
+        cache->layout = layout;
+        cache->style_version = cont->style_version;
+    }
+
+    uint32_t child_cnt = cont->spec_attr->child_cnt;
+    if(cache->item_cnt != child_cnt) {
+        lv_layout_measure_t * items = lv_realloc(cache->items, child_cnt * sizeof(lv_layout_measure_t));
+        if(items == NULL && child_cnt) {
+            LV_ASSERT_MALLOC(items);
+            return NULL;
+        }
+        if(child_cnt > cache->item_cnt) {
+            lv_memzero(&items[cache->item_cnt], (child_cnt - cache->item_cnt) * sizeof(lv_layout_measure_t));
+        }
+        cache->items = items;
+        cache->item_cnt = child_cnt;
+
+        /*The layout data might depend on the deleted children*/
+        lv_free(cache->layout_data);
+        cache->layout_data = NULL;
+    }
+
+    return cache;
+#else
+    LV_UNUSED(cont);
+    LV_UNUSED(layout);
+    return NULL;
+#endif
+}
+
+lv_layout_measure_t * lv_layout_cache_get_measure(lv_layout_cache_t * cache, uint32_t idx, lv_obj_t * item,
+                                                  lv_layout_measure_t * tmp, bool * valid)
+{
+#if LV_LAYOUT_MEASURE_CACHE
+    if(cache && idx < cache->item_cnt) {
+        lv_layout_measure_t * m = &cache->items[idx];
+        *valid = m->obj == item && m->style_version == item->style_version;
+        m->obj = item;
+        m->style_version = item->style_version;
+        return m;
+    }
+#else
+    LV_UNUSED(cache);
+    LV_UNUSED(idx);
+    LV_UNUSED(item);
+#endif
+
+    *valid = false;
+    return tmp;
+}
+
+void lv_layout_cache_delete(lv_obj_t * cont)
+{
+#if LV_LAYOUT_MEASURE_CACHE
+    if(cont->spec_attr == NULL || cont->spec_attr->layout_cache == NULL) return;
+
+    lv_layout_cache_t * cache = cont->spec_attr->layout_cache;
+    lv_free(cache->items);
+    lv_free(cache->layout_data);
+    lv_free(cache);
+    cont->spec_attr->layout_cache = NULL;
+#else
+    LV_UNUSED(cont);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -20,6 +20,8 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#define LV_LAYOUT_MEASURE_VALUE_CNT     8
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -29,6 +31,22 @@ typedef struct {
     void * user_data;
 } lv_layout_dsc_t;
 
+/** The style dependent values of a child measured by the layout of its parent */
+typedef struct {
+    lv_obj_t * obj;                                 /**< The measured child, NULL if not measured yet*/
+    uint32_t style_version;                         /**< `style_version` of `obj` when it was measured*/
+    int32_t values[LV_LAYOUT_MEASURE_VALUE_CNT];    /**< The meaning of the values depends on the layout*/
+} lv_layout_measure_t;
+
+/** The values measured by the layout of a container, kept between the layout updates */
+struct _lv_layout_cache_t {
+    uint32_t layout;                /**< The layout which measured the children*/
+    uint32_t style_version;         /**< `style_version` of the container when the children were measured*/
+    uint32_t item_cnt;
+    lv_layout_measure_t * items;    /**< The measured children by child index*/
+    void * layout_data;             /**< Allocated by the layout with `lv_malloc` to keep e.g. tracks*/
+};
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -47,6 +65,33 @@ void lv_layout_deinit(void);
  */
 void lv_layout_apply(lv_obj_t * obj);
 
+/**
+ * Get the cache of the measured children of a container. Drop the cached values if
+ * they were measured by an other layout or the style of the container has changed.
+ * @param cont      pointer to a container
+ * @param layout    the layout of the container
+ * @return          the cache with an entry for every child, or NULL if not enabled or out of memory
+ */
+lv_layout_cache_t * lv_layout_cache_get(lv_obj_t * cont, uint32_t layout);
+
+/**
+ * Get the measured values of a child
+ * @param cache     the cache of the container (can be NULL)
+ * @param idx       index of the child
+ * @param item      the child
+ * @param tmp       used if the child has no entry in the cache
+ * @param valid     set to true if the values are still valid, else they need to be measured again
+ * @return          the entry to read the values from or to measure the child into
+ */
+lv_layout_measure_t * lv_layout_cache_get_measure(lv_layout_cache_t * cache, uint32_t idx, lv_obj_t * item,
+                                                  lv_layout_measure_t * tmp, bool * valid);
+
+/**
+ * Free the cache of the measured children of a container
+ * @param cont      pointer to a container
+ */
+void lv_layout_cache_delete(lv_obj_t * cont);
+
 /**********************
  *      MACROS
  **********************/
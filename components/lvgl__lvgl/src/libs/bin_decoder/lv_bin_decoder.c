@@ -31,17 +31,24 @@
 
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
 
+#define COMPRESSED_HEADER_SIZE  12
+
 /**********************
  *      TYPEDEFS
  **********************/
 
 /**
  * Data format for compressed image data.
+ *
+ * If `block_rows` is not 0, the data is a table of `block_cnt + 1` `uint32_t` offsets,
+ * followed by `block_cnt` independently compressed blocks of `block_rows` rows (the last can be shorter).
+ * The offsets are relative to the first block, the last one is the end of the last block.
+ * This way only the blocks of the drawn rows need to be read and decompressed.
  */
 
 typedef struct _lv_image_compressed_t {
     uint32_t method: 4; /*Compression method, see `lv_image_compress_t`*/
-    uint32_t reserved : 28;  /*Reserved to be used later*/
+    uint32_t block_rows : 28;  /*If not 0, every `block_rows` rows are compressed independently*/
     uint32_t compressed_size;  /*Compressed data size in byte*/
     uint32_t decompressed_size;  /*Decompressed data size in byte*/
     const uint8_t * data; /*Compressed data*/
@@ -56,6 +63,8 @@ typedef struct {
     lv_draw_buf_t * decompressed;       /*Decompressed data could be used directly, thus must also be draw buf*/
     lv_draw_buf_t c_array;              /*An C-array image that need to be converted to a draw buf*/
     lv_draw_buf_t * decoded_partial;    /*A draw buf for decoded image via get_area_cb*/
+    uint32_t * block_offsets;           /*Offsets of the compressed row blocks and the end of the last one*/
+    uint8_t * block_buf;                /*A compressed row block read from file*/
 } decoder_data_t;
 
 /**********************
@@ -69,13 +78,22 @@ static lv_result_t load_indexed(lv_image_decoder_t * decoder, lv_image_decoder_d
     static lv_result_t decode_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 #endif
 static lv_result_t decode_alpha_only(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static const uint8_t * get_mapped_data(lv_image_decoder_dsc_t * dsc, uint32_t * data_size);
+static lv_result_t decode_mapped(lv_image_decoder_dsc_t * dsc);
 static lv_result_t decode_indexed_line(lv_color_format_t color_format, const lv_color32_t * palette, int32_t x,
                                        int32_t w_px, const uint8_t * in, lv_color32_t * out);
 static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static lv_result_t load_compressed_header(lv_image_decoder_dsc_t * dsc);
+static lv_result_t load_row_blocks(lv_image_decoder_dsc_t * dsc);
+static lv_result_t decode_row_block(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                    lv_area_t * decoded_area);
 
 static lv_fs_res_t fs_read_file_at(lv_fs_file_t * f, uint32_t pos, void * buff, uint32_t btr, uint32_t * br);
 
 static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image_compressed_t * compressed);
+static bool compress_method_is_enabled(uint32_t method);
+static uint32_t decompress_data(uint32_t method, lv_color_format_t cf, const uint8_t * input, uint32_t input_len,
+                                uint8_t * output, uint32_t output_len);
 
 /**********************
  *  STATIC VARIABLES
@@ -223,6 +241,10 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
         if(dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED) {
             res = decode_compressed(decoder, dsc);
         }
+        else if(get_mapped_data(dsc, NULL)) {
+            res = decode_mapped(dsc);
+            use_directly = true; /*The file mapped to the memory can be used directly as a variable.*/
+        }
         else if(LV_COLOR_FORMAT_IS_INDEXED(cf)) {
             if(dsc->args.use_indexed) {
                 /*Palette for indexed image and whole image of A8 image are always loaded to RAM for simplicity*/
@@ -415,6 +437,8 @@ lv_result_t lv_bin_decoder_get_area(lv_image_decoder_t * decoder, lv_image_decod
         return LV_RESULT_INVALID;
     }
 
+    if(decoder_data->block_offsets) return decode_row_block(dsc, full_area, decoded_area);
+
     lv_fs_file_t * f = decoder_data->f;
     uint32_t bpp = lv_color_format_get_bpp(cf);
     int32_t w_px = lv_area_get_width(full_area);
@@ -560,6 +584,8 @@ static void free_decoder_data(lv_image_decoder_dsc_t * dsc)
     if(decoder_data->decoded) lv_draw_buf_destroy(decoder_data->decoded);
     if(decoder_data->decompressed) lv_draw_buf_destroy(decoder_data->decompressed);
     lv_free(decoder_data->palette);
+    lv_free(decoder_data->block_offsets);
+    lv_free(decoder_data->block_buf);
     lv_free(decoder_data);
     dsc->user_data = NULL;
 }
@@ -913,45 +939,99 @@ static lv_result_t decode_alpha_only(lv_image_decoder_t * decoder, lv_image_deco
     return LV_RESULT_OK;
 }
 
-static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
+/**
+ * Get the pixels of an uncompressed file if it's mapped to the memory and they can be used directly
+ * @param dsc           pointer to the decoder descriptor
+ * @param data_size     store the size of the data after the header here (can be NULL)
+ * @return              pointer to the data after the header or NULL if the file needs to be read
+ */
+static const uint8_t * get_mapped_data(lv_image_decoder_dsc_t * dsc, uint32_t * data_size)
 {
-#if LV_BIN_DECODER_RAM_LOAD
-    uint32_t rn;
-    uint32_t len;
-    uint32_t compressed_len;
-    decoder_data_t * decoder_data = get_decoder_data(dsc);
-    lv_result_t res;
-    lv_fs_res_t fs_res;
-    uint8_t * file_buf = NULL;
-    lv_image_compressed_t * compressed = &decoder_data->compressed;
+    decoder_data_t * decoder_data = dsc->user_data;
+    lv_color_format_t cf = dsc->header.cf;
 
-    lv_memzero(compressed, sizeof(lv_image_compressed_t));
+    /*Only the formats which are used directly from variables too*/
+    if(LV_COLOR_FORMAT_IS_INDEXED(cf) || (LV_COLOR_FORMAT_IS_ALPHA_ONLY(cf) && cf != LV_COLOR_FORMAT_A8)) {
+        return NULL;
+    }
 
-    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
-        lv_fs_file_t * f = decoder_data->f;
+    uint32_t map_size;
+    const uint8_t * map = lv_fs_get_mapped_ptr(decoder_data->f, &map_size);
+    if(map == NULL || map_size < sizeof(lv_image_header_t)) {
+        return NULL;
+    }
 
-        if(lv_fs_seek(f, 0, LV_FS_SEEK_END) != LV_FS_RES_OK ||
-           lv_fs_tell(f, &compressed_len) != LV_FS_RES_OK) {
-            LV_LOG_WARN("Failed to get compressed file len");
-            return LV_RESULT_INVALID;
-        }
+    /*The data follows the header, it's read to an aligned buffer if the draw units can't use it*/
+    const uint8_t * data = map + sizeof(lv_image_header_t);
+    if(lv_draw_buf_align((void *)data, cf) != data) {
+        return NULL;
+    }
 
-        compressed_len -= sizeof(lv_image_header_t);
-        compressed_len -= 12;
+    if(data_size) *data_size = map_size - sizeof(lv_image_header_t);
+    return data;
+}
 
-        /*Read compress header*/
-        len = 12;
-        fs_res = fs_read_file_at(f, sizeof(lv_image_header_t), compressed, len, &rn);
-        if(fs_res != LV_FS_RES_OK || rn != len) {
-            LV_LOG_WARN("Read compressed header failed: %d, with len: %" LV_PRIu32 ", expected: %" LV_PRIu32, fs_res, rn, len);
-            return LV_RESULT_INVALID;
-        }
+/**
+ * Use the pixels of an uncompressed file directly, see `get_mapped_data`
+ * @param dsc     pointer to the decoder descriptor
+ * @return LV_RESULT_OK: `dsc->decoded` points to the file's data; LV_RESULT_INVALID: the file is truncated
+ */
+static lv_result_t decode_mapped(lv_image_decoder_dsc_t * dsc)
+{
+    decoder_data_t * decoder_data = dsc->user_data;
 
-        if(compressed->compressed_size != compressed_len) {
-            LV_LOG_WARN("Compressed size mismatch: %" LV_PRIu32" != %" LV_PRIu32, compressed->compressed_size, compressed_len);
-            return LV_RESULT_INVALID;
-        }
+    lv_image_dsc_t image;
+    lv_memzero(&image, sizeof(image));
+    image.header = dsc->header;
+    image.header.flags &= ~(LV_IMAGE_FLAGS_MODIFIABLE | LV_IMAGE_FLAGS_ALLOCATED);   /*The mapping is read only*/
+    image.data = get_mapped_data(dsc, &image.data_size);
+
+    /*If the file doesn't have stride, treat it as lvgl v8 legacy image format like the variables*/
+    lv_color_format_t cf = image.header.cf;
+    if(image.header.stride == 0) image.header.stride = (image.header.w * lv_color_format_get_bpp(cf) + 7) >> 3;
+
+    uint32_t size_expected = image.header.stride * image.header.h;
+    if(cf == LV_COLOR_FORMAT_RGB565A8) size_expected += (image.header.stride / 2) * image.header.h;    /*A8 mask*/
+    if(image.data_size < size_expected) {
+        LV_LOG_WARN("Truncated file, %" LV_PRIu32 " bytes instead of %" LV_PRIu32, image.data_size, size_expected);
+        return LV_RESULT_INVALID;
+    }
+
+    if(lv_draw_buf_from_image(&decoder_data->c_array, &image) != LV_RESULT_OK) {
+        return LV_RESULT_INVALID;
+    }
+
+    dsc->decoded = &decoder_data->c_array;
+    return LV_RESULT_OK;
+}
+
+static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
+{
+    decoder_data_t * decoder_data = get_decoder_data(dsc);
+    if(decoder_data == NULL) {
+        return LV_RESULT_INVALID;
+    }
+
+    lv_result_t res = load_compressed_header(dsc);
+    if(res != LV_RESULT_OK) {
+        return res;
+    }
+
+    lv_image_compressed_t * compressed = &decoder_data->compressed;
+
+    /*Row blocks are decompressed on demand in get_area_cb, so they don't need RAM for the whole image*/
+    if(compressed->block_rows) {
+        return load_row_blocks(dsc);
+    }
+
+#if LV_BIN_DECODER_RAM_LOAD
+    uint32_t rn;
+    uint32_t compressed_len = compressed->compressed_size;
+    lv_fs_res_t fs_res;
+    uint8_t * file_buf = NULL;
 
+    /*Files mapped to the memory are used directly*/
+    if(compressed->data == NULL) {
         file_buf = lv_malloc(compressed_len);
         if(file_buf == NULL) {
             LV_LOG_WARN("No memory for compressed file");
@@ -959,8 +1039,9 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
 
         }
 
-        /*Continue to read the compressed data following compression header*/
-        fs_res = lv_fs_read(f, file_buf, compressed_len, &rn);
+        /*Read the compressed data following compression header*/
+        fs_res = fs_read_file_at(decoder_data->f, sizeof(lv_image_header_t) + COMPRESSED_HEADER_SIZE, file_buf,
+                                 compressed_len, &rn);
         if(fs_res != LV_FS_RES_OK || rn != compressed_len) {
             LV_LOG_WARN("Read compressed file failed: %d, with len: %" LV_PRIu32 ", expected: %" LV_PRIu32, fs_res, rn,
                         compressed_len);
@@ -971,24 +1052,6 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
         /*Decompress the image*/
         compressed->data = file_buf;
     }
-    else if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
-        lv_image_dsc_t * image = (lv_image_dsc_t *)dsc->src;
-        compressed_len = image->data_size;
-
-        /*Read compress header*/
-        len = 12;
-        compressed_len -= len;
-        lv_memcpy(compressed, image->data, len);
-        compressed->data = image->data + len;
-        if(compressed->compressed_size != compressed_len) {
-            LV_LOG_WARN("Compressed size mismatch: %" LV_PRIu32" != %" LV_PRIu32, compressed->compressed_size, compressed_len);
-            return LV_RESULT_INVALID;
-        }
-    }
-    else {
-        LV_LOG_WARN("Compressed image only support file or variable");
-        return LV_RESULT_INVALID;
-    }
 
     res = decompress_image(dsc, compressed);
     compressed->data = NULL; /*No need to store the data any more*/
@@ -1026,12 +1089,249 @@ static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_deco
 #else
     LV_UNUSED(decompress_image);
     LV_UNUSED(decoder);
-    LV_UNUSED(dsc);
     LV_LOG_ERROR("Need LV_BIN_DECODER_RAM_LOAD to be enabled");
     return LV_RESULT_INVALID;
 #endif
 }
 
+/**
+ * Read the compression header and check the size of the compressed data
+ * @param dsc     pointer to the decoder descriptor
+ * @return LV_RESULT_OK: no error; LV_RESULT_INVALID: invalid header
+ */
+static lv_result_t load_compressed_header(lv_image_decoder_dsc_t * dsc)
+{
+    uint32_t rn;
+    uint32_t len = COMPRESSED_HEADER_SIZE;
+    uint32_t compressed_len;
+    decoder_data_t * decoder_data = dsc->user_data;
+    lv_fs_res_t fs_res;
+    lv_image_compressed_t * compressed = &decoder_data->compressed;
+
+    lv_memzero(compressed, sizeof(lv_image_compressed_t));
+
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        lv_fs_file_t * f = decoder_data->f;
+
+        if(lv_fs_seek(f, 0, LV_FS_SEEK_END) != LV_FS_RES_OK ||
+           lv_fs_tell(f, &compressed_len) != LV_FS_RES_OK) {
+            LV_LOG_WARN("Failed to get compressed file len");
+            return LV_RESULT_INVALID;
+        }
+
+        compressed_len -= sizeof(lv_image_header_t);
+        compressed_len -= len;
+
+        /*Read compress header*/
+        fs_res = fs_read_file_at(f, sizeof(lv_image_header_t), compressed, len, &rn);
+        if(fs_res != LV_FS_RES_OK || rn != len) {
+            LV_LOG_WARN("Read compressed header failed: %d, with len: %" LV_PRIu32 ", expected: %" LV_PRIu32, fs_res, rn, len);
+            return LV_RESULT_INVALID;
+        }
+
+        /*If the file is mapped to the memory, the compressed data can be used from there as from a variable*/
+        uint32_t map_size;
+        const uint8_t * map = lv_fs_get_mapped_ptr(f, &map_size);
+        if(map && map_size == sizeof(lv_image_header_t) + len + compressed_len) {
+            compressed->data = map + sizeof(lv_image_header_t) + len;
+        }
+    }
+    else if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
+        lv_image_dsc_t * image = (lv_image_dsc_t *)dsc->src;
+        compressed_len = image->data_size;
+
+        /*Read compress header*/
+        compressed_len -= len;
+        lv_memcpy(compressed, image->data, len);
+        compressed->data = image->data + len;
+    }
+    else {
+        LV_LOG_WARN("Compressed image only support file or variable");
+        return LV_RESULT_INVALID;
+    }
+
+    if(compressed->compressed_size != compressed_len) {
+        LV_LOG_WARN("Compressed size mismatch: %" LV_PRIu32" != %" LV_PRIu32, compressed->compressed_size, compressed_len);
+        return LV_RESULT_INVALID;
+    }
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Load the offset table of an image compressed in row blocks and
+ * allocate a buffer to read one compressed block from file.
+ * @param dsc     pointer to the decoder descriptor
+ * @return LV_RESULT_OK: the blocks can be decoded by `decode_row_block`; LV_RESULT_INVALID: error
+ */
+static lv_result_t load_row_blocks(lv_image_decoder_dsc_t * dsc)
+{
+    decoder_data_t * decoder_data = dsc->user_data;
+    const lv_image_compressed_t * compressed = &decoder_data->compressed;
+    lv_color_format_t cf = dsc->header.cf;
+
+    /*Only the formats whose rows are stored in one plane*/
+    if(cf != LV_COLOR_FORMAT_ARGB8888 && cf != LV_COLOR_FORMAT_XRGB8888 && cf != LV_COLOR_FORMAT_RGB888
+       && cf != LV_COLOR_FORMAT_RGB565 && cf != LV_COLOR_FORMAT_RGB565_SWAPPED && cf != LV_COLOR_FORMAT_ARGB8565) {
+        LV_LOG_WARN("CF: %d is not supported with row blocks", cf);
+        return LV_RESULT_INVALID;
+    }
+
+    if(!compress_method_is_enabled(compressed->method)) {
+        return LV_RESULT_INVALID;
+    }
+
+    if(compressed->decompressed_size != dsc->header.h * dsc->header.stride) {
+        LV_LOG_WARN("Decompressed size mismatch: %" LV_PRIu32 " != %" LV_PRIu32, compressed->decompressed_size,
+                    (uint32_t)(dsc->header.h * dsc->header.stride));
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t block_cnt = (dsc->header.h + compressed->block_rows - 1) / compressed->block_rows;
+    uint32_t table_size = (block_cnt + 1) * sizeof(uint32_t);
+    if(table_size > compressed->compressed_size) {
+        LV_LOG_WARN("Row block table doesn't fit: %" LV_PRIu32 " > %" LV_PRIu32, table_size, compressed->compressed_size);
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t * offsets = lv_malloc(table_size);
+    if(offsets == NULL) {
+        LV_LOG_WARN("No memory for row block table");
+        return LV_RESULT_INVALID;
+    }
+    decoder_data->block_offsets = offsets; /*Free on decoder close*/
+
+    if(compressed->data == NULL) {
+        uint32_t rn;
+        lv_fs_res_t fs_res = fs_read_file_at(decoder_data->f, sizeof(lv_image_header_t) + COMPRESSED_HEADER_SIZE, offsets,
+                                             table_size, &rn);
+        if(fs_res != LV_FS_RES_OK || rn != table_size) {
+            LV_LOG_WARN("Read row block table failed: %d", fs_res);
+            return LV_RESULT_INVALID;
+        }
+    }
+    else {
+        lv_memcpy(offsets, compressed->data, table_size);
+    }
+
+    /*Validate the table once to trust it when decoding and find the largest block*/
+    uint32_t data_size = compressed->compressed_size - table_size;
+    uint32_t block_size_max = 0;
+    uint32_t i;
+    for(i = 0; i < block_cnt; i++) {
+        if(offsets[i] > offsets[i + 1] || offsets[i + 1] > data_size) {
+            LV_LOG_WARN("Invalid row block offset: %" LV_PRIu32, i);
+            return LV_RESULT_INVALID;
+        }
+
+        block_size_max = LV_MAX(block_size_max, offsets[i + 1] - offsets[i]);
+    }
+
+    if(compressed->data == NULL) {
+        decoder_data->block_buf = lv_malloc(block_size_max);
+        if(decoder_data->block_buf == NULL) {
+            LV_LOG_WARN("No memory for row block: %" LV_PRIu32, block_size_max);
+            return LV_RESULT_INVALID;
+        }
+    }
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Decompress the row block of the first row which is not decoded yet.
+ * The decoded area is wider and taller than needed if the block is larger than `full_area`.
+ * @param dsc           pointer to the decoder descriptor
+ * @param full_area     the whole area to decode
+ * @param decoded_area  the area decoded in the previous call, `y1` is `LV_COORD_MIN` on the first call
+ * @return LV_RESULT_OK: a block is decoded; LV_RESULT_INVALID: no more rows or error
+ */
+static lv_result_t decode_row_block(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
+                                    lv_area_t * decoded_area)
+{
+    decoder_data_t * decoder_data = dsc->user_data;
+    const lv_image_compressed_t * compressed = &decoder_data->compressed;
+    lv_color_format_t cf = dsc->header.cf;
+    int32_t w = dsc->header.w;
+    int32_t h = dsc->header.h;
+    int32_t block_rows = compressed->block_rows;
+    uint32_t stride = dsc->header.stride;
+
+    int32_t y = decoded_area->y1 == LV_COORD_MIN ? full_area->y1 : decoded_area->y2 + 1;
+    if(y > full_area->y2 || y >= h) {
+        return LV_RESULT_INVALID;
+    }
+
+    lv_draw_buf_t * decoded = decoder_data->decoded_partial;
+    if(decoded == NULL) {
+        /*Leave space to align the stride if needed*/
+        uint32_t stride_max = LV_MAX(stride, lv_draw_buf_width_to_stride(w, cf));
+        decoded = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, w, block_rows, cf, stride_max);
+        if(decoded == NULL) {
+            return LV_RESULT_INVALID;
+        }
+
+        if(dsc->header.flags & LV_IMAGE_FLAGS_PREMULTIPLIED) {
+            lv_draw_buf_set_flag(decoded, LV_IMAGE_FLAGS_PREMULTIPLIED);
+        }
+
+        decoder_data->decoded_partial = decoded; /*Free on decoder close*/
+    }
+
+    uint32_t block = y / block_rows;
+    int32_t y1 = block * block_rows;
+    int32_t y2 = LV_MIN(y1 + block_rows, h) - 1;
+    uint32_t out_len = (y2 - y1 + 1) * stride;
+    decoded = lv_draw_buf_reshape(decoded, cf, w, y2 - y1 + 1, stride);
+    if(decoded == NULL) {
+        return LV_RESULT_INVALID;
+    }
+
+    const uint32_t * offsets = decoder_data->block_offsets;
+    uint32_t block_cnt = (h + block_rows - 1) / block_rows;
+    uint32_t block_pos = (block_cnt + 1) * sizeof(uint32_t) + offsets[block];
+    uint32_t block_size = offsets[block + 1] - offsets[block];
+    const uint8_t * block_data;
+    if(compressed->data == NULL) {
+        uint32_t rn;
+        lv_fs_res_t res = fs_read_file_at(decoder_data->f, sizeof(lv_image_header_t) + COMPRESSED_HEADER_SIZE + block_pos,
+                                          decoder_data->block_buf, block_size, &rn);
+        if(res != LV_FS_RES_OK || rn != block_size) {
+            LV_LOG_WARN("Read row block %" LV_PRIu32 " failed: %d", block, res);
+            return LV_RESULT_INVALID;
+        }
+
+        block_data = decoder_data->block_buf;
+    }
+    else {
+        block_data = compressed->data + block_pos;
+    }
+
+    uint32_t len = decompress_data(compressed->method, cf, block_data, block_size, decoded->data, out_len);
+    if(len != out_len) {
+        LV_LOG_WARN("Decompress row block %" LV_PRIu32 " failed: %" LV_PRIu32 ", got: %" LV_PRIu32, block, out_len, len);
+        return LV_RESULT_INVALID;
+    }
+
+    /*The same adjustments as `lv_image_decoder_post_process` does on whole images, but in place*/
+    if(dsc->args.stride_align && lv_draw_buf_adjust_stride(decoded, 0) != LV_RESULT_OK) {
+        return LV_RESULT_INVALID;
+    }
+
+    if(dsc->args.premultiply && lv_color_format_has_alpha(cf)
+       && !(dsc->header.flags & LV_IMAGE_FLAGS_PREMULTIPLIED)) {
+        lv_draw_buf_premultiply(decoded);
+    }
+
+    decoded_area->x1 = 0;
+    decoded_area->x2 = w - 1;
+    decoded_area->y1 = y1;
+    decoded_area->y2 = y2;
+
+    dsc->decoded = decoded; /*Return decoded image*/
+    return LV_RESULT_OK;
+}
+
 static lv_result_t decode_indexed_line(lv_color_format_t color_format, const lv_color32_t * palette, int32_t x,
                                        int32_t w_px, const uint8_t * in, lv_color32_t * out)
 {
@@ -1085,6 +1385,18 @@ static lv_fs_res_t fs_read_file_at(lv_fs_file_t * f, uint32_t pos, void * buff,
     lv_fs_res_t res;
     if(br) *br = 0;
 
+    /*Copying from a file mapped to the memory is cheaper than seeking and reading*/
+    uint32_t map_size;
+    const uint8_t * map = lv_fs_get_mapped_ptr(f, &map_size);
+    if(map) {
+        if(pos < map_size) {
+            btr = LV_MIN(btr, map_size - pos);
+            lv_memcpy(buff, map + pos, btr);
+            if(br) *br = btr;
+        }
+        return LV_FS_RES_OK;
+    }
+
     res = lv_fs_seek(f, pos, LV_FS_SEEK_SET);
     if(res != LV_FS_RES_OK) {
         return res;
@@ -1103,20 +1415,7 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
     /* At least one compression method must be enabled */
 #if (LV_USE_LZ4 || LV_USE_RLE)
     /* Check if the decompression method is enabled and valid */
-    if(compressed->method == LV_IMAGE_COMPRESS_RLE) {
-#if !LV_USE_RLE
-        LV_LOG_WARN("RLE decompression is not enabled");
-        return LV_RESULT_INVALID;
-#endif
-    }
-    else if(compressed->method == LV_IMAGE_COMPRESS_LZ4) {
-#if !LV_USE_LZ4
-        LV_LOG_WARN("LZ4 decompression is not enabled");
-        return LV_RESULT_INVALID;
-#endif
-    }
-    else {
-        LV_LOG_WARN("Unknown compression method: %" LV_PRIu32, compressed->method);
+    if(!compress_method_is_enabled(compressed->method)) {
         return LV_RESULT_INVALID;
     }
 
@@ -1126,10 +1425,9 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
         return LV_RESULT_INVALID;
     }
 
-    uint8_t * img_data;
     uint32_t out_len = compressed->decompressed_size;
     uint32_t input_len = compressed->compressed_size;
-    uint32_t len = 0;
+    uint32_t len;
 
     lv_draw_buf_t * decompressed = lv_draw_buf_create_ex(image_cache_draw_buf_handlers, dsc->header.w, dsc->header.h,
                                                          dsc->header.cf,
@@ -1145,29 +1443,80 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
         return LV_RESULT_INVALID;
     }
 
-    img_data = decompressed->data;
+    len = decompress_data(compressed->method, dsc->header.cf, compressed->data, input_len, decompressed->data, out_len);
+    if(len != compressed->decompressed_size) {
+        LV_LOG_WARN("Decompress failed: %" LV_PRIu32 ", got: %" LV_PRIu32, out_len, len);
+        lv_draw_buf_destroy(decompressed);
+        return LV_RESULT_INVALID;
+    }
 
-    if(compressed->method == LV_IMAGE_COMPRESS_RLE) {
+    decoder_data->decompressed = decompressed; /*Free on decoder close*/
+    return LV_RESULT_OK;
+#else
+    LV_UNUSED(dsc);
+    LV_UNUSED(compressed);
+    LV_LOG_WARN("At least one compression method must be enabled");
+    return LV_RESULT_INVALID;
+#endif /* (LV_USE_LZ4 || LV_USE_RLE) */
+}
+
+static bool compress_method_is_enabled(uint32_t method)
+{
+    if(method == LV_IMAGE_COMPRESS_RLE) {
+#if !LV_USE_RLE
+        LV_LOG_WARN("RLE decompression is not enabled");
+        return false;
+#endif
+    }
+    else if(method == LV_IMAGE_COMPRESS_LZ4) {
+#if !LV_USE_LZ4
+        LV_LOG_WARN("LZ4 decompression is not enabled");
+        return false;
+#endif
+    }
+    else {
+        LV_LOG_WARN("Unknown compression method: %" LV_PRIu32, method);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Decompress data with an enabled compression method
+ * @param method        the compression method, see `lv_image_compress_t`
+ * @param cf            color format of the image, RLE works on pixels
+ * @param input         the compressed data
+ * @param input_len     length of the compressed data
+ * @param output        buffer for the decompressed data
+ * @param output_len    size of `output`
+ * @return              length of the decompressed data, 0 on error
+ */
+static uint32_t decompress_data(uint32_t method, lv_color_format_t cf, const uint8_t * input, uint32_t input_len,
+                                uint8_t * output, uint32_t output_len)
+{
+    uint32_t len = 0;
+    LV_UNUSED(cf);
+    LV_UNUSED(input);
+    LV_UNUSED(input_len);
+    LV_UNUSED(output);
+    LV_UNUSED(output_len);
+
+    if(method == LV_IMAGE_COMPRESS_RLE) {
 #if LV_USE_RLE
         /*Compress always happen on byte*/
         uint32_t pixel_byte;
-        if(dsc->header.cf == LV_COLOR_FORMAT_RGB565A8)
+        if(cf == LV_COLOR_FORMAT_RGB565A8)
             pixel_byte = 2;
         else
-            pixel_byte = (lv_color_format_get_bpp(dsc->header.cf) + 7) >> 3;
-
-        const uint8_t * input = compressed->data;
-        uint8_t * output = img_data;
+            pixel_byte = (lv_color_format_get_bpp(cf) + 7) >> 3;
 
-        len = lv_rle_decompress(input, input_len, output, out_len, pixel_byte);
+        len = lv_rle_decompress(input, input_len, output, output_len, pixel_byte);
 #endif /* LV_USE_RLE */
     }
-    else if(compressed->method == LV_IMAGE_COMPRESS_LZ4) {
+    else if(method == LV_IMAGE_COMPRESS_LZ4) {
 #if LV_USE_LZ4
-        const char * input = (const char *)compressed->data;
-        char * output = (char *)img_data;
-
-        int ret = LZ4_decompress_safe(input, output, (int)input_len, (int)out_len);
+        int ret = LZ4_decompress_safe((const char *)input, (char *)output, (int)input_len, (int)output_len);
         if(ret >= 0) {
             /* Cast is safe because of the above check */
             len = (uint32_t)ret;
@@ -1175,18 +1524,5 @@ static lv_result_t decompress_image(lv_image_decoder_dsc_t * dsc, const lv_image
 #endif /* LV_USE_LZ4 */
     }
 
-    if(len != compressed->decompressed_size) {
-        LV_LOG_WARN("Decompress failed: %" LV_PRIu32 ", got: %" LV_PRIu32, out_len, len);
-        lv_draw_buf_destroy(decompressed);
-        return LV_RESULT_INVALID;
-    }
-
-    decoder_data->decompressed = decompressed; /*Free on decoder close*/
-    return LV_RESULT_OK;
-#else
-    LV_UNUSED(dsc);
-    LV_UNUSED(compressed);
-    LV_LOG_WARN("At least one compression method must be enabled");
-    return LV_RESULT_INVALID;
-#endif /* (LV_USE_LZ4 || LV_USE_RLE) */
+    return len;
 }
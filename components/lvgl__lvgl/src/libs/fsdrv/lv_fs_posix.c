@@ -13,9 +13,16 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <dirent.h>
 #include <unistd.h>
 #include <errno.h>
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+    #include <sys/mman.h>
+    #define FS_POSIX_MMAP 1
+#else
+    #define FS_POSIX_MMAP 0
+#endif
 #include "../../core/lv_global.h"
 
 /*********************
@@ -26,16 +33,18 @@
     #error "Invalid drive letter"
 #endif
 
-/** The reason for 'fd + 1' is because open() may return a legal fd with a value of 0,
-  * preventing it from being judged as NULL when converted to a pointer type.
-  */
-#define FILEP2FD(file_p) ((lv_uintptr_t)file_p - 1)
-#define FD2FILEP(fd) ((void *)(lv_uintptr_t)(fd + 1))
-
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    int fd;
+    bool map_disabled;      /*Not opened for reading only or mapping failed*/
+    void * map;             /*The whole file mapped to the memory on the first request*/
+    uint32_t map_size;
+    uint32_t map_pos;       /*Position of the reads once the file is mapped*/
+} posix_file_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -45,6 +54,7 @@ static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_
 static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
 static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
 static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static const void * fs_get_mapped_ptr(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
 static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
 static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn, uint32_t fn_len);
 static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
@@ -84,6 +94,7 @@ void lv_fs_posix_init(void)
     fs_drv_p->write_cb = fs_write;
     fs_drv_p->seek_cb = fs_seek;
     fs_drv_p->tell_cb = fs_tell;
+    fs_drv_p->get_mapped_ptr_cb = fs_get_mapped_ptr;
 
     fs_drv_p->dir_close_cb = fs_dir_close;
     fs_drv_p->dir_open_cb = fs_dir_open;
@@ -122,7 +133,16 @@ static void * fs_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
         return NULL;
     }
 
-    return FD2FILEP(fd);
+    posix_file_t * file = lv_malloc_zeroed(sizeof(posix_file_t));
+    LV_ASSERT_MALLOC(file);
+    if(file == NULL) {
+        close(fd);
+        return NULL;
+    }
+
+    file->fd = fd;
+    file->map_disabled = mode != LV_FS_MODE_RD;
+    return file;
 }
 
 /**
@@ -136,7 +156,13 @@ static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p)
 {
     LV_UNUSED(drv);
 
-    int fd = FILEP2FD(file_p);
+    posix_file_t * file = file_p;
+    int fd = file->fd;
+#if FS_POSIX_MMAP
+    if(file->map) munmap(file->map, file->map_size);
+#endif
+    lv_free(file);
+
     int ret = close(fd);
     if(ret < 0) {
         LV_LOG_WARN("Could not close file: %d, errno: %d", fd, errno);
@@ -160,7 +186,19 @@ static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_
 {
     LV_UNUSED(drv);
 
-    int fd = FILEP2FD(file_p);
+    posix_file_t * file = file_p;
+    if(file->map) {
+        /*Read from the memory once it's mapped instead of calling `read()`*/
+        *br = 0;
+        if(file->map_pos < file->map_size) {
+            *br = LV_MIN(btr, file->map_size - file->map_pos);
+            lv_memcpy(buf, (uint8_t *)file->map + file->map_pos, *br);
+            file->map_pos += *br;
+        }
+        return LV_FS_RES_OK;
+    }
+
+    int fd = file->fd;
     ssize_t ret = read(fd, buf, btr);
     if(ret < 0) {
         LV_LOG_WARN("Could not read file: %d, errno: %d", fd, errno);
@@ -184,7 +222,7 @@ static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf,
 {
     LV_UNUSED(drv);
 
-    int fd = FILEP2FD(file_p);
+    int fd = ((posix_file_t *)file_p)->fd;
     ssize_t ret = write(fd, buf, btw);
     if(ret < 0) {
         LV_LOG_WARN("Could not write file: %d, errno: %d", fd, errno);
@@ -221,7 +259,15 @@ static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs
             return LV_FS_RES_INV_PARAM;
     }
 
-    int fd = FILEP2FD(file_p);
+    posix_file_t * file = file_p;
+    if(file->map) {
+        if(whence == LV_FS_SEEK_CUR) pos += file->map_pos;
+        else if(whence == LV_FS_SEEK_END) pos += file->map_size;
+        file->map_pos = pos;
+        return LV_FS_RES_OK;
+    }
+
+    int fd = file->fd;
     off_t offset = lseek(fd, pos, w);
     if(offset < 0) {
         LV_LOG_WARN("Could not seek file: %d, errno: %d", fd, errno);
@@ -243,7 +289,13 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
 {
     LV_UNUSED(drv);
 
-    int fd = FILEP2FD(file_p);
+    posix_file_t * file = file_p;
+    if(file->map) {
+        *pos_p = file->map_pos;
+        return LV_FS_RES_OK;
+    }
+
+    int fd = file->fd;
     off_t offset = lseek(fd, 0, SEEK_CUR);
     if(offset < 0) {
         LV_LOG_WARN("Could not get position of file: %d, errno: %d", fd, errno);
@@ -254,6 +306,47 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
     return LV_FS_RES_OK;
 }
 
+/**
+ * Map a file opened for reading to the memory
+ * @param drv       pointer to a driver where this function belongs
+ * @param file_p    a file handle variable
+ * @param size_p    pointer to store the size of the file
+ * @return pointer to the mapped file or NULL if mapping is not possible
+ */
+static const void * fs_get_mapped_ptr(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p)
+{
+    LV_UNUSED(drv);
+
+    posix_file_t * file = file_p;
+#if FS_POSIX_MMAP
+    if(file->map == NULL && !file->map_disabled) {
+        struct stat st;
+        /*Empty files can't be mapped*/
+        if(fstat(file->fd, &st) < 0 || st.st_size <= 0 || (uint64_t)st.st_size > UINT32_MAX) {
+            file->map_disabled = true;
+            return NULL;
+        }
+
+        /*Reads continue from the same position in the mapping*/
+        off_t pos = lseek(file->fd, 0, SEEK_CUR);
+        void * map = pos < 0 ? MAP_FAILED : mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, file->fd, 0);
+        if(map == MAP_FAILED) {
+            LV_LOG_WARN("Could not map file: %d, errno: %d", file->fd, errno);
+            file->map_disabled = true;
+            return NULL;
+        }
+
+        file->map_pos = (uint32_t)pos;
+
+        file->map = map;
+        file->map_size = (uint32_t)st.st_size;
+    }
+#endif
+
+    *size_p = file->map_size;
+    return file->map;
+}
+
 /**
  * Initialize a 'fs_read_dir_t' variable for directory reading
  * @param drv   pointer to a driver where this function belongs
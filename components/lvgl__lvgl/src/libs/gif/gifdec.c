@@ -2,6 +2,7 @@
 #include "../../misc/lv_log.h"
 #include "../../stdlib/lv_mem.h"
 #include "../../misc/lv_color.h"
+#include "../../draw/lv_draw_buf.h"
 #if LV_USE_GIF
 
 #include <stdlib.h>
@@ -34,6 +35,7 @@ static bool f_gif_open(gd_GIF * gif, const void * path, bool is_file);
 static void f_gif_read(gd_GIF * gif, void * buf, size_t len);
 static int f_gif_seek(gd_GIF * gif, size_t pos, int k);
 static void f_gif_close(gd_GIF * gif);
+static void fill_canvas_rect(gd_GIF * gif, int x, int y, int w, int h, const uint8_t * color, uint8_t opa);
 
 #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
     #include "gifdec_mve.h"
@@ -49,10 +51,11 @@ read_num(gd_GIF * gif)
 }
 
 gd_GIF *
-gd_open_gif_file(const char * fname)
+gd_open_gif_file(const char * fname, lv_color_format_t color_format)
 {
     gd_GIF gif_base;
     memset(&gif_base, 0, sizeof(gif_base));
+    gif_base.color_format = color_format;
 
     bool res = f_gif_open(&gif_base, fname, true);
     if(!res) return NULL;
@@ -61,10 +64,11 @@ gd_open_gif_file(const char * fname)
 }
 
 gd_GIF *
-gd_open_gif_data(const void * data)
+gd_open_gif_data(const void * data, lv_color_format_t color_format)
 {
     gd_GIF gif_base;
     memset(&gif_base, 0, sizeof(gif_base));
+    gif_base.color_format = color_format;
 
     bool res = f_gif_open(&gif_base, data, false);
     if(!res) return NULL;
@@ -80,6 +84,7 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     uint8_t * bgcolor;
     int gct_sz;
     gd_GIF * gif = NULL;
+    uint32_t px_size;
 
     /* Header */
     f_gif_read(gif_base, sigver, 3);
@@ -112,23 +117,29 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     f_gif_read(gif_base, &bgidx, 1);
     /* Aspect Ratio */
     f_gif_read(gif_base, &aspect, 1);
+    /* Canvas Color Format */
+    if(gif_base->color_format != LV_COLOR_FORMAT_ARGB8888 && gif_base->color_format != LV_COLOR_FORMAT_RGB565) {
+        LV_LOG_WARN("unsupported canvas color format");
+        goto fail;
+    }
+    px_size = lv_color_format_get_size(gif_base->color_format);
     /* Create gd_GIF Structure. */
     if(0 == width || 0 == height){
         LV_LOG_WARN("Zero size image");
         goto fail;
     }
 #if LV_GIF_CACHE_DECODE_DATA
-    if(0 == (INT_MAX - sizeof(gd_GIF) - LZW_CACHE_SIZE) / width / height / 5){
+    if(0 == (INT_MAX - sizeof(gd_GIF) - LV_DRAW_BUF_ALIGN - LZW_CACHE_SIZE) / width / height / (px_size + 1)){
         LV_LOG_WARN("Image dimensions are too large");
         goto fail;
     } 
-    gif = lv_malloc(sizeof(gd_GIF) + 5 * width * height + LZW_CACHE_SIZE);
+    gif = lv_malloc(sizeof(gd_GIF) + LV_DRAW_BUF_ALIGN + (px_size + 1) * width * height + LZW_CACHE_SIZE);
     #else
-    if(0 == (INT_MAX - sizeof(gd_GIF)) / width / height / 5){
+    if(0 == (INT_MAX - sizeof(gd_GIF) - LV_DRAW_BUF_ALIGN) / width / height / (px_size + 1)){
         LV_LOG_WARN("Image dimensions are too large");
         goto fail;
     } 
-    gif = lv_malloc(sizeof(gd_GIF) + 5 * width * height);
+    gif = lv_malloc(sizeof(gd_GIF) + LV_DRAW_BUF_ALIGN + (px_size + 1) * width * height);
     #endif
     if(!gif) goto fail;
     memcpy(gif, gif_base, sizeof(gd_GIF));
@@ -140,8 +151,9 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     f_gif_read(gif, gif->gct.colors, 3 * gif->gct.size);
     gif->palette = &gif->gct;
     gif->bgindex = bgidx;
-    gif->canvas = (uint8_t *) &gif[1];
-    gif->frame = &gif->canvas[4 * width * height];
+    /* Align the canvas to draw it directly */
+    gif->canvas = lv_draw_buf_align(&gif[1], gif->color_format);
+    gif->frame = &gif->canvas[px_size * width * height];
     if(gif->bgindex) {
         memset(gif->frame, gif->bgindex, gif->width * gif->height);
     }
@@ -150,16 +162,7 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     gif->lzw_cache = gif->frame + width * height;
     #endif
 
-#ifdef GIFDEC_FILL_BG
-    GIFDEC_FILL_BG(gif->canvas, gif->width * gif->height, 1, gif->width * gif->height, bgcolor, 0xff);
-#else
-    for(int i = 0; i < gif->width * gif->height; i++) {
-        gif->canvas[i * 4 + 0] = *(bgcolor + 2);
-        gif->canvas[i * 4 + 1] = *(bgcolor + 1);
-        gif->canvas[i * 4 + 2] = *(bgcolor + 0);
-        gif->canvas[i * 4 + 3] = 0xff;
-    }
-#endif
+    fill_canvas_rect(gif, 0, 0, gif->width, gif->height, bgcolor, 0xff);
     gif->anim_start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     gif->loop_count = -1;
     goto ok;
@@ -662,14 +665,34 @@ static void
 render_frame_rect(gd_GIF * gif, uint8_t * buffer)
 {
     int i = gif->fy * gif->width + gif->fx;
+    int j, k;
+    uint8_t index, * color;
+
+    if(gif->color_format == LV_COLOR_FORMAT_RGB565) {
+        /* Convert the palette only once per frame */
+        uint16_t colors[0x100];
+        uint16_t * buffer16 = (uint16_t *) buffer;
+        for(j = 0; j < gif->palette->size; j++) {
+            color = &gif->palette->colors[j * 3];
+            colors[j] = lv_color_to_u16(lv_color_make(color[0], color[1], color[2]));
+        }
+        for(j = 0; j < gif->fh; j++) {
+            for(k = 0; k < gif->fw; k++) {
+                index = gif->frame[(gif->fy + j) * gif->width + gif->fx + k];
+                if(!gif->gce.transparency || index != gif->gce.tindex) {
+                    buffer16[i + k] = colors[index];
+                }
+            }
+            i += gif->width;
+        }
+        return;
+    }
+
 #ifdef GIFDEC_RENDER_FRAME
     GIFDEC_RENDER_FRAME(&buffer[i * 4], gif->fw, gif->fh, gif->width,
                         &gif->frame[i], gif->palette->colors,
                         gif->gce.transparency ? gif->gce.tindex : 0x100);
 #else
-    int j, k;
-    uint8_t index, * color;
-
     for(j = 0; j < gif->fh; j++) {
         for(k = 0; k < gif->fw; k++) {
             index = gif->frame[(gif->fy + j) * gif->width + gif->fx + k];
@@ -686,10 +709,64 @@ render_frame_rect(gd_GIF * gif, uint8_t * buffer)
 #endif
 }
 
+/* Fill a rectangle of the canvas with a color.
+ * The RGB565 canvas has no alpha channel so `opa` is ignored there. */
+static void
+fill_canvas_rect(gd_GIF * gif, int x, int y, int w, int h, const uint8_t * color, uint8_t opa)
+{
+    int i = y * gif->width + x;
+    int j, k;
+
+    if(gif->color_format == LV_COLOR_FORMAT_RGB565) {
+        uint16_t color16 = lv_color_to_u16(lv_color_make(color[0], color[1], color[2]));
+        uint16_t * canvas16 = (uint16_t *) gif->canvas;
+        for(j = 0; j < h; j++) {
+            for(k = 0; k < w; k++) {
+                canvas16[i + k] = color16;
+            }
+            i += gif->width;
+        }
+        return;
+    }
+
+#ifdef GIFDEC_FILL_BG
+    GIFDEC_FILL_BG(&(gif->canvas[i * 4]), w, h, gif->width, color, opa);
+#else
+    for(j = 0; j < h; j++) {
+        for(k = 0; k < w; k++) {
+            gif->canvas[(i + k) * 4 + 0] = *(color + 2);
+            gif->canvas[(i + k) * 4 + 1] = *(color + 1);
+            gif->canvas[(i + k) * 4 + 2] = *(color + 0);
+            gif->canvas[(i + k) * 4 + 3] = opa;
+        }
+        i += gif->width;
+    }
+#endif
+}
+
+/* Copy the canvas under the frame rectangle to or from `gif->prev_rect` */
+static void
+copy_prev_rect(gd_GIF * gif, bool save)
+{
+    uint32_t px_size = lv_color_format_get_size(gif->color_format);
+    uint32_t line_size = gif->fw * px_size;
+    uint8_t * canvas = &gif->canvas[(gif->fy * gif->width + gif->fx) * px_size];
+    uint8_t * prev = gif->prev_rect;
+    int j;
+
+    for(j = 0; j < gif->fh; j++) {
+        if(save) memcpy(prev, canvas, line_size);
+        else memcpy(canvas, prev, line_size);
+        prev += line_size;
+        canvas += gif->width * px_size;
+    }
+}
+
+/* Dispose the current frame in the canvas. The frame rectangle is
+ * the only part of the canvas that can change. */
 static void
 dispose(gd_GIF * gif)
 {
-    int i;
     uint8_t * bgcolor;
     switch(gif->gce.disposal) {
         case 2: /* Restore to background color. */
@@ -698,27 +775,18 @@ dispose(gd_GIF * gif)
             uint8_t opa = 0xff;
             if(gif->gce.transparency) opa = 0x00;
 
-            i = gif->fy * gif->width + gif->fx;
-#ifdef GIFDEC_FILL_BG
-            GIFDEC_FILL_BG(&(gif->canvas[i * 4]), gif->fw, gif->fh, gif->width, bgcolor, opa);
-#else
-            int j, k;
-            for(j = 0; j < gif->fh; j++) {
-                for(k = 0; k < gif->fw; k++) {
-                    gif->canvas[(i + k) * 4 + 0] = *(bgcolor + 2);
-                    gif->canvas[(i + k) * 4 + 1] = *(bgcolor + 1);
-                    gif->canvas[(i + k) * 4 + 2] = *(bgcolor + 0);
-                    gif->canvas[(i + k) * 4 + 3] = opa;
-                }
-                i += gif->width;
-            }
-#endif
+            fill_canvas_rect(gif, gif->fx, gif->fy, gif->fw, gif->fh, bgcolor, opa);
             break;
-        case 3: /* Restore to previous, i.e., don't update canvas.*/
+        case 3: /* Restore to previous, i.e. the canvas before rendering the frame. */
+            if(gif->prev_rect) {
+                copy_prev_rect(gif, false);
+                lv_free(gif->prev_rect);
+                gif->prev_rect = NULL;
+            }
             break;
         default:
-            /* Add frame non-transparent pixels to canvas. */
-            render_frame_rect(gif, gif->canvas);
+            /* Leave the frame in place, it's already rendered into the canvas. */
+            break;
     }
 }
 
@@ -747,6 +815,13 @@ gd_get_frame(gd_GIF * gif)
     }
     if(read_image(gif) == -1)
         return -1;
+    if(gif->gce.disposal == 3) {
+        /* Save the canvas under the frame to restore it when disposing the frame. */
+        lv_free(gif->prev_rect);
+        gif->prev_rect = lv_malloc(gif->fw * gif->fh * lv_color_format_get_size(gif->color_format));
+        if(gif->prev_rect) copy_prev_rect(gif, true);
+        else LV_LOG_WARN("couldn't allocate the buffer to restore the previous frame");
+    }
     return 1;
 }
 
@@ -767,6 +842,7 @@ void
 gd_close_gif(gd_GIF * gif)
 {
     f_gif_close(gif);
+    lv_free(gif->prev_rect);
     lv_free(gif);
 }
 
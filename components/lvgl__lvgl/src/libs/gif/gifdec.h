@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 #include "../../misc/lv_fs.h"
+#include "../../misc/lv_color.h"
 
 #if LV_USE_GIF
 #include <stdint.h>
@@ -47,15 +48,19 @@ typedef struct _gd_GIF {
     uint16_t fx, fy, fw, fh;
     uint8_t bgindex;
     uint8_t * canvas, * frame;
+    lv_color_format_t color_format;     /* Of the canvas: ARGB8888 or RGB565 */
+    uint8_t * prev_rect;                /* Canvas under the frame to restore if the disposal is 3 */
     #if LV_GIF_CACHE_DECODE_DATA
     uint8_t *lzw_cache;
     #endif
 } gd_GIF;
 
-gd_GIF * gd_open_gif_file(const char * fname);
+gd_GIF * gd_open_gif_file(const char * fname, lv_color_format_t color_format);
 
-gd_GIF * gd_open_gif_data(const void * data);
+gd_GIF * gd_open_gif_data(const void * data, lv_color_format_t color_format);
 
+/* Render the frame rectangle into `buffer` which should be the canvas
+ * as the previous frames are disposed only in the canvas. */
 void gd_render_frame(gd_GIF * gif, uint8_t * buffer);
 
 int gd_get_frame(gd_GIF * gif);
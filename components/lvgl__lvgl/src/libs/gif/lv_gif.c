@@ -9,6 +9,7 @@
 #include "lv_gif_private.h"
 #if LV_USE_GIF
 #include "../../misc/lv_timer_private.h"
+#include "../../misc/lv_area_private.h"
 #include "../../misc/cache/lv_cache.h"
 #include "../../core/lv_obj_class_private.h"
 
@@ -29,6 +30,7 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static void invalidate_frame_area(lv_obj_t * obj, const lv_area_t * frame_area);
 
 /**********************
  *  STATIC VARIABLES
@@ -75,10 +77,10 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
     if(lv_image_src_get_type(src) == LV_IMAGE_SRC_VARIABLE) {
         const lv_image_dsc_t * img_dsc = src;
-        gif = gd_open_gif_data(img_dsc->data);
+        gif = gd_open_gif_data(img_dsc->data, gifobj->color_format);
     }
     else if(lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE) {
-        gif = gd_open_gif_file(src);
+        gif = gd_open_gif_file(src, gifobj->color_format);
     }
     if(gif == NULL) {
         LV_LOG_WARN("Couldn't load the source");
@@ -89,11 +91,11 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     gifobj->imgdsc.data = gif->canvas;
     gifobj->imgdsc.header.magic = LV_IMAGE_HEADER_MAGIC;
     gifobj->imgdsc.header.flags = LV_IMAGE_FLAGS_MODIFIABLE;
-    gifobj->imgdsc.header.cf = LV_COLOR_FORMAT_ARGB8888;
+    gifobj->imgdsc.header.cf = gif->color_format;
     gifobj->imgdsc.header.h = gif->height;
     gifobj->imgdsc.header.w = gif->width;
-    gifobj->imgdsc.header.stride = gif->width * 4;
-    gifobj->imgdsc.data_size = gif->width * gif->height * 4;
+    gifobj->imgdsc.header.stride = gif->width * lv_color_format_get_size(gif->color_format);
+    gifobj->imgdsc.data_size = gifobj->imgdsc.header.stride * gif->height;
 
     gifobj->last_call = lv_tick_get();
 
@@ -106,6 +108,18 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
 }
 
+void lv_gif_set_color_format(lv_obj_t * obj, lv_color_format_t color_format)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+
+    if(color_format != LV_COLOR_FORMAT_ARGB8888 && color_format != LV_COLOR_FORMAT_RGB565) {
+        LV_LOG_WARN("Only ARGB8888 and RGB565 are supported");
+        return;
+    }
+
+    gifobj->color_format = color_format;
+}
+
 void lv_gif_restart(lv_obj_t * obj)
 {
     lv_gif_t * gifobj = (lv_gif_t *) obj;
@@ -179,6 +193,7 @@ static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_gif_t * gifobj = (lv_gif_t *) obj;
 
     gifobj->gif = NULL;
+    gifobj->color_format = LV_COLOR_FORMAT_ARGB8888;
     gifobj->timer = lv_timer_create(next_frame_task_cb, 10, obj);
     lv_timer_pause(gifobj->timer);
 }
@@ -204,7 +219,15 @@ static void next_frame_task_cb(lv_timer_t * t)
 
     gifobj->last_call = lv_tick_get();
 
-    int has_next = gd_get_frame(gifobj->gif);
+    /*Only the disposed area of the previous frame and the new frame change*/
+    gd_GIF * gif = gifobj->gif;
+    lv_area_t inv_area;
+    lv_area_set(&inv_area, 0, 0, -1, -1);
+    if(gif->gce.disposal == 2 || gif->gce.disposal == 3) {
+        lv_area_set(&inv_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+    }
+
+    int has_next = gd_get_frame(gif);
     if(has_next == 0) {
         /*It was the last repeat*/
         lv_result_t res = lv_obj_send_event(obj, LV_EVENT_READY, NULL);
@@ -212,10 +235,41 @@ static void next_frame_task_cb(lv_timer_t * t)
         if(res != LV_RESULT_OK) return;
     }
 
-    gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
+    gd_render_frame(gif, (uint8_t *)gifobj->imgdsc.data);
+
+    lv_area_t frame_area;
+    lv_area_set(&frame_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+    if(lv_area_get_size(&inv_area) == 0) inv_area = frame_area;
+    else lv_area_join(&inv_area, &inv_area, &frame_area);
 
     lv_image_cache_drop(lv_image_get_src(obj));
-    lv_obj_invalidate(obj);
+    invalidate_frame_area(obj, &inv_area);
+}
+
+/**
+ * Invalidate the area of the object where an area of the canvas is drawn
+ * @param obj           pointer to a gif object
+ * @param frame_area    the changed area of the canvas
+ */
+static void invalidate_frame_area(lv_obj_t * obj, const lv_area_t * frame_area)
+{
+    lv_image_t * img = (lv_image_t *) obj;
+    if(lv_area_get_size(frame_area) == 0) return;
+
+    /*Find the area only if the image is drawn as it is, else invalidate all*/
+    if(img->rotation || img->scale_x != LV_SCALE_NONE || img->scale_y != LV_SCALE_NONE ||
+       img->align >= LV_IMAGE_ALIGN_AUTO_TRANSFORM) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_area_t image_area;
+    lv_area_set(&image_area, 0, 0, img->w - 1, img->h - 1);
+    lv_area_align(&obj->coords, &image_area, img->align, img->offset.x, img->offset.y);
+
+    lv_area_t inv_area = *frame_area;
+    lv_area_move(&inv_area, image_area.x1, image_area.y1);
+    lv_obj_invalidate_area(obj, &inv_area);
 }
 
 #endif /*LV_USE_GIF*/
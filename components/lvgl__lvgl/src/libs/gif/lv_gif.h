@@ -54,6 +54,16 @@ lv_obj_t * lv_gif_create(lv_obj_t * parent);
  */
 void lv_gif_set_src(lv_obj_t * obj, const void * src);
 
+/**
+ * Set the color format of the canvas the frames are rendered to.
+ * RGB565 needs half of the memory and is faster to draw, but the
+ * transparent areas are filled with the background color of the GIF.
+ * Call it before `lv_gif_set_src` as it's applied when a GIF is opened.
+ * @param obj           pointer to a gif object
+ * @param color_format  LV_COLOR_FORMAT_ARGB8888 (default) or LV_COLOR_FORMAT_RGB565
+ */
+void lv_gif_set_color_format(lv_obj_t * obj, lv_color_format_t color_format);
+
 /**
  * Restart a gif animation.
  * @param obj pointer to a gif obj
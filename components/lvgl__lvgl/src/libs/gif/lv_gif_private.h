@@ -37,6 +37,7 @@ struct _lv_gif_t {
     lv_timer_t * timer;
     lv_image_dsc_t imgdsc;
     uint32_t last_call;
+    lv_color_format_t color_format;     /**< Of the canvas, ARGB8888 or RGB565*/
 };
 
 
@@ -5906,6 +5906,559 @@ unsigned lodepng_decode24_file(unsigned char ** out, unsigned * w, unsigned * h,
 }
 #endif /*LODEPNG_COMPILE_DISK*/
 
+/* ////////////////////////////////////////////////////////////////////////// */
+/* / Row by row decoder (LVGL extension)                                    / */
+/* ////////////////////////////////////////////////////////////////////////// */
+
+/*size of the buffer of the compressed data, it needs to hold the header of a dynamic block*/
+#define ROWDEC_IN_SIZE 1024u
+/*the largest dynamic block header is 4551 bits*/
+#define ROWDEC_BLOCK_START_BYTES 640u
+/*a length and a distance code with their extra bits and the bit position in the first byte*/
+#define ROWDEC_SYMBOL_BYTES 8u
+
+struct LodePNGRowDecoder {
+    LodePNGState state;
+    unsigned w, h;
+
+    /*the PNG is read through this callback, the IDAT chunks piece by piece*/
+    LodePNGRowReadFunc read;
+    void * read_user;
+    const unsigned char * in; /*the PNG of lodepng_row_decoder_create*/
+    size_t insize;
+    size_t first_idat; /*position of the first IDAT chunk*/
+    size_t chunk_pos; /*position of the next byte of the current IDAT chunk*/
+    size_t chunk_left; /*unread bytes of the current IDAT chunk*/
+    unsigned chunk_crc; /*CRC of the current IDAT chunk so far*/
+    unsigned check_crc;
+    unsigned zend; /*all the IDAT chunks are read*/
+    unsigned char inbuf[ROWDEC_IN_SIZE];
+
+    /*inflate state which can stop after any byte*/
+    LodePNGBitReader reader;
+    unsigned char * window; /*the last decompressed bytes for the back references*/
+    size_t window_mask;
+    size_t wpos; /*number of decompressed bytes*/
+    HuffmanTree tree_ll;
+    HuffmanTree tree_d;
+    unsigned in_block;
+    unsigned btype;
+    unsigned bfinal;
+    size_t stored_left; /*remaining bytes of an uncompressed block*/
+    size_t match_len; /*remaining bytes of a back reference*/
+    size_t match_dist;
+    unsigned adler;
+
+    /*unfilter state: only the current and the previous row are kept*/
+    unsigned char * cur;
+    unsigned char * prev;
+    size_t linebytes; /*without the filter type byte*/
+    size_t bytewidth;
+    unsigned y;
+};
+
+static size_t rowdec_read_mem(void * user, size_t offset, unsigned char * buf, size_t size)
+{
+    LodePNGRowDecoder * decoder = (LodePNGRowDecoder *)user;
+    if(offset >= decoder->insize) return 0;
+    if(size > decoder->insize - offset) size = decoder->insize - offset;
+    lodepng_memcpy(buf, decoder->in + offset, size);
+    return size;
+}
+
+/*read exactly size bytes, the callback may return less than asked. Returns 1 on success.*/
+static unsigned rowdec_read(LodePNGRowDecoder * decoder, size_t pos, unsigned char * buf, size_t size)
+{
+    while(size > 0) {
+        size_t n = decoder->read(decoder->read_user, pos, buf, size);
+        if(n == 0 || n > size) return 0;
+        pos += n;
+        buf += n;
+        size -= n;
+    }
+    return 1;
+}
+
+static unsigned rowdec_crc32_update(unsigned crc, const unsigned char * data, size_t length)
+{
+#ifdef LODEPNG_COMPILE_CRC
+    unsigned r = crc ^ 0xffffffffu;
+    while(length--) {
+        r = lodepng_crc32_table0[(r ^ *data++) & 0xffu] ^ (r >> 8);
+    }
+    return r ^ 0xffffffffu;
+#else
+    /*an external lodepng_crc32 can't be continued, the CRC of the IDAT chunks is not checked*/
+    (void)data;
+    (void)length;
+    return crc;
+#endif
+}
+
+/*find the first IDAT chunk from the chunk at pos, or mark the end of the compressed data at IEND*/
+static unsigned rowdec_next_idat(LodePNGRowDecoder * decoder, size_t pos)
+{
+    unsigned char header[8];
+    for(;;) {
+        unsigned length;
+        if(!rowdec_read(decoder, pos, header, 8)) return 30; /*error: chunk broken off*/
+        length = lodepng_chunk_length(header);
+        if(length > 2147483647) return 63; /*error: chunk length larger than the max PNG chunk size*/
+
+        if(lodepng_chunk_type_equals(header, "IDAT")) {
+            decoder->chunk_pos = pos + 8;
+            decoder->chunk_left = length;
+            decoder->chunk_crc = rowdec_crc32_update(0, &header[4], 4);
+            return 0;
+        }
+        if(lodepng_chunk_type_equals(header, "IEND")) {
+            decoder->zend = 1;
+            return 0;
+        }
+        if(lodepng_addofl(pos, (size_t)length + 12, &pos)) return 30;
+    }
+}
+
+/*make at least min bytes available to the bit reader, unless the compressed data ends before*/
+static unsigned rowdec_fill(LodePNGRowDecoder * decoder, size_t min)
+{
+    LodePNGBitReader * reader = &decoder->reader;
+    size_t start = reader->bp >> 3u;
+    size_t size, i;
+    unsigned error;
+
+    if(start > reader->size) return 51; /*error, bit pointer jumps past memory*/
+    size = reader->size - start;
+    if(size >= min || decoder->zend) return 0;
+
+    /*keep the unread bytes and append the next ones from the IDAT chunks*/
+    for(i = 0; i < size; i++) decoder->inbuf[i] = decoder->inbuf[start + i];
+    while(size < ROWDEC_IN_SIZE && !decoder->zend) {
+        size_t n = decoder->chunk_left;
+        if(n == 0) {
+            unsigned char crc[4];
+            if(!rowdec_read(decoder, decoder->chunk_pos, crc, 4)) return 30;
+            if(decoder->check_crc && decoder->chunk_crc != lodepng_read32bitInt(crc)) return 57; /*invalid CRC*/
+            error = rowdec_next_idat(decoder, decoder->chunk_pos + 4);
+            if(error) return error;
+            continue;
+        }
+
+        if(n > ROWDEC_IN_SIZE - size) n = ROWDEC_IN_SIZE - size;
+        if(!rowdec_read(decoder, decoder->chunk_pos, &decoder->inbuf[size], n)) return 30;
+        if(decoder->check_crc) decoder->chunk_crc = rowdec_crc32_update(decoder->chunk_crc, &decoder->inbuf[size], n);
+        decoder->chunk_pos += n;
+        decoder->chunk_left -= n;
+        size += n;
+    }
+
+    reader->size = size;
+    reader->bitsize = size * 8u;
+    reader->bp &= 7u;
+    return 0;
+}
+
+static unsigned rowdec_block_start(LodePNGRowDecoder * decoder)
+{
+    LodePNGBitReader * reader = &decoder->reader;
+    unsigned error = 0;
+
+    if(decoder->bfinal) return 91; /*error: the stream ended before all the rows*/
+    error = rowdec_fill(decoder, ROWDEC_BLOCK_START_BYTES);
+    if(error) return error;
+    if(reader->bitsize - reader->bp < 3) return 52; /*error, bit pointer will jump past memory*/
+    ensureBits9(reader, 3);
+    decoder->bfinal = readBits(reader, 1);
+    decoder->btype = readBits(reader, 2);
+
+    if(decoder->btype == 3) return 20; /*error: invalid BTYPE*/
+    else if(decoder->btype == 0) {
+        unsigned LEN, NLEN;
+        /*go to first boundary of byte*/
+        size_t bytepos = (reader->bp + 7u) >> 3u;
+        if(bytepos + 4 >= reader->size) return 52; /*error, bit pointer will jump past memory*/
+        LEN = (unsigned)reader->data[bytepos] + ((unsigned)reader->data[bytepos + 1] << 8u);
+        NLEN = (unsigned)reader->data[bytepos + 2] + ((unsigned)reader->data[bytepos + 3] << 8u);
+        bytepos += 4;
+        if(!decoder->state.decoder.zlibsettings.ignore_nlen && LEN + NLEN != 65535) {
+            return 21; /*error: NLEN is not one's complement of LEN*/
+        }
+        decoder->stored_left = LEN;
+        reader->bp = bytepos << 3u;
+    }
+    else {
+        HuffmanTree_cleanup(&decoder->tree_ll);
+        HuffmanTree_cleanup(&decoder->tree_d);
+        HuffmanTree_init(&decoder->tree_ll);
+        HuffmanTree_init(&decoder->tree_d);
+        if(decoder->btype == 1) error = getTreeInflateFixed(&decoder->tree_ll, &decoder->tree_d);
+        else error = getTreeInflateDynamic(&decoder->tree_ll, &decoder->tree_d, reader);
+        if(error) return error;
+    }
+
+    decoder->in_block = 1;
+    return 0;
+}
+
+/*inflate exactly len bytes to out, continuing where the previous call stopped*/
+static unsigned rowdec_inflate(LodePNGRowDecoder * decoder, unsigned char * out, size_t len)
+{
+    LodePNGBitReader * reader = &decoder->reader;
+    unsigned char * window = decoder->window;
+    size_t mask = decoder->window_mask;
+    size_t i = 0;
+    unsigned error = 0;
+
+    while(i < len) {
+        if(decoder->match_len) {
+            /*continue copying the back reference*/
+            size_t n = decoder->match_len < len - i ? decoder->match_len : len - i;
+            decoder->match_len -= n;
+            while(n--) {
+                unsigned char c = window[(decoder->wpos - decoder->match_dist) & mask];
+                window[decoder->wpos++ & mask] = c;
+                out[i++] = c;
+            }
+        }
+        else if(!decoder->in_block) {
+            error = rowdec_block_start(decoder);
+            if(error) return error;
+        }
+        else if(decoder->btype == 0) {
+            const unsigned char * src;
+            size_t n, avail;
+            error = rowdec_fill(decoder, 1);
+            if(error) return error;
+            avail = reader->size - (reader->bp >> 3u);
+            if(avail == 0) return 23; /*error: reading outside of in buffer*/
+            src = reader->data + (reader->bp >> 3u);
+            n = decoder->stored_left < len - i ? decoder->stored_left : len - i;
+            if(n > avail) n = avail;
+            decoder->stored_left -= n;
+            reader->bp += n << 3u;
+            while(n--) {
+                unsigned char c = *src++;
+                window[decoder->wpos++ & mask] = c;
+                out[i++] = c;
+            }
+            if(decoder->stored_left == 0) decoder->in_block = 0;
+        }
+        else {
+            unsigned code_ll;
+            error = rowdec_fill(decoder, ROWDEC_SYMBOL_BYTES);
+            if(error) return error;
+            ensureBits25(reader, 20); /*up to 15 for the huffman symbol, up to 5 for the extra bits of the length*/
+            code_ll = huffmanDecodeSymbol(reader, &decoder->tree_ll);
+            if(code_ll <= 255) { /*literal symbol*/
+                window[decoder->wpos++ & mask] = (unsigned char)code_ll;
+                out[i++] = (unsigned char)code_ll;
+            }
+            else if(code_ll >= FIRST_LENGTH_CODE_INDEX && code_ll <= LAST_LENGTH_CODE_INDEX) { /*length code*/
+                unsigned code_d, numextrabits;
+                size_t length = LENGTHBASE[code_ll - FIRST_LENGTH_CODE_INDEX];
+                size_t distance;
+                numextrabits = LENGTHEXTRA[code_ll - FIRST_LENGTH_CODE_INDEX];
+                if(numextrabits != 0) length += readBits(reader, numextrabits);
+
+                ensureBits32(reader, 28); /* up to 15 for the huffman symbol, up to 13 for the extra bits */
+                code_d = huffmanDecodeSymbol(reader, &decoder->tree_d);
+                if(code_d > 29) {
+                    if(code_d <= 31) return 18; /*error: invalid distance code (30-31 are never used)*/
+                    else return 16; /*error: tried to read disallowed huffman symbol*/
+                }
+                distance = DISTANCEBASE[code_d];
+                numextrabits = DISTANCEEXTRA[code_d];
+                if(numextrabits != 0) distance += readBits(reader, numextrabits);
+
+                /*error: too long backward distance*/
+                if(distance > decoder->wpos || distance > mask + 1) return 52;
+                decoder->match_len = length;
+                decoder->match_dist = distance;
+            }
+            else if(code_ll == 256) {
+                decoder->in_block = 0; /*end code*/
+            }
+            else { /*if(code_ll == INVALIDSYMBOL)*/
+                return 16; /*error: tried to read disallowed huffman symbol*/
+            }
+        }
+
+        /*check if any of the ensureBits above went out of bounds*/
+        if(reader->bp > reader->bitsize) return 51; /*error, bit pointer jumps past memory*/
+    }
+
+    return 0;
+}
+
+/*read the end of the deflate stream after the last row and check the Adler-32 checksum after it*/
+static unsigned rowdec_finish(LodePNGRowDecoder * decoder)
+{
+    LodePNGBitReader * reader = &decoder->reader;
+    size_t bytepos;
+    unsigned error = 0;
+
+    /*only the end codes and empty blocks can follow the last row*/
+    while(decoder->in_block || !decoder->bfinal) {
+        if(decoder->match_len || decoder->stored_left) return 91; /*error: more data than rows*/
+        if(!decoder->in_block) {
+            error = rowdec_block_start(decoder);
+            if(error) return error;
+        }
+        else if(decoder->btype == 0) {
+            decoder->in_block = 0;
+        }
+        else {
+            error = rowdec_fill(decoder, ROWDEC_SYMBOL_BYTES);
+            if(error) return error;
+            ensureBits25(reader, 20);
+            if(huffmanDecodeSymbol(reader, &decoder->tree_ll) != 256) return 91; /*error: more data than rows*/
+            if(reader->bp > reader->bitsize) return 51; /*error, bit pointer jumps past memory*/
+            decoder->in_block = 0;
+        }
+    }
+
+    error = rowdec_fill(decoder, 5);
+    if(error) return error;
+    bytepos = (reader->bp + 7u) >> 3u;
+    if(bytepos + 4 > reader->size) return 52; /*error, bit pointer will jump past memory*/
+    if(decoder->adler != lodepng_read32bitInt(&reader->data[bytepos])) {
+        return 58; /*error, adler checksum not correct, data must be corrupted*/
+    }
+
+    return 0;
+}
+
+/*read the PLTE or tRNS chunk at pos*/
+static unsigned rowdec_read_color_chunk(LodePNGRowDecoder * decoder, size_t pos, unsigned length, unsigned is_plte)
+{
+    unsigned char * chunk;
+    unsigned error = 0;
+
+    /*at most 256 RGB or alpha values*/
+    if(length > 3 * 256) return is_plte ? 38 : 39; /*error: palette too big*/
+    chunk = (unsigned char *)lodepng_malloc((size_t)length + 12);
+    if(!chunk) return 83; /*alloc fail*/
+    if(!rowdec_read(decoder, pos, chunk, (size_t)length + 12)) error = 30;
+    if(!error && !decoder->state.decoder.ignore_crc && lodepng_chunk_check_crc(chunk)) error = 57; /*invalid CRC*/
+    if(!error) {
+        if(is_plte) {
+            error = readChunk_PLTE(&decoder->state.info_png.color, lodepng_chunk_data_const(chunk), length);
+        }
+        else {
+            error = readChunk_tRNS(&decoder->state.info_png.color, lodepng_chunk_data_const(chunk), length);
+        }
+    }
+
+    lodepng_free(chunk);
+    return error;
+}
+
+static unsigned rowdec_create(LodePNGRowDecoder ** out, LodePNGRowReadFunc read, void * user,
+                              const unsigned char * in, size_t insize)
+{
+    LodePNGRowDecoder * decoder;
+    LodePNGState * state;
+    unsigned char header[33];
+    size_t pos = 33;
+    size_t idatsize = 0;
+    size_t rawsize, window_size;
+    unsigned idat_found = 0, IEND = 0, bpp;
+    unsigned error = 0;
+
+    *out = 0;
+    decoder = (LodePNGRowDecoder *)lodepng_malloc(sizeof(LodePNGRowDecoder));
+    if(!decoder) return 83; /*alloc fail*/
+    lodepng_memset(decoder, 0, sizeof(LodePNGRowDecoder));
+    lodepng_state_init(&decoder->state);
+    HuffmanTree_init(&decoder->tree_ll);
+    HuffmanTree_init(&decoder->tree_d);
+    state = &decoder->state;
+    decoder->in = in;
+    decoder->insize = insize;
+    decoder->read = read ? read : rowdec_read_mem;
+    decoder->read_user = read ? user : decoder;
+#ifdef LODEPNG_COMPILE_CRC
+    decoder->check_crc = !state->decoder.ignore_crc;
+#endif
+
+    if(!rowdec_read(decoder, 0, header, sizeof(header))) {
+        error = 27; /*error: the data length is smaller than the length of a PNG header*/
+    }
+    if(!error) error = lodepng_inspect(&decoder->w, &decoder->h, state, header, sizeof(header));
+    if(!error && state->info_png.interlace_method != 0) error = 116;
+    if(!error && lodepng_pixel_overflow(decoder->w, decoder->h, &state->info_png.color, &state->info_raw)) error = 92;
+
+    /*read the chunks needed for the colors and find the image data. Only the headers of the other chunks are read.*/
+    while(!error && !IEND) {
+        unsigned char chunk[8];
+        unsigned chunkLength;
+
+        if(!rowdec_read(decoder, pos, chunk, 8)) {
+            error = 30; /*error: next chunk out of bounds of the in buffer*/
+            break;
+        }
+        chunkLength = lodepng_chunk_length(chunk);
+        if(chunkLength > 2147483647) {
+            error = 63; /*error: chunk length larger than the max PNG chunk size*/
+            break;
+        }
+
+        if(lodepng_chunk_type_equals(chunk, "IDAT")) {
+            if(!idat_found) decoder->first_idat = pos;
+            idat_found = 1;
+            idatsize += chunkLength;
+        }
+        else if(lodepng_chunk_type_equals(chunk, "IEND")) IEND = 1;
+        else if(lodepng_chunk_type_equals(chunk, "PLTE") || lodepng_chunk_type_equals(chunk, "tRNS")) {
+            error = rowdec_read_color_chunk(decoder, pos, chunkLength, lodepng_chunk_type_equals(chunk, "PLTE"));
+        }
+        else if(!state->decoder.ignore_critical && !lodepng_chunk_ancillary(chunk)) {
+            error = 69; /*error: unknown critical chunk (5th bit of first byte of chunk type is 0)*/
+        }
+
+        if(!error && lodepng_addofl(pos, (size_t)chunkLength + 12, &pos)) error = 30;
+    }
+
+    if(!error && state->info_png.color.colortype == LCT_PALETTE && !state->info_png.color.palette) {
+        error = 106; /* error: PNG file must have PLTE chunk if color type is palette */
+    }
+
+    if(!error && idatsize < 6) error = 53; /*error, size of zlib data too small*/
+
+    /*read the first bytes and check the zlib header*/
+    if(!error) error = lodepng_row_decoder_rewind(decoder);
+
+    if(!error) {
+        bpp = lodepng_get_bpp(&state->info_png.color);
+        rawsize = lodepng_get_raw_size_idat(decoder->w, decoder->h, bpp);
+        decoder->bytewidth = (bpp + 7u) / 8u;
+        decoder->linebytes = lodepng_get_raw_size_idat(decoder->w, 1, bpp) - 1u;
+
+        /*the window can't be larger than the whole image*/
+        window_size = (size_t)1u << (((decoder->inbuf[0] >> 4) & 15) + 8);
+        while(window_size > 256 && window_size / 2 >= rawsize) window_size /= 2;
+        decoder->window_mask = window_size - 1;
+        decoder->window = (unsigned char *)lodepng_malloc(window_size);
+        decoder->cur = (unsigned char *)lodepng_malloc(decoder->linebytes);
+        decoder->prev = (unsigned char *)lodepng_malloc(decoder->linebytes);
+        if(!decoder->window || !decoder->cur || !decoder->prev) error = 83; /*alloc fail*/
+    }
+
+    if(error) {
+        lodepng_row_decoder_delete(decoder);
+        return error;
+    }
+
+    *out = decoder;
+    return 0;
+}
+
+unsigned lodepng_row_decoder_create(LodePNGRowDecoder ** out, const unsigned char * in, size_t insize)
+{
+    return rowdec_create(out, 0, 0, in, insize);
+}
+
+unsigned lodepng_row_decoder_create_stream(LodePNGRowDecoder ** out, LodePNGRowReadFunc read, void * user)
+{
+    return rowdec_create(out, read, user, 0, 0);
+}
+
+unsigned lodepng_row_decoder_next(LodePNGRowDecoder * decoder, const unsigned char ** row)
+{
+    unsigned char filterType;
+    unsigned char * tmp;
+    unsigned error;
+
+    *row = 0;
+    if(decoder->y >= decoder->h) return 91; /*error: no more rows*/
+
+    error = rowdec_inflate(decoder, &filterType, 1);
+    if(!error) error = rowdec_inflate(decoder, decoder->cur, decoder->linebytes);
+    if(error) return error;
+
+    if(!decoder->state.decoder.zlibsettings.ignore_adler32) {
+        decoder->adler = update_adler32(decoder->adler, &filterType, 1);
+        decoder->adler = update_adler32(decoder->adler, decoder->cur, (unsigned)decoder->linebytes);
+    }
+
+    /*recon and scanline can be the same, the previous row is needed only for this row*/
+    error = unfilterScanline(decoder->cur, decoder->cur, decoder->y ? decoder->prev : 0,
+                             decoder->bytewidth, filterType, decoder->linebytes);
+    if(error) return error;
+
+    decoder->y++;
+    if(decoder->y == decoder->h && !decoder->state.decoder.zlibsettings.ignore_adler32) {
+        error = rowdec_finish(decoder);
+        if(error) return error;
+    }
+
+    tmp = decoder->prev;
+    decoder->prev = decoder->cur;
+    decoder->cur = tmp;
+    *row = decoder->prev;
+    return 0;
+}
+
+unsigned lodepng_row_decoder_rewind(LodePNGRowDecoder * decoder)
+{
+    LodePNGBitReader * reader = &decoder->reader;
+    const unsigned char * zlib = decoder->inbuf;
+    unsigned error;
+
+    /*start reading the IDAT chunks again*/
+    decoder->zend = 0;
+    error = rowdec_next_idat(decoder, decoder->first_idat);
+    if(error) return error;
+    error = LodePNGBitReader_init(reader, decoder->inbuf, 0);
+    if(!error) error = rowdec_fill(decoder, 6);
+    if(error) return error;
+
+    /*check the zlib header like lodepng_zlib_decompressv*/
+    if(reader->size < 6) return 53; /*error, size of zlib data too small*/
+    if((zlib[0] * 256 + zlib[1]) % 31 != 0) return 24;
+    if((zlib[0] & 15) != 8 || ((zlib[0] >> 4) & 15) > 7) return 25;
+    if(((zlib[1] >> 5) & 1) != 0) return 26;
+    reader->bp = 16;
+
+    decoder->wpos = 0;
+    decoder->in_block = 0;
+    decoder->bfinal = 0;
+    decoder->stored_left = 0;
+    decoder->match_len = 0;
+    decoder->match_dist = 0;
+    decoder->adler = 1u;
+    decoder->y = 0;
+    return 0;
+}
+
+unsigned lodepng_row_decoder_get_y(const LodePNGRowDecoder * decoder)
+{
+    return decoder->y;
+}
+
+void lodepng_row_decoder_get_size(const LodePNGRowDecoder * decoder, unsigned * w, unsigned * h)
+{
+    *w = decoder->w;
+    *h = decoder->h;
+}
+
+const LodePNGColorMode * lodepng_row_decoder_get_color(const LodePNGRowDecoder * decoder)
+{
+    return &decoder->state.info_png.color;
+}
+
+void lodepng_row_decoder_delete(LodePNGRowDecoder * decoder)
+{
+    if(!decoder) return;
+    HuffmanTree_cleanup(&decoder->tree_ll);
+    HuffmanTree_cleanup(&decoder->tree_d);
+    lodepng_state_cleanup(&decoder->state);
+    lodepng_free(decoder->window);
+    lodepng_free(decoder->cur);
+    lodepng_free(decoder->prev);
+    lodepng_free(decoder);
+}
+
 void lodepng_decoder_settings_init(LodePNGDecoderSettings * settings)
 {
     settings->color_convert = 1;
@@ -7427,6 +7980,8 @@ const char * lodepng_error_text(unsigned code)
             return "sBIT chunk has wrong size for the color type of the image";
         case 115:
             return "sBIT value out of range";
+        case 116:
+            return "interlaced PNG can't be decoded row by row";
     }
     return "unknown error code";
 }
@@ -897,6 +897,45 @@ information is placed in the info_png field of the LodePNGState.
 unsigned lodepng_inspect(unsigned * w, unsigned * h,
                          LodePNGState * state,
                          const unsigned char * in, size_t insize);
+
+/*
+Row by row decoder (LVGL extension). Inflates and unfilters the image data one row at
+a time, so only a 32K (or smaller) inflate window, a 1K buffer of the compressed data and
+two rows are in memory instead of the whole image. The IDAT chunks are read piece by piece,
+they are not joined. The rows are given in the color mode of the PNG, see
+lodepng_row_decoder_get_color, convert them with lodepng_convert if needed.
+Interlaced images are not supported (error 116).
+*/
+typedef struct LodePNGRowDecoder LodePNGRowDecoder;
+
+/*Read callback of lodepng_row_decoder_create_stream: copy size bytes from offset of the PNG
+to buf and return the number of bytes copied. Returning less than size is fine, 0 means the
+end of the data or an error.*/
+typedef size_t (*LodePNGRowReadFunc)(void * user, size_t offset, unsigned char * buf, size_t size);
+
+/*Parse the chunks and prepare decoding the first row. The in buffer must be kept valid while
+the decoder is used. Returns error code.*/
+unsigned lodepng_row_decoder_create(LodePNGRowDecoder ** decoder, const unsigned char * in, size_t insize);
+
+/*Same as lodepng_row_decoder_create but the PNG is read by a callback, e.g. from a file.
+The CRC of the IDAT chunks is checked only with LODEPNG_COMPILE_CRC. Returns error code.*/
+unsigned lodepng_row_decoder_create_stream(LodePNGRowDecoder ** decoder, LodePNGRowReadFunc read, void * user);
+
+/*Decode the next row. *row points to the unfiltered row, valid until the next call. Returns error code.*/
+unsigned lodepng_row_decoder_next(LodePNGRowDecoder * decoder, const unsigned char ** row);
+
+/*Start again from the first row. Returns error code.*/
+unsigned lodepng_row_decoder_rewind(LodePNGRowDecoder * decoder);
+
+/*Get the index of the row returned by the next lodepng_row_decoder_next*/
+unsigned lodepng_row_decoder_get_y(const LodePNGRowDecoder * decoder);
+
+void lodepng_row_decoder_get_size(const LodePNGRowDecoder * decoder, unsigned * w, unsigned * h);
+
+/*Color mode of the rows, including the palette*/
+const LodePNGColorMode * lodepng_row_decoder_get_color(const LodePNGRowDecoder * decoder);
+
+void lodepng_row_decoder_delete(LodePNGRowDecoder * decoder);
 #endif /*LODEPNG_COMPILE_DECODER*/
 
 /*
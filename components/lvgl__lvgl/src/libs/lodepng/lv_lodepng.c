@@ -27,6 +27,17 @@
  *      TYPEDEFS
  **********************/
 
+#if LV_LODEPNG_BAND_HEIGHT
+/*State of an image decoded in row bands by `decoder_get_area`*/
+typedef struct {
+    LodePNGRowDecoder * rows;
+    lv_fs_file_t file;          /*The PNG is read from it piece by piece if it couldn't be mapped*/
+    bool file_opened;
+    uint8_t * rgba_row;         /*Used if the rows need to be converted to RGBA first*/
+    lv_draw_buf_t * band;
+} band_data_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -35,6 +46,15 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
 static void decoder_close(lv_image_decoder_t * dec, lv_image_decoder_dsc_t * dsc);
 static void convert_color_depth(uint8_t * img_p, uint32_t px_cnt);
 static lv_draw_buf_t * decode_png_data(const void * png_data, size_t png_data_size);
+#if LV_LODEPNG_BAND_HEIGHT
+static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                    const lv_area_t * full_area, lv_area_t * decoded_area);
+static bool band_is_needed(lv_image_decoder_dsc_t * dsc);
+static lv_result_t band_open(lv_image_decoder_dsc_t * dsc);
+static void band_close(band_data_t * data);
+static size_t band_file_read_cb(void * user, size_t offset, unsigned char * buf, size_t size);
+static void band_write_row(band_data_t * data, const uint8_t * row, uint32_t px_size, int32_t band_y);
+#endif
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -56,6 +76,9 @@ void lv_lodepng_init(void)
     lv_image_decoder_set_info_cb(dec, decoder_info);
     lv_image_decoder_set_open_cb(dec, decoder_open);
     lv_image_decoder_set_close_cb(dec, decoder_close);
+#if LV_LODEPNG_BAND_HEIGHT
+    lv_image_decoder_set_get_area_cb(dec, decoder_get_area);
+#endif
 
     dec->name = DECODER_NAME;
 }
@@ -141,6 +164,14 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
     LV_UNUSED(decoder);
     LV_PROFILER_DECODER_BEGIN_TAG("lv_lodepng_decoder_open");
 
+#if LV_LODEPNG_BAND_HEIGHT
+    /*Decode only a few rows at once while drawing if the whole image wouldn't be kept anyway*/
+    if(band_is_needed(dsc) && band_open(dsc) == LV_RESULT_OK) {
+        LV_PROFILER_DECODER_END_TAG("lv_lodepng_decoder_open");
+        return LV_RESULT_OK;
+    }
+#endif
+
     const uint8_t * png_data = NULL;
     size_t png_data_size = 0;
     if(dsc->src_type == LV_IMAGE_SRC_FILE) {
@@ -231,6 +262,15 @@ static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t *
 {
     LV_UNUSED(decoder);
 
+#if LV_LODEPNG_BAND_HEIGHT
+    if(dsc->user_data) {
+        band_close(dsc->user_data);
+        dsc->user_data = NULL;
+        dsc->decoded = NULL;
+        return;
+    }
+#endif
+
     if(dsc->args.no_cache ||
        !lv_image_cache_is_enabled()) lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
 }
@@ -270,4 +310,267 @@ static void convert_color_depth(uint8_t * img_p, uint32_t px_cnt)
     }
 }
 
+#if LV_LODEPNG_BAND_HEIGHT
+
+/**
+ * Decode the next rows of `full_area` into a band. The rows above the area are decoded but not converted,
+ * and the decoding is restarted from the top if an area above the last decoded row is requested.
+ */
+static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                    const lv_area_t * full_area, lv_area_t * decoded_area)
+{
+    LV_UNUSED(decoder);
+
+    band_data_t * data = dsc->user_data;
+    if(data == NULL) return LV_RESULT_INVALID;
+
+    LV_PROFILER_DECODER_BEGIN_TAG("lv_lodepng_get_area");
+
+    LodePNGRowDecoder * rows = data->rows;
+    lv_draw_buf_t * band = data->band;
+    int32_t y = (int32_t)lodepng_row_decoder_get_y(rows);
+    int32_t y_start;
+    if(decoded_area->y1 == LV_COORD_MIN) {
+        dsc->decoded = band;
+        y_start = LV_MAX(full_area->y1, 0);
+        if(y > y_start) {
+            lodepng_row_decoder_rewind(rows);
+            y = 0;
+        }
+    }
+    else {
+        y_start = decoded_area->y2 + 1;
+    }
+
+    int32_t y_end = LV_MIN(full_area->y2, (int32_t)dsc->header.h - 1);
+    if(y_start > y_end) {
+        LV_PROFILER_DECODER_END_TAG("lv_lodepng_get_area");
+        return LV_RESULT_INVALID;
+    }
+
+    const unsigned char * row;
+    unsigned error = 0;
+    while(y < y_start && !error) {
+        error = lodepng_row_decoder_next(rows, &row);
+        y++;
+    }
+
+    int32_t band_h = LV_MIN(LV_LODEPNG_BAND_HEIGHT, y_end - y_start + 1);
+    band->header.h = band_h;
+    band->header.flags &= ~LV_IMAGE_FLAGS_PREMULTIPLIED;
+    band->data_size = lv_draw_buf_width_to_stride(band->header.w, band->header.cf) * band_h;
+    if(band->header.cf == LV_COLOR_FORMAT_RGB565A8) band->data_size += band->header.stride / 2 * band_h;
+
+    const LodePNGColorMode * color = lodepng_row_decoder_get_color(rows);
+    LodePNGColorMode rgba_mode;
+    lodepng_color_mode_init(&rgba_mode);
+
+    int32_t i;
+    for(i = 0; i < band_h && !error; i++) {
+        error = lodepng_row_decoder_next(rows, &row);
+        if(error) break;
+
+        if(data->rgba_row) {
+            error = lodepng_convert(data->rgba_row, row, &rgba_mode, color, band->header.w, 1);
+            if(!error) band_write_row(data, data->rgba_row, 4, i);
+        }
+        else {
+            band_write_row(data, row, color->colortype == LCT_RGBA ? 4 : 3, i);
+        }
+    }
+
+    if(error) {
+        LV_LOG_WARN("error %u: %s", error, lodepng_error_text(error));
+        LV_PROFILER_DECODER_END_TAG("lv_lodepng_get_area");
+        return LV_RESULT_INVALID;
+    }
+
+    if(dsc->args.premultiply && lv_color_format_has_alpha(band->header.cf)) lv_draw_buf_premultiply(band);
+
+    decoded_area->x1 = 0;
+    decoded_area->y1 = y_start;
+    decoded_area->x2 = band->header.w - 1;
+    decoded_area->y2 = y_start + band_h - 1;
+
+    LV_PROFILER_DECODER_END_TAG("lv_lodepng_get_area");
+    return LV_RESULT_OK;
+}
+
+/**
+ * Check if the image should be decoded in bands because it wouldn't be cached anyway
+ * @param dsc       decoded image descriptor
+ * @return          true: decode in bands; false: decode the whole image
+ */
+static bool band_is_needed(lv_image_decoder_dsc_t * dsc)
+{
+    /*E.g. the transformed images are sampled from the whole image*/
+    if(dsc->args.full_image) return false;
+
+    /*The inflate window of the row decoder can be up to 32 kB, so small images are decoded at once*/
+    uint32_t size = dsc->header.w * dsc->header.h * 4;
+    if(size <= 32 * 1024) return false;
+
+    if(dsc->args.no_cache || !lv_image_cache_is_enabled()) return true;
+    return size > lv_cache_get_max_size(LV_GLOBAL_DEFAULT()->img_cache, NULL);
+}
+
+/**
+ * Prepare decoding the image in bands. Only the inflate window, two rows and a band of
+ * `LV_LODEPNG_BAND_HEIGHT` rows are kept in the memory. Files which can't be mapped are read
+ * piece by piece while decoding.
+ * @param dsc       decoded image descriptor
+ * @return          LV_RESULT_OK: ready to decode by `decoder_get_area`; LV_RESULT_INVALID: decode the whole image instead
+ */
+static lv_result_t band_open(lv_image_decoder_dsc_t * dsc)
+{
+    band_data_t * data = lv_malloc_zeroed(sizeof(band_data_t));
+    LV_ASSERT_MALLOC(data);
+    if(data == NULL) return LV_RESULT_INVALID;
+
+    unsigned error;
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+        if(lv_fs_open(&data->file, dsc->src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            band_close(data);
+            return LV_RESULT_INVALID;
+        }
+        data->file_opened = true;
+
+        /*Use the file directly if it's in the memory anyway*/
+        uint32_t map_size = 0;
+        const uint8_t * png_data = lv_fs_get_mapped_ptr(&data->file, &map_size);
+        if(png_data) error = lodepng_row_decoder_create(&data->rows, png_data, map_size);
+        else error = lodepng_row_decoder_create_stream(&data->rows, band_file_read_cb, &data->file);
+    }
+    else if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
+        const lv_image_dsc_t * img_dsc = dsc->src;
+        error = lodepng_row_decoder_create(&data->rows, img_dsc->data, img_dsc->data_size);
+    }
+    else {
+        band_close(data);
+        return LV_RESULT_INVALID;
+    }
+
+    if(error) {
+        /*E.g. interlaced images can't be decoded row by row*/
+        LV_LOG_INFO("can't decode in bands, error %u: %s", error, lodepng_error_text(error));
+        band_close(data);
+        return LV_RESULT_INVALID;
+    }
+
+    unsigned w, h;
+    lodepng_row_decoder_get_size(data->rows, &w, &h);
+    const LodePNGColorMode * color = lodepng_row_decoder_get_color(data->rows);
+    bool has_alpha = lodepng_can_have_alpha(color);
+
+    /*Convert directly to the color format of the display*/
+#if LV_COLOR_DEPTH == 16
+    lv_color_format_t cf = has_alpha ? LV_COLOR_FORMAT_RGB565A8 : LV_COLOR_FORMAT_RGB565;
+#else
+    lv_color_format_t cf = has_alpha ? LV_COLOR_FORMAT_ARGB8888 : LV_COLOR_FORMAT_RGB888;
+#endif
+
+    /*Only 8 bit RGB(A) rows can be used directly, the others are converted to RGBA first*/
+    bool direct = color->bitdepth == 8 && (color->colortype == LCT_RGBA || (color->colortype == LCT_RGB && !has_alpha));
+    if(!direct) {
+        data->rgba_row = lv_malloc(w * 4);
+        LV_ASSERT_MALLOC(data->rgba_row);
+    }
+
+    data->band = lv_draw_buf_create(w, LV_MIN(h, LV_LODEPNG_BAND_HEIGHT), cf, LV_STRIDE_AUTO);
+    if(data->band == NULL || (!direct && data->rgba_row == NULL)) {
+        band_close(data);
+        return LV_RESULT_INVALID;
+    }
+
+    dsc->header.cf = cf;
+    dsc->header.stride = data->band->header.stride;
+    dsc->user_data = data;
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Free the resources of an image decoded in bands
+ * @param data      the band data to free
+ */
+static void band_close(band_data_t * data)
+{
+    lodepng_row_decoder_delete(data->rows);
+    if(data->file_opened) lv_fs_close(&data->file);
+    lv_free(data->rgba_row);
+    if(data->band) lv_draw_buf_destroy(data->band);
+    lv_free(data);
+}
+
+/**
+ * Read a part of a PNG file for the row decoder
+ * @param user      pointer to the opened file
+ * @param offset    position in the file
+ * @param buf       store the data here
+ * @param size      number of bytes to read
+ * @return          number of bytes read
+ */
+static size_t band_file_read_cb(void * user, size_t offset, unsigned char * buf, size_t size)
+{
+    lv_fs_file_t * file = user;
+    uint32_t rn = 0;
+    if(lv_fs_seek(file, (uint32_t)offset, LV_FS_SEEK_SET) != LV_FS_RES_OK) return 0;
+    if(lv_fs_read(file, buf, (uint32_t)size, &rn) != LV_FS_RES_OK) return 0;
+    return rn;
+}
+
+/**
+ * Convert an 8 bit RGB or RGBA row to a row of the band
+ * @param data      the band data
+ * @param row       the RGB or RGBA row
+ * @param px_size   3: RGB, 4: RGBA
+ * @param band_y    index of the row in the band
+ */
+static void band_write_row(band_data_t * data, const uint8_t * row, uint32_t px_size, int32_t band_y)
+{
+    lv_draw_buf_t * band = data->band;
+    uint32_t w = band->header.w;
+    uint8_t * dest = band->data + band->header.stride * band_y;
+    uint32_t x;
+
+    switch(band->header.cf) {
+        case LV_COLOR_FORMAT_ARGB8888:
+            for(x = 0; x < w; x++) {
+                dest[0] = row[2];
+                dest[1] = row[1];
+                dest[2] = row[0];
+                dest[3] = px_size == 4 ? row[3] : 0xff;
+                dest += 4;
+                row += px_size;
+            }
+            break;
+        case LV_COLOR_FORMAT_RGB888:
+            for(x = 0; x < w; x++) {
+                dest[0] = row[2];
+                dest[1] = row[1];
+                dest[2] = row[0];
+                dest += 3;
+                row += px_size;
+            }
+            break;
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB565A8: {
+                uint16_t * dest16 = (uint16_t *)dest;
+                /*The alpha plane is after the color rows of the band*/
+                uint8_t * alpha = band->data + band->header.stride * band->header.h + band->header.stride / 2 * band_y;
+                bool has_alpha = band->header.cf == LV_COLOR_FORMAT_RGB565A8;
+                for(x = 0; x < w; x++) {
+                    dest16[x] = lv_color_to_u16(lv_color_make(row[0], row[1], row[2]));
+                    if(has_alpha) alpha[x] = px_size == 4 ? row[3] : 0xff;
+                    row += px_size;
+                }
+                break;
+            }
+        default:
+            break;
+    }
+}
+
+#endif /*LV_LODEPNG_BAND_HEIGHT*/
+
 #endif /*LV_USE_LODEPNG*/
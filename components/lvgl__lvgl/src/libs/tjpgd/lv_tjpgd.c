@@ -24,10 +24,52 @@
 
 #define TJPGD_WORKBUFF_SIZE             4096    //Recommended by TJPGD library
 
+/*Number of images whose MCU row index is kept*/
+#define TJPGD_INDEX_CNT                 4
+
+#if JD_FASTDECODE == 0
+    #error "The MCU row index needs the working register of JD_FASTDECODE >= 1"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*The state of the decoder at the start of an MCU row to continue decoding from there*/
+typedef struct {
+    uint32_t pos;           /*Position of the next byte to read in the stream*/
+    uint32_t wreg;
+    int16_t dcv[3];
+    uint16_t rst;
+    uint16_t rsc;
+    uint8_t dbit;
+    uint8_t marker;
+} mcu_row_state_t;
+
+/*The MCU row states of an image, kept between decoder sessions*/
+typedef struct {
+    lv_image_src_t src_type;
+    const void * src;           /*A copy of the path for files*/
+    uint32_t src_size;          /*To detect if the file has changed*/
+    uint32_t row_cnt;
+    uint32_t known_cnt;         /*The state of the first `known_cnt` rows is known*/
+    uint32_t ref_cnt;           /*Number of open sessions using it. Only unused indexes are deleted*/
+    mcu_row_state_t * rows;
+} mcu_row_index_t;
+
+/*The indexes of the recently used images, shared by the decoder sessions*/
+typedef struct {
+    lv_ll_t index_ll;
+    lv_mutex_t lock;            /*The sessions can run on the draw and decoder threads*/
+} index_cache_t;
+
+typedef struct {
+    JDEC jd;
+    mcu_row_index_t * index;
+    int32_t x;                  /*Coordinates of the next MCU in the stream*/
+    int32_t y;
+} decoder_data_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -39,6 +81,13 @@ static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decod
 static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
 static int is_jpg(const uint8_t * raw_data, size_t len);
+static mcu_row_index_t * index_get(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc, const JDEC * jd,
+                                   uint32_t src_size);
+static void index_release(lv_image_decoder_t * decoder, mcu_row_index_t * index);
+static void index_trim(index_cache_t * cache, uint32_t max_cnt);
+static void index_delete(mcu_row_index_t * index);
+static void index_save_row(lv_image_decoder_t * decoder, decoder_data_t * data);
+static lv_result_t index_restore_row(decoder_data_t * data, uint32_t row);
 
 /**********************
  *  STATIC VARIABLES
@@ -61,6 +110,14 @@ void lv_tjpgd_init(void)
     lv_image_decoder_set_close_cb(dec, decoder_close);
 
     dec->name = DECODER_NAME;
+
+    index_cache_t * cache = lv_malloc(sizeof(index_cache_t));
+    LV_ASSERT_MALLOC(cache);
+    if(cache) {
+        lv_ll_init(&cache->index_ll, sizeof(mcu_row_index_t));
+        lv_mutex_init(&cache->lock);
+    }
+    dec->user_data = cache;
 }
 
 void lv_tjpgd_deinit(void)
@@ -68,6 +125,16 @@ void lv_tjpgd_deinit(void)
     lv_image_decoder_t * dec = NULL;
     while((dec = lv_image_decoder_get_next(dec)) != NULL) {
         if(dec->info_cb == decoder_info) {
+            index_cache_t * cache = dec->user_data;
+            if(cache) {
+                mcu_row_index_t * index;
+                LV_LL_READ(&cache->index_ll, index) {
+                    index_delete(index);
+                }
+                lv_ll_clear(&cache->index_ll);
+                lv_mutex_delete(&cache->lock);
+                lv_free(cache);
+            }
             lv_image_decoder_delete(dec);
             break;
         }
@@ -152,8 +219,10 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata)
  */
 static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
 {
-    LV_UNUSED(decoder);
     lv_fs_file_t * f = lv_malloc(sizeof(lv_fs_file_t));
+    if(f == NULL) return LV_RESULT_INVALID;
+
+    uint32_t src_size = 0;
     if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
 #if LV_USE_FS_MEMFS
         const lv_image_dsc_t * img_dsc = dsc->src;
@@ -166,9 +235,11 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
                 lv_free(f);
                 return LV_RESULT_INVALID;
             }
+            src_size = img_dsc->data_size;
         }
 #else
         LV_LOG_WARN("LV_USE_FS_MEMFS needs to enabled to decode from data");
+        lv_free(f);
         return LV_RESULT_INVALID;
 #endif
     }
@@ -181,98 +252,132 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
                 lv_free(f);
                 return LV_RESULT_INVALID;
             }
+
+            lv_fs_seek(f, 0, LV_FS_SEEK_END);
+            lv_fs_tell(f, &src_size);
+            lv_fs_seek(f, 0, LV_FS_SEEK_SET);
         }
     }
 
     uint8_t * workb_temp = lv_malloc(TJPGD_WORKBUFF_SIZE);
-    JDEC * jd = lv_malloc(sizeof(JDEC));
-    dsc->user_data = jd;
+    decoder_data_t * data = lv_malloc_zeroed(sizeof(decoder_data_t));
+    if(workb_temp == NULL || data == NULL) {
+        lv_free(workb_temp);
+        lv_free(data);
+        lv_fs_close(f);
+        lv_free(f);
+        return LV_RESULT_INVALID;
+    }
+
+    JDEC * jd = &data->jd;
     JRESULT rc = jd_prepare(jd, input_func, workb_temp, (size_t)TJPGD_WORKBUFF_SIZE, f);
-    if(rc) return LV_RESULT_INVALID;
+    if(rc == JDR_OK) {
+        data->index = index_get(decoder, dsc, jd, src_size);
+    }
+
+    if(rc != JDR_OK || data->index == NULL) {
+        lv_free(workb_temp);
+        lv_free(data);
+        lv_fs_close(f);
+        lv_free(f);
+        return LV_RESULT_INVALID;
+    }
+
+    jd->scale = 0;
+    jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;   /* Initialize DC values */
+    jd->rst = 0;
+    jd->rsc = 0;
+    dsc->user_data = data;
 
     dsc->header.cf = LV_COLOR_FORMAT_RGB888;
     dsc->header.w = jd->width;
     dsc->header.h = jd->height;
     dsc->header.stride = jd->width * 3;
 
-    if(rc != JDR_OK) {
-        lv_free(workb_temp);
-        lv_free(jd);
-        return LV_RESULT_INVALID;
-    }
-
     return LV_RESULT_OK;
 }
 
+/**
+ * Decode the next MCU in `full_area`. The MCUs above and left of it are only
+ * loaded, and the decoding starts at the first MCU row of `full_area` if its state is known.
+ */
 static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
                                     const lv_area_t * full_area, lv_area_t * decoded_area)
 {
-    LV_UNUSED(decoder);
-    LV_UNUSED(full_area);
-
-    JDEC * jd = dsc->user_data;
+    decoder_data_t * data = dsc->user_data;
+    JDEC * jd = &data->jd;
     lv_draw_buf_t * decoded = (void *)dsc->decoded;
 
-    uint32_t  mx, my;
+    int32_t mx, my;
     mx = jd->msx * 8;
     my = jd->msy * 8;         /* Size of the MCU (pixel) */
     if(decoded_area->y1 == LV_COORD_MIN) {
-        decoded_area->y1 = 0;
-        decoded_area->y2 = my - 1;
-        decoded_area->x1 = -((int32_t)mx);
-        decoded_area->x2 = -1;
-        jd->scale = 0;
-        jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;   /* Initialize DC values */
-        jd->rst = 0;
-        jd->rsc = 0;
         if(decoded == NULL) {
             decoded = lv_malloc_zeroed(sizeof(lv_draw_buf_t));
+            if(decoded == NULL) return LV_RESULT_INVALID;
             dsc->decoded = decoded;
         }
-        else {
-            lv_fs_seek(jd->device, 0, LV_FS_SEEK_SET);
-            JRESULT rc = jd_prepare(jd, input_func, jd->pool_original, (size_t)TJPGD_WORKBUFF_SIZE, jd->device);
-            if(rc) return LV_RESULT_INVALID;
-        }
         decoded->data = jd->workbuf;
         decoded->header = dsc->header;
-    }
-
-    decoded_area->x1 += mx;
-    decoded_area->x2 += mx;
 
-    if(decoded_area->x1 >= jd->width) {
-        decoded_area->x1 = 0;
-        decoded_area->x2 = mx - 1;
-        decoded_area->y1 += my;
-        decoded_area->y2 += my;
+        /*Jump to the first row of the area, or as close as possible if it wasn't reached yet*/
+        index_cache_t * cache = decoder->user_data;
+        lv_result_t res = LV_RESULT_OK;
+        lv_mutex_lock(&cache->lock);
+        if(data->index->known_cnt) {
+            uint32_t row = LV_MIN((uint32_t)(LV_MAX(full_area->y1, 0) / my), data->index->known_cnt - 1);
+            if(data->x != 0 || data->y != (int32_t)row * my) {
+                res = index_restore_row(data, row);
+            }
+        }
+        lv_mutex_unlock(&cache->lock);
+        if(res != LV_RESULT_OK) return res;
     }
 
-    if(decoded_area->x2 >= jd->width) decoded_area->x2 = jd->width - 1;
-    if(decoded_area->y2 >= jd->height) decoded_area->y2 = jd->height - 1;
+    while(1) {
+        if(data->y > full_area->y2 || data->y >= jd->height) return LV_RESULT_INVALID;
+
+        if(data->x == 0) index_save_row(decoder, data);
 
-    decoded->header.w = lv_area_get_width(decoded_area);
-    decoded->header.h = lv_area_get_height(decoded_area);
-    decoded->header.stride = decoded->header.w * 3;
-    decoded->data_size = decoded->header.stride * decoded->header.h;
+        /* Process restart interval if enabled */
+        JRESULT rc;
+        if(jd->nrst && jd->rst++ == jd->nrst) {
+            rc = jd_restart(jd, jd->rsc++);
+            if(rc != JDR_OK) return LV_RESULT_INVALID;
+            jd->rst = 1;
+        }
 
-    /* Process restart interval if enabled */
-    JRESULT rc;
-    if(jd->nrst && jd->rst++ == jd->nrst) {
-        rc = jd_restart(jd, jd->rsc++);
+        /* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
+        rc = jd_mcu_load(jd);
         if(rc != JDR_OK) return LV_RESULT_INVALID;
-        jd->rst = 1;
-    }
 
-    /* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
-    rc = jd_mcu_load(jd);
-    if(rc != JDR_OK) return LV_RESULT_INVALID;
+        int32_t x = data->x;
+        int32_t y = data->y;
+        data->x += mx;
+        if(data->x >= jd->width) {
+            data->x = 0;
+            data->y += my;
+        }
 
-    /* Output the MCU (YCbCr to RGB, scaling and output) */
-    rc = jd_mcu_output(jd, NULL, decoded_area->x1, decoded_area->y1);
-    if(rc != JDR_OK) return LV_RESULT_INVALID;
+        /*Needed only to get to the next MCUs*/
+        if(y + my <= full_area->y1 || x + mx <= full_area->x1 || x > full_area->x2) continue;
 
-    return LV_RESULT_OK;
+        decoded_area->x1 = x;
+        decoded_area->y1 = y;
+        decoded_area->x2 = LV_MIN(x + mx - 1, jd->width - 1);
+        decoded_area->y2 = LV_MIN(y + my - 1, jd->height - 1);
+
+        decoded->header.w = lv_area_get_width(decoded_area);
+        decoded->header.h = lv_area_get_height(decoded_area);
+        decoded->header.stride = decoded->header.w * 3;
+        decoded->data_size = decoded->header.stride * decoded->header.h;
+
+        /* Output the MCU (YCbCr to RGB, scaling and output) */
+        rc = jd_mcu_output(jd, NULL, x, y);
+        if(rc != JDR_OK) return LV_RESULT_INVALID;
+
+        return LV_RESULT_OK;
+    }
 }
 
 /**
@@ -282,12 +387,13 @@ static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decod
  */
 static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
 {
-    LV_UNUSED(decoder);
-    JDEC * jd = dsc->user_data;
+    decoder_data_t * data = dsc->user_data;
+    JDEC * jd = &data->jd;
+    index_release(decoder, data->index);
     lv_fs_close(jd->device);
     lv_free(jd->device);
     lv_free(jd->pool_original);
-    lv_free(jd);
+    lv_free(data);
     lv_free((void *)dsc->decoded);
 }
 
@@ -298,4 +404,183 @@ static int is_jpg(const uint8_t * raw_data, size_t len)
     return memcmp(jpg_signature, raw_data, sizeof(jpg_signature)) == 0;
 }
 
+/**
+ * Get the MCU row index of an image or create an empty one for it, and take a reference to it.
+ * The recently used indexes are kept at the head of the list.
+ * @param decoder   pointer to the decoder
+ * @param dsc       pointer to the decoder descriptor
+ * @param jd        pointer to the prepared JPEG decoder of the image
+ * @param src_size  size of the file or data to detect if it has changed
+ * @return          pointer to the index or NULL on error
+ */
+static mcu_row_index_t * index_get(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc, const JDEC * jd,
+                                   uint32_t src_size)
+{
+    index_cache_t * cache = decoder->user_data;
+    if(cache == NULL) return NULL;
+    lv_ll_t * index_ll = &cache->index_ll;
+
+    uint32_t row_cnt = (jd->height + jd->msy * 8 - 1) / (jd->msy * 8);
+
+    lv_mutex_lock(&cache->lock);
+    mcu_row_index_t * index;
+    LV_LL_READ(index_ll, index) {
+        if(index->src_type != dsc->src_type) continue;
+        if(index->src_size != src_size || index->row_cnt != row_cnt) continue;
+
+        if(dsc->src_type == LV_IMAGE_SRC_FILE) {
+            if(lv_strcmp(index->src, dsc->src) != 0) continue;
+        }
+        else {
+            const lv_image_dsc_t * img_dsc = dsc->src;
+            if(index->src != img_dsc->data) continue;
+        }
+
+        lv_ll_move_before(index_ll, index, lv_ll_get_head(index_ll));
+        index->ref_cnt++;
+        lv_mutex_unlock(&cache->lock);
+        return index;
+    }
+
+    /*Not found, make room for it by dropping the least recently used unused indexes*/
+    index_trim(cache, TJPGD_INDEX_CNT - 1);
+
+    index = lv_ll_ins_head(index_ll);
+    if(index == NULL) {
+        lv_mutex_unlock(&cache->lock);
+        return NULL;
+    }
+    lv_memzero(index, sizeof(mcu_row_index_t));
+
+    index->src_type = dsc->src_type;
+    index->src_size = src_size;
+    index->row_cnt = row_cnt;
+    if(dsc->src_type == LV_IMAGE_SRC_FILE) index->src = lv_strdup(dsc->src);
+    else index->src = ((const lv_image_dsc_t *)dsc->src)->data;
+    index->rows = lv_malloc(row_cnt * sizeof(mcu_row_state_t));
+
+    if(index->src == NULL || index->rows == NULL) {
+        index_delete(index);
+        lv_ll_remove(index_ll, index);
+        lv_free(index);
+        index = NULL;
+    }
+    else {
+        index->ref_cnt = 1;
+    }
+
+    lv_mutex_unlock(&cache->lock);
+    return index;
+}
+
+/**
+ * Drop the reference of a session to an index
+ * @param decoder   pointer to the decoder
+ * @param index     pointer to an index returned by `index_get()`
+ */
+static void index_release(lv_image_decoder_t * decoder, mcu_row_index_t * index)
+{
+    index_cache_t * cache = decoder->user_data;
+    lv_mutex_lock(&cache->lock);
+    index->ref_cnt--;
+    /*There can be more indexes than the limit if they were all in use when a new one was added*/
+    index_trim(cache, TJPGD_INDEX_CNT);
+    lv_mutex_unlock(&cache->lock);
+}
+
+/**
+ * Delete the least recently used indexes which are not used by any session until at most `max_cnt` remain.
+ * The lock of the cache needs to be taken.
+ * @param cache     pointer to the index cache
+ * @param max_cnt   number of indexes to keep
+ */
+static void index_trim(index_cache_t * cache, uint32_t max_cnt)
+{
+    lv_ll_t * index_ll = &cache->index_ll;
+    mcu_row_index_t * index = lv_ll_get_tail(index_ll);
+    while(index && lv_ll_get_len(index_ll) > max_cnt) {
+        mcu_row_index_t * prev = lv_ll_get_prev(index_ll, index);
+        if(index->ref_cnt == 0) {
+            index_delete(index);
+            lv_ll_remove(index_ll, index);
+            lv_free(index);
+        }
+        index = prev;
+    }
+}
+
+/**
+ * Free the data of an index, but not the index itself
+ * @param index     pointer to an index
+ */
+static void index_delete(mcu_row_index_t * index)
+{
+    if(index->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)index->src);
+    lv_free(index->rows);
+    index->src = NULL;
+    index->rows = NULL;
+}
+
+/**
+ * Save the state of the decoder if it's at the start of the first not indexed MCU row
+ * @param decoder   pointer to the decoder
+ * @param data      pointer to the decoder data
+ */
+static void index_save_row(lv_image_decoder_t * decoder, decoder_data_t * data)
+{
+    JDEC * jd = &data->jd;
+    mcu_row_index_t * index = data->index;
+    uint32_t row = data->y / (jd->msy * 8);
+
+    uint32_t pos;
+    if(lv_fs_tell(jd->device, &pos) != LV_FS_RES_OK) return;
+
+    /*Other sessions of the same image might index it at the same time*/
+    index_cache_t * cache = decoder->user_data;
+    lv_mutex_lock(&cache->lock);
+    if(row != index->known_cnt || row >= index->row_cnt) {
+        lv_mutex_unlock(&cache->lock);
+        return;
+    }
+
+    mcu_row_state_t * state = &index->rows[row];
+    state->pos = pos - (uint32_t)jd->dctr;
+    state->wreg = jd->wreg;
+    lv_memcpy(state->dcv, jd->dcv, sizeof(state->dcv));
+    state->rst = jd->rst;
+    state->rsc = jd->rsc;
+    state->dbit = jd->dbit;
+    state->marker = jd->marker;
+    index->known_cnt++;
+    lv_mutex_unlock(&cache->lock);
+}
+
+/**
+ * Continue decoding from the start of an indexed MCU row. The lock of the index cache needs to be taken.
+ * @param data      pointer to the decoder data
+ * @param row       index of an MCU row, less than `known_cnt`
+ * @return          LV_RESULT_OK: no error; LV_RESULT_INVALID: the file couldn't be seeked
+ */
+static lv_result_t index_restore_row(decoder_data_t * data, uint32_t row)
+{
+    JDEC * jd = &data->jd;
+    const mcu_row_state_t * state = &data->index->rows[row];
+    if(lv_fs_seek(jd->device, state->pos, LV_FS_SEEK_SET) != LV_FS_RES_OK) return LV_RESULT_INVALID;
+
+    /*Drop the buffered data, it will be read again from the new position*/
+    jd->dctr = 0;
+    jd->dptr = jd->inbuf;
+    jd->wreg = state->wreg;
+    lv_memcpy(jd->dcv, state->dcv, sizeof(jd->dcv));
+    jd->rst = state->rst;
+    jd->rsc = state->rsc;
+    jd->dbit = state->dbit;
+    jd->marker = state->marker;
+
+    data->x = 0;
+    data->y = row * jd->msy * 8;
+
+    return LV_RESULT_OK;
+}
+
 #endif /*LV_USE_TJPGD*/
@@ -28,6 +28,8 @@
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_SSE2         3
+#define LV_DRAW_SW_ASM_AVX2         4
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 #define LV_NEMA_HAL_CUSTOM          0
@@ -228,8 +230,29 @@
             #endif
         #endif
     #endif
+
+    /** Keep up to this many freed blocks of each 16 byte wide size class up to 128 bytes
+     *  and reuse them for the next allocations of the same size class without calling TLSF.
+     *  The cached blocks are returned to TLSF by `lv_mem_monitor()`. 0: disable */
+    #ifndef LV_MEM_SIZE_CLASS_CACHE_CNT
+        #ifdef CONFIG_LV_MEM_SIZE_CLASS_CACHE_CNT
+            #define LV_MEM_SIZE_CLASS_CACHE_CNT CONFIG_LV_MEM_SIZE_CLASS_CACHE_CNT
+        #else
+            #define LV_MEM_SIZE_CLASS_CACHE_CNT 0
+        #endif
+    #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
+/** 1: Count the live and peak size of the allocations per module (see `lv_mem_set_tag()`)
+ *  and a histogram of the allocation sizes. Adds a 16 byte header to each allocation. */
+#ifndef LV_USE_MEM_STATS
+    #ifdef CONFIG_LV_USE_MEM_STATS
+        #define LV_USE_MEM_STATS CONFIG_LV_USE_MEM_STATS
+    #else
+        #define LV_USE_MEM_STATS 0
+    #endif
+#endif
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -557,6 +580,30 @@
         #endif
     #endif
 
+    /** Balance the load between the SW draw units.
+     *  Every render thread gets its own job queue and large fills and images are split
+     *  into row bands which idle threads can steal from the busy ones.
+     *  The displays are not split into tiles by default in this case.
+     *  Requires `LV_DRAW_SW_DRAW_UNIT_CNT > 1`. */
+    #ifndef LV_DRAW_SW_WORK_STEALING
+        #ifdef CONFIG_LV_DRAW_SW_WORK_STEALING
+            #define LV_DRAW_SW_WORK_STEALING CONFIG_LV_DRAW_SW_WORK_STEALING
+        #else
+            #define LV_DRAW_SW_WORK_STEALING    0
+        #endif
+    #endif
+
+    #if LV_DRAW_SW_WORK_STEALING
+        /** Minimum height of a row band in pixels. Draw tasks lower than twice this value are not split. */
+        #ifndef LV_DRAW_SW_WORK_STEALING_MIN_ROWS
+            #ifdef CONFIG_LV_DRAW_SW_WORK_STEALING_MIN_ROWS
+                #define LV_DRAW_SW_WORK_STEALING_MIN_ROWS CONFIG_LV_DRAW_SW_WORK_STEALING_MIN_ROWS
+            #else
+                #define LV_DRAW_SW_WORK_STEALING_MIN_ROWS   32
+            #endif
+        #endif
+    #endif
+
     /** Use Arm-2D to accelerate software (sw) rendering. */
     #ifndef LV_USE_DRAW_ARM2D_SYNC
         #ifdef CONFIG_LV_USE_DRAW_ARM2D_SYNC
@@ -615,6 +662,13 @@
         #endif
     #endif
 
+    /** Use SIMD accelerated blending:
+     *  - LV_DRAW_SW_ASM_NONE:    plain C
+     *  - LV_DRAW_SW_ASM_NEON:    Arm NEON assembly
+     *  - LV_DRAW_SW_ASM_HELIUM:  Arm Helium assembly
+     *  - LV_DRAW_SW_ASM_SSE2:    x86 SSE2 intrinsics
+     *  - LV_DRAW_SW_ASM_AVX2:    x86 AVX2 intrinsics (the compiler has to target AVX2, e.g. `-mavx2`)
+     *  - LV_DRAW_SW_ASM_CUSTOM:  use LV_DRAW_SW_ASM_CUSTOM_INCLUDE */
     #ifndef LV_USE_DRAW_SW_ASM
         #ifdef CONFIG_LV_USE_DRAW_SW_ASM
             #define LV_USE_DRAW_SW_ASM CONFIG_LV_USE_DRAW_SW_ASM
@@ -1322,6 +1376,60 @@
     #endif
 #endif
 
+/** 1: Evict the images from the cache by decoding time and size (GreedyDual-Size), not only by last use.
+ *  Small images which are slow to decode (e.g. PNG, JPG) are kept longer than large, quick to open ones. */
+#ifndef LV_IMAGE_CACHE_COST_AWARE
+    #ifdef CONFIG_LV_IMAGE_CACHE_COST_AWARE
+        #define LV_IMAGE_CACHE_COST_AWARE CONFIG_LV_IMAGE_CACHE_COST_AWARE
+    #else
+        #define LV_IMAGE_CACHE_COST_AWARE 0
+    #endif
+#endif
+
+/** Images larger than this % of `LV_CACHE_DEF_SIZE` are cached only when they are opened the second time,
+ *  so one-off large images don't evict the others. 0: cache all images. */
+#ifndef LV_IMAGE_CACHE_ADMIT_PCT
+    #ifdef CONFIG_LV_IMAGE_CACHE_ADMIT_PCT
+        #define LV_IMAGE_CACHE_ADMIT_PCT CONFIG_LV_IMAGE_CACHE_ADMIT_PCT
+    #else
+        #define LV_IMAGE_CACHE_ADMIT_PCT 0
+    #endif
+#endif
+
+/** Split the image and image header caches into this many independently locked shards,
+ *  so the draw threads (`LV_DRAW_SW_DRAW_UNIT_CNT > 1`) don't wait for each other on cache hits.
+ *  Each shard can hold 1/N of the cache size. 1: no sharding. */
+#ifndef LV_IMAGE_CACHE_SHARD_CNT
+    #ifdef CONFIG_LV_IMAGE_CACHE_SHARD_CNT
+        #define LV_IMAGE_CACHE_SHARD_CNT CONFIG_LV_IMAGE_CACHE_SHARD_CNT
+    #else
+        #define LV_IMAGE_CACHE_SHARD_CNT 1
+    #endif
+#endif
+
+/** 1: Enable decoding images on a background thread with `lv_image_set_decode_async()`.
+ *  Requires `LV_USE_OS` and the image cache (`LV_CACHE_DEF_SIZE > 0`) to keep the decoded images. */
+#ifndef LV_USE_IMAGE_DECODER_ASYNC
+    #ifdef CONFIG_LV_USE_IMAGE_DECODER_ASYNC
+        #define LV_USE_IMAGE_DECODER_ASYNC CONFIG_LV_USE_IMAGE_DECODER_ASYNC
+    #else
+        #define LV_USE_IMAGE_DECODER_ASYNC 0
+    #endif
+#endif
+
+/** 1: Convert the cached RGB888, XRGB8888 and ARGB8888 images to the display's RGB565 or RGB565_SWAPPED
+ *  color format (RGB565A8 if the image has transparent pixels) when they are decoded,
+ *  so they can be blended without color conversion. Can be disabled with `lv_image_decoder_set_convert_native()`.
+ *  Variable images which can be drawn directly (e.g. C arrays) are converted only if enabled by
+ *  `lv_image_decoder_set_convert_native_variables()`. */
+#ifndef LV_IMAGE_DECODER_CONVERT_NATIVE
+    #ifdef CONFIG_LV_IMAGE_DECODER_CONVERT_NATIVE
+        #define LV_IMAGE_DECODER_CONVERT_NATIVE CONFIG_LV_IMAGE_DECODER_CONVERT_NATIVE
+    #else
+        #define LV_IMAGE_DECODER_CONVERT_NATIVE 0
+    #endif
+#endif
+
 /** Number of stops allowed per gradient. Increase this to allow more stops.
  *  This adds (sizeof(lv_color_t) + 1) bytes per additional stop. */
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -1355,6 +1463,59 @@
     #endif
 #endif
 
+/** Cache the resolved style property values of each `lv_obj_t`.
+ *  Number of cached values per object, must be a power of 2. 0: disable.
+ *  The cache is allocated together with the object, each entry takes 8..16 bytes.
+ *  The cached values of an object are dropped when its style list, state or parent changes,
+ *  or lv_obj_report_style_change() reports a change of one of its styles. */
+#ifndef LV_OBJ_STYLE_VALUE_CACHE_CNT
+    #ifdef CONFIG_LV_OBJ_STYLE_VALUE_CACHE_CNT
+        #define LV_OBJ_STYLE_VALUE_CACHE_CNT CONFIG_LV_OBJ_STYLE_VALUE_CACHE_CNT
+    #else
+        #define LV_OBJ_STYLE_VALUE_CACHE_CNT    0
+    #endif
+#endif
+
+/** Keep the properties of the (non-constant) styles sorted to find them with binary search.
+ *  The property buffer of the styles grows geometrically instead of being reallocated on every new property. */
+#ifndef LV_STYLE_SORTED_PROPS
+    #ifdef CONFIG_LV_STYLE_SORTED_PROPS
+        #define LV_STYLE_SORTED_PROPS CONFIG_LV_STYLE_SORTED_PROPS
+    #else
+        #define LV_STYLE_SORTED_PROPS   0
+    #endif
+#endif
+
+/** Keep the timers in a binary heap ordered by their deadlines.
+ *  `lv_timer_handler()` checks only the timers which are ready instead of all of them. */
+#ifndef LV_TIMER_DEADLINE_HEAP
+    #ifdef CONFIG_LV_TIMER_DEADLINE_HEAP
+        #define LV_TIMER_DEADLINE_HEAP CONFIG_LV_TIMER_DEADLINE_HEAP
+    #else
+        #define LV_TIMER_DEADLINE_HEAP  0
+    #endif
+#endif
+
+/** Index the running animations by their `var` in a hash table.
+ *  Starting and deleting animations doesn't need to scan all the running animations. */
+#ifndef LV_ANIM_HASH_INDEX
+    #ifdef CONFIG_LV_ANIM_HASH_INDEX
+        #define LV_ANIM_HASH_INDEX CONFIG_LV_ANIM_HASH_INDEX
+    #else
+        #define LV_ANIM_HASH_INDEX      0
+    #endif
+#endif
+
+/** Keep the memory of the deleted objects of the classes set by `lv_obj_class_set_pool_size()`
+ *  and reuse it for the new objects of the same class. */
+#ifndef LV_USE_OBJ_POOL
+    #ifdef CONFIG_LV_USE_OBJ_POOL
+        #define LV_USE_OBJ_POOL CONFIG_LV_USE_OBJ_POOL
+    #else
+        #define LV_USE_OBJ_POOL         0
+    #endif
+#endif
+
 /** Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -1897,6 +2058,16 @@
     #endif
 #endif
 
+/** Allow creating tables to get the glyph of a letter and the kerning values without searching.
+ *  See `lv_font_fmt_txt_lookup_create()`. Useful for fonts with many sparse characters, e.g. CJK fonts. */
+#ifndef LV_FONT_FMT_TXT_LOOKUP_TABLE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_LOOKUP_TABLE
+        #define LV_FONT_FMT_TXT_LOOKUP_TABLE CONFIG_LV_FONT_FMT_TXT_LOOKUP_TABLE
+    #else
+        #define LV_FONT_FMT_TXT_LOOKUP_TABLE 0
+    #endif
+#endif
+
 /** Enables/disables support for compressed fonts. */
 #ifndef LV_USE_FONT_COMPRESSED
     #ifdef CONFIG_LV_USE_FONT_COMPRESSED
@@ -1906,6 +2077,16 @@
     #endif
 #endif
 
+/** Size of the cache for the decompressed glyph bitmaps of compressed fonts [bytes].
+ *  The recently used glyphs are not decompressed again on every draw. 0: disable caching. */
+#ifndef LV_FONT_FMT_TXT_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_CACHE_SIZE 0
+    #endif
+#endif
+
 /** Enable drawing placeholders when glyph dsc is not found. */
 #ifndef LV_USE_FONT_PLACEHOLDER
     #ifdef LV_KCONFIG_PRESENT
@@ -2296,6 +2477,13 @@
             #define LV_LABEL_LONG_TXT_HINT 1    /**< Store some extra info in labels to speed up drawing of very long text */
         #endif
     #endif
+    #ifndef LV_LABEL_LINE_CACHE
+        #ifdef CONFIG_LV_LABEL_LINE_CACHE
+            #define LV_LABEL_LINE_CACHE CONFIG_LV_LABEL_LINE_CACHE
+        #else
+            #define LV_LABEL_LINE_CACHE 0       /**< Store the start and width of the wrapped lines to draw only the visible lines */
+        #endif
+    #endif
     #ifndef LV_LABEL_WAIT_CHAR_COUNT
         #ifdef CONFIG_LV_LABEL_WAIT_CHAR_COUNT
             #define LV_LABEL_WAIT_CHAR_COUNT CONFIG_LV_LABEL_WAIT_CHAR_COUNT
@@ -2651,6 +2839,17 @@
     #endif
 #endif
 
+/** Keep the style dependent values of the children measured by Flex and Grid (~40 bytes per child of
+ *  the containers) and the tracks of Grid between the layout updates.
+ *  Adds a 4 bytes style version counter to every widget. */
+#ifndef LV_LAYOUT_MEASURE_CACHE
+    #ifdef CONFIG_LV_LAYOUT_MEASURE_CACHE
+        #define LV_LAYOUT_MEASURE_CACHE CONFIG_LV_LAYOUT_MEASURE_CACHE
+    #else
+        #define LV_LAYOUT_MEASURE_CACHE 0
+    #endif
+#endif
+
 /*====================
  * 3RD PARTS LIBRARIES
  *====================*/
@@ -2669,6 +2868,16 @@
     #endif
 #endif
 
+/** Number of `LV_FS_*_CACHE_SIZE` bytes large blocks cached by `lv_fs_read()` per open file.
+ *  With 2 or more blocks, the next block is also read when a file is read sequentially. */
+#ifndef LV_FS_CACHE_BLOCK_CNT
+    #ifdef CONFIG_LV_FS_CACHE_BLOCK_CNT
+        #define LV_FS_CACHE_BLOCK_CNT CONFIG_LV_FS_CACHE_BLOCK_CNT
+    #else
+        #define LV_FS_CACHE_BLOCK_CNT 1
+    #endif
+#endif
+
 /** API for fopen, fread, etc. */
 #ifndef LV_USE_FS_STDIO
     #ifdef CONFIG_LV_USE_FS_STDIO
@@ -2916,6 +3125,17 @@
         #define LV_USE_LODEPNG 0
     #endif
 #endif
+#if LV_USE_LODEPNG
+    /** >0: Decode the images which are not cached in bands of this many rows while drawing,
+     *  instead of decoding the whole image to the memory. */
+    #ifndef LV_LODEPNG_BAND_HEIGHT
+        #ifdef CONFIG_LV_LODEPNG_BAND_HEIGHT
+            #define LV_LODEPNG_BAND_HEIGHT CONFIG_LV_LODEPNG_BAND_HEIGHT
+        #else
+            #define LV_LODEPNG_BAND_HEIGHT 0
+        #endif
+    #endif
+#endif
 
 /** PNG decoder(libpng) library */
 #ifndef LV_USE_LIBPNG
@@ -10,8 +10,10 @@
 #include "misc/lv_profiler_builtin_private.h"
 #include "misc/lv_anim_private.h"
 #include "draw/lv_image_decoder_private.h"
+#include "font/lv_font_fmt_txt_private.h"
 #include "draw/lv_draw_buf_private.h"
 #include "core/lv_refr_private.h"
+#include "core/lv_obj_class_private.h"
 #include "core/lv_obj_style_private.h"
 #include "core/lv_group_private.h"
 #include "lv_init.h"
@@ -34,6 +36,7 @@
 #include "draw/lv_draw.h"
 #include "misc/lv_async.h"
 #include "misc/lv_fs_private.h"
+#include "stdlib/lv_mem_private.h"
 #include "widgets/span/lv_span.h"
 #include "themes/simple/lv_theme_simple.h"
 #include "misc/lv_fs.h"
@@ -187,6 +190,10 @@ void lv_init(void)
     /*Initialize members of static variable lv_global */
     LV_GLOBAL_INIT(LV_GLOBAL_DEFAULT());
 
+#if LV_USE_MEM_STATS
+    lv_mem_stats_init();
+#endif
+
     lv_mem_init();
 
     lv_draw_buf_init_handlers();
@@ -280,6 +287,10 @@ void lv_init(void)
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+    lv_font_fmt_txt_cache_init();
+#endif
+
 #if LV_USE_DRAW_VG_LITE
     lv_draw_vg_lite_init();
 #endif
@@ -427,6 +438,14 @@ void lv_deinit(void)
     lv_freetype_uninit();
 #endif
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0
+    lv_font_fmt_txt_cache_deinit();
+#endif
+
+#if LV_USE_OBJ_POOL
+    lv_obj_class_pool_deinit();
+#endif
+
 #if LV_USE_THEME_DEFAULT
     lv_theme_default_deinit();
 #endif
@@ -501,6 +520,10 @@ void lv_deinit(void)
 
     lv_mem_deinit();
 
+#if LV_USE_MEM_STATS
+    lv_mem_stats_deinit();
+#endif
+
     lv_initialized = false;
 
     LV_LOG_INFO("lv_deinit done");
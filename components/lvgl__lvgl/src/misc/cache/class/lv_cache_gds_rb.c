@@ -0,0 +1,419 @@
+/**
+* @file lv_cache_gds_rb.c
+*
+*/
+
+/**
+ * GreedyDual-Size eviction:
+ * - every entry has a priority `H = L + cost / size` which is set when it's added or used
+ * - the entry with the lowest `H` is evicted and `L` is raised to its `H`
+ *
+ * So cheap to recreate and large entries are evicted first, but as `L` grows
+ * entries which are not used for a long time get evicted eventually even if they are expensive.
+ * The cost is read from the `lv_cache_slot_cost_t` slot when looking for a victim,
+ * so it can be set after the entry was added (e.g. when the decoding time is known).
+ * On equal priority the least recently used entry is evicted.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_cache_gds_rb.h"
+#include "../lv_cache_entry.h"
+#include "../../../stdlib/lv_sprintf.h"
+#include "../../../stdlib/lv_string.h"
+#include "../../lv_ll.h"
+#include "../../lv_rb_private.h"
+#include "../../lv_rb.h"
+#include "../../lv_iter.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Fixed point scale of `cost / size`*/
+#define GDS_PRIORITY_SCALE  (1 << 20)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Stored after the entry in the rb nodes. Not aligned so accessed by `lv_memcpy`*/
+typedef struct {
+    void * ll_node;     /**< Node in the recency list*/
+    uint64_t base;      /**< `L` when the entry was last added or used*/
+} gds_node_ext_t;
+
+typedef struct {
+    lv_cache_t cache;
+
+    lv_rb_t rb;
+    lv_ll_t ll;         /**< Pointers to the rb nodes, the most recently used first*/
+
+    uint64_t inflation; /**< `L`: the priority of the last victim*/
+} lv_gds_rb_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void * alloc_cb(void);
+static bool init_cb(lv_cache_t * cache);
+static void destroy_cb(lv_cache_t * cache, void * user_data);
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data);
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data);
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void drop_all_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data);
+
+static void * get_ext(lv_gds_rb_t * gds, lv_rb_node_t * node);
+static void ext_read(lv_gds_rb_t * gds, lv_rb_node_t * node, gds_node_ext_t * ext);
+static void ext_write(lv_gds_rb_t * gds, lv_rb_node_t * node, const gds_node_ext_t * ext);
+static uint64_t get_priority(lv_gds_rb_t * gds, lv_rb_node_t * node);
+static void remove_node(lv_gds_rb_t * gds, lv_rb_node_t * node);
+
+static lv_iter_t * cache_iter_create_cb(lv_cache_t * cache);
+static lv_result_t cache_iter_next_cb(void * instance, void * context, void * elem);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_cache_class_t lv_cache_class_gds_rb_size = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb,
+    .iter_create_cb = cache_iter_create_cb,
+};
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * alloc_cb(void)
+{
+    void * res = lv_malloc(sizeof(lv_gds_rb_t));
+    LV_ASSERT_MALLOC(res);
+    if(res == NULL) {
+        LV_LOG_ERROR("malloc failed");
+        return NULL;
+    }
+
+    lv_memzero(res, sizeof(lv_gds_rb_t));
+    return res;
+}
+
+static bool init_cb(lv_cache_t * cache)
+{
+    lv_gds_rb_t * gds = (lv_gds_rb_t *)cache;
+
+    LV_ASSERT_NULL(gds->cache.ops.compare_cb);
+    LV_ASSERT_NULL(gds->cache.ops.free_cb);
+    LV_ASSERT(gds->cache.node_size >= sizeof(lv_cache_slot_cost_t));
+
+    if(gds->cache.node_size < sizeof(lv_cache_slot_cost_t) || gds->cache.ops.compare_cb == NULL ||
+       gds->cache.ops.free_cb == NULL) {
+        return false;
+    }
+
+    if(!lv_rb_init(&gds->rb, gds->cache.ops.compare_cb,
+                   lv_cache_entry_get_size(gds->cache.node_size) + sizeof(gds_node_ext_t))) {
+        return false;
+    }
+    lv_ll_init(&gds->ll, sizeof(void *));
+    gds->inflation = 0;
+
+    return true;
+}
+
+static void destroy_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_ASSERT_NULL(cache);
+
+    if(cache == NULL) {
+        return;
+    }
+
+    cache->clz->drop_all_cb(cache, user_data);
+}
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_gds_rb_t * gds = (lv_gds_rb_t *)cache;
+
+    LV_ASSERT_NULL(gds);
+    LV_ASSERT_NULL(key);
+
+    if(gds == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&gds->rb, key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    /*Restore the priority and make it the most recently used*/
+    gds_node_ext_t ext;
+    ext_read(gds, node, &ext);
+    ext.base = gds->inflation;
+    ext_write(gds, node, &ext);
+    lv_ll_move_before(&gds->ll, ext.ll_node, lv_ll_get_head(&gds->ll));
+
+    return lv_cache_entry_get_entry(node->data, cache->node_size);
+}
+
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_gds_rb_t * gds = (lv_gds_rb_t *)cache;
+
+    LV_ASSERT_NULL(gds);
+    LV_ASSERT_NULL(key);
+
+    if(gds == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_insert(&gds->rb, (void *)key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    gds_node_ext_t ext;
+    ext.ll_node = lv_ll_ins_head(&gds->ll);
+    if(ext.ll_node == NULL) {
+        lv_rb_drop_node(&gds->rb, node);
+        return NULL;
+    }
+    lv_memcpy(ext.ll_node, &node, sizeof(void *));
+    ext.base = gds->inflation;
+
+    lv_memcpy(node->data, key, cache->node_size);
+    ext_write(gds, node, &ext);
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(node->data, cache->node_size);
+    lv_cache_entry_init(entry, cache, cache->node_size);
+
+    cache->size += ((lv_cache_slot_cost_t *)key)->size;
+
+    return entry;
+}
+
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_gds_rb_t * gds = (lv_gds_rb_t *)cache;
+
+    LV_ASSERT_NULL(gds);
+    LV_ASSERT_NULL(entry);
+
+    if(gds == NULL || entry == NULL) {
+        return;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&gds->rb, lv_cache_entry_get_data(entry));
+    if(node == NULL) {
+        return;
+    }
+
+    remove_node(gds, node);
+}
+
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    lv_gds_rb_t * gds = (lv_gds_rb_t *)cache;
+
+    LV_ASSERT_NULL(gds);
+    LV_ASSERT_NULL(key);
+
+    if(gds == NULL || key == NULL) {
+        return;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&gds->rb, key);
+    if(node == NULL) {
+        return;
+    }
+
+    void * data = node->data;
+    gds->cache.ops.free_cb(data, user_data);
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+    remove_node(gds, node);
+    lv_cache_entry_delete(entry);
+}
+
+static void drop_all_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_gds_rb_t * gds = (lv_gds_rb_t *)cache;
+
+    LV_ASSERT_NULL(gds);
+
+    if(gds == NULL) {
+        return;
+    }
+
+    uint32_t used_cnt = 0;
+    lv_rb_node_t ** node;
+    LV_LL_READ(&gds->ll, node) {
+        void * data = (*node)->data;
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+        if(lv_cache_entry_get_ref(entry) == 0) {
+            gds->cache.ops.free_cb(data, user_data);
+        }
+        else {
+            LV_LOG_WARN("entry (%p) is still referenced (%" LV_PRId32 ")", (void *)entry, lv_cache_entry_get_ref(entry));
+            used_cnt++;
+        }
+    }
+    if(used_cnt > 0) {
+        LV_LOG_WARN("%" LV_PRId32 " entries are still referenced", used_cnt);
+    }
+
+    lv_rb_destroy(&gds->rb);
+    lv_ll_clear(&gds->ll);
+
+    cache->size = 0;
+    gds->inflation = 0;
+}
+
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_gds_rb_t * gds = (lv_gds_rb_t *)cache;
+
+    LV_ASSERT_NULL(gds);
+
+    /*Start from the least recently used to evict it on equal priority*/
+    lv_cache_entry_t * victim = NULL;
+    uint64_t victim_priority = UINT64_MAX;
+    lv_rb_node_t ** node;
+    LV_LL_READ_BACK(&gds->ll, node) {
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry((*node)->data, cache->node_size);
+        if(lv_cache_entry_get_ref(entry) != 0) continue;
+
+        uint64_t priority = get_priority(gds, *node);
+        if(priority < victim_priority) {
+            victim = entry;
+            victim_priority = priority;
+        }
+    }
+
+    if(victim) gds->inflation = victim_priority;
+
+    return victim;
+}
+
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    LV_ASSERT_NULL(cache);
+
+    if(cache == NULL) {
+        return LV_CACHE_RESERVE_COND_ERROR;
+    }
+
+    size_t data_size = key ? ((lv_cache_slot_cost_t *)key)->size : 0;
+    if(data_size > cache->max_size) {
+        LV_LOG_ERROR("data size (%" LV_PRIu32 ") is larger than max size (%" LV_PRIu32 ")", (uint32_t)data_size,
+                     cache->max_size);
+        return LV_CACHE_RESERVE_COND_TOO_LARGE;
+    }
+
+    return cache->size + reserved_size + data_size > cache->max_size
+           ? LV_CACHE_RESERVE_COND_NEED_VICTIM
+           : LV_CACHE_RESERVE_COND_OK;
+}
+
+static void * get_ext(lv_gds_rb_t * gds, lv_rb_node_t * node)
+{
+    return (char *)node->data + lv_cache_entry_get_size(gds->cache.node_size);
+}
+
+static void ext_read(lv_gds_rb_t * gds, lv_rb_node_t * node, gds_node_ext_t * ext)
+{
+    lv_memcpy(ext, get_ext(gds, node), sizeof(gds_node_ext_t));
+}
+
+static void ext_write(lv_gds_rb_t * gds, lv_rb_node_t * node, const gds_node_ext_t * ext)
+{
+    lv_memcpy(get_ext(gds, node), ext, sizeof(gds_node_ext_t));
+}
+
+static uint64_t get_priority(lv_gds_rb_t * gds, lv_rb_node_t * node)
+{
+    gds_node_ext_t ext;
+    ext_read(gds, node, &ext);
+
+    /*+1 to prefer the smaller ones from the entries with unknown or zero cost*/
+    const lv_cache_slot_cost_t * slot = node->data;
+    uint64_t size = slot->size > 0 ? slot->size : 1;
+    return ext.base + ((uint64_t)slot->cost + 1) * GDS_PRIORITY_SCALE / size;
+}
+
+static void remove_node(lv_gds_rb_t * gds, lv_rb_node_t * node)
+{
+    gds_node_ext_t ext;
+    ext_read(gds, node, &ext);
+    gds->cache.size -= ((lv_cache_slot_cost_t *)node->data)->size;
+
+    lv_rb_remove_node(&gds->rb, node);
+    lv_ll_remove(&gds->ll, ext.ll_node);
+    lv_free(ext.ll_node);
+}
+
+static lv_iter_t * cache_iter_create_cb(lv_cache_t * cache)
+{
+    return lv_iter_create(cache, lv_cache_entry_get_size(cache->node_size), sizeof(void *), cache_iter_next_cb);
+}
+
+static lv_result_t cache_iter_next_cb(void * instance, void * context, void * elem)
+{
+    lv_gds_rb_t * gds = (lv_gds_rb_t *)instance;
+    lv_rb_node_t *** ll_node = context;
+
+    LV_ASSERT_NULL(ll_node);
+
+    if(*ll_node == NULL) *ll_node = lv_ll_get_head(&gds->ll);
+    else *ll_node = lv_ll_get_next(&gds->ll, *ll_node);
+
+    lv_rb_node_t ** node = *ll_node;
+
+    if(node == NULL) return LV_RESULT_INVALID;
+
+    lv_memcpy(elem, (*node)->data, lv_cache_entry_get_size(gds->cache.node_size));
+
+    return LV_RESULT_OK;
+}
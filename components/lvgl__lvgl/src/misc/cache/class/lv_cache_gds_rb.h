@@ -0,0 +1,50 @@
+/**
+* @file lv_cache_gds_rb.h
+*
+*/
+
+#ifndef LV_CACHE_GDS_RB_H
+#define LV_CACHE_GDS_RB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_cache_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/*************************
+ *    GLOBAL VARIABLES
+ *************************/
+
+/**
+ * GreedyDual-Size cache with size-based limit. The nodes need to start with `lv_cache_slot_cost_t`.
+ * The entry with the lowest `cost / size` is evicted first, but recently used entries are kept longer
+ * so expensive entries which are not used anymore are evicted eventually too.
+ */
+LV_ATTRIBUTE_EXTERN_DATA extern const lv_cache_class_t lv_cache_class_gds_rb_size;
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_CACHE_GDS_RB_H*/
@@ -21,6 +21,8 @@
 #define CACHE_NAME  "IMAGE"
 
 #define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
+#define admission_p (&LV_GLOBAL_DEFAULT()->img_cache_admission)
+#define ADMISSION_SEEN_CNT (sizeof(admission_p->seen) / sizeof(admission_p->seen[0]))
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
 
 /**********************
@@ -35,6 +37,7 @@ static lv_cache_compare_res_t image_cache_compare_cb(const lv_image_cache_data_t
                                                      const lv_image_cache_data_t * rhs);
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data);
 static void iter_inspect_cb(void * elem);
+static uint32_t image_cache_hash_cb(const lv_image_cache_data_t * data);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -58,12 +61,22 @@ lv_result_t lv_image_cache_init(uint32_t size)
         return LV_RESULT_OK;
     }
 
-    img_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+#if LV_IMAGE_CACHE_COST_AWARE
+    const lv_cache_class_t * cache_class = &lv_cache_class_gds_rb_size;
+#else
+    const lv_cache_class_t * cache_class = &lv_cache_class_lru_rb_size;
+#endif
+
+    lv_memzero(admission_p, sizeof(lv_image_cache_admission_t));
+    admission_p->max_pct = LV_IMAGE_CACHE_ADMIT_PCT;
+
+    img_cache_p = lv_cache_create_sharded(cache_class,
     sizeof(lv_image_cache_data_t), size, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_cache_compare_cb,
         .create_cb = NULL,
         .free_cb = (lv_cache_free_cb_t) image_cache_free_cb,
-    });
+        .hash_cb = (lv_cache_hash_cb_t) image_cache_hash_cb,
+    }, LV_IMAGE_CACHE_SHARD_CNT);
 
     lv_cache_set_name(img_cache_p, CACHE_NAME);
     return img_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
@@ -100,6 +113,77 @@ bool lv_image_cache_is_enabled(void)
     return lv_cache_is_enabled(img_cache_p);
 }
 
+bool lv_image_cache_contains(const void * src)
+{
+    if(src == NULL || !lv_cache_is_enabled(img_cache_p)) return false;
+
+    lv_image_cache_data_t search_key = {
+        .src = src,
+        .src_type = lv_image_src_get_type(src),
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire(img_cache_p, &search_key, NULL);
+    if(entry == NULL) return false;
+
+    lv_cache_release(img_cache_p, entry, NULL);
+    return true;
+}
+
+void lv_image_cache_set_admission(uint32_t max_pct)
+{
+    lv_mutex_lock(&img_cache_p->lock);
+    admission_p->max_pct = max_pct;
+    lv_memzero(admission_p->seen, sizeof(admission_p->seen));
+    lv_mutex_unlock(&img_cache_p->lock);
+}
+
+bool lv_image_cache_admit(const void * src, uint32_t size)
+{
+    lv_image_cache_admission_t * admission = admission_p;
+    if(admission->max_pct == 0) return true;
+
+    lv_mutex_lock(&img_cache_p->lock);
+    bool admit = (uint64_t)size * 100 <= (uint64_t)img_cache_p->max_size * admission->max_pct;
+    if(!admit) {
+        /*Admit if it was opened recently, else remember it*/
+        uint32_t hash = lv_image_cache_src_hash(src, lv_image_src_get_type(src));
+        uint32_t i;
+        for(i = 0; i < ADMISSION_SEEN_CNT; i++) {
+            if(admission->seen[i] == hash) {
+                admission->seen[i] = 0;
+                admit = true;
+                break;
+            }
+        }
+
+        if(!admit) {
+            admission->seen[admission->seen_idx] = hash;
+            admission->seen_idx = (admission->seen_idx + 1) % ADMISSION_SEEN_CNT;
+        }
+    }
+    lv_mutex_unlock(&img_cache_p->lock);
+
+    return admit;
+}
+
+uint32_t lv_image_cache_src_hash(const void * src, lv_image_src_t src_type)
+{
+    /*FNV-1a of the path or the pointer*/
+    uint32_t hash = 2166136261u;
+    if(src_type == LV_IMAGE_SRC_FILE) {
+        const uint8_t * c;
+        for(c = src; *c; c++) hash = (hash ^ *c) * 16777619u;
+    }
+    else {
+        uintptr_t p = (uintptr_t)src;
+        uint32_t i;
+        for(i = 0; i < sizeof(p); i++) hash = (hash ^ ((p >> (i * 8)) & 0xff)) * 16777619u;
+    }
+
+    /*0 means empty slot in the admission filter*/
+    return hash ? hash : 1;
+}
+
 lv_iter_t * lv_image_cache_iter_create(void)
 {
     return lv_cache_iter_create(img_cache_p);
@@ -111,7 +195,7 @@ void lv_image_cache_dump(void)
     if(iter == NULL) return;
 
     LV_LOG_USER("Image cache dump:");
-    LV_LOG_USER("\tsize\tdata_size\tcf\trc\ttype\tdecoded\t\t\tsrc");
+    LV_LOG_USER("\tsize\tdata_size\tcf\trc\tcost\thits\ttype\tdecoded\t\t\tsrc");
     lv_iter_inspect(iter, iter_inspect_cb);
 }
 
@@ -171,20 +255,28 @@ static void iter_inspect_cb(void * elem)
     LV_UNUSED(header);
     LV_UNUSED(entry);
 
-    /*  size    data_size   cf  rc  type    decoded         src*/
-#define IMAGE_CACHE_DUMP_FORMAT "	%4dx%-4d	%9"LV_PRIu32"	%d	%"LV_PRId32"	"
+    /*  size    data_size   cf  rc  cost    hits    type    decoded         src*/
+#define IMAGE_CACHE_DUMP_FORMAT "	%4dx%-4d	%9"LV_PRIu32"	%d	%"LV_PRId32"	%4"LV_PRIu32"ms	%"LV_PRIu32"	"
     switch(data->src_type) {
         case LV_IMAGE_SRC_FILE:
             LV_LOG_USER(IMAGE_CACHE_DUMP_FORMAT "file\t%-12p\t%s", header->w, header->h, decoded->data_size, header->cf,
-                        lv_cache_entry_get_ref(entry), (void *)data->decoded, (char *)data->src);
+                        lv_cache_entry_get_ref(entry), data->slot.cost, lv_cache_entry_get_hit_cnt(entry),
+                        (void *)data->decoded, (char *)data->src);
             break;
         case LV_IMAGE_SRC_VARIABLE:
             LV_LOG_USER(IMAGE_CACHE_DUMP_FORMAT "var \t%-12p\t%p", header->w, header->h, decoded->data_size, header->cf,
-                        lv_cache_entry_get_ref(entry), (void *)data->decoded, data->src);
+                        lv_cache_entry_get_ref(entry), data->slot.cost, lv_cache_entry_get_hit_cnt(entry),
+                        (void *)data->decoded, data->src);
             break;
         default:
             LV_LOG_USER(IMAGE_CACHE_DUMP_FORMAT "unkn\t%-12p\t%p", header->w, header->h, decoded->data_size, header->cf,
-                        lv_cache_entry_get_ref(entry), (void *)data->decoded, data->src);
+                        lv_cache_entry_get_ref(entry), data->slot.cost, lv_cache_entry_get_hit_cnt(entry),
+                        (void *)data->decoded, data->src);
             break;
     }
 }
+
+static uint32_t image_cache_hash_cb(const lv_image_cache_data_t * data)
+{
+    return lv_image_cache_src_hash(data->src, data->src_type);
+}
@@ -55,6 +55,29 @@ void lv_image_cache_drop(const void * src);
  */
 bool lv_image_cache_is_enabled(void);
 
+/**
+ * Check whether the decoded image of a source is in the cache.
+ * @param src   pointer to an image source.
+ * @return      true: the image is cached, false: it needs to be decoded.
+ */
+bool lv_image_cache_contains(const void * src);
+
+/**
+ * Set the admission filter of the image cache. Images larger than `max_pct` % of the cache size
+ * are not cached when opened the first time, only when they are opened again soon. So one-off
+ * large images don't evict the frequently used ones.
+ * @param max_pct   size limit in percentage of the cache size. 0: cache all images
+ */
+void lv_image_cache_set_admission(uint32_t max_pct);
+
+/**
+ * Check if an image can be added to the cache. Used by the image decoder before opening an image.
+ * @param src       pointer to an image source.
+ * @param size      the expected size of the decoded image in bytes
+ * @return          true: add it to the cache, false: the decoded image should be used only once
+ */
+bool lv_image_cache_admit(const void * src, uint32_t size);
+
 /**
  * Create an iterator to iterate over the image cache.
  * @return an iterator to iterate over the image cache.
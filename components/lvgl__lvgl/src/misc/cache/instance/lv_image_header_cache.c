@@ -33,6 +33,7 @@
 static lv_cache_compare_res_t image_header_cache_compare_cb(const lv_image_header_cache_data_t * lhs,
                                                             const lv_image_header_cache_data_t * rhs);
 static void image_header_cache_free_cb(lv_image_header_cache_data_t * entry, void * user_data);
+static uint32_t image_header_cache_hash_cb(const lv_image_header_cache_data_t * data);
 static void iter_inspect_cb(void * elem);
 
 /**********************
@@ -57,12 +58,13 @@ lv_result_t lv_image_header_cache_init(uint32_t count)
         return LV_RESULT_OK;
     }
 
-    img_header_cache_p = lv_cache_create(&lv_cache_class_lru_rb_count,
+    img_header_cache_p = lv_cache_create_sharded(&lv_cache_class_lru_rb_count,
     sizeof(lv_image_header_cache_data_t), count, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_header_cache_compare_cb,
         .create_cb = NULL,
-        .free_cb = (lv_cache_free_cb_t) image_header_cache_free_cb
-    });
+        .free_cb = (lv_cache_free_cb_t) image_header_cache_free_cb,
+        .hash_cb = (lv_cache_hash_cb_t) image_header_cache_hash_cb,
+    }, LV_IMAGE_CACHE_SHARD_CNT);
 
     lv_cache_set_name(img_header_cache_p, CACHE_NAME);
     return img_header_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
@@ -149,6 +151,11 @@ static void image_header_cache_free_cb(lv_image_header_cache_data_t * entry, voi
     if(entry->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)entry->src);
 }
 
+static uint32_t image_header_cache_hash_cb(const lv_image_header_cache_data_t * data)
+{
+    return lv_image_cache_src_hash(data->src, data->src_type);
+}
+
 static void iter_inspect_cb(void * elem)
 {
     lv_image_cache_data_t * data = (lv_image_cache_data_t *)elem;
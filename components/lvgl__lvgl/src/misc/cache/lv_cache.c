@@ -8,7 +8,9 @@
  *********************/
 #include "lv_cache.h"
 #include "../../stdlib/lv_sprintf.h"
+#include "../../stdlib/lv_string.h"
 #include "../lv_assert.h"
+#include "../lv_iter.h"
 #include "lv_cache_entry_private.h"
 #include "lv_cache_private.h"
 
@@ -20,12 +22,30 @@
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    uint32_t shard_idx;
+    lv_iter_t * shard_iter;
+} shard_iter_context_t;
+
+typedef struct {
+    const void * key;
+    lv_mutex_t lock;        /**< Held by the claiming thread until the key is unclaimed*/
+    uint32_t waiter_cnt;    /**< Threads waiting for `lock`. The last one frees the claim.*/
+    bool done;
+} cache_claim_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void cache_drop_internal_no_lock(lv_cache_t * cache, const void * key, void * user_data);
 static bool cache_evict_one_internal_no_lock(lv_cache_t * cache, void * user_data);
 static lv_cache_entry_t * cache_add_internal_no_lock(lv_cache_t * cache, const void * key, void * user_data);
+static lv_cache_t * cache_get_shard(lv_cache_t * cache, const void * key);
+#if LV_USE_OS
+    static cache_claim_t * cache_find_claim_no_lock(lv_cache_t * cache, const void * key);
+#endif
+static size_t shard_share(size_t size, uint32_t shard_cnt, uint32_t shard_idx);
+static lv_result_t shard_iter_next_cb(void * instance, void * context, void * elem);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -62,8 +82,52 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
         return NULL;
     }
 
+    lv_mutex_init(&cache->lock);
+    lv_ll_init(&cache->claim_ll, sizeof(cache_claim_t));
+
+    return cache;
+}
+
+lv_cache_t * lv_cache_create_sharded(const lv_cache_class_t * cache_class,
+                                     size_t node_size, size_t max_size,
+                                     lv_cache_ops_t ops, uint32_t shard_cnt)
+{
+    if(shard_cnt <= 1) return lv_cache_create(cache_class, node_size, max_size, ops);
+
+    if(ops.hash_cb == NULL) {
+        LV_LOG_WARN("hash_cb is required for sharding, creating a single cache");
+        return lv_cache_create(cache_class, node_size, max_size, ops);
+    }
+
+    lv_cache_t * cache = lv_malloc_zeroed(sizeof(lv_cache_t));
+    LV_ASSERT_MALLOC(cache);
+    if(cache == NULL) return NULL;
+
+    cache->shards = lv_malloc_zeroed(shard_cnt * sizeof(lv_cache_t *));
+    LV_ASSERT_MALLOC(cache->shards);
+    if(cache->shards == NULL) {
+        lv_free(cache);
+        return NULL;
+    }
+
+    /*Only the shards use the class, this cache just forwards the calls*/
+    cache->clz = cache_class;
+    cache->node_size = node_size;
+    cache->max_size = max_size;
+    cache->ops = ops;
+    cache->shard_cnt = shard_cnt;
     lv_mutex_init(&cache->lock);
 
+    uint32_t i;
+    for(i = 0; i < shard_cnt; i++) {
+        cache->shards[i] = lv_cache_create(cache_class, node_size, shard_share(max_size, shard_cnt, i), ops);
+        if(cache->shards[i] == NULL) {
+            LV_LOG_ERROR("Cache shard init failed");
+            lv_cache_destroy(cache, NULL);
+            return NULL;
+        }
+    }
+
     return cache;
 }
 
@@ -71,7 +135,19 @@ void lv_cache_destroy(lv_cache_t * cache, void * user_data)
 {
     LV_ASSERT_NULL(cache);
 
+    if(cache->shard_cnt) {
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) {
+            if(cache->shards[i]) lv_cache_destroy(cache->shards[i], user_data);
+        }
+        lv_free(cache->shards);
+        lv_mutex_delete(&cache->lock);
+        lv_free(cache);
+        return;
+    }
+
     lv_mutex_lock(&cache->lock);
+    LV_ASSERT_MSG(lv_ll_is_empty(&cache->claim_ll), "A key is still claimed");
     cache->clz->destroy_cb(cache, user_data);
     lv_mutex_unlock(&cache->lock);
     lv_mutex_delete(&cache->lock);
@@ -83,6 +159,8 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     LV_ASSERT_NULL(cache);
     LV_ASSERT_NULL(key);
 
+    if(cache->shard_cnt) return lv_cache_acquire(cache_get_shard(cache, key), key, user_data);
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -97,6 +175,7 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
     if(entry != NULL) {
         lv_cache_entry_acquire_data(entry);
+        lv_cache_entry_inc_hit(entry);
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -107,6 +186,9 @@ void lv_cache_release(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_
 {
     LV_ASSERT_NULL(entry);
 
+    /*The entry knows its shard*/
+    if(cache->shard_cnt) cache = (lv_cache_t *)lv_cache_entry_get_cache(entry);
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -120,11 +202,97 @@ void lv_cache_release(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_
 
     LV_PROFILER_CACHE_END;
 }
+lv_cache_entry_t * lv_cache_acquire_or_claim(lv_cache_t * cache, const void * key, bool * claimed, void * user_data)
+{
+    LV_ASSERT_NULL(cache);
+    LV_ASSERT_NULL(key);
+
+    *claimed = false;
+    if(cache->shard_cnt) return lv_cache_acquire_or_claim(cache_get_shard(cache, key), key, claimed, user_data);
+
+#if LV_USE_OS
+    LV_PROFILER_CACHE_BEGIN;
+
+    lv_mutex_lock(&cache->lock);
+    while(cache->max_size != 0) {
+        lv_cache_entry_t * entry = cache->size != 0 ? cache->clz->get_cb(cache, key, user_data) : NULL;
+        if(entry != NULL) {
+            lv_cache_entry_acquire_data(entry);
+            lv_cache_entry_inc_hit(entry);
+            lv_mutex_unlock(&cache->lock);
+
+            LV_PROFILER_CACHE_END;
+            return entry;
+        }
+
+        cache_claim_t * claim = cache_find_claim_no_lock(cache, key);
+        if(claim == NULL) {
+            claim = lv_ll_ins_tail(&cache->claim_ll);
+            LV_ASSERT_MALLOC(claim);
+            if(claim == NULL) break;
+
+            lv_memzero(claim, sizeof(cache_claim_t));
+            claim->key = key;
+            lv_mutex_init(&claim->lock);
+            lv_mutex_lock(&claim->lock);
+            *claimed = true;
+            break;
+        }
+
+        /*Wait until the other thread creates the entry and look it up again*/
+        claim->waiter_cnt++;
+        lv_mutex_unlock(&cache->lock);
+        lv_mutex_lock(&claim->lock);
+        lv_mutex_unlock(&claim->lock);
+        lv_mutex_lock(&cache->lock);
+        claim->waiter_cnt--;
+        if(claim->done && claim->waiter_cnt == 0) {
+            lv_mutex_delete(&claim->lock);
+            lv_free(claim);
+        }
+    }
+    lv_mutex_unlock(&cache->lock);
+
+    LV_PROFILER_CACHE_END;
+    return NULL;
+#else
+    return lv_cache_acquire(cache, key, user_data);
+#endif
+}
+void lv_cache_unclaim(lv_cache_t * cache, const void * key)
+{
+    LV_ASSERT_NULL(cache);
+    LV_ASSERT_NULL(key);
+
+    if(cache->shard_cnt) {
+        lv_cache_unclaim(cache_get_shard(cache, key), key);
+        return;
+    }
+
+#if LV_USE_OS
+    lv_mutex_lock(&cache->lock);
+    cache_claim_t * claim = cache_find_claim_no_lock(cache, key);
+    LV_ASSERT_MSG(claim != NULL, "The key is not claimed");
+    if(claim) {
+        /*The waiters still use the claim after it's removed from the list*/
+        lv_ll_remove(&cache->claim_ll, claim);
+        claim->done = true;
+        lv_mutex_unlock(&claim->lock);
+        if(claim->waiter_cnt == 0) {
+            lv_mutex_delete(&claim->lock);
+            lv_free(claim);
+        }
+    }
+    lv_mutex_unlock(&cache->lock);
+#endif
+}
 lv_cache_entry_t * lv_cache_add(lv_cache_t * cache, const void * key, void * user_data)
 {
     LV_ASSERT_NULL(cache);
     LV_ASSERT_NULL(key);
 
+    if(cache->shard_cnt) return lv_cache_add(cache_get_shard(cache, key), key, user_data);
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -149,6 +317,8 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
     LV_ASSERT_NULL(cache);
     LV_ASSERT_NULL(key);
 
+    if(cache->shard_cnt) return lv_cache_acquire_or_create(cache_get_shard(cache, key), key, user_data);
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -158,6 +328,7 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         entry = cache->clz->get_cb(cache, key, user_data);
         if(entry != NULL) {
             lv_cache_entry_acquire_data(entry);
+            lv_cache_entry_inc_hit(entry);
             lv_mutex_unlock(&cache->lock);
 
             LV_PROFILER_CACHE_END;
@@ -198,6 +369,14 @@ void lv_cache_reserve(lv_cache_t * cache, uint32_t reserved_size, void * user_da
 {
     LV_ASSERT_NULL(cache);
 
+    if(cache->shard_cnt) {
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) {
+            lv_cache_reserve(cache->shards[i], shard_share(reserved_size, cache->shard_cnt, i), user_data);
+        }
+        return;
+    }
+
     LV_PROFILER_CACHE_BEGIN;
 
     for(lv_cache_reserve_cond_res_t reserve_cond_res = cache->clz->reserve_cond_cb(cache, NULL, reserved_size, user_data);
@@ -212,6 +391,11 @@ void lv_cache_drop(lv_cache_t * cache, const void * key, void * user_data)
     LV_ASSERT_NULL(cache);
     LV_ASSERT_NULL(key);
 
+    if(cache->shard_cnt) {
+        lv_cache_drop(cache_get_shard(cache, key), key, user_data);
+        return;
+    }
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -224,6 +408,18 @@ bool lv_cache_evict_one(lv_cache_t * cache, void * user_data)
 {
     LV_ASSERT_NULL(cache);
 
+    if(cache->shard_cnt) {
+        /*Evict from the largest shard to free the most memory*/
+        lv_cache_t * largest = cache->shards[0];
+        uint32_t i;
+        for(i = 1; i < cache->shard_cnt; i++) {
+            if(cache->shards[i]->size > largest->size) largest = cache->shards[i];
+        }
+
+        if(largest->size == 0) return false;
+        return lv_cache_evict_one(largest, user_data);
+    }
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -237,6 +433,14 @@ void lv_cache_drop_all(lv_cache_t * cache, void * user_data)
 {
     LV_ASSERT_NULL(cache);
 
+    if(cache->shard_cnt) {
+        uint32_t i;
+        for(i = 0; i < cache->shard_cnt; i++) {
+            lv_cache_drop_all(cache->shards[i], user_data);
+        }
+        return;
+    }
+
     LV_PROFILER_CACHE_BEGIN;
 
     lv_mutex_lock(&cache->lock);
@@ -250,6 +454,11 @@ void lv_cache_set_max_size(lv_cache_t * cache, size_t max_size, void * user_data
 {
     LV_UNUSED(user_data);
     cache->max_size = max_size;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        lv_cache_set_max_size(cache->shards[i], shard_share(max_size, cache->shard_cnt, i), user_data);
+    }
 }
 size_t lv_cache_get_max_size(lv_cache_t * cache, void * user_data)
 {
@@ -259,12 +468,18 @@ size_t lv_cache_get_max_size(lv_cache_t * cache, void * user_data)
 size_t lv_cache_get_size(lv_cache_t * cache, void * user_data)
 {
     LV_UNUSED(user_data);
-    return cache->size;
+    if(cache->shard_cnt == 0) return cache->size;
+
+    size_t size = 0;
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        size += cache->shards[i]->size;
+    }
+    return size;
 }
 size_t lv_cache_get_free_size(lv_cache_t * cache, void * user_data)
 {
-    LV_UNUSED(user_data);
-    return cache->max_size - cache->size;
+    return cache->max_size - lv_cache_get_size(cache, user_data);
 }
 bool lv_cache_is_enabled(lv_cache_t * cache)
 {
@@ -274,21 +489,41 @@ void lv_cache_set_compare_cb(lv_cache_t * cache, lv_cache_compare_cb_t compare_c
 {
     LV_UNUSED(user_data);
     cache->ops.compare_cb = compare_cb;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        cache->shards[i]->ops.compare_cb = compare_cb;
+    }
 }
 void lv_cache_set_create_cb(lv_cache_t * cache, lv_cache_create_cb_t alloc_cb, void * user_data)
 {
     LV_UNUSED(user_data);
     cache->ops.create_cb = alloc_cb;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        cache->shards[i]->ops.create_cb = alloc_cb;
+    }
 }
 void lv_cache_set_free_cb(lv_cache_t * cache, lv_cache_free_cb_t free_cb, void * user_data)
 {
     LV_UNUSED(user_data);
     cache->ops.free_cb = free_cb;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        cache->shards[i]->ops.free_cb = free_cb;
+    }
 }
 void lv_cache_set_name(lv_cache_t * cache, const char * name)
 {
     if(cache == NULL) return;
     cache->name = name;
+
+    uint32_t i;
+    for(i = 0; i < cache->shard_cnt; i++) {
+        cache->shards[i]->name = name;
+    }
 }
 const char * lv_cache_get_name(lv_cache_t * cache)
 {
@@ -299,6 +534,10 @@ lv_iter_t * lv_cache_iter_create(lv_cache_t * cache)
 {
     LV_ASSERT_NULL(cache);
     if(cache == NULL || cache->clz->iter_create_cb == NULL) return NULL;
+    if(cache->shard_cnt) {
+        return lv_iter_create(cache, lv_cache_entry_get_size(cache->node_size), sizeof(shard_iter_context_t),
+                              shard_iter_next_cb);
+    }
     return cache->clz->iter_create_cb(cache);
 }
 
@@ -356,3 +595,44 @@ static lv_cache_entry_t * cache_add_internal_no_lock(lv_cache_t * cache, const v
 
     return entry;
 }
+
+static lv_cache_t * cache_get_shard(lv_cache_t * cache, const void * key)
+{
+    return cache->shards[cache->ops.hash_cb(key) % cache->shard_cnt];
+}
+
+#if LV_USE_OS
+static cache_claim_t * cache_find_claim_no_lock(lv_cache_t * cache, const void * key)
+{
+    cache_claim_t * claim;
+    LV_LL_READ(&cache->claim_ll, claim) {
+        if(cache->ops.compare_cb(claim->key, key) == 0) return claim;
+    }
+
+    return NULL;
+}
+#endif
+
+static size_t shard_share(size_t size, uint32_t shard_cnt, uint32_t shard_idx)
+{
+    /*Give the remainder to the first shards*/
+    return size / shard_cnt + (shard_idx < size % shard_cnt ? 1 : 0);
+}
+
+static lv_result_t shard_iter_next_cb(void * instance, void * context, void * elem)
+{
+    lv_cache_t * cache = (lv_cache_t *)instance;
+    shard_iter_context_t * ctx = (shard_iter_context_t *)context;
+
+    /*Walk the shards one after the other. The iterator of a shard is freed when it's finished.*/
+    while(ctx->shard_idx < cache->shard_cnt) {
+        if(ctx->shard_iter == NULL) ctx->shard_iter = lv_cache_iter_create(cache->shards[ctx->shard_idx]);
+        if(ctx->shard_iter && lv_iter_next(ctx->shard_iter, elem) == LV_RESULT_OK) return LV_RESULT_OK;
+
+        if(ctx->shard_iter) lv_iter_destroy(ctx->shard_iter);
+        ctx->shard_iter = NULL;
+        ctx->shard_idx++;
+    }
+
+    return LV_RESULT_INVALID;
+}
@@ -49,6 +49,22 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
                              size_t node_size, size_t max_size,
                              lv_cache_ops_t ops);
 
+/**
+ * Create a cache which is split into independently locked shards to let several threads use it at the same time.
+ * The shard of an entry is selected by `lv_cache_ops_t::hash_cb` and each shard gets `max_size / shard_cnt`.
+ * The shards evict independently so an entry larger than the share of a shard can't be added.
+ * The returned cache can be used with the same API as a normal cache.
+ * @param cache_class   The class of the shards. See lv_cache_create().
+ * @param node_size     The node size is the size of the data stored in the cache.
+ * @param max_size      The maximum size or count of all the shards together.
+ * @param ops           The operations of the cache. `hash_cb` needs to be set.
+ * @param shard_cnt     Number of shards. With 0 or 1 a normal cache is created.
+ * @return              Returns a pointer to the created cache object on success, `NULL` on error.
+ */
+lv_cache_t * lv_cache_create_sharded(const lv_cache_class_t * cache_class,
+                                     size_t node_size, size_t max_size,
+                                     lv_cache_ops_t ops, uint32_t shard_cnt);
+
 /**
  * Destroy a cache object.
  * @param cache         The cache object pointer to destroy.
@@ -79,6 +95,28 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
  */
 lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * key, void * user_data);
 
+/**
+ * Acquire a cache entry with the given key. If the entry is not in the cache, claim the key for the caller,
+ * which is expected to create the data and add it with lv_cache_add(), then call lv_cache_unclaim().
+ * Meanwhile the other threads acquiring the same key wait for the claim to be released and then
+ * try again, so the same data is created only once. Other keys are not blocked.
+ * Without an OS it works as lv_cache_acquire().
+ * @param cache         The cache object pointer to acquire the entry.
+ * @param key           The key of the entry. It needs to be valid until lv_cache_unclaim() is called.
+ * @param claimed       Set to true if the key is claimed by the caller, and lv_cache_unclaim() needs to be called.
+ * @param user_data     A user data pointer.
+ * @return              Returns a pointer to the acquired cache entry with `lv_cache_entry_t::ref_cnt` incremented,
+ *                      or `NULL` if it's not in the cache.
+ */
+lv_cache_entry_t * lv_cache_acquire_or_claim(lv_cache_t * cache, const void * key, bool * claimed, void * user_data);
+
+/**
+ * Release the claim of a key taken by lv_cache_acquire_or_claim() and wake the threads waiting for it.
+ * @param cache         The cache object pointer.
+ * @param key           The same key which was claimed.
+ */
+void lv_cache_unclaim(lv_cache_t * cache, const void * key);
+
 /**
  * Add a new cache entry with the given key and data. If the cache is full, the cache's policy will be used to evict an entry.
  * @param cache         The cache object pointer to add the entry.
@@ -24,6 +24,7 @@ struct _lv_cache_entry_t {
     const lv_cache_t * cache;
     int32_t ref_cnt;
     uint32_t node_size;
+    uint32_t hit_cnt;
 
     bool is_invalid;
 };
@@ -75,6 +76,18 @@ int32_t lv_cache_entry_get_ref(lv_cache_entry_t * entry)
     return entry->ref_cnt;
 }
 
+void lv_cache_entry_inc_hit(lv_cache_entry_t * entry)
+{
+    LV_ASSERT_NULL(entry);
+    entry->hit_cnt++;
+}
+
+uint32_t lv_cache_entry_get_hit_cnt(lv_cache_entry_t * entry)
+{
+    LV_ASSERT_NULL(entry);
+    return entry->hit_cnt;
+}
+
 uint32_t lv_cache_entry_get_node_size(lv_cache_entry_t * entry)
 {
     return entry->node_size;
@@ -169,6 +182,7 @@ void lv_cache_entry_init(lv_cache_entry_t * entry, const lv_cache_t * cache, con
     entry->cache = cache;
     entry->node_size = node_size;
     entry->ref_cnt = 0;
+    entry->hit_cnt = 0;
     entry->is_invalid = false;
 }
 
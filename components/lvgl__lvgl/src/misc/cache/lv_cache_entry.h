@@ -41,6 +41,13 @@ uint32_t lv_cache_entry_get_size(const uint32_t node_size);
  */
 int32_t  lv_cache_entry_get_ref(lv_cache_entry_t * entry);
 
+/**
+ * Get how many times a cache entry was found by `lv_cache_acquire` or `lv_cache_acquire_or_create`.
+ * @param entry        The cache entry to get the hit count of.
+ * @return             The number of cache hits of the entry.
+ */
+uint32_t lv_cache_entry_get_hit_cnt(lv_cache_entry_t * entry);
+
 /**
  * Get the node size of a cache entry. Which is the same size with lv_cache_entry_get_size()'s node_size parameter.
  * @param entry        The cache entry to get the node size of.
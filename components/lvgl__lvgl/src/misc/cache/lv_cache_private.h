@@ -14,6 +14,7 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "../lv_types.h"
+#include "../lv_ll.h"
 #include "../../osal/lv_os.h"
 
 /*********************
@@ -46,6 +47,7 @@ typedef int8_t lv_cache_compare_res_t;
 typedef bool (*lv_cache_create_cb_t)(void * node, void * user_data);
 typedef void (*lv_cache_free_cb_t)(void * node, void * user_data);
 typedef lv_cache_compare_res_t (*lv_cache_compare_cb_t)(const void * a, const void * b);
+typedef uint32_t (*lv_cache_hash_cb_t)(const void * key);
 
 /**
  * The cache instance allocation function, used by the cache class to allocate memory for cache instances.
@@ -118,15 +120,18 @@ struct _lv_cache_ops_t {
     lv_cache_compare_cb_t compare_cb;    /**< Compare function for keys */
     lv_cache_create_cb_t create_cb;      /**< Create function for nodes */
     lv_cache_free_cb_t free_cb;          /**< Free function for nodes */
+    lv_cache_hash_cb_t hash_cb;          /**< Hash function for keys. Equal keys need to have the same hash.
+                                          *   Only needed for sharded caches. */
 };
 
 /**
  * The cache entry struct
  */
 struct _lv_cache_t {
-    const lv_cache_class_t * clz;     /**< Cache class. There are two built-in classes:
+    const lv_cache_class_t * clz;     /**< Cache class. There are three built-in classes:
                                        * - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
-                                       * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy. */
+                                       * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+                                       * - lv_cache_class_gds_rb_size for cost and size-based eviction policy. */
 
     uint32_t node_size;               /**< Size of a node */
 
@@ -138,6 +143,11 @@ struct _lv_cache_t {
     lv_mutex_t lock;                  /**< Cache lock used to protect the cache in multithreading environments */
 
     const char * name;                /**< Name of the cache */
+
+    lv_cache_t ** shards;             /**< Independently locked sub-caches selected by the hash of the key, or `NULL` */
+    uint32_t shard_cnt;               /**< Number of shards, 0 if the cache is not sharded */
+
+    lv_ll_t claim_ll;                 /**< Keys being created by a thread, see lv_cache_acquire_or_claim() */
 };
 
 /**
@@ -180,6 +190,19 @@ typedef struct _lv_cache_slot_size_t lv_cache_slot_size_t;
 struct _lv_cache_slot_size_t {
     size_t size;
 };
+
+struct _lv_cache_slot_cost_t;
+
+typedef struct _lv_cache_slot_cost_t lv_cache_slot_cost_t;
+
+/**
+ * Cache entry slot with size and the cost of recreating the entry, used by cost-aware classes
+ * like `lv_cache_class_gds_rb_size`. It starts with the size so size-based classes can use it too.
+ */
+struct _lv_cache_slot_cost_t {
+    size_t size;
+    uint32_t cost;      /**< E.g. time to create the entry in ms. Can be set after adding the entry too.*/
+};
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -32,6 +32,9 @@
 #define state LV_GLOBAL_DEFAULT()->anim_state
 #define anim_ll_p &(state.anim_ll)
 
+/**Initial number of buckets in the `var` index*/
+#define ANIM_HASH_MIN_SIZE 32
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -48,6 +51,16 @@ static void lv_anim_pause_for_internal(lv_anim_t * a, uint32_t ms);
 static void resolve_time(lv_anim_t * a);
 static bool remove_concurrent_anims(const lv_anim_t * a_current);
 static void remove_anim(void * a);
+static void anim_ll_remove(lv_anim_t * a);
+static lv_anim_t * anim_get_first(const void * var);
+static lv_anim_t * anim_get_next(const void * var, lv_anim_t * a);
+#if LV_ANIM_HASH_INDEX
+    static uint32_t hash_var(const void * var);
+    static bool hash_reserve(uint32_t cnt);
+    static void hash_insert(lv_anim_t * a);
+    static void hash_remove(lv_anim_t * a);
+    static bool hash_contains(const lv_anim_t * a);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -78,6 +91,11 @@ void lv_anim_core_init(void)
 void lv_anim_core_deinit(void)
 {
     lv_anim_delete_all();
+#if LV_ANIM_HASH_INDEX
+    lv_free(state.hash);
+    state.hash = NULL;
+    state.hash_size = 0;
+#endif
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -100,14 +118,27 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         remove_concurrent_anims(a);
     }
 
+#if LV_ANIM_HASH_INDEX
+    if(!hash_reserve(state.anim_cnt + 1)) {
+        LV_LOG_WARN("couldn't allocate the animation index");
+        return NULL;
+    }
+#endif
+
     /*Add the new animation to the animation linked list*/
+    lv_mem_tag_t mem_tag_prev;
+    LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_ANIM, mem_tag_prev);
     lv_anim_t * new_anim = lv_ll_ins_head(anim_ll_p);
+    LV_MEM_STATS_TAG_END(mem_tag_prev);
     LV_ASSERT_MALLOC(new_anim);
     if(new_anim == NULL) return NULL;
 
     /*Initialize the animation descriptor*/
     lv_memcpy(new_anim, a, sizeof(lv_anim_t));
     if(a->var == a) new_anim->var = new_anim;
+#if LV_ANIM_HASH_INDEX
+    hash_insert(new_anim);
+#endif
     new_anim->run_round = state.anim_run_round;
     new_anim->last_timer_run = lv_tick_get();
     new_anim->is_paused = false;
@@ -158,7 +189,7 @@ bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
 {
     lv_anim_t * a;
     bool del_any = false;
-    a        = lv_ll_get_head(anim_ll_p);
+    a        = anim_get_first(var);
     while(a != NULL) {
         bool del = false;
         if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
@@ -171,7 +202,7 @@ bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
 
         /*Always start from the head on delete, because we don't know
          *how `anim_ll_p` was changes in `a->deleted_cb` */
-        a = del ? lv_ll_get_head(anim_ll_p) : lv_ll_get_next(anim_ll_p, a);
+        a = del ? anim_get_first(var) : anim_get_next(var, a);
     }
 
     return del_any;
@@ -186,7 +217,7 @@ void lv_anim_delete_all(void)
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
     lv_anim_t * a;
-    LV_LL_READ(anim_ll_p, a) {
+    for(a = anim_get_first(var); a != NULL; a = anim_get_next(var, a)) {
         if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             return a;
         }
@@ -202,11 +233,15 @@ lv_timer_t * lv_anim_get_timer(void)
 
 uint16_t lv_anim_count_running(void)
 {
+#if LV_ANIM_HASH_INDEX
+    return (uint16_t)state.anim_cnt;
+#else
     uint16_t cnt = 0;
     lv_anim_t * a;
     LV_LL_READ(anim_ll_p, a) cnt++;
 
     return cnt;
+#endif
 }
 
 uint32_t lv_anim_speed_clamped(uint32_t speed, uint32_t min_time, uint32_t max_time)
@@ -360,6 +395,15 @@ int32_t lv_anim_path_custom_bezier3(const lv_anim_t * a)
 
 void lv_anim_set_var(lv_anim_t * a, void * var)
 {
+#if LV_ANIM_HASH_INDEX
+    /*A running animation has to be moved to the bucket of its new `var`*/
+    if(hash_contains(a)) {
+        hash_remove(a);
+        a->var = var;
+        hash_insert(a);
+        return;
+    }
+#endif
     a->var = var;
 }
 
@@ -547,6 +591,9 @@ static void anim_timer(lv_timer_t * param)
 
     lv_anim_t * a = lv_ll_get_head(anim_ll_p);
     while(a != NULL) {
+        /*If the next animation is deleted in a callback `anim_ll_remove()` moves this forward*/
+        state.anim_next = lv_ll_get_next(anim_ll_p, a);
+
         uint32_t elaps = lv_tick_elaps(a->last_timer_run);
 
         if(a->is_paused) {
@@ -565,10 +612,8 @@ static void anim_timer(lv_timer_t * param)
         }
         a->last_timer_run = lv_tick_get();
 
-        /*It can be set by `lv_anim_delete()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_completed_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
+        /*It can be set by `lv_anim_delete()` typically in `end_cb`. If set then `a` might be deleted
+         *in a callback so it shouldn't be used anymore*/
         state.anim_list_changed = false;
 
         if(!a->is_paused && a->run_round != state.anim_run_round) {
@@ -596,6 +641,8 @@ static void anim_timer(lv_timer_t * param)
                 if(a->act_time > a->duration) a->act_time = a->duration;
 
                 int32_t act_time_before_exec = a->act_time;
+                /*The path is evaluated right before `exec_cb` and not in a separate batch because
+                 *the callbacks of the previous animations can change, pause or delete this one*/
                 int32_t new_value;
                 new_value = a->path_cb(a);
 
@@ -619,14 +666,12 @@ static void anim_timer(lv_timer_t * param)
             }
         }
 
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(state.anim_list_changed)
-            a = lv_ll_get_head(anim_ll_p);
-        else
-            a = lv_ll_get_next(anim_ll_p, a);
+        /*The animations created meanwhile were added to the head with the current `run_round`
+         *so they would be skipped anyway. Therefore it's enough to continue from the next one.*/
+        a = state.anim_next;
     }
 
+    state.anim_next = NULL;
 }
 
 /**
@@ -648,7 +693,7 @@ static void anim_completed_handler(lv_anim_t * a)
 
         /*Delete the animation from the list.
          * This way the `completed_cb` will see the animations like it's animation is already deleted*/
-        lv_ll_remove(anim_ll_p, a);
+        anim_ll_remove(a);
         /*Flag that the list has changed*/
         anim_mark_list_change();
 
@@ -733,7 +778,7 @@ static bool remove_concurrent_anims(const lv_anim_t * a_current)
 
     lv_anim_t * a;
     bool del_any = false;
-    a = lv_ll_get_head(anim_ll_p);
+    a = anim_get_first(a_current->var);
     while(a != NULL) {
         bool del = false;
         /*We can't test for custom_exec_cb equality because in the MicroPython binding
@@ -744,7 +789,7 @@ static bool remove_concurrent_anims(const lv_anim_t * a_current)
            (a->var == a_current->var) &&
            ((a->exec_cb && a->exec_cb == a_current->exec_cb)
             /*|| (a->custom_exec_cb && a->custom_exec_cb == a_current->custom_exec_cb)*/)) {
-            lv_ll_remove(anim_ll_p, a);
+            anim_ll_remove(a);
             if(a->deleted_cb != NULL) a->deleted_cb(a);
             lv_free(a);
             /*Read by `anim_timer`. It need to know if a delete occurred in the linked list*/
@@ -756,7 +801,7 @@ static bool remove_concurrent_anims(const lv_anim_t * a_current)
 
         /*Always start from the head on delete, because we don't know
          *how `anim_ll_p` was changes in `a->deleted_cb` */
-        a = del ? lv_ll_get_head(anim_ll_p) : lv_ll_get_next(anim_ll_p, a);
+        a = del ? anim_get_first(a_current->var) : anim_get_next(a_current->var, a);
     }
 
     return del_any;
@@ -765,7 +810,144 @@ static bool remove_concurrent_anims(const lv_anim_t * a_current)
 static void remove_anim(void * a)
 {
     lv_anim_t * anim = a;
-    lv_ll_remove(anim_ll_p, a);
+    anim_ll_remove(anim);
     if(anim->deleted_cb != NULL) anim->deleted_cb(anim);
     lv_free(a);
 }
+
+/**
+ * Remove an animation from the linked list (and the index) without freeing it
+ * @param a     pointer to a running animation
+ */
+static void anim_ll_remove(lv_anim_t * a)
+{
+    /*Don't let `anim_timer` continue with a deleted animation*/
+    if(state.anim_next == a) state.anim_next = lv_ll_get_next(anim_ll_p, a);
+
+#if LV_ANIM_HASH_INDEX
+    hash_remove(a);
+#endif
+    lv_ll_remove(anim_ll_p, a);
+}
+
+/**
+ * Get the first running animation which can belong to `var`
+ * @param var   the variable to look for, or `NULL` to get all animations
+ * @return      the first candidate animation or `NULL` if there are none
+ */
+static lv_anim_t * anim_get_first(const void * var)
+{
+#if LV_ANIM_HASH_INDEX
+    if(var != NULL) {
+        if(state.hash == NULL) return NULL;
+        return state.hash[hash_var(var) & (state.hash_size - 1)];
+    }
+#else
+    LV_UNUSED(var);
+#endif
+    return lv_ll_get_head(anim_ll_p);
+}
+
+/**
+ * Get the next running animation which can belong to `var`
+ * @param var   the same variable as in `anim_get_first()`
+ * @param a     the current candidate
+ * @return      the next candidate animation or `NULL` if there are no more
+ */
+static lv_anim_t * anim_get_next(const void * var, lv_anim_t * a)
+{
+#if LV_ANIM_HASH_INDEX
+    if(var != NULL) return a->hash_next;
+#else
+    LV_UNUSED(var);
+#endif
+    return lv_ll_get_next(anim_ll_p, a);
+}
+
+#if LV_ANIM_HASH_INDEX
+
+static uint32_t hash_var(const void * var)
+{
+    /*The low bits are always 0 due to alignment, mix the higher bits into them*/
+    uint32_t h = (uint32_t)((lv_uintptr_t)var >> 3);
+    h ^= h >> 16;
+    h *= 0x45d9f3b;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * Make room in the index for `cnt` animations with at most 1 animation per bucket on average.
+ * @param cnt   the number of animations to store
+ * @return      false if the index couldn't be allocated at all
+ */
+static bool hash_reserve(uint32_t cnt)
+{
+    if(state.hash != NULL && cnt <= state.hash_size) return true;
+
+    uint32_t new_size = state.hash_size ? state.hash_size * 2 : ANIM_HASH_MIN_SIZE;
+    lv_anim_t ** new_hash = lv_malloc_zeroed(new_size * sizeof(lv_anim_t *));
+    /*It's still correct with longer chains*/
+    if(new_hash == NULL) return state.hash != NULL;
+
+    lv_free(state.hash);
+    state.hash = new_hash;
+    state.hash_size = new_size;
+    state.anim_cnt = 0;
+
+    /*Add them from the tail so that the newer animations are first in the buckets too*/
+    lv_anim_t * a;
+    LV_LL_READ_BACK(anim_ll_p, a) {
+        hash_insert(a);
+    }
+
+    return true;
+}
+
+static void hash_insert(lv_anim_t * a)
+{
+    lv_anim_t ** bucket = &state.hash[hash_var(a->var) & (state.hash_size - 1)];
+    a->hash_next = *bucket;
+    *bucket = a;
+    state.anim_cnt++;
+}
+
+static void hash_remove(lv_anim_t * a)
+{
+    lv_anim_t ** p = &state.hash[hash_var(a->var) & (state.hash_size - 1)];
+    while(*p != a) {
+        if(*p == NULL) {
+            /*`var` was changed while running. Look for it in all buckets.*/
+            uint32_t i;
+            for(i = 0; i < state.hash_size; i++) {
+                p = &state.hash[i];
+                while(*p != NULL && *p != a) p = &(*p)->hash_next;
+                if(*p == a) break;
+            }
+            if(*p == NULL) return;
+            break;
+        }
+        p = &(*p)->hash_next;
+    }
+
+    *p = a->hash_next;
+    state.anim_cnt--;
+}
+
+/**
+ * Check if `a` is a running animation. Only its `var` is used, so it can be any descriptor.
+ * @param a     pointer to an animation
+ * @return      true if `a` is in the index
+ */
+static bool hash_contains(const lv_anim_t * a)
+{
+    if(state.hash == NULL) return false;
+
+    const lv_anim_t * b;
+    for(b = state.hash[hash_var(a->var) & (state.hash_size - 1)]; b != NULL; b = b->hash_next) {
+        if(b == a) return true;
+    }
+    return false;
+}
+
+#endif /*LV_ANIM_HASH_INDEX*/
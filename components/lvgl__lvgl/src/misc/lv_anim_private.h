@@ -29,6 +29,12 @@ typedef struct {
     bool anim_run_round;
     lv_timer_t * timer;
     lv_ll_t anim_ll;
+    lv_anim_t * anim_next;      /**< The next animation to handle in `anim_timer`*/
+#if LV_ANIM_HASH_INDEX
+    lv_anim_t ** hash;          /**< Buckets of the running animations by `var`*/
+    uint32_t hash_size;         /**< Number of buckets, power of 2*/
+    uint32_t anim_cnt;          /**< Number of running animations*/
+#endif
 } lv_anim_state_t;
 
 /**********************
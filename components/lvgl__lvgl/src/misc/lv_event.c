@@ -19,6 +19,8 @@
 #define event_head LV_GLOBAL_DEFAULT()->event_header
 #define event_last_id LV_GLOBAL_DEFAULT()->event_last_register_id
 
+#define EVENT_CODE_BIT(code) ((uint64_t)1 << ((code) & 63))
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,6 +35,7 @@ static void cleanup_event_list_core(lv_array_t * array);
 
 static void event_mark_deleting(lv_event_list_t * list, lv_event_dsc_t * dsc);
 static bool event_is_marked_deleting(lv_event_dsc_t * dsc);
+static void event_list_add_to_mask(lv_event_list_t * list, uint32_t filter);
 static uint32_t event_array_size(lv_event_list_t * list);
 static lv_event_dsc_t ** event_array_at(lv_event_list_t * list, uint32_t index);
 
@@ -74,6 +77,10 @@ lv_result_t lv_event_send(lv_event_list_t * list, lv_event_t * e, bool preproces
     if(list == NULL) return LV_RESULT_OK;
     if(e->deleted) return LV_RESULT_INVALID;
 
+    /*Return quickly if there is surely no callback for this event*/
+    if(preprocess && !list->has_preprocess) return LV_RESULT_OK;
+    if((list->code_mask & EVENT_CODE_BIT(e->code)) == 0) return LV_RESULT_OK;
+
     /* When obj is deleted in its own event, it will cause the `list->array` header to be released,
      * but the content still exists, which leads to memory leakage.
      * Therefore, back up the header in advance,
@@ -120,6 +127,8 @@ lv_result_t lv_event_send(lv_event_list_t * list, lv_event_t * e, bool preproces
 lv_event_dsc_t * lv_event_add(lv_event_list_t * list, lv_event_cb_t cb, lv_event_code_t filter,
                               void * user_data)
 {
+    lv_mem_tag_t mem_tag_prev;
+    LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_EVENT, mem_tag_prev);
     lv_event_dsc_t * dsc = lv_malloc(sizeof(lv_event_dsc_t));
     LV_ASSERT_NULL(dsc);
 
@@ -133,6 +142,9 @@ lv_event_dsc_t * lv_event_add(lv_event_list_t * list, lv_event_cb_t cb, lv_event
     }
 
     lv_array_push_back(&list->array, &dsc);
+    LV_MEM_STATS_TAG_END(mem_tag_prev);
+
+    event_list_add_to_mask(list, filter);
     return dsc;
 }
 
@@ -383,6 +395,23 @@ static void cleanup_event_list(lv_event_list_t * list)
     cleanup_event_list_core(&list->array);
 
     list->has_marked_deleting = false;
+
+    /*Rebuild the mask from the remaining callbacks*/
+    list->code_mask = 0;
+    list->has_preprocess = false;
+    const uint32_t size = event_array_size(list);
+    for(uint32_t i = 0; i < size; i++) {
+        event_list_add_to_mask(list, (*event_array_at(list, i))->filter);
+    }
+}
+
+static void event_list_add_to_mask(lv_event_list_t * list, uint32_t filter)
+{
+    if(filter & LV_EVENT_PREPROCESS) list->has_preprocess = true;
+
+    filter &= ~LV_EVENT_PREPROCESS;
+    if(filter == LV_EVENT_ALL) list->code_mask = UINT64_MAX;
+    else list->code_mask |= EVENT_CODE_BIT(filter);
 }
 
 static void event_mark_deleting(lv_event_list_t * list, lv_event_dsc_t * dsc)
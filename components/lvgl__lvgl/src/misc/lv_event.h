@@ -124,9 +124,12 @@ typedef enum {
 
 typedef struct {
     lv_array_t array;
+    uint64_t code_mask;                /**< Bit `code % 64` is set if there can be a callback for `code`.
+                                         All bits are set if there is a callback for `LV_EVENT_ALL`. */
     uint8_t is_traversing: 1;          /**< True: the list is being nested traversed */
     uint8_t has_marked_deleting: 1;    /**< True: the list has marked deleting objects
                                          when some of events are marked as deleting */
+    uint8_t has_preprocess: 1;         /**< True: there can be callbacks with `LV_EVENT_PREPROCESS` */
 } lv_event_list_t;
 
 /**
@@ -39,6 +39,9 @@ static resolved_path_t lv_fs_resolve_path(const char * path);
 static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br);
 static lv_fs_res_t lv_fs_write_cached(lv_fs_file_t * file_p, const void * buf, uint32_t btw, uint32_t * bw);
 static lv_fs_res_t lv_fs_seek_cached(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whence);
+static lv_fs_res_t lv_fs_read_from_drv(lv_fs_file_t * file_p, uint32_t pos, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_cache_block_t * lv_fs_cache_find_block(lv_fs_file_cache_t * cache, uint32_t pos);
+static lv_fs_res_t lv_fs_cache_load_block(lv_fs_file_t * file_p, uint32_t start, lv_fs_cache_block_t ** block_p);
 
 /**********************
  *  STATIC VARIABLES
@@ -130,10 +133,9 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
             file_p->cache->file_position = 0;
             file_p->cache->end = path_ex->size;
         }
-        /*Set an invalid range by default*/
+        /*The blocks are allocated on the first read. The position of the driver is not known yet.*/
         else {
-            file_p->cache->start = UINT32_MAX;
-            file_p->cache->end = UINT32_MAX - 1;
+            file_p->cache->drv_position = UINT32_MAX;
         }
     }
 
@@ -167,8 +169,8 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
 
     if(file_p->drv->cache_size && file_p->cache) {
         /* Only free cache if it was pre-allocated (for memory-mapped files it is never allocated) */
-        if(file_p->drv->cache_size != LV_FS_CACHE_FROM_BUFFER && file_p->cache->buffer) {
-            lv_free(file_p->cache->buffer);
+        if(file_p->drv->cache_size != LV_FS_CACHE_FROM_BUFFER && file_p->cache->blocks) {
+            lv_free(file_p->cache->blocks);
         }
 
         lv_free(file_p->cache);
@@ -301,6 +303,40 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     return res;
 }
 
+const void * lv_fs_get_mapped_ptr(lv_fs_file_t * file_p, uint32_t * size)
+{
+    if(size != NULL) *size = 0;
+    if(file_p->drv == NULL) return NULL;
+
+    /*Files opened from a buffer are in the memory already*/
+    if(file_p->drv->cache_size == LV_FS_CACHE_FROM_BUFFER) {
+        if(size != NULL) *size = file_p->cache->end;
+        return file_p->cache->buffer;
+    }
+
+    if(file_p->drv->get_mapped_ptr_cb == NULL) return NULL;
+
+    LV_PROFILER_FS_BEGIN;
+
+    uint32_t size_tmp = 0;
+    const void * ptr = file_p->drv->get_mapped_ptr_cb(file_p->drv, file_p->file_d, &size_tmp);
+    if(ptr != NULL && size != NULL) *size = size_tmp;
+
+    LV_PROFILER_FS_END;
+
+    return ptr;
+}
+
+void lv_fs_get_cache_stat(lv_fs_file_t * file_p, lv_fs_cache_stat_t * stat)
+{
+    if(file_p->drv == NULL || file_p->drv->cache_size == 0 || file_p->cache == NULL) {
+        lv_memzero(stat, sizeof(lv_fs_cache_stat_t));
+        return;
+    }
+
+    *stat = file_p->cache->stat;
+}
+
 lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t * rddir_p, const char * path)
 {
     if(path == NULL) return LV_FS_RES_INV_PARAM;
@@ -390,6 +426,7 @@ lv_fs_res_t lv_fs_dir_close(lv_fs_dir_t * rddir_p)
 void lv_fs_drv_init(lv_fs_drv_t * drv)
 {
     lv_memzero(drv, sizeof(lv_fs_drv_t));
+    drv->cache_block_cnt = LV_FS_CACHE_BLOCK_CNT;
 }
 
 void lv_fs_drv_register(lv_fs_drv_t * drv_p)
@@ -536,84 +573,90 @@ static resolved_path_t lv_fs_resolve_path(const char * path)
 
 static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br)
 {
-    lv_fs_res_t res = LV_FS_RES_OK;
-    uint32_t file_position = file_p->cache->file_position;
-    uint32_t start = file_p->cache->start;
-    uint32_t end = file_p->cache->end;
-    char * buffer = file_p->cache->buffer;
-    uint32_t buffer_size = file_p->drv->cache_size;
-
-    if(start <= file_position && file_position <= end) {
-        /* Data can be read from cache buffer */
-        uint32_t buffer_remaining_length = (uint32_t)end - file_position + 1;
-        uint32_t buffer_offset = (end - start) - buffer_remaining_length + 1;
-
-        /* Do not allow reading beyond the actual memory block for memory-mapped files */
-        if(file_p->drv->cache_size == LV_FS_CACHE_FROM_BUFFER) {
-            if(btr > buffer_remaining_length)
-                btr = buffer_remaining_length - 1;
+    lv_fs_file_cache_t * cache = file_p->cache;
+
+    /*Files opened from a buffer are read directly from the buffer*/
+    if(file_p->drv->cache_size == LV_FS_CACHE_FROM_BUFFER) {
+        uint32_t size = cache->end;
+        *br = cache->file_position < size ? LV_MIN(btr, size - cache->file_position) : 0;
+        lv_memcpy(buf, (const uint8_t *)cache->buffer + cache->file_position, *br);
+        cache->file_position += *br;
+        return LV_FS_RES_OK;
+    }
+
+    uint32_t block_size = file_p->drv->cache_size;
+    if(cache->blocks == NULL) {
+        cache->block_cnt = LV_MAX(file_p->drv->cache_block_cnt, 1);
+        /*Allocate the descriptors and the data of the blocks together*/
+        cache->blocks = lv_malloc(cache->block_cnt * (sizeof(lv_fs_cache_block_t) + block_size));
+        LV_ASSERT_MALLOC(cache->blocks);
+        if(cache->blocks == NULL) return LV_FS_RES_OUT_OF_MEM;
+
+        uint8_t * data = (uint8_t *)&cache->blocks[cache->block_cnt];
+        uint32_t i;
+        for(i = 0; i < cache->block_cnt; i++) {
+            cache->blocks[i].start = UINT32_MAX;
+            cache->blocks[i].size = 0;
+            cache->blocks[i].life = 0;
+            cache->blocks[i].data = data + i * block_size;
         }
+    }
+
+    /*Read ahead only if this read continues the previous one*/
+    bool sequential = cache->file_position == cache->seq_position;
+    lv_fs_res_t res = LV_FS_RES_OK;
+    uint8_t * dest = buf;
+    uint32_t pos = cache->file_position;
 
-        if(btr <= buffer_remaining_length) {
-            /*Data is in cache buffer, and buffer end not reached, no need to read from FS*/
-            lv_memcpy(buf, buffer + buffer_offset, btr);
-            *br = btr;
+    while(btr > 0) {
+        lv_fs_cache_block_t * block = lv_fs_cache_find_block(cache, pos);
+        if(block) {
+            cache->stat.hit_cnt++;
         }
         else {
-            /*First part of data is in cache buffer, but we need to read rest of data from FS*/
-            lv_memcpy(buf, buffer + buffer_offset, buffer_remaining_length);
-
-            file_p->drv->seek_cb(file_p->drv, file_p->file_d, file_p->cache->end + 1,
-                                 LV_FS_SEEK_SET);
-
-            uint32_t bytes_read_to_buffer = 0;
-            if(btr - buffer_remaining_length > buffer_size) {
-                /*If remaining data chuck is bigger than buffer size, then do not use cache, instead read it directly from FS*/
-                res = file_p->drv->read_cb(file_p->drv, file_p->file_d, (char *)buf + buffer_remaining_length,
-                                           btr - buffer_remaining_length, &bytes_read_to_buffer);
-            }
-            else {
-                /*If remaining data chunk is smaller than buffer size, then read into cache buffer*/
-                res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buffer, buffer_size, &bytes_read_to_buffer);
-                file_p->cache->start = file_p->cache->end + 1;
-                file_p->cache->end = file_p->cache->start + bytes_read_to_buffer - 1;
-
-                uint16_t data_chunk_remaining = LV_MIN(btr - buffer_remaining_length, bytes_read_to_buffer);
-                lv_memcpy((char *)buf + buffer_remaining_length, buffer, data_chunk_remaining);
+            cache->stat.miss_cnt++;
+
+            /*If the remaining data is not smaller than a block, then do not use cache, instead read it directly*/
+            if(btr >= block_size) {
+                uint32_t br_direct = 0;
+                res = lv_fs_read_from_drv(file_p, pos, dest, btr, &br_direct);
+                *br += br_direct;
+                pos += br_direct;
+                break;
             }
-            *br = LV_MIN(buffer_remaining_length + bytes_read_to_buffer, btr);
-        }
-    }
-    else {
-        file_p->drv->seek_cb(file_p->drv, file_p->file_d, file_p->cache->file_position,
-                             LV_FS_SEEK_SET);
 
-        /*Data is not in cache buffer*/
-        if(btr > buffer_size) {
-            /*If bigger data is requested, then do not use cache, instead read it directly*/
-            res = file_p->drv->read_cb(file_p->drv, file_p->file_d, (void *)buf, btr, br);
-        }
-        else {
-            /*If small data is requested, then read from FS into cache buffer*/
-            if(buffer == NULL) {
-                file_p->cache->buffer = lv_malloc(buffer_size);
-                LV_ASSERT_MALLOC(file_p->cache->buffer);
-                buffer = file_p->cache->buffer;
+            uint32_t block_start = pos - pos % block_size;
+            res = lv_fs_cache_load_block(file_p, block_start, &block);
+            if(res != LV_FS_RES_OK) break;
+
+            /*When reading sequentially, the next block will be needed soon too*/
+            uint32_t next_start = block_start + block_size;
+            if(sequential && cache->block_cnt > 1 && block->size == block_size &&
+               lv_fs_cache_find_block(cache, next_start) == NULL) {
+                lv_fs_cache_block_t * next_block;
+                if(lv_fs_cache_load_block(file_p, next_start, &next_block) == LV_FS_RES_OK) {
+                    cache->stat.read_ahead_cnt++;
+                }
             }
 
-            uint32_t bytes_read_to_buffer = 0;
-            res = file_p->drv->read_cb(file_p->drv, file_p->file_d, (void *)buffer, buffer_size, &bytes_read_to_buffer);
-            file_p->cache->start = file_position;
-            file_p->cache->end = file_p->cache->start + bytes_read_to_buffer - 1;
+            /*End of the file*/
+            if(pos >= block->start + block->size) break;
+        }
 
-            *br = LV_MIN(btr, bytes_read_to_buffer);
-            lv_memcpy(buf, buffer, *br);
+        uint32_t offset = pos - block->start;
+        uint32_t len = LV_MIN(btr, block->size - offset);
+        lv_memcpy(dest, block->data + offset, len);
+        block->life = ++cache->use_cnt;
 
-        }
+        dest += len;
+        pos += len;
+        btr -= len;
+        *br += len;
     }
 
     if(res == LV_FS_RES_OK) {
-        file_p->cache->file_position += *br;
+        cache->file_position += *br;
+        cache->seq_position = cache->file_position;
     }
 
     return res;
@@ -623,42 +666,33 @@ static lv_fs_res_t lv_fs_write_cached(lv_fs_file_t * file_p, const void * buf, u
 {
     lv_fs_res_t res = LV_FS_RES_OK;
 
-    /*Need to do FS seek before writing data to FS*/
-    res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, file_p->cache->file_position, LV_FS_SEEK_SET);
+    lv_fs_file_cache_t * cache = file_p->cache;
+
+    /*Need to do FS seek before writing data to FS. Also seek before the next read
+     *as e.g. stdio requires it when switching between reading and writing.*/
+    cache->drv_position = UINT32_MAX;
+    res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, cache->file_position, LV_FS_SEEK_SET);
     if(res != LV_FS_RES_OK) return res;
 
     res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, bw);
     if(res != LV_FS_RES_OK) return res;
 
-    if(file_p->cache->end >= file_p->cache->start) {
-        uint32_t start_position = file_p->cache->file_position;
-        uint32_t end_position = file_p->cache->file_position + *bw - 1;
-        char * cache_buffer = file_p->cache->buffer;
-        const char * write_buffer = buf;
-
-        if(start_position <= file_p->cache->start && end_position >= file_p->cache->end) {
-            lv_memcpy(cache_buffer,
-                      write_buffer + (file_p->cache->start - start_position),
-                      file_p->cache->end + 1 - file_p->cache->start);
-        }
-        else if(start_position >= file_p->cache->start && end_position <= file_p->cache->end) {
-            lv_memcpy(cache_buffer + (start_position - file_p->cache->start),
-                      write_buffer,
-                      end_position + 1 - start_position);
-        }
-        else if(end_position >= file_p->cache->start && end_position <= file_p->cache->end) {
-            lv_memcpy(cache_buffer,
-                      write_buffer + (file_p->cache->start - start_position),
-                      end_position + 1 - file_p->cache->start);
-        }
-        else if(start_position >= file_p->cache->start && start_position <= file_p->cache->end) {
-            lv_memcpy(cache_buffer + (start_position - file_p->cache->start),
-                      write_buffer,
-                      file_p->cache->end + 1 - start_position);
+    /*Update the cached blocks which coincide with the written content*/
+    uint32_t write_start = cache->file_position;
+    uint32_t write_end = cache->file_position + *bw;
+    uint32_t i;
+    for(i = 0; i < cache->block_cnt; i++) {
+        lv_fs_cache_block_t * block = &cache->blocks[i];
+        if(block->start == UINT32_MAX) continue;
+
+        uint32_t start = LV_MAX(write_start, block->start);
+        uint32_t end = LV_MIN(write_end, block->start + block->size);
+        if(start < end) {
+            lv_memcpy(block->data + (start - block->start), (const uint8_t *)buf + (start - write_start), end - start);
         }
     }
 
-    file_p->cache->file_position += *bw;
+    cache->file_position += *bw;
 
     return res;
 }
@@ -684,6 +718,10 @@ static lv_fs_res_t lv_fs_seek_cached(lv_fs_file_t * file_p, uint32_t pos, lv_fs_
 
                     if(res == LV_FS_RES_OK) {
                         file_p->cache->file_position = tmp_position;
+                        file_p->cache->drv_position = tmp_position;
+                    }
+                    else {
+                        file_p->cache->drv_position = UINT32_MAX;
                     }
                 }
                 break;
@@ -692,3 +730,70 @@ static lv_fs_res_t lv_fs_seek_cached(lv_fs_file_t * file_p, uint32_t pos, lv_fs_
 
     return res;
 }
+
+/**
+ * Read from the driver, seeking only if the driver's position is not `pos` already
+ */
+static lv_fs_res_t lv_fs_read_from_drv(lv_fs_file_t * file_p, uint32_t pos, void * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_file_cache_t * cache = file_p->cache;
+    lv_fs_res_t res;
+
+    *br = 0;
+    if(cache->drv_position != pos) {
+        cache->drv_position = UINT32_MAX;
+        res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, LV_FS_SEEK_SET);
+        if(res != LV_FS_RES_OK) return res;
+    }
+
+    res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, br);
+    cache->drv_position = res == LV_FS_RES_OK ? pos + *br : UINT32_MAX;
+
+    return res;
+}
+
+static lv_fs_cache_block_t * lv_fs_cache_find_block(lv_fs_file_cache_t * cache, uint32_t pos)
+{
+    uint32_t i;
+    for(i = 0; i < cache->block_cnt; i++) {
+        lv_fs_cache_block_t * block = &cache->blocks[i];
+        if(block->start != UINT32_MAX && block->start <= pos && pos < block->start + block->size) return block;
+    }
+
+    return NULL;
+}
+
+/**
+ * Read a block from the driver to the cache, replacing the block with the same start,
+ * an unused block or the least recently used one
+ */
+static lv_fs_res_t lv_fs_cache_load_block(lv_fs_file_t * file_p, uint32_t start, lv_fs_cache_block_t ** block_p)
+{
+    lv_fs_file_cache_t * cache = file_p->cache;
+    lv_fs_cache_block_t * block = NULL;
+    uint32_t i;
+    for(i = 0; i < cache->block_cnt; i++) {
+        lv_fs_cache_block_t * b = &cache->blocks[i];
+        if(b->start == start) {
+            block = b;
+            break;
+        }
+
+        if(block == NULL) block = b;
+        else if(block->start == UINT32_MAX) continue;
+        else if(b->start == UINT32_MAX || b->life < block->life) block = b;
+    }
+
+    lv_fs_res_t res = lv_fs_read_from_drv(file_p, start, block->data, file_p->drv->cache_size, &block->size);
+    if(res != LV_FS_RES_OK) {
+        block->start = UINT32_MAX;
+        block->size = 0;
+        return res;
+    }
+
+    block->start = start;
+    block->life = ++cache->use_cnt;
+    *block_p = block;
+
+    return LV_FS_RES_OK;
+}
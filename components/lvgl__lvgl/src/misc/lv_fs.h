@@ -69,6 +69,7 @@ typedef struct _lv_fs_drv_t lv_fs_drv_t;
 struct _lv_fs_drv_t {
     char letter;
     uint32_t cache_size;
+    uint32_t cache_block_cnt;   /**< Number of `cache_size` bytes large blocks cached per file*/
     bool (*ready_cb)(lv_fs_drv_t * drv);
 
     void * (*open_cb)(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode);
@@ -77,6 +78,7 @@ struct _lv_fs_drv_t {
     lv_fs_res_t (*write_cb)(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
     lv_fs_res_t (*seek_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
     lv_fs_res_t (*tell_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+    const void * (*get_mapped_ptr_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
 
     void * (*dir_open_cb)(lv_fs_drv_t * drv, const char * path);
     lv_fs_res_t (*dir_read_cb)(lv_fs_drv_t * drv, void * rddir_p, char * fn, uint32_t fn_len);
@@ -91,6 +93,15 @@ typedef struct {
     lv_fs_file_cache_t * cache;
 } lv_fs_file_t;
 
+/**
+ * Statistics of the read cache of a file
+ */
+typedef struct {
+    uint32_t hit_cnt;           /**< Number of times the data was found in a cached block*/
+    uint32_t miss_cnt;          /**< Number of times the data was read from the driver*/
+    uint32_t read_ahead_cnt;    /**< Number of blocks read ahead because the file was read sequentially*/
+} lv_fs_cache_stat_t;
+
 
 typedef struct {
     void * dir_d;
@@ -194,6 +205,24 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
  */
 lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos);
 
+/**
+ * Get the whole content of a file opened for reading as a directly readable memory block.
+ * It's possible with files opened from a buffer and if the driver can map the file to the memory
+ * (e.g. with `mmap()` or from an XIP flash partition). The data can be used without copying it.
+ * The pointer is valid until the file is closed and the file must not be written meanwhile.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param size      pointer to store the size of the file in bytes. NULL if unused.
+ * @return          pointer to the content of the file or NULL if it can't be mapped
+ */
+const void * lv_fs_get_mapped_ptr(lv_fs_file_t * file_p, uint32_t * size);
+
+/**
+ * Get the statistics of the read cache of a file.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param stat      pointer to a variable to store the result. Zeroed if the file is not cached.
+ */
+void lv_fs_get_cache_stat(lv_fs_file_t * file_p, lv_fs_cache_stat_t * stat);
+
 /**
  * Initialize a 'fs_dir_t' variable for directory reading
  * @param rddir_p   pointer to a 'lv_fs_dir_t' variable
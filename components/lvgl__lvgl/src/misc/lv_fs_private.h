@@ -24,11 +24,25 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** A block of a file cached by `lv_fs_read()` */
+typedef struct {
+    uint32_t start;         /**< Position of the first byte in the file, `UINT32_MAX` if not used*/
+    uint32_t size;          /**< Number of valid bytes (less than the block size at the end of the file)*/
+    uint32_t life;          /**< Value of `use_cnt` of the cache when the block was used last time*/
+    uint8_t * data;
+} lv_fs_cache_block_t;
+
 struct _lv_fs_file_cache_t {
-    uint32_t start;
-    uint32_t end;
+    uint32_t start;                 /**< Start of the buffer of a file opened from a buffer (always 0)*/
+    uint32_t end;                   /**< Size of the buffer of a file opened from a buffer*/
     uint32_t file_position;
-    void * buffer;
+    void * buffer;                  /**< Buffer of a file opened from a buffer*/
+    lv_fs_cache_block_t * blocks;   /**< Blocks of `cache_size` bytes, allocated on the first read*/
+    uint32_t block_cnt;
+    uint32_t use_cnt;               /**< Incremented on every use of a block to find the least recently used one*/
+    uint32_t drv_position;          /**< Position of the file in the driver, `UINT32_MAX` if unknown*/
+    uint32_t seq_position;          /**< A read from here continues the previous one*/
+    lv_fs_cache_stat_t stat;
 };
 
 /** Extended path object to specify buffer for memory-mapped files */
@@ -27,6 +27,11 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_STYLE_SORTED_PROPS
+    static uint32_t sorted_prop_find(const lv_style_t * style, lv_style_prop_t prop);
+    static bool sorted_prop_insert(lv_style_t * style, uint32_t idx, lv_style_prop_t prop, lv_style_value_t value);
+    static void sorted_prop_remove(lv_style_t * style, uint32_t idx);
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -284,6 +289,15 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
 
     LV_PROFILER_STYLE_BEGIN;
 
+#if LV_STYLE_SORTED_PROPS
+    lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    uint32_t idx = sorted_prop_find(style, prop);
+    if(idx < style->prop_cnt && props[idx] == prop) {
+        sorted_prop_remove(style, idx);
+        LV_PROFILER_STYLE_END;
+        return true;
+    }
+#else
     uint8_t * tmp = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
     uint8_t * old_props = (uint8_t *)tmp;
     uint32_t i;
@@ -292,7 +306,10 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
             lv_style_value_t * old_values = (lv_style_value_t *)style->values_and_props;
 
             size_t size = (style->prop_cnt - 1) * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+            lv_mem_tag_t mem_tag_prev;
+            LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_STYLE, mem_tag_prev);
             uint8_t * new_values_and_props = lv_malloc(size);
+            LV_MEM_STATS_TAG_END(mem_tag_prev);
             if(new_values_and_props == NULL) {
                 LV_PROFILER_STYLE_END;
                 return false;
@@ -319,6 +336,7 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
             return true;
         }
     }
+#endif
 
     LV_PROFILER_STYLE_END;
     return false;
@@ -336,6 +354,19 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     LV_ASSERT(prop != LV_STYLE_PROP_INV);
     LV_PROFILER_STYLE_BEGIN;
     lv_style_prop_t * props;
+
+#if LV_STYLE_SORTED_PROPS
+    props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    uint32_t idx = sorted_prop_find(style, prop);
+    if(idx < style->prop_cnt && props[idx] == prop) {
+        lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+        values[idx] = value;
+    }
+    else if(!sorted_prop_insert(style, idx, prop, value)) {
+        LV_PROFILER_STYLE_END;
+        return;
+    }
+#else
     int32_t i;
 
     if(style->values_and_props) {
@@ -351,7 +382,10 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     }
 
     size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+    lv_mem_tag_t mem_tag_prev;
+    LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_STYLE, mem_tag_prev);
     uint8_t * values_and_props = lv_realloc(style->values_and_props, size);
+    LV_MEM_STATS_TAG_END(mem_tag_prev);
     if(values_and_props == NULL) {
         LV_PROFILER_STYLE_END;
         return;
@@ -373,6 +407,7 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     /*Set the new property and value*/
     props[style->prop_cnt - 1] = prop;
     values[style->prop_cnt - 1] = value;
+#endif
 
     uint32_t group = lv_style_get_prop_group(prop);
     style->has_group |= (uint32_t)1 << group;
@@ -487,3 +522,103 @@ uint8_t lv_style_prop_lookup_flags(lv_style_prop_t prop)
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_STYLE_SORTED_PROPS
+/**
+ * Find the position of a property in a style with sorted props
+ * @param style     pointer to a non-constant style
+ * @param prop      the property to find
+ * @return          index of `prop` if it's in the style,
+ *                  else the index where it should be inserted
+ */
+static uint32_t sorted_prop_find(const lv_style_t * style, lv_style_prop_t prop)
+{
+    const lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props +
+                                    style->prop_cnt * sizeof(lv_style_value_t);
+    uint32_t min = 0;
+    uint32_t max = style->prop_cnt;
+    while(min < max) {
+        uint32_t mid = (min + max) >> 1;
+        if(props[mid] < prop) min = mid + 1;
+        else max = mid;
+    }
+
+    return min;
+}
+
+/**
+ * Insert a new property into a style keeping the order of the props.
+ * The buffer is grown geometrically so not every insert needs a reallocation.
+ * @param style     pointer to a non-constant style
+ * @param idx       the index returned by `sorted_prop_find`
+ * @param prop      the new property
+ * @param value     the value of the property
+ * @return          false on out of memory
+ */
+static bool sorted_prop_insert(lv_style_t * style, uint32_t idx, lv_style_prop_t prop, lv_style_value_t value)
+{
+    uint32_t cnt = style->prop_cnt;
+    if(cnt == style->prop_cap) {
+        /*255 is reserved to mark the constant styles*/
+        uint32_t cap = cnt ? LV_MIN(cnt * 2, 254) : 4;
+        if(cap <= cnt) {
+            LV_LOG_WARN("Too many properties in a style");
+            return false;
+        }
+
+        lv_mem_tag_t mem_tag_prev;
+        LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_STYLE, mem_tag_prev);
+        uint8_t * values_and_props = lv_realloc(style->values_and_props,
+                                                cap * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t)));
+        LV_MEM_STATS_TAG_END(mem_tag_prev);
+        if(values_and_props == NULL) return false;
+
+        style->values_and_props = values_and_props;
+        style->prop_cap = (uint8_t)cap;
+    }
+
+    lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+    lv_style_prop_t * old_props = (lv_style_prop_t *)style->values_and_props + cnt * sizeof(lv_style_value_t);
+    lv_style_prop_t * new_props = old_props + sizeof(lv_style_value_t);
+
+    /*The props are after the values, so move them first to make place for the new value*/
+    lv_memmove(&new_props[idx + 1], &old_props[idx], cnt - idx);
+    lv_memmove(new_props, old_props, idx);
+    lv_memmove(&values[idx + 1], &values[idx], (cnt - idx) * sizeof(lv_style_value_t));
+
+    values[idx] = value;
+    new_props[idx] = prop;
+    style->prop_cnt++;
+
+    return true;
+}
+
+/**
+ * Remove a property from a style keeping the order of the other props.
+ * The buffer is kept for the next inserts, it's freed only if the style becomes empty.
+ * @param style     pointer to a non-constant style
+ * @param idx       index of the property to remove
+ */
+static void sorted_prop_remove(lv_style_t * style, uint32_t idx)
+{
+    uint32_t cnt = style->prop_cnt;
+    if(cnt == 1) {
+        lv_free(style->values_and_props);
+        style->values_and_props = NULL;
+        style->prop_cnt = 0;
+        style->prop_cap = 0;
+        return;
+    }
+
+    lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+    lv_style_prop_t * old_props = (lv_style_prop_t *)style->values_and_props + cnt * sizeof(lv_style_value_t);
+    lv_style_prop_t * new_props = old_props - sizeof(lv_style_value_t);
+
+    /*The values are before the props, so close their gap first*/
+    lv_memmove(&values[idx], &values[idx + 1], (cnt - idx - 1) * sizeof(lv_style_value_t));
+    lv_memmove(new_props, old_props, idx);
+    lv_memmove(&new_props[idx], &old_props[idx + 1], cnt - idx - 1);
+
+    style->prop_cnt--;
+}
+#endif
@@ -329,6 +329,9 @@ typedef struct {
 
     uint32_t has_group;
     uint8_t prop_cnt;   /**< 255 means it's a constant style*/
+#if LV_STYLE_SORTED_PROPS
+    uint8_t prop_cap;   /**< Number of props `values_and_props` has space for*/
+#endif
 } lv_style_t;
 
 /**********************
@@ -479,6 +482,21 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
     }
     else {
         lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+#if LV_STYLE_SORTED_PROPS
+        /*The props are in ascending order, use binary search*/
+        uint32_t min = 0;
+        uint32_t max = style->prop_cnt;
+        while(min < max) {
+            uint32_t mid = (min + max) >> 1;
+            if(props[mid] < prop) min = mid + 1;
+            else max = mid;
+        }
+        if(min < style->prop_cnt && props[min] == prop) {
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            *value = values[min];
+            return LV_STYLE_RES_FOUND;
+        }
+#else
         uint32_t i;
         for(i = 0; i < style->prop_cnt; i++) {
             if(props[i] == prop) {
@@ -487,6 +505,7 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
                 return LV_STYLE_RES_FOUND;
             }
         }
+#endif
     }
     return LV_STYLE_RES_NOT_FOUND;
 }
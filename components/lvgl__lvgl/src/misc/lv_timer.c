@@ -12,6 +12,7 @@
 #include "../stdlib/lv_sprintf.h"
 #include "lv_assert.h"
 #include "lv_ll.h"
+#include "lv_math.h"
 #include "lv_profiler.h"
 
 /*********************
@@ -24,6 +25,16 @@
 #define state LV_GLOBAL_DEFAULT()->timer_state
 #define timer_ll_p &(state.timer_ll)
 
+#define SCHED_IDX_NONE  0xFFFFFFFF  /*The timer is paused, it's not in the heap*/
+#define SCHED_IDX_RAN   0x80000000  /*Flag to mark an index in the list of the timers which ran*/
+
+#if LV_TIMER_DEADLINE_HEAP
+    /*Only the deletion of the executed timer matters, not of the others*/
+    #define timer_deleted_in_exec() (state.timer_exec == NULL)
+#else
+    #define timer_deleted_in_exec() (state.timer_deleted)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -34,6 +45,17 @@
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static void lv_timer_handler_resume(void);
+#if LV_TIMER_DEADLINE_HEAP
+    static bool sched_reserve(uint32_t cnt);
+    static bool sched_is_before(const lv_timer_t * a, const lv_timer_t * b);
+    static void heap_insert(lv_timer_t * timer);
+    static void heap_remove(lv_timer_t * timer);
+    static void heap_update(lv_timer_t * timer);
+    static void heap_sift_up(uint32_t idx);
+    static void heap_sift_down(uint32_t idx);
+    static void ran_add(lv_timer_t * timer);
+    static void ran_remove(lv_timer_t * timer);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -90,6 +112,34 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
+#if LV_TIMER_DEADLINE_HEAP
+    /*Run the timers in the order of their deadlines until one is found which is not ready.
+     *The timers which ran are put aside so that they run at most once in a call
+     *and creating or deleting timers in the callbacks doesn't affect the loop.*/
+    while(state_p->heap_cnt) {
+        lv_timer_t * timer_active = state_p->heap[0];
+        if(timer_active->repeat_count != 0 && lv_timer_time_remaining(timer_active) != 0) break;
+
+        heap_remove(timer_active);
+        ran_add(timer_active);
+        lv_timer_exec(timer_active);
+    }
+
+    /*The deleted timers are already removed from the list, put back the others*/
+    uint32_t i;
+    for(i = 0; i < state_p->ran_cnt; i++) {
+        lv_timer_t * timer_ran = state_p->ran[i];
+        if(timer_ran->paused) timer_ran->sched_idx = SCHED_IDX_NONE;
+        else heap_insert(timer_ran);
+    }
+    state_p->ran_cnt = 0;
+
+    uint32_t time_until_next = LV_NO_TIMER_READY;
+    if(state_p->heap_cnt) {
+        lv_timer_t * first = state_p->heap[0];
+        time_until_next = first->repeat_count == 0 ? 0 : lv_timer_time_remaining(first);
+    }
+#else
     /*Run all timer from the list*/
     lv_timer_t * next;
     lv_timer_t * timer_active;
@@ -127,6 +177,7 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
 
         next = lv_ll_get_next(timer_head, next); /*Find the next timer*/
     }
+#endif
 
     state_p->busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(state_p->idle_period_start);
@@ -166,7 +217,18 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+#if LV_TIMER_DEADLINE_HEAP
+    /*Reserve space in advance so that a timer can be always scheduled again without allocation*/
+    if(!sched_reserve(state.timer_cnt + 1)) {
+        LV_ASSERT_MALLOC(NULL);
+        return NULL;
+    }
+#endif
+
+    lv_mem_tag_t mem_tag_prev;
+    LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_TIMER, mem_tag_prev);
     new_timer = lv_ll_ins_head(timer_ll_p);
+    LV_MEM_STATS_TAG_END(mem_tag_prev);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
 
@@ -178,6 +240,12 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
 
+#if LV_TIMER_DEADLINE_HEAP
+    new_timer->seq = state.timer_seq++;
+    state.timer_cnt++;
+    heap_insert(new_timer);
+#endif
+
     state.timer_created = true;
 
     lv_timer_handler_resume();
@@ -193,6 +261,17 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 
 void lv_timer_delete(lv_timer_t * timer)
 {
+#if LV_TIMER_DEADLINE_HEAP
+    if(timer->sched_idx == SCHED_IDX_NONE) {
+        /*Paused, not scheduled*/
+    }
+    else if(timer->sched_idx & SCHED_IDX_RAN) ran_remove(timer);
+    else heap_remove(timer);
+
+    if(state.timer_exec == timer) state.timer_exec = NULL;
+    state.timer_cnt--;
+#endif
+
     lv_ll_remove(timer_ll_p, timer);
     state.timer_deleted = true;
 
@@ -203,12 +282,19 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+#if LV_TIMER_DEADLINE_HEAP
+    if(timer->sched_idx < SCHED_IDX_RAN) heap_remove(timer);
+#endif
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = false;
+#if LV_TIMER_DEADLINE_HEAP
+    /*If it just ran it will be put back at the end of `lv_timer_handler`*/
+    if(timer->sched_idx == SCHED_IDX_NONE) heap_insert(timer);
+#endif
     lv_timer_handler_resume();
 }
 
@@ -216,18 +302,27 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+#if LV_TIMER_DEADLINE_HEAP
+    heap_update(timer);
+#endif
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+#if LV_TIMER_DEADLINE_HEAP
+    heap_update(timer);
+#endif
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     LV_ASSERT_NULL(timer);
     timer->repeat_count = repeat_count;
+#if LV_TIMER_DEADLINE_HEAP
+    heap_update(timer);
+#endif
 }
 
 void lv_timer_set_auto_delete(lv_timer_t * timer, bool auto_delete)
@@ -246,6 +341,9 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+#if LV_TIMER_DEADLINE_HEAP
+    heap_update(timer);
+#endif
     lv_timer_handler_resume();
 }
 
@@ -260,6 +358,17 @@ void lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     lv_ll_clear(timer_ll_p);
+
+#if LV_TIMER_DEADLINE_HEAP
+    lv_free(state.heap);
+    lv_free(state.ran);
+    state.heap = NULL;
+    state.ran = NULL;
+    state.heap_cnt = 0;
+    state.ran_cnt = 0;
+    state.sched_size = 0;
+    state.timer_cnt = 0;
+#endif
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -312,6 +421,10 @@ static bool lv_timer_exec(lv_timer_t * timer)
 {
     if(timer->paused) return false;
 
+#if LV_TIMER_DEADLINE_HEAP
+    state.timer_exec = timer;
+#endif
+
     bool exec = false;
     if(lv_timer_time_remaining(timer) == 0) {
         /* Decrement the repeat count before executing the timer_cb.
@@ -328,7 +441,7 @@ static bool lv_timer_exec(lv_timer_t * timer)
             LV_PROFILER_TIMER_END_TAG("timer_cb");
         }
 
-        if(!state.timer_deleted) {
+        if(!timer_deleted_in_exec()) {
             LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
         }
         else {
@@ -339,7 +452,7 @@ static bool lv_timer_exec(lv_timer_t * timer)
         exec = true;
     }
 
-    if(state.timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    if(!timer_deleted_in_exec()) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             if(timer->auto_delete) {
                 LV_TRACE_TIMER("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
@@ -386,3 +499,148 @@ void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data
     state.resume_cb = cb;
     state.resume_data = data;
 }
+
+#if LV_TIMER_DEADLINE_HEAP
+/**
+ * Make sure that `heap` and `ran` can store a given number of timers
+ * @param cnt       the number of timers
+ * @return          false on out of memory
+ */
+static bool sched_reserve(uint32_t cnt)
+{
+    if(cnt <= state.sched_size) return true;
+
+    uint32_t size = LV_MAX(cnt, state.sched_size * 2);
+    size = LV_MAX(size, 8);
+
+    lv_timer_t ** heap = lv_realloc(state.heap, size * sizeof(lv_timer_t *));
+    if(heap == NULL) return false;
+    state.heap = heap;
+
+    lv_timer_t ** ran = lv_realloc(state.ran, size * sizeof(lv_timer_t *));
+    if(ran == NULL) return false;
+    state.ran = ran;
+
+    state.sched_size = size;
+    return true;
+}
+
+/**
+ * Get the time when a timer should run next
+ * @param timer     pointer to a timer
+ * @return          the tick of the deadline
+ */
+static uint32_t timer_deadline(const lv_timer_t * timer)
+{
+    /*If the repeat count is over the timer needs to be deleted or paused as soon as possible*/
+    if(timer->repeat_count == 0) return timer->last_run;
+    return timer->last_run + timer->period;
+}
+
+/**
+ * Check if a timer should run before an other
+ * @param a         pointer to a timer
+ * @param b         pointer to an other timer
+ * @return          true: `a` should run first
+ */
+static bool sched_is_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    /*Compare the difference to handle the overflow of the tick*/
+    int32_t diff = (int32_t)(timer_deadline(a) - timer_deadline(b));
+    if(diff != 0) return diff < 0;
+
+    /*Same order as in the timer list: the newer first*/
+    return (int32_t)(a->seq - b->seq) > 0;
+}
+
+static void heap_insert(lv_timer_t * timer)
+{
+    uint32_t idx = state.heap_cnt;
+    state.heap[idx] = timer;
+    timer->sched_idx = idx;
+    state.heap_cnt++;
+    heap_sift_up(idx);
+}
+
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t idx = timer->sched_idx;
+    state.heap_cnt--;
+    if(idx != state.heap_cnt) {
+        /*Move the last timer to the empty place and restore the order around it*/
+        lv_timer_t * last = state.heap[state.heap_cnt];
+        state.heap[idx] = last;
+        last->sched_idx = idx;
+        heap_sift_up(idx);
+        heap_sift_down(last->sched_idx);
+    }
+    timer->sched_idx = SCHED_IDX_NONE;
+}
+
+/**
+ * Restore the order of the heap after the deadline of a timer has changed
+ * @param timer     pointer to a timer
+ */
+static void heap_update(lv_timer_t * timer)
+{
+    /*Paused timers and the timers which just ran are not in the heap*/
+    if(timer->sched_idx >= SCHED_IDX_RAN) return;
+
+    heap_sift_up(timer->sched_idx);
+    heap_sift_down(timer->sched_idx);
+}
+
+static void heap_sift_up(uint32_t idx)
+{
+    lv_timer_t ** heap = state.heap;
+    lv_timer_t * timer = heap[idx];
+    while(idx > 0) {
+        uint32_t parent = (idx - 1) / 2;
+        if(!sched_is_before(timer, heap[parent])) break;
+
+        heap[idx] = heap[parent];
+        heap[idx]->sched_idx = idx;
+        idx = parent;
+    }
+
+    heap[idx] = timer;
+    timer->sched_idx = idx;
+}
+
+static void heap_sift_down(uint32_t idx)
+{
+    lv_timer_t ** heap = state.heap;
+    lv_timer_t * timer = heap[idx];
+    uint32_t cnt = state.heap_cnt;
+    while(1) {
+        uint32_t child = idx * 2 + 1;
+        if(child >= cnt) break;
+        if(child + 1 < cnt && sched_is_before(heap[child + 1], heap[child])) child++;
+        if(!sched_is_before(heap[child], timer)) break;
+
+        heap[idx] = heap[child];
+        heap[idx]->sched_idx = idx;
+        idx = child;
+    }
+
+    heap[idx] = timer;
+    timer->sched_idx = idx;
+}
+
+static void ran_add(lv_timer_t * timer)
+{
+    state.ran[state.ran_cnt] = timer;
+    timer->sched_idx = SCHED_IDX_RAN | state.ran_cnt;
+    state.ran_cnt++;
+}
+
+static void ran_remove(lv_timer_t * timer)
+{
+    uint32_t idx = timer->sched_idx & ~SCHED_IDX_RAN;
+    state.ran_cnt--;
+    lv_timer_t * last = state.ran[state.ran_cnt];
+    state.ran[idx] = last;
+    last->sched_idx = SCHED_IDX_RAN | idx;
+    timer->sched_idx = SCHED_IDX_NONE;
+}
+#endif
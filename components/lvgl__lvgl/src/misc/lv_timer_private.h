@@ -35,6 +35,10 @@ struct _lv_timer_t {
     int32_t repeat_count;      /**< 1: One time;  -1 : infinity;  n>0: residual times */
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
+#if LV_TIMER_DEADLINE_HEAP
+    uint32_t sched_idx;        /**< Index in the deadline heap or in the list of the timers which just ran*/
+    uint32_t seq;              /**< Creation order, the newer timer runs first if the deadlines are the same*/
+#endif
 };
 
 typedef struct {
@@ -54,6 +58,17 @@ typedef struct {
 
     lv_timer_handler_resume_cb_t resume_cb;
     void * resume_data;
+
+#if LV_TIMER_DEADLINE_HEAP
+    lv_timer_t ** heap;        /**< Binary heap of the not paused timers, `heap[0]` has the earliest deadline*/
+    uint32_t heap_cnt;
+    lv_timer_t ** ran;         /**< Timers which ran in this `lv_timer_handler` call, they are put back to the heap at the end*/
+    uint32_t ran_cnt;
+    uint32_t sched_size;       /**< Size of both `heap` and `ran`, enough to hold all the timers*/
+    uint32_t timer_cnt;
+    uint32_t timer_seq;
+    lv_timer_t * timer_exec;   /**< The timer whose callback runs now, set to NULL if it's deleted*/
+#endif
 } lv_timer_state_t;
 
 /**********************
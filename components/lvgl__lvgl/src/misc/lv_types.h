@@ -134,6 +134,7 @@ typedef struct _lv_anim_t lv_anim_t;
 typedef struct _lv_font_t lv_font_t;
 typedef struct _lv_font_class_t lv_font_class_t;
 typedef struct _lv_font_info_t lv_font_info_t;
+typedef struct _lv_font_fmt_txt_lookup_t lv_font_fmt_txt_lookup_t;
 
 typedef struct _lv_font_manager_t lv_font_manager_t;
 
@@ -175,6 +176,8 @@ typedef struct _lv_draw_mask_t lv_draw_mask_t;
 
 typedef struct _lv_draw_label_hint_t lv_draw_label_hint_t;
 
+typedef struct _lv_draw_label_lines_t lv_draw_label_lines_t;
+
 typedef struct _lv_draw_glyph_dsc_t lv_draw_glyph_dsc_t;
 
 typedef struct _lv_draw_image_sup_t lv_draw_image_sup_t;
@@ -185,12 +188,16 @@ typedef struct _lv_obj_style_t lv_obj_style_t;
 
 typedef struct _lv_obj_style_transition_dsc_t lv_obj_style_transition_dsc_t;
 
+typedef struct _lv_obj_style_value_cache_t lv_obj_style_value_cache_t;
+
 typedef struct _lv_hit_test_info_t lv_hit_test_info_t;
 
 typedef struct _lv_cover_check_info_t lv_cover_check_info_t;
 
 typedef struct _lv_obj_spec_attr_t lv_obj_spec_attr_t;
 
+typedef struct _lv_layout_cache_t lv_layout_cache_t;
+
 typedef struct _lv_image_t lv_image_t;
 
 typedef struct _lv_animimg_t lv_animimg_t;
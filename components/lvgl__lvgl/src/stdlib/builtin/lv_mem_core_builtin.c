@@ -38,6 +38,12 @@
 #endif
 #define state LV_GLOBAL_DEFAULT()->tlsf_state
 
+#if LV_MEM_SIZE_CLASS_CACHE_CNT
+    /*Blocks up to this size are kept in per-size class free lists instead of returning them to TLSF*/
+    #define SIZE_CLASS_STEP     16
+    #define SIZE_CLASS_MAX      (SIZE_CLASS_STEP * LV_MEM_SIZE_CLASS_NUM)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -46,6 +52,9 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
+#if LV_MEM_SIZE_CLASS_CACHE_CNT
+    static void size_class_flush(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -88,6 +97,11 @@ void lv_mem_init(void)
 
     lv_ll_init(&state.pool_ll, sizeof(lv_pool_t));
 
+#if LV_MEM_SIZE_CLASS_CACHE_CNT
+    lv_memzero(state.size_class_head, sizeof(state.size_class_head));
+    lv_memzero(state.size_class_cnt, sizeof(state.size_class_cnt));
+#endif
+
     /*Record the first pool*/
     lv_pool_t * pool_p = lv_ll_ins_tail(&state.pool_ll);
     LV_ASSERT_MALLOC(pool_p);
@@ -125,6 +139,11 @@ lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes)
 void lv_mem_remove_pool(lv_mem_pool_t pool)
 {
     lv_pool_t * pool_p;
+#if LV_MEM_SIZE_CLASS_CACHE_CNT
+    /*Some of the cached blocks might be in this pool*/
+    size_class_flush();
+#endif
+
     LV_LL_READ(&state.pool_ll, pool_p) {
         if(*pool_p == pool) {
             lv_ll_remove(&state.pool_ll, pool_p);
@@ -141,7 +160,27 @@ void * lv_malloc_core(size_t size)
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
+
+#if LV_MEM_SIZE_CLASS_CACHE_CNT
+    void * p = NULL;
+    if(size <= SIZE_CLASS_MAX) {
+        uint32_t c = (uint32_t)(size - 1) / SIZE_CLASS_STEP;
+        p = state.size_class_head[c];
+        if(p) {
+            state.size_class_head[c] = *(void **)p;
+            state.size_class_cnt[c]--;
+        }
+        else {
+            /*Allocate the full size of the class so that the block can be reused for any size of the class*/
+            p = lv_tlsf_malloc(state.tlsf, (c + 1) * SIZE_CLASS_STEP);
+        }
+    }
+    else {
+        p = lv_tlsf_malloc(state.tlsf, size);
+    }
+#else
     void * p = lv_tlsf_malloc(state.tlsf, size);
+#endif
 
     if(p) {
         state.cur_used += lv_tlsf_block_size(p);
@@ -185,10 +224,27 @@ void lv_free_core(void * p)
     lv_memset(p, 0xbb, lv_tlsf_block_size(data));
 #endif
     size_t size = lv_tlsf_block_size(p);
-    lv_tlsf_free(state.tlsf, p);
     if(state.cur_used > size) state.cur_used -= size;
     else state.cur_used = 0;
 
+#if LV_MEM_SIZE_CLASS_CACHE_CNT
+    /*Keep the small blocks in the free list of the largest class they fit*/
+    if(size >= SIZE_CLASS_STEP && size <= SIZE_CLASS_MAX) {
+        uint32_t c = (uint32_t)size / SIZE_CLASS_STEP - 1;
+        if(state.size_class_cnt[c] < LV_MEM_SIZE_CLASS_CACHE_CNT) {
+            *(void **)p = state.size_class_head[c];
+            state.size_class_head[c] = p;
+            state.size_class_cnt[c]++;
+#if LV_USE_OS
+            lv_mutex_unlock(&state.mutex);
+#endif
+            return;
+        }
+    }
+#endif
+
+    lv_tlsf_free(state.tlsf, p);
+
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
 #endif
@@ -200,6 +256,11 @@ void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
     lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
     LV_TRACE_MEM("begin");
 
+#if LV_MEM_SIZE_CLASS_CACHE_CNT
+    /*Return the cached blocks to TLSF to see them as free memory*/
+    size_class_flush();
+#endif
+
     lv_pool_t * pool_p;
     LV_LL_READ(&state.pool_ll, pool_p) {
         lv_tlsf_walk_pool(*pool_p, lv_mem_walker, mon_p);
@@ -254,6 +315,29 @@ lv_result_t lv_mem_test_core(void)
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_MEM_SIZE_CLASS_CACHE_CNT
+static void size_class_flush(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+
+    uint32_t c;
+    for(c = 0; c < LV_MEM_SIZE_CLASS_NUM; c++) {
+        while(state.size_class_head[c]) {
+            void * p = state.size_class_head[c];
+            state.size_class_head[c] = *(void **)p;
+            lv_tlsf_free(state.tlsf, p);
+        }
+        state.size_class_cnt[c] = 0;
+    }
+
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+#endif
+
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
 {
     LV_UNUSED(ptr);
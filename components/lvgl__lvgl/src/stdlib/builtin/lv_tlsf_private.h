@@ -23,6 +23,9 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*Number of 16 byte wide size classes cached in front of TLSF*/
+#define LV_MEM_SIZE_CLASS_NUM   8
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,6 +38,10 @@ typedef struct {
     size_t cur_used;
     size_t max_used;
     lv_ll_t  pool_ll;
+#if LV_MEM_SIZE_CLASS_CACHE_CNT
+    void * size_class_head[LV_MEM_SIZE_CLASS_NUM];  /**< Linked lists of the freed blocks per size class*/
+    uint16_t size_class_cnt[LV_MEM_SIZE_CLASS_NUM];
+#endif
 } lv_tlsf_state_t;
 
 /**********************
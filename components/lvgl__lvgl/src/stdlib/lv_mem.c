@@ -7,6 +7,7 @@
  *********************/
 #include "lv_mem_private.h"
 #include "lv_string.h"
+#include "lv_sprintf.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_log.h"
 #include "../core/lv_global.h"
@@ -25,13 +26,51 @@
 
 #define zero_mem LV_GLOBAL_DEFAULT()->memory_zero
 
+#if LV_USE_MEM_STATS
+    #define mem_stats LV_GLOBAL_DEFAULT()->mem_stats
+    #define mem_stats_lock LV_GLOBAL_DEFAULT()->mem_stats_lock
+    #define MEM_HEADER_SIZE sizeof(mem_header_t)
+#else
+    #define MEM_HEADER_SIZE 0
+#endif
+
+/*Each thread tags its own allocations. Without thread local storage
+ *the allocations of the other threads might be counted for a wrong tag.*/
+#if LV_USE_OS == LV_OS_NONE
+    #define MEM_TAG_THREAD_LOCAL
+#elif defined(__GNUC__) || defined(__clang__)
+    #define MEM_TAG_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+    #define MEM_TAG_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+    #define MEM_TAG_THREAD_LOCAL _Thread_local
+#else
+    #define MEM_TAG_THREAD_LOCAL
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_MEM_STATS
+/*Stored before the allocated memory to know its size and tag when it's freed.
+ *It's 16 bytes to keep the alignment of the allocated memory.*/
+typedef union {
+    struct {
+        uint32_t size;
+        uint8_t tag;
+    } info;
+    uint8_t align[16];
+} mem_header_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_USE_MEM_STATS
+    static void * mem_stats_add(void * p, size_t size, uint8_t tag);
+    static void * mem_stats_remove(void * p);
+#endif
 
 /**********************
  *  GLOBAL PROTOTYPES
@@ -45,6 +84,9 @@ lv_result_t lv_mem_test_core(void);
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_MEM_STATS
+    static MEM_TAG_THREAD_LOCAL lv_mem_tag_t mem_tag_act;
+#endif
 
 /**********************
  *      MACROS
@@ -67,7 +109,7 @@ void * lv_malloc(size_t size)
         return &zero_mem;
     }
 
-    void * alloc = lv_malloc_core(size);
+    void * alloc = lv_malloc_core(size + MEM_HEADER_SIZE);
 
     if(alloc == NULL) {
         LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
@@ -81,6 +123,10 @@ void * lv_malloc(size_t size)
         return NULL;
     }
 
+#if LV_USE_MEM_STATS
+    alloc = mem_stats_add(alloc, size, mem_tag_act);
+#endif
+
 #if LV_MEM_ADD_JUNK
     lv_memset(alloc, 0xaa, size);
 #endif
@@ -97,7 +143,7 @@ void * lv_malloc_zeroed(size_t size)
         return &zero_mem;
     }
 
-    void * alloc = lv_malloc_core(size);
+    void * alloc = lv_malloc_core(size + MEM_HEADER_SIZE);
     if(alloc == NULL) {
         LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
@@ -110,6 +156,10 @@ void * lv_malloc_zeroed(size_t size)
         return NULL;
     }
 
+#if LV_USE_MEM_STATS
+    alloc = mem_stats_add(alloc, size, mem_tag_act);
+#endif
+
     lv_memzero(alloc, size);
 
     LV_TRACE_MEM("allocated at %p", alloc);
@@ -133,6 +183,10 @@ void lv_free(void * data)
     if(data == &zero_mem) return;
     if(data == NULL) return;
 
+#if LV_USE_MEM_STATS
+    data = mem_stats_remove(data);
+#endif
+
     lv_free_core(data);
 }
 
@@ -156,13 +210,27 @@ void * lv_realloc(void * data_p, size_t new_size)
 
     if(data_p == &zero_mem) return lv_malloc(new_size);
 
+#if LV_USE_MEM_STATS
+    if(data_p == NULL) return lv_malloc(new_size);
+
+    /*Keep the tag of the original allocation*/
+    mem_header_t header = *((mem_header_t *)data_p - 1);
+    void * new_p = lv_realloc_core((mem_header_t *)data_p - 1, new_size + MEM_HEADER_SIZE);
+#else
     void * new_p = lv_realloc_core(data_p, new_size);
+#endif
 
     if(new_p == NULL) {
         LV_LOG_ERROR("couldn't reallocate memory");
         return NULL;
     }
 
+#if LV_USE_MEM_STATS
+    /*The header was copied too. Remove the original size from the stats and add the new one.*/
+    mem_stats_remove((mem_header_t *)new_p + 1);
+    new_p = mem_stats_add(new_p, new_size, header.info.tag);
+#endif
+
     LV_TRACE_MEM("reallocated at %p", new_p);
     return new_p;
 }
@@ -183,6 +251,121 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     lv_mem_monitor_core(mon_p);
 }
 
+#if LV_USE_MEM_STATS
+
+void lv_mem_stats_init(void)
+{
+    lv_mutex_init(&mem_stats_lock);
+}
+
+void lv_mem_stats_deinit(void)
+{
+    lv_mutex_delete(&mem_stats_lock);
+}
+
+lv_mem_tag_t lv_mem_set_tag(lv_mem_tag_t tag)
+{
+    LV_ASSERT(tag < LV_MEM_TAG_CNT);
+
+    lv_mem_tag_t tag_prev = mem_tag_act;
+    mem_tag_act = tag;
+    return tag_prev;
+}
+
+void lv_mem_get_stats(lv_mem_stats_t * stats)
+{
+    lv_mutex_lock(&mem_stats_lock);
+    *stats = mem_stats;
+    lv_mutex_unlock(&mem_stats_lock);
+}
+
+void lv_mem_reset_peaks(void)
+{
+    lv_mutex_lock(&mem_stats_lock);
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TAG_CNT; i++) {
+        mem_stats.tags[i].peak_size = mem_stats.tags[i].live_size;
+    }
+    lv_mutex_unlock(&mem_stats_lock);
+}
+
+void lv_mem_dump_stats(void)
+{
+    static const char * tag_names[] = {"other", "obj", "style", "event", "timer", "anim", "draw", "image", "font"};
+
+    /*Log a snapshot as the other threads might allocate meanwhile*/
+    lv_mem_stats_t stats;
+    lv_mem_get_stats(&stats);
+
+    LV_LOG_USER("tag       live bytes  peak bytes  live cnt  alloc cnt");
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TAG_CNT; i++) {
+        const lv_mem_tag_stats_t * t = &stats.tags[i];
+        if(t->alloc_cnt == 0) continue;
+        const char * name = i < sizeof(tag_names) / sizeof(tag_names[0]) ? tag_names[i] : "user";
+        LV_LOG_USER("%2d %-6s %10zu  %10zu  %8" LV_PRIu32 "  %9" LV_PRIu32, (int)i, name,
+                    t->live_size, t->peak_size, t->live_cnt, t->alloc_cnt);
+    }
+
+    LV_LOG_USER("size       alloc cnt");
+    for(i = 0; i < LV_MEM_SIZE_HIST_CNT; i++) {
+        if(i < LV_MEM_SIZE_HIST_CNT - 1) LV_LOG_USER("<= %6d  %9" LV_PRIu32, 16 << i, stats.size_hist[i]);
+        else LV_LOG_USER(" > %6d  %9" LV_PRIu32, 16 << (i - 1), stats.size_hist[i]);
+    }
+}
+
+#endif /*LV_USE_MEM_STATS*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_USE_MEM_STATS
+
+/**
+ * Save the size and tag of an allocation in its header and add it to the stats
+ * @param p     pointer to the header
+ * @param size  the requested size
+ * @param tag   the tag of the allocation
+ * @return      pointer to the memory after the header
+ */
+static void * mem_stats_add(void * p, size_t size, uint8_t tag)
+{
+    mem_header_t * header = p;
+    header->info.size = (uint32_t)size;
+    header->info.tag = tag;
+
+    uint32_t i = 0;
+    while(i < LV_MEM_SIZE_HIST_CNT - 1 && size > ((size_t)16 << i)) i++;
+
+    lv_mutex_lock(&mem_stats_lock);
+    lv_mem_tag_stats_t * t = &mem_stats.tags[tag];
+    t->live_size += size;
+    t->live_cnt++;
+    t->alloc_cnt++;
+    if(t->live_size > t->peak_size) t->peak_size = t->live_size;
+    mem_stats.size_hist[i]++;
+    lv_mutex_unlock(&mem_stats_lock);
+
+    return header + 1;
+}
+
+/**
+ * Remove an allocation from the stats
+ * @param p     pointer to the memory after the header
+ * @return      pointer to the header
+ */
+static void * mem_stats_remove(void * p)
+{
+    mem_header_t * header = (mem_header_t *)p - 1;
+
+    lv_mutex_lock(&mem_stats_lock);
+    lv_mem_tag_stats_t * t = &mem_stats.tags[header->info.tag];
+    t->live_size -= header->info.size;
+    t->live_cnt--;
+    lv_mutex_unlock(&mem_stats_lock);
+
+    return header;
+}
+
+#endif /*LV_USE_MEM_STATS*/
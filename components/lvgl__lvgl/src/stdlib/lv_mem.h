@@ -43,6 +43,46 @@ typedef struct {
     uint8_t frag_pct;   /**< Amount of fragmentation */
 } lv_mem_monitor_t;
 
+/**
+ * The modules the allocations are counted for.
+ * Set the tag of the next allocations with `lv_mem_set_tag()`.
+ */
+typedef enum {
+    LV_MEM_TAG_OTHER = 0,
+    LV_MEM_TAG_OBJ,
+    LV_MEM_TAG_STYLE,
+    LV_MEM_TAG_EVENT,
+    LV_MEM_TAG_TIMER,
+    LV_MEM_TAG_ANIM,
+    LV_MEM_TAG_DRAW,
+    LV_MEM_TAG_IMAGE,
+    LV_MEM_TAG_FONT,
+    LV_MEM_TAG_USER,    /**< The first tag for the application (up to `LV_MEM_TAG_CNT - 1`)*/
+} lv_mem_tag_t;
+
+#define LV_MEM_TAG_CNT          16
+
+/** The allocations are counted in size ranges of <= 16, <= 32, ... <= 8192 and > 8192 bytes*/
+#define LV_MEM_SIZE_HIST_CNT    11
+
+/**
+ * Allocation statistics of a tag
+ */
+typedef struct {
+    size_t live_size;       /**< Size of the currently allocated memory*/
+    size_t peak_size;       /**< Max of `live_size` since the start or `lv_mem_reset_peaks()`*/
+    uint32_t live_cnt;      /**< Number of currently allocated blocks*/
+    uint32_t alloc_cnt;     /**< Number of allocations so far*/
+} lv_mem_tag_stats_t;
+
+/**
+ * Allocation statistics of `lv_malloc` and friends
+ */
+typedef struct {
+    lv_mem_tag_stats_t tags[LV_MEM_TAG_CNT];
+    uint32_t size_hist[LV_MEM_SIZE_HIST_CNT];   /**< Number of allocations by requested size*/
+} lv_mem_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -155,10 +195,49 @@ lv_result_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+#if LV_USE_MEM_STATS
+
+/**
+ * Set the tag of the next allocations of the current thread
+ * @param tag       an `lv_mem_tag_t` value or `LV_MEM_TAG_USER + n`
+ * @return          the previous tag to restore it later
+ */
+lv_mem_tag_t lv_mem_set_tag(lv_mem_tag_t tag);
+
+/**
+ * Get the allocation statistics of each tag and the size histogram
+ * @param stats     pointer to a `lv_mem_stats_t` variable to store the result
+ */
+void lv_mem_get_stats(lv_mem_stats_t * stats);
+
+/**
+ * Set the peak sizes of the tags to their current live size
+ */
+void lv_mem_reset_peaks(void);
+
+/**
+ * Log the allocation statistics of each tag and the size histogram
+ */
+void lv_mem_dump_stats(void);
+
+#endif /*LV_USE_MEM_STATS*/
+
 /**********************
  *      MACROS
  **********************/
 
+/**
+ * Count the allocations of the current thread for `tag` until `LV_MEM_STATS_TAG_END(prev)`.
+ * `prev` is an `lv_mem_tag_t` variable of the caller to save the previous tag in.
+ */
+#if LV_USE_MEM_STATS
+    #define LV_MEM_STATS_TAG_BEGIN(tag, prev)   do { (prev) = lv_mem_set_tag(tag); } while(0)
+    #define LV_MEM_STATS_TAG_END(prev)          do { lv_mem_set_tag(prev); } while(0)
+#else
+    #define LV_MEM_STATS_TAG_BEGIN(tag, prev)   do { (prev) = (tag); } while(0)
+    #define LV_MEM_STATS_TAG_END(prev)          do { LV_UNUSED(prev); } while(0)
+#endif
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
@@ -28,6 +28,22 @@ extern "C" {
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_USE_MEM_STATS
+
+/**
+ * Initialize the lock of the allocation statistics.
+ * Called before `lv_mem_init()` as the memory core might allocate already.
+ */
+void lv_mem_stats_init(void);
+
+/**
+ * Delete the lock of the allocation statistics.
+ * Called after `lv_mem_deinit()`.
+ */
+void lv_mem_stats_deinit(void);
+
+#endif /*LV_USE_MEM_STATS*/
+
 /**********************
  *      MACROS
  **********************/
@@ -27,6 +27,13 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_IMAGE_DECODER_ASYNC
+enum {
+    ASYNC_STATE_IDLE,       /**< Not requested or decoded, the cache tells if it's ready*/
+    ASYNC_STATE_PENDING,    /**< Being decoded in the background*/
+    ASYNC_STATE_FAILED,     /**< Couldn't be decoded in the background, draw it as usual*/
+};
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -37,6 +44,12 @@ static void lv_image_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_image(lv_event_t * e);
 static void scale_update(lv_obj_t * obj, int32_t scale_x, int32_t scale_y);
 static void update_align(lv_obj_t * obj);
+#if LV_USE_IMAGE_DECODER_ASYNC
+    static bool async_decode_pending(lv_obj_t * obj);
+    static void async_cancel(lv_obj_t * obj);
+    static void async_decode_ready_cb(lv_result_t res, void * user_data);
+    static bool set_placeholder(lv_image_t * img, lv_draw_image_dsc_t * draw_dsc);
+#endif
 #if LV_USE_OBJ_PROPERTY
     static void lv_image_set_pivot_helper(lv_obj_t * obj, lv_point_t * pivot);
     static lv_point_t lv_image_get_pivot_helper(lv_obj_t * obj);
@@ -157,6 +170,10 @@ void lv_image_set_src(lv_obj_t * obj, const void * src)
     lv_image_src_t src_type = lv_image_src_get_type(src);
     lv_image_t * img = (lv_image_t *)obj;
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+    async_cancel(obj);
+#endif
+
 #if LV_USE_LOG && LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
     switch(src_type) {
         case LV_IMAGE_SRC_FILE:
@@ -467,6 +484,27 @@ void lv_image_set_bitmap_map_src(lv_obj_t * obj, const lv_image_dsc_t * src)
     lv_obj_invalidate(obj);
 }
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+void lv_image_set_decode_async(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_image_t * img = (lv_image_t *)obj;
+    if(img->decode_async == en) return;
+
+    if(!en) async_cancel(obj);
+    img->decode_async = en;
+    lv_obj_invalidate(obj);
+}
+
+void lv_image_set_placeholder(lv_obj_t * obj, const void * src)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_image_t * img = (lv_image_t *)obj;
+    img->placeholder_src = src;
+    lv_obj_invalidate(obj);
+}
+#endif
+
 /*=====================
  * Getter functions
  *====================*/
@@ -632,6 +670,35 @@ const lv_image_dsc_t * lv_image_get_bitmap_map_src(lv_obj_t * obj)
     return img->bitmap_mask_src;
 }
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+bool lv_image_get_decode_async(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_image_t * img = (lv_image_t *)obj;
+
+    return img->decode_async;
+}
+
+const void * lv_image_get_placeholder(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_image_t * img = (lv_image_t *)obj;
+
+    return img->placeholder_src;
+}
+
+bool lv_image_is_decode_pending(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_image_t * img = (lv_image_t *)obj;
+
+    return img->async_state == ASYNC_STATE_PENDING;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -666,6 +733,9 @@ static void lv_image_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 {
     LV_UNUSED(class_p);
     lv_image_t * img = (lv_image_t *)obj;
+#if LV_USE_IMAGE_DECODER_ASYNC
+    async_cancel(obj);
+#endif
     if(img->src_type == LV_IMAGE_SRC_FILE || img->src_type == LV_IMAGE_SRC_SYMBOL) {
         lv_free((void *)img->src);
         img->src      = NULL;
@@ -778,6 +848,14 @@ static void draw_image(lv_event_t * e)
             return;
         }
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+        /*Only the placeholder is drawn*/
+        if(async_decode_pending(obj)) {
+            info->res = LV_COVER_RES_NOT_COVER;
+            return;
+        }
+#endif
+
         /*With not LV_OPA_COVER images can't cover an area */
         if(lv_obj_get_style_image_opa(obj, LV_PART_MAIN) != LV_OPA_COVER) {
             info->res = LV_COVER_RES_NOT_COVER;
@@ -875,6 +953,16 @@ static void draw_image(lv_event_t * e)
                 coords = draw_dsc.image_area;
             }
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+            if(async_decode_pending(obj)) {
+                if(!draw_dsc.tile && set_placeholder(img, &draw_dsc)) {
+                    lv_draw_image(layer, &draw_dsc, &draw_dsc.image_area);
+                }
+                layer->_clip_area = clip_area_ori;
+                return;
+            }
+#endif
+
             lv_draw_image(layer, &draw_dsc, &coords);
             layer->_clip_area = clip_area_ori;
         }
@@ -993,6 +1081,81 @@ static void update_align(lv_obj_t * obj)
     }
 }
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+/**
+ * Check if the image needs to be decoded in the background and request it if not requested yet.
+ * @param obj   pointer to an image object
+ * @return      true: the image is not ready yet, draw the placeholder instead
+ */
+static bool async_decode_pending(lv_obj_t * obj)
+{
+    lv_image_t * img = (lv_image_t *)obj;
+    if(!img->decode_async || img->async_state == ASYNC_STATE_FAILED) return false;
+    if(img->src_type != LV_IMAGE_SRC_FILE && img->src_type != LV_IMAGE_SRC_VARIABLE) return false;
+    if(img->async_state == ASYNC_STATE_PENDING) return true;
+
+    /*Already decoded (or decoded again after it was evicted)*/
+    if(lv_image_cache_contains(img->src)) return false;
+
+    if(lv_image_decoder_decode_async(img->src, async_decode_ready_cb, obj) != LV_RESULT_OK) {
+        img->async_state = ASYNC_STATE_FAILED;
+        return false;
+    }
+
+    img->async_state = ASYNC_STATE_PENDING;
+    return true;
+}
+
+static void async_cancel(lv_obj_t * obj)
+{
+    lv_image_t * img = (lv_image_t *)obj;
+    if(img->async_state == ASYNC_STATE_PENDING) lv_image_decoder_cancel_async(obj);
+    img->async_state = ASYNC_STATE_IDLE;
+}
+
+static void async_decode_ready_cb(lv_result_t res, void * user_data)
+{
+    lv_obj_t * obj = user_data;
+    lv_image_t * img = (lv_image_t *)obj;
+
+    /*If it was decoded the cache has it, else fall back to decoding it while drawing*/
+    img->async_state = res == LV_RESULT_OK ? ASYNC_STATE_IDLE : ASYNC_STATE_FAILED;
+    lv_obj_invalidate(obj);
+}
+
+/**
+ * Replace the image with the placeholder in a draw descriptor.
+ * The placeholder is scaled to the area of the image and transformed the same way.
+ * @param img           pointer to an image object
+ * @param draw_dsc      draw descriptor of the image
+ * @return              true: the placeholder can be drawn
+ */
+static bool set_placeholder(lv_image_t * img, lv_draw_image_dsc_t * draw_dsc)
+{
+    if(img->placeholder_src == NULL) return false;
+
+    lv_image_header_t header;
+    if(lv_image_decoder_get_info(img->placeholder_src, &header) != LV_RESULT_OK) return false;
+    if(header.w == 0 || header.h == 0) return false;
+
+    draw_dsc->src = img->placeholder_src;
+    draw_dsc->bitmap_mask_src = NULL;
+    draw_dsc->scale_x = draw_dsc->scale_x * img->w / header.w;
+    draw_dsc->scale_y = draw_dsc->scale_y * img->h / header.h;
+
+    /*Keep the pivot at the same place on the screen*/
+    lv_point_t pivot = draw_dsc->pivot;
+    draw_dsc->pivot.x = pivot.x * header.w / img->w;
+    draw_dsc->pivot.y = pivot.y * header.h / img->h;
+    draw_dsc->image_area.x1 += pivot.x - draw_dsc->pivot.x;
+    draw_dsc->image_area.y1 += pivot.y - draw_dsc->pivot.y;
+    draw_dsc->image_area.x2 = draw_dsc->image_area.x1 + header.w - 1;
+    draw_dsc->image_area.y2 = draw_dsc->image_area.y1 + header.h - 1;
+
+    return true;
+}
+#endif
+
 #if LV_USE_OBJ_PROPERTY
 static void lv_image_set_pivot_helper(lv_obj_t * obj, lv_point_t * pivot)
 {
@@ -205,6 +205,26 @@ void lv_image_set_inner_align(lv_obj_t * obj, lv_image_align_t align);
  */
 void lv_image_set_bitmap_map_src(lv_obj_t * obj, const lv_image_dsc_t * src);
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+/**
+ * Decode the image on a background thread instead of while drawing it.
+ * Until it's decoded the placeholder is drawn.
+ * @param obj       pointer to an image object
+ * @param en        true: decode in the background; false: decode while drawing
+ * @note            it's useful only with the image cache as the decoded image is passed in the cache
+ */
+void lv_image_set_decode_async(lv_obj_t * obj, bool en);
+
+/**
+ * Set an image to draw while the image is decoded in the background.
+ * It's scaled to the size of the image. Typically a small, quick to decode image.
+ * @param obj       pointer to an image object
+ * @param src       an image source like in `lv_image_set_src`. Only the pointer is saved.
+ *                  NULL to draw nothing until the image is ready.
+ */
+void lv_image_set_placeholder(lv_obj_t * obj, const void * src);
+#endif
+
 /*=====================
  * Getter functions
  *====================*/
@@ -324,6 +344,29 @@ lv_image_align_t lv_image_get_inner_align(lv_obj_t * obj);
  */
 const lv_image_dsc_t * lv_image_get_bitmap_map_src(lv_obj_t * obj);
 
+#if LV_USE_IMAGE_DECODER_ASYNC
+/**
+ * Get whether the image is decoded in the background.
+ * @param obj       pointer to an image object
+ * @return          true: decoded in the background
+ */
+bool lv_image_get_decode_async(lv_obj_t * obj);
+
+/**
+ * Get the placeholder image source.
+ * @param obj       pointer to an image object
+ * @return          the placeholder image source
+ */
+const void * lv_image_get_placeholder(lv_obj_t * obj);
+
+/**
+ * Check if the image is being decoded in the background and the placeholder is drawn instead.
+ * @param obj       pointer to an image object
+ * @return          true: the image is not ready yet
+ */
+bool lv_image_is_decode_pending(lv_obj_t * obj);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -46,6 +46,11 @@ struct _lv_image_t {
     uint32_t antialias : 1; /**< Apply anti-aliasing in transformations (rotate, zoom)*/
     uint32_t align: 4;      /**< Image size mode when image size and object size is different. See lv_image_align_t*/
     uint32_t blend_mode: 4; /**< Element of `lv_blend_mode_t`*/
+#if LV_USE_IMAGE_DECODER_ASYNC
+    const void * placeholder_src;   /**< Drawn instead of the image while it's decoded in the background*/
+    uint32_t decode_async : 1;      /**< Decode the image on the background worker*/
+    uint32_t async_state : 2;       /**< 0: not requested, 1: pending, 2: decoded or failed*/
+#endif
 };
 
 /**********************
@@ -727,6 +727,10 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->hint.y          = 0;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_memzero(&label->lines, sizeof(label->lines));
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     label->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     label->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -746,6 +750,10 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     if(!label->static_txt) lv_free(label->text);
     label->text = NULL;
+
+#if LV_LABEL_LINE_CACHE
+    lv_draw_label_lines_free(&label->lines);
+#endif
 }
 
 static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -870,6 +878,15 @@ static void draw_main(lv_event_t * e)
         return;
     }
 
+#if LV_LABEL_LINE_CACHE
+    /*Wrap the text only once and not on every draw*/
+    int32_t lines_w = lv_draw_label_get_lines_width(&label_draw_dsc, &txt_coords);
+    if(!lv_draw_label_lines_is_valid(&label->lines, &label_draw_dsc, lines_w)) {
+        lv_draw_label_lines_update(&label->lines, &label_draw_dsc, lines_w);
+    }
+    label_draw_dsc.lines = &label->lines;
+#endif
+
     if(label->long_mode == LV_LABEL_LONG_MODE_WRAP) {
         int32_t s = lv_obj_get_scroll_top(obj);
         lv_area_move(&txt_coords, 0, -s);
@@ -949,6 +966,9 @@ static void lv_label_refr_text(lv_obj_t * obj)
     if(label->text == NULL) return;
 #if LV_LABEL_LONG_TXT_HINT
     label->hint.line_start = -1; /*The hint is invalid if the text changes*/
+#endif
+#if LV_LABEL_LINE_CACHE
+    lv_draw_label_lines_invalidate(&label->lines); /*The text or the style changed, wrap the text again when drawn*/
 #endif
     label->invalid_size_cache = true;
 
@@ -967,6 +987,12 @@ static void lv_label_refr_text(lv_obj_t * obj)
     lv_text_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
     label->text_size = size;
 
+#if LV_LABEL_LINE_CACHE
+    /*Allocate the lines now instead of in the middle of a rendering*/
+    int32_t line_h = lv_font_get_line_height(font) + line_space;
+    if(line_h > 0) lv_draw_label_lines_reserve(&label->lines, (size.y + line_space) / line_h);
+#endif
+
     lv_obj_refresh_self_size(obj);
 
     /*In scroll mode start an offset animation*/
@@ -23,6 +23,13 @@ extern "C" {
 #define LV_USE_OS                   LV_OS_PTHREAD
 #define LV_OBJ_STYLE_CACHE          0
 #define LV_BIN_DECODER_RAM_LOAD     1   /* Run test with bin image loaded to RAM */
+#define LV_USE_IMAGE_DECODER_ASYNC  1
+#define LV_DRAW_SW_DRAW_UNIT_CNT    4
+#define LV_DRAW_SW_WORK_STEALING    1
+#define LV_USE_MEM_STATS            1
+#if defined(__AVX2__)
+#define LV_USE_DRAW_SW_ASM          LV_DRAW_SW_ASM_AVX2   /* Run the render tests on the AVX2 blend backend */
+#endif
 #endif
 
 #ifdef LVGL_CI_USING_DEF_HEAP
@@ -30,7 +37,19 @@ extern "C" {
 #define LV_USE_STDLIB_STRING    LV_STDLIB_BUILTIN
 #define LV_USE_STDLIB_SPRINTF   LV_STDLIB_BUILTIN
 #define LV_OBJ_STYLE_CACHE      1
+#define LV_OBJ_STYLE_VALUE_CACHE_CNT    32
+#define LV_STYLE_SORTED_PROPS   1
+#define LV_TIMER_DEADLINE_HEAP  1
+#define LV_ANIM_HASH_INDEX      1
+#define LV_USE_OBJ_POOL         1
+#define LV_LABEL_LINE_CACHE     1
+#define LV_LAYOUT_MEASURE_CACHE 1
+#define LV_FONT_FMT_TXT_CACHE_SIZE  (32 * 1024)
+#define LV_FONT_FMT_TXT_LOOKUP_TABLE    1
 #define LV_BIN_DECODER_RAM_LOAD 0
+#if defined(__SSE2__)
+#define LV_USE_DRAW_SW_ASM      LV_DRAW_SW_ASM_SSE2   /* Run the render tests on the x86 blend backend too */
+#endif
 #endif
 
 #ifdef MICROPYTHON
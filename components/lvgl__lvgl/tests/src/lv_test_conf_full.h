@@ -71,10 +71,12 @@
 #define LV_FS_MEMFS_LETTER  'M'
 
 #define LV_FS_DEFAULT_DRIVER_LETTER 'A'
+#define LV_FS_CACHE_BLOCK_CNT   4
 
 #define LV_USE_MONKEY       1
 #define LV_USE_RLE          1
 #define LV_USE_LODEPNG      1
+#define LV_LODEPNG_BAND_HEIGHT  16
 #define LV_USE_LIBPNG       1
 #define LV_USE_BMP          1
 #define LV_USE_TJPGD        1
@@ -136,6 +138,8 @@
 #define LV_USE_OBJ_NAME         1
 
 #define LV_CACHE_DEF_SIZE       (10 * 1024 * 1024)
+#define LV_IMAGE_CACHE_COST_AWARE   1
+#define LV_IMAGE_DECODER_CONVERT_NATIVE 1
 
 #ifndef LV_USE_LINUX_DRM
     #define LV_USE_LINUX_DRM    1
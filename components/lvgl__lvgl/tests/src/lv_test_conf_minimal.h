@@ -2,6 +2,8 @@
 #define LV_TEST_CONF_MINIMAL_H
 
 #define  LV_MEM_SIZE        65535
+#define  LV_MEM_SIZE_CLASS_CACHE_CNT    8
+#define  LV_USE_MEM_STATS               1
 #define  LV_USE_LOG         1
 #define  LV_USE_ASSERT_NULL             0
 #define  LV_USE_ASSERT_MALLOC           0
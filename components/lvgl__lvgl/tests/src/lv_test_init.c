@@ -1,8 +1,16 @@
 #if LV_BUILD_TEST
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include "lv_test_init.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 #include "../unity/unity.h"
 
 #define HOR_RES 800
@@ -21,6 +29,11 @@ void lv_test_init(void)
     lv_profiler_builtin_set_enable(false);
 #endif
 
+#if LV_IMAGE_DECODER_CONVERT_NATIVE
+    /* Keep the color format of the images, so the reference images don't depend on it */
+    lv_image_decoder_set_convert_native(false);
+#endif
+
     lv_test_display_create(HOR_RES, VER_RES);
     lv_test_indev_create_all();
 
@@ -43,6 +56,21 @@ void lv_test_deinit(void)
     lv_mem_deinit();
 }
 
+uint64_t lv_test_get_time_us(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq;
+    LARGE_INTEGER cnt;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&cnt);
+    return (uint64_t)(cnt.QuadPart * 1000000 / freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+#endif
+}
+
 static void test_log_print_cb(lv_log_level_t level, const char * buf)
 {
     if(level < LV_LOG_LEVEL_WARN) {
@@ -12,6 +12,13 @@ extern "C" {
 void lv_test_init(void);
 void lv_test_deinit(void);
 
+/**
+ * Get a monotonic wall clock time for benchmarks.
+ * `lv_tick_get()` can't be used as the tests advance the tick manually.
+ * @return  the elapsed time since an arbitrary point in microseconds
+ */
+uint64_t lv_test_get_time_us(void);
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
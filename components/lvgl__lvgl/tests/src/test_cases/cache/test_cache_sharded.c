@@ -0,0 +1,306 @@
+#if LV_BUILD_TEST
+
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_init.h"
+
+#include "unity/unity.h"
+
+#define KEY_CNT             64
+#define SHARD_CNT           4
+
+typedef struct {
+    lv_cache_slot_size_t slot;
+    uint32_t key;
+} test_node_t;
+
+static uint32_t mem_size;
+
+static lv_cache_compare_res_t compare_cb(const test_node_t * lhs, const test_node_t * rhs)
+{
+    if(lhs->key != rhs->key) return lhs->key > rhs->key ? 1 : -1;
+    return 0;
+}
+
+static void free_cb(test_node_t * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+}
+
+static uint32_t hash_cb(const test_node_t * node)
+{
+    return node->key * 2654435761u;
+}
+
+static lv_cache_t * cache_create(uint32_t max_cnt, uint32_t shard_cnt)
+{
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t)free_cb,
+        .hash_cb = (lv_cache_hash_cb_t)hash_cb,
+    };
+
+    return lv_cache_create_sharded(&lv_cache_class_lru_rb_count, sizeof(test_node_t), max_cnt, ops, shard_cnt);
+}
+
+static void cache_fill(lv_cache_t * cache, uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        test_node_t search_key = {.key = i};
+        lv_cache_entry_t * entry = lv_cache_add(cache, &search_key, NULL);
+        TEST_ASSERT_NOT_NULL(entry);
+        lv_cache_release(cache, entry, NULL);
+    }
+}
+
+void setUp(void)
+{
+    mem_size = lv_test_get_free_mem();
+}
+
+void tearDown(void)
+{
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_size, 32);
+}
+
+void test_cache_sharded_basic(void)
+{
+    lv_cache_t * cache = cache_create(KEY_CNT * 2, SHARD_CNT);
+    TEST_ASSERT_NOT_NULL(cache);
+    TEST_ASSERT_EQUAL(KEY_CNT * 2, lv_cache_get_max_size(cache, NULL));
+
+    cache_fill(cache, KEY_CNT);
+    TEST_ASSERT_EQUAL(KEY_CNT, lv_cache_get_size(cache, NULL));
+
+    uint32_t i;
+    for(i = 0; i < KEY_CNT; i++) {
+        test_node_t search_key = {.key = i};
+        lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
+        TEST_ASSERT_NOT_NULL(entry);
+        TEST_ASSERT_EQUAL(i, ((test_node_t *)lv_cache_entry_get_data(entry))->key);
+        lv_cache_release(cache, entry, NULL);
+    }
+
+    /*The iterator walks all the shards*/
+    lv_iter_t * iter = lv_cache_iter_create(cache);
+    TEST_ASSERT_NOT_NULL(iter);
+    uint32_t cnt = 0;
+    void * elem = lv_malloc(lv_cache_entry_get_size(sizeof(test_node_t)));
+    while(lv_iter_next(iter, elem) == LV_RESULT_OK) cnt++;
+    lv_free(elem);
+    lv_iter_destroy(iter);
+    TEST_ASSERT_EQUAL(KEY_CNT, cnt);
+
+    test_node_t search_key = {.key = 5};
+    lv_cache_drop(cache, &search_key, NULL);
+    TEST_ASSERT_NULL(lv_cache_acquire(cache, &search_key, NULL));
+    TEST_ASSERT_EQUAL(KEY_CNT - 1, lv_cache_get_size(cache, NULL));
+
+    lv_cache_drop_all(cache, NULL);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(cache, NULL));
+
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_sharded_evict(void)
+{
+    lv_cache_t * cache = cache_create(KEY_CNT, SHARD_CNT);
+
+    /*Each shard evicts on its own, so the total size stays below the limit*/
+    cache_fill(cache, KEY_CNT * 4);
+    TEST_ASSERT_LESS_OR_EQUAL(KEY_CNT, lv_cache_get_size(cache, NULL));
+
+    /*The most recent key is always kept*/
+    test_node_t search_key = {.key = KEY_CNT * 4 - 1};
+    lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
+    TEST_ASSERT_NOT_NULL(entry);
+    lv_cache_release(cache, entry, NULL);
+
+    /*Shrink and evict now*/
+    lv_cache_set_max_size(cache, KEY_CNT / 2, NULL);
+    lv_cache_reserve(cache, 0, NULL);
+    TEST_ASSERT_LESS_OR_EQUAL(KEY_CNT / 2, lv_cache_get_size(cache, NULL));
+
+    while(lv_cache_evict_one(cache, NULL));
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(cache, NULL));
+
+    lv_cache_destroy(cache, NULL);
+}
+
+void test_cache_sharded_single(void)
+{
+    /*With one shard it's a normal cache*/
+    lv_cache_t * cache = cache_create(KEY_CNT, 1);
+    cache_fill(cache, KEY_CNT);
+    TEST_ASSERT_EQUAL(KEY_CNT, lv_cache_get_size(cache, NULL));
+    lv_cache_destroy(cache, NULL);
+}
+
+#if LV_USE_OS == LV_OS_PTHREAD
+
+#include <pthread.h>
+
+#define BENCH_LOOKUP_CNT    200000
+#define BENCH_THREAD_MAX    8
+
+typedef struct {
+    lv_cache_t * cache;
+    uint32_t seed;
+    uint32_t hit_cnt;
+} bench_thread_t;
+
+static void * bench_thread_cb(void * arg)
+{
+    bench_thread_t * t = arg;
+    uint32_t rnd = t->seed;
+    uint32_t i;
+    for(i = 0; i < BENCH_LOOKUP_CNT; i++) {
+        rnd = rnd * 1103515245 + 12345;
+        test_node_t search_key = {.key = (rnd >> 16) % KEY_CNT};
+        lv_cache_entry_t * entry = lv_cache_acquire(t->cache, &search_key, NULL);
+        if(entry) {
+            t->hit_cnt++;
+            lv_cache_release(t->cache, entry, NULL);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Look up the keys of a cache from several threads at the same time
+ * @param shard_cnt     number of shards of the cache
+ * @param thread_cnt    number of threads
+ * @return              lookups per second
+ */
+static uint32_t bench(uint32_t shard_cnt, uint32_t thread_cnt)
+{
+    lv_cache_t * cache = cache_create(KEY_CNT * 2, shard_cnt);
+    cache_fill(cache, KEY_CNT);
+
+    pthread_t threads[BENCH_THREAD_MAX];
+    bench_thread_t data[BENCH_THREAD_MAX];
+    uint64_t t_start = lv_test_get_time_us();
+    uint32_t i;
+    for(i = 0; i < thread_cnt; i++) {
+        data[i].cache = cache;
+        data[i].seed = i + 1;
+        data[i].hit_cnt = 0;
+        pthread_create(&threads[i], NULL, bench_thread_cb, &data[i]);
+    }
+
+    for(i = 0; i < thread_cnt; i++) {
+        pthread_join(threads[i], NULL);
+        TEST_ASSERT_EQUAL(BENCH_LOOKUP_CNT, data[i].hit_cnt);
+    }
+
+    uint64_t t_elaps = lv_test_get_time_us() - t_start;
+    lv_cache_destroy(cache, NULL);
+
+    return (uint32_t)((uint64_t)BENCH_LOOKUP_CNT * thread_cnt * 1000000 / LV_MAX(t_elaps, 1));
+}
+
+void test_cache_sharded_bench(void)
+{
+    uint32_t thread_cnt;
+    for(thread_cnt = 1; thread_cnt <= BENCH_THREAD_MAX; thread_cnt *= 2) {
+        uint32_t single = bench(1, thread_cnt);
+        uint32_t sharded = bench(BENCH_THREAD_MAX * 2, thread_cnt);
+        TEST_PRINTF("%d threads: %d lookups/s with one lock, %d lookups/s with %d shards",
+                    (int)thread_cnt, (int)single, (int)sharded, BENCH_THREAD_MAX * 2);
+    }
+}
+
+#define CLAIM_THREAD_CNT    4
+#define CLAIM_KEY_CNT       8
+
+typedef struct {
+    lv_cache_t * cache;
+    pthread_mutex_t * lock;
+    uint32_t * create_cnt;
+} claim_thread_t;
+
+static void * claim_thread_cb(void * arg)
+{
+    claim_thread_t * t = arg;
+    uint32_t i;
+    for(i = 0; i < CLAIM_KEY_CNT; i++) {
+        test_node_t search_key = {.key = i};
+        bool claimed;
+        lv_cache_entry_t * entry = lv_cache_acquire_or_claim(t->cache, &search_key, &claimed, NULL);
+        if(claimed) {
+            /*Create the data slowly to let the other threads find the claim*/
+            pthread_mutex_lock(t->lock);
+            t->create_cnt[i]++;
+            pthread_mutex_unlock(t->lock);
+            lv_sleep_ms(5);
+            entry = lv_cache_add(t->cache, &search_key, NULL);
+            lv_cache_unclaim(t->cache, &search_key);
+        }
+
+        TEST_ASSERT_NOT_NULL(entry);
+        lv_cache_release(t->cache, entry, NULL);
+    }
+
+    return NULL;
+}
+
+void test_cache_sharded_claim(void)
+{
+    lv_cache_t * cache = cache_create(KEY_CNT, SHARD_CNT);
+    pthread_mutex_t lock;
+    pthread_mutex_init(&lock, NULL);
+    uint32_t create_cnt[CLAIM_KEY_CNT] = {0};
+
+    pthread_t threads[CLAIM_THREAD_CNT];
+    claim_thread_t data[CLAIM_THREAD_CNT];
+    uint32_t i;
+    for(i = 0; i < CLAIM_THREAD_CNT; i++) {
+        data[i].cache = cache;
+        data[i].lock = &lock;
+        data[i].create_cnt = create_cnt;
+        pthread_create(&threads[i], NULL, claim_thread_cb, &data[i]);
+    }
+
+    for(i = 0; i < CLAIM_THREAD_CNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    /*Each key was created once and added once*/
+    for(i = 0; i < CLAIM_KEY_CNT; i++) {
+        TEST_ASSERT_EQUAL(1, create_cnt[i]);
+    }
+    TEST_ASSERT_EQUAL(CLAIM_KEY_CNT, lv_cache_get_size(cache, NULL));
+
+    /*A claimed key doesn't block the others*/
+    test_node_t key_a = {.key = CLAIM_KEY_CNT};
+    test_node_t key_b = {.key = CLAIM_KEY_CNT + 1};
+    bool claimed_a;
+    bool claimed_b;
+    TEST_ASSERT_NULL(lv_cache_acquire_or_claim(cache, &key_a, &claimed_a, NULL));
+    TEST_ASSERT_NULL(lv_cache_acquire_or_claim(cache, &key_b, &claimed_b, NULL));
+    TEST_ASSERT_TRUE(claimed_a);
+    TEST_ASSERT_TRUE(claimed_b);
+    lv_cache_unclaim(cache, &key_b);
+    lv_cache_unclaim(cache, &key_a);
+
+    pthread_mutex_destroy(&lock);
+    lv_cache_destroy(cache, NULL);
+}
+
+#else
+
+void test_cache_sharded_bench(void)
+{
+}
+
+void test_cache_sharded_claim(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,277 @@
+#if LV_BUILD_TEST
+
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+/*A trace of image accesses like a UI with icons, backgrounds and photos shown once*/
+#define TRACE_LEN           2000
+#define ICON_CNT            6
+#define BG_CNT              3
+#define PHOTO_CNT           64      /*Used round-robin, so they are not seen again for a long time*/
+#define IMAGE_CNT           (ICON_CNT + BG_CNT + PHOTO_CNT)
+#define CACHE_SIZE          (400 * 1024)
+
+typedef struct {
+    lv_image_dsc_t dsc;     /*First to be a valid variable image source*/
+    uint32_t cost;          /*Decoding time in ms*/
+} sim_image_t;
+
+typedef struct {
+    lv_cache_slot_cost_t slot;
+    uint32_t id;
+} sim_node_t;
+
+typedef struct {
+    uint32_t hit_cnt;
+    uint32_t decode_time;
+} sim_result_t;
+
+static sim_image_t images[IMAGE_CNT];
+static uint32_t trace[TRACE_LEN];
+static lv_image_decoder_t * decoder;
+static uint32_t decode_time;
+static uint32_t cache_size_ori;
+
+static void image_init(sim_image_t * img, uint32_t w, uint32_t h, uint32_t cost)
+{
+    img->dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    img->dsc.header.cf = LV_COLOR_FORMAT_ARGB8888;
+    img->dsc.header.w = w;
+    img->dsc.header.h = h;
+    img->dsc.header.stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_ARGB8888);
+    img->dsc.data_size = img->dsc.header.stride * h;
+    img->dsc.data = (const uint8_t *)img;  /*Not used, but it can't be NULL*/
+    img->cost = cost;
+}
+
+static void trace_init(void)
+{
+    uint32_t i;
+    /*Small but slow to decode, e.g. PNG icons*/
+    for(i = 0; i < ICON_CNT; i++) image_init(&images[i], 64, 64, 30);
+    /*Large and quick to open, e.g. uncompressed backgrounds*/
+    for(i = ICON_CNT; i < ICON_CNT + BG_CNT; i++) image_init(&images[i], 200, 160, 2);
+    /*Large and slow to decode, e.g. JPG photos*/
+    for(i = ICON_CNT + BG_CNT; i < IMAGE_CNT; i++) image_init(&images[i], 240, 200, 15);
+
+    uint32_t rnd = 12345;
+    uint32_t photo = 0;
+    for(i = 0; i < TRACE_LEN; i++) {
+        rnd = rnd * 1103515245 + 12345;
+        uint32_t r = (rnd >> 16) % 100;
+        if(r < 60) trace[i] = (rnd >> 8) % ICON_CNT;
+        else if(r < 90) trace[i] = ICON_CNT + (rnd >> 8) % BG_CNT;
+        else trace[i] = ICON_CNT + BG_CNT + (photo++ % PHOTO_CNT);
+    }
+}
+
+static sim_image_t * get_sim_image(const void * src)
+{
+    if((const sim_image_t *)src < images || (const sim_image_t *)src >= images + IMAGE_CNT) return NULL;
+    return (sim_image_t *)src;
+}
+
+static lv_result_t decoder_info(lv_image_decoder_t * dec, lv_image_decoder_dsc_t * dsc, lv_image_header_t * header)
+{
+    LV_UNUSED(dec);
+    sim_image_t * img = get_sim_image(dsc->src);
+    if(img == NULL) return LV_RESULT_INVALID;
+
+    *header = img->dsc.header;
+    return LV_RESULT_OK;
+}
+
+static lv_result_t decoder_open(lv_image_decoder_t * dec, lv_image_decoder_dsc_t * dsc)
+{
+    sim_image_t * img = get_sim_image(dsc->src);
+
+    /*"Decode" it, the image decoder measures the time*/
+    lv_tick_inc(img->cost);
+    decode_time += img->cost;
+
+    lv_draw_buf_t * decoded = lv_draw_buf_create(img->dsc.header.w, img->dsc.header.h, img->dsc.header.cf, 0);
+    if(decoded == NULL) return LV_RESULT_INVALID;
+    dsc->decoded = decoded;
+
+    if(dsc->args.no_cache || !lv_image_cache_is_enabled()) return LV_RESULT_OK;
+
+    lv_image_cache_data_t search_key;
+    search_key.src_type = dsc->src_type;
+    search_key.src = dsc->src;
+    search_key.slot.size = decoded->data_size;
+
+    lv_cache_entry_t * entry = lv_image_decoder_add_to_cache(dec, &search_key, decoded, NULL);
+    if(entry == NULL) {
+        lv_draw_buf_destroy(decoded);
+        return LV_RESULT_INVALID;
+    }
+    dsc->cache_entry = entry;
+
+    return LV_RESULT_OK;
+}
+
+static void decoder_close(lv_image_decoder_t * dec, lv_image_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    if(dsc->args.no_cache || !lv_image_cache_is_enabled()) lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
+}
+
+static lv_cache_compare_res_t sim_compare_cb(const sim_node_t * lhs, const sim_node_t * rhs)
+{
+    if(lhs->id != rhs->id) return lhs->id > rhs->id ? 1 : -1;
+    return 0;
+}
+
+static void sim_free_cb(sim_node_t * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+}
+
+void setUp(void)
+{
+    trace_init();
+
+    decoder = lv_image_decoder_create();
+    decoder->name = "SIM";
+    lv_image_decoder_set_info_cb(decoder, decoder_info);
+    lv_image_decoder_set_open_cb(decoder, decoder_open);
+    lv_image_decoder_set_close_cb(decoder, decoder_close);
+
+    cache_size_ori = lv_cache_get_max_size(LV_GLOBAL_DEFAULT()->img_cache, NULL);
+    lv_image_cache_drop(NULL);
+    lv_image_cache_resize(CACHE_SIZE, true);
+}
+
+void tearDown(void)
+{
+    lv_image_cache_set_admission(LV_IMAGE_CACHE_ADMIT_PCT);
+    lv_image_cache_drop(NULL);
+    lv_image_cache_resize(cache_size_ori, true);
+    lv_image_decoder_delete(decoder);
+}
+
+/**
+ * Replay the trace on a cache with the given eviction class
+ * @param cache_class   the cache class to test
+ * @return              number of hits and the time spent with decoding the misses
+ */
+static sim_result_t simulate_class(const lv_cache_class_t * cache_class)
+{
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)sim_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t)sim_free_cb,
+    };
+    lv_cache_t * cache = lv_cache_create(cache_class, sizeof(sim_node_t), CACHE_SIZE, ops);
+    TEST_ASSERT_NOT_NULL(cache);
+
+    sim_result_t res = {0};
+    uint32_t i;
+    for(i = 0; i < TRACE_LEN; i++) {
+        sim_image_t * img = &images[trace[i]];
+        sim_node_t search_key;
+        search_key.id = trace[i];
+        search_key.slot.size = img->dsc.data_size;
+        search_key.slot.cost = img->cost;
+
+        lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
+        if(entry) {
+            res.hit_cnt++;
+        }
+        else {
+            res.decode_time += img->cost;
+            entry = lv_cache_add(cache, &search_key, NULL);
+            TEST_ASSERT_NOT_NULL(entry);
+        }
+        lv_cache_release(cache, entry, NULL);
+    }
+
+    lv_cache_destroy(cache, NULL);
+    return res;
+}
+
+/**
+ * Replay the trace through the image decoder and the image cache
+ * @return      number of hits and the time spent with decoding
+ */
+static sim_result_t simulate_image_cache(void)
+{
+    lv_image_cache_drop(NULL);
+    decode_time = 0;
+
+    sim_result_t res = {0};
+    uint32_t i;
+    for(i = 0; i < TRACE_LEN; i++) {
+        uint32_t decode_time_prev = decode_time;
+        lv_image_decoder_dsc_t dsc;
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, &images[trace[i]], NULL));
+        lv_image_decoder_close(&dsc);
+
+        if(decode_time == decode_time_prev) res.hit_cnt++;
+    }
+
+    res.decode_time = decode_time;
+    return res;
+}
+
+void test_image_cache_policy_gds(void)
+{
+    sim_result_t lru = simulate_class(&lv_cache_class_lru_rb_size);
+    sim_result_t gds = simulate_class(&lv_cache_class_gds_rb_size);
+
+    TEST_PRINTF("LRU: %d%% hit rate, %d ms decoding", (int)(lru.hit_cnt * 100 / TRACE_LEN), (int)lru.decode_time);
+    TEST_PRINTF("GDS: %d%% hit rate, %d ms decoding", (int)(gds.hit_cnt * 100 / TRACE_LEN), (int)gds.decode_time);
+
+    /*The icons are kept even if the large images are used often*/
+    TEST_ASSERT_LESS_THAN(lru.decode_time, gds.decode_time);
+}
+
+void test_image_cache_policy_admission(void)
+{
+    sim_result_t all = simulate_image_cache();
+
+    /*The photos are larger than 25%*/
+    lv_image_cache_set_admission(25);
+    sim_result_t admit = simulate_image_cache();
+
+    TEST_PRINTF("cache all: %d%% hit rate, %d ms decoding", (int)(all.hit_cnt * 100 / TRACE_LEN), (int)all.decode_time);
+    TEST_PRINTF("admission: %d%% hit rate, %d ms decoding", (int)(admit.hit_cnt * 100 / TRACE_LEN),
+                (int)admit.decode_time);
+
+    TEST_ASSERT_LESS_THAN(all.decode_time, admit.decode_time);
+
+    /*A photo is not cached the first time, but the second time*/
+    lv_image_cache_drop(NULL);
+    const void * photo = &images[ICON_CNT + BG_CNT];
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, photo, NULL));
+    lv_image_decoder_close(&dsc);
+    TEST_ASSERT_FALSE(lv_image_cache_contains(photo));
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, photo, NULL));
+    lv_image_decoder_close(&dsc);
+    TEST_ASSERT_TRUE(lv_image_cache_contains(photo));
+}
+
+void test_image_cache_policy_cost(void)
+{
+    /*The decoding time is measured and the hits are counted*/
+    lv_image_decoder_dsc_t dsc;
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, &images[0], NULL));
+        TEST_ASSERT_NOT_NULL(dsc.cache_entry);
+
+        lv_image_cache_data_t * data = lv_cache_entry_get_data(dsc.cache_entry);
+        TEST_ASSERT_EQUAL(images[0].cost, data->slot.cost);
+        TEST_ASSERT_EQUAL(i, lv_cache_entry_get_hit_cnt(dsc.cache_entry));
+        lv_image_decoder_close(&dsc);
+    }
+
+    lv_image_cache_dump();
+}
+
+#endif
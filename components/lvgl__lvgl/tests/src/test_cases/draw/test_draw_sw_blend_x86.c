@@ -0,0 +1,386 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_init.h"
+
+#include "unity/unity.h"
+
+#include "blend_ref/lv_test_blend_ref.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+    #define BLEND_X86   1
+#else
+    #define BLEND_X86   0
+#endif
+
+#define CASE_CNT        2000
+#define MAX_W           67      /*Not a multiple of any vector width to test the tails too*/
+#define MAX_H           4
+#define MAX_OFS         7       /*Start the buffers at different pixels to test the alignments too*/
+#define MAX_PAD         9       /*Extra pixels at the end of the lines*/
+#define BUF_SIZE        ((MAX_OFS + (MAX_W + MAX_PAD) * MAX_H) * 4)
+
+#define BENCH_W         800
+#define BENCH_H         480
+#define BENCH_ROUND_CNT 10
+
+typedef enum {
+    DEST_RGB565,
+    DEST_ARGB8888,
+    DEST_XRGB8888,
+    DEST_RGB888,
+} dest_t;
+
+typedef struct {
+    dest_t dest;
+    uint32_t dest_px_size;
+    int32_t w;
+    int32_t h;
+    int32_t dest_ofs;
+    int32_t dest_stride;
+    lv_color_format_t src_cf;
+    int32_t src_ofs;
+    int32_t src_stride;
+    int32_t mask_stride;
+    bool has_mask;
+    lv_opa_t opa;
+    lv_color_t color;
+} blend_case_t;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_rand_set_seed(0x27);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+#if BLEND_X86
+
+static uint8_t dest_act[BUF_SIZE];
+static uint8_t dest_ref[BUF_SIZE];
+static uint8_t src_buf[BUF_SIZE];
+static lv_opa_t mask_buf[BUF_SIZE];
+
+static uint8_t bench_dest[BENCH_W * BENCH_H * 4];
+static uint8_t bench_src[BENCH_W * BENCH_H * 4];
+static lv_opa_t bench_mask[BENCH_W * BENCH_H];
+
+static uint32_t dest_px_size_get(dest_t dest)
+{
+    switch(dest) {
+        case DEST_RGB565:
+            return 2;
+        case DEST_RGB888:
+            return 3;
+        default:
+            return 4;
+    }
+}
+
+/*Mostly the special values as the kernels handle them separately*/
+static lv_opa_t rnd_opa(void)
+{
+    static const lv_opa_t opa_special[] = {LV_OPA_TRANSP, 1, LV_OPA_50, LV_OPA_MAX - 1, LV_OPA_MAX, LV_OPA_COVER};
+    if(lv_rand(0, 1)) return opa_special[lv_rand(0, sizeof(opa_special) - 1)];
+    return (lv_opa_t)lv_rand(0, 255);
+}
+
+static void rnd_fill(uint8_t * buf, uint32_t size, bool opa_like)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) buf[i] = opa_like ? rnd_opa() : (uint8_t)lv_rand(0, 255);
+}
+
+static void rnd_case(blend_case_t * c, dest_t dest, bool image)
+{
+    static const lv_color_format_t src_cfs[] = {LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB888,
+                                                LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_ARGB8888
+                                               };
+
+    c->dest = dest;
+    c->dest_px_size = dest_px_size_get(dest);
+    c->w = (int32_t)lv_rand(1, MAX_W);
+    c->h = (int32_t)lv_rand(1, MAX_H);
+    c->dest_ofs = (int32_t)(lv_rand(0, MAX_OFS) * c->dest_px_size);
+    c->dest_stride = (int32_t)((c->w + lv_rand(0, MAX_PAD)) * c->dest_px_size);
+    c->has_mask = lv_rand(0, 1);
+    c->mask_stride = c->w + (int32_t)lv_rand(0, MAX_PAD);
+    c->opa = rnd_opa();
+    c->color = lv_color_hex(lv_rand(0, 0xffffff));
+
+    c->src_cf = LV_COLOR_FORMAT_UNKNOWN;
+    c->src_ofs = 0;
+    c->src_stride = 0;
+    if(image) {
+        c->src_cf = src_cfs[lv_rand(0, sizeof(src_cfs) / sizeof(src_cfs[0]) - 1)];
+        uint32_t src_px_size = lv_color_format_get_size(c->src_cf);
+        c->src_ofs = (int32_t)(lv_rand(0, MAX_OFS) * src_px_size);
+        c->src_stride = (int32_t)((c->w + lv_rand(0, MAX_PAD)) * src_px_size);
+    }
+}
+
+static void fill_dsc_init(lv_draw_sw_blend_fill_dsc_t * dsc, const blend_case_t * c, uint8_t * dest,
+                          const lv_opa_t * mask)
+{
+    lv_memzero(dsc, sizeof(*dsc));
+    dsc->dest_buf = dest + c->dest_ofs;
+    dsc->dest_w = c->w;
+    dsc->dest_h = c->h;
+    dsc->dest_stride = c->dest_stride;
+    dsc->mask_buf = c->has_mask ? mask : NULL;
+    dsc->mask_stride = c->mask_stride;
+    dsc->color = c->color;
+    dsc->opa = c->opa;
+    lv_area_set(&dsc->relative_area, 0, 0, c->w - 1, c->h - 1);
+}
+
+static void image_dsc_init(lv_draw_sw_blend_image_dsc_t * dsc, const blend_case_t * c, uint8_t * dest,
+                           const uint8_t * src, const lv_opa_t * mask)
+{
+    lv_memzero(dsc, sizeof(*dsc));
+    dsc->dest_buf = dest + c->dest_ofs;
+    dsc->dest_w = c->w;
+    dsc->dest_h = c->h;
+    dsc->dest_stride = c->dest_stride;
+    dsc->mask_buf = c->has_mask ? mask : NULL;
+    dsc->mask_stride = c->mask_stride;
+    dsc->src_buf = src + c->src_ofs;
+    dsc->src_stride = c->src_stride;
+    dsc->src_color_format = c->src_cf;
+    dsc->opa = c->opa;
+    dsc->blend_mode = LV_BLEND_MODE_NORMAL;
+    lv_area_set(&dsc->relative_area, 0, 0, c->w - 1, c->h - 1);
+    dsc->src_area = dsc->relative_area;
+}
+
+static void color_blend(const blend_case_t * c, lv_draw_sw_blend_fill_dsc_t * dsc, bool ref)
+{
+    switch(c->dest) {
+        case DEST_RGB565:
+            if(ref) lv_test_blend_ref_color_to_rgb565(dsc);
+            else lv_draw_sw_blend_color_to_rgb565(dsc);
+            break;
+        case DEST_ARGB8888:
+            if(ref) lv_test_blend_ref_color_to_argb8888(dsc);
+            else lv_draw_sw_blend_color_to_argb8888(dsc);
+            break;
+        default:
+            if(ref) lv_test_blend_ref_color_to_rgb888(dsc, c->dest_px_size);
+            else lv_draw_sw_blend_color_to_rgb888(dsc, c->dest_px_size);
+            break;
+    }
+}
+
+static void image_blend(const blend_case_t * c, lv_draw_sw_blend_image_dsc_t * dsc, bool ref)
+{
+    switch(c->dest) {
+        case DEST_RGB565:
+            if(ref) lv_test_blend_ref_image_to_rgb565(dsc);
+            else lv_draw_sw_blend_image_to_rgb565(dsc);
+            break;
+        case DEST_ARGB8888:
+            if(ref) lv_test_blend_ref_image_to_argb8888(dsc);
+            else lv_draw_sw_blend_image_to_argb8888(dsc);
+            break;
+        default:
+            if(ref) lv_test_blend_ref_image_to_rgb888(dsc, c->dest_px_size);
+            else lv_draw_sw_blend_image_to_rgb888(dsc, c->dest_px_size);
+            break;
+    }
+}
+
+/**
+ * Blend random areas with random strides, alignments, masks and opacities
+ * and compare the whole buffers, also the padding, with the C implementation
+ */
+static void test_random(dest_t dest, bool image)
+{
+    uint32_t i;
+    for(i = 0; i < CASE_CNT; i++) {
+        blend_case_t c;
+        rnd_case(&c, dest, image);
+        rnd_fill(dest_ref, BUF_SIZE, false);
+        lv_memcpy(dest_act, dest_ref, BUF_SIZE);
+        rnd_fill(src_buf, BUF_SIZE, false);
+        rnd_fill(mask_buf, BUF_SIZE, true);
+
+        if(image) {
+            lv_draw_sw_blend_image_dsc_t dsc;
+            image_dsc_init(&dsc, &c, dest_ref, src_buf, mask_buf);
+            image_blend(&c, &dsc, true);
+            image_dsc_init(&dsc, &c, dest_act, src_buf, mask_buf);
+            image_blend(&c, &dsc, false);
+        }
+        else {
+            lv_draw_sw_blend_fill_dsc_t dsc;
+            fill_dsc_init(&dsc, &c, dest_ref, mask_buf);
+            color_blend(&c, &dsc, true);
+            fill_dsc_init(&dsc, &c, dest_act, mask_buf);
+            color_blend(&c, &dsc, false);
+        }
+
+        if(lv_memcmp(dest_ref, dest_act, BUF_SIZE) != 0) {
+            TEST_PRINTF("case %d: dest %d, src_cf %d, w %d, h %d, dest_ofs %d, dest_stride %d, "
+                        "src_ofs %d, src_stride %d, mask %d, opa %d",
+                        (int)i, (int)c.dest, (int)c.src_cf, (int)c.w, (int)c.h, (int)c.dest_ofs,
+                        (int)c.dest_stride, (int)c.src_ofs, (int)c.src_stride, (int)c.has_mask, (int)c.opa);
+            TEST_FAIL_MESSAGE("The x86 blending differs from the C implementation");
+        }
+    }
+}
+
+#endif /*BLEND_X86*/
+
+void test_draw_sw_blend_x86_color_to_rgb565(void)
+{
+#if BLEND_X86
+    test_random(DEST_RGB565, false);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_blend_x86_image_to_rgb565(void)
+{
+#if BLEND_X86
+    test_random(DEST_RGB565, true);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_blend_x86_color_to_argb8888(void)
+{
+#if BLEND_X86
+    test_random(DEST_ARGB8888, false);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_blend_x86_image_to_argb8888(void)
+{
+#if BLEND_X86
+    test_random(DEST_ARGB8888, true);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_blend_x86_color_to_xrgb8888(void)
+{
+#if BLEND_X86
+    test_random(DEST_XRGB8888, false);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_blend_x86_image_to_xrgb8888(void)
+{
+#if BLEND_X86
+    test_random(DEST_XRGB8888, true);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_blend_x86_color_to_rgb888(void)
+{
+#if BLEND_X86
+    test_random(DEST_RGB888, false);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_draw_sw_blend_x86_image_to_rgb888(void)
+{
+#if BLEND_X86
+    test_random(DEST_RGB888, true);
+#else
+    TEST_PASS();
+#endif
+}
+
+#if BLEND_X86
+
+/**
+ * Blend a full screen several times
+ * @return  average time of a blending in us
+ */
+static uint32_t bench(dest_t dest, lv_color_format_t src_cf, bool has_mask, lv_opa_t opa, bool ref)
+{
+    blend_case_t c;
+    lv_memzero(&c, sizeof(c));
+    c.dest = dest;
+    c.dest_px_size = dest_px_size_get(dest);
+    c.w = BENCH_W;
+    c.h = BENCH_H;
+    c.dest_stride = (int32_t)(BENCH_W * c.dest_px_size);
+    c.src_cf = src_cf;
+    c.src_stride = (int32_t)(BENCH_W * lv_color_format_get_size(src_cf));
+    c.mask_stride = BENCH_W;
+    c.has_mask = has_mask;
+    c.opa = opa;
+    c.color = lv_color_hex(0x3080c0);
+
+    uint64_t t_start = lv_test_get_time_us();
+    uint32_t i;
+    for(i = 0; i < BENCH_ROUND_CNT; i++) {
+        if(src_cf == LV_COLOR_FORMAT_UNKNOWN) {
+            lv_draw_sw_blend_fill_dsc_t dsc;
+            fill_dsc_init(&dsc, &c, bench_dest, bench_mask);
+            color_blend(&c, &dsc, ref);
+        }
+        else {
+            lv_draw_sw_blend_image_dsc_t dsc;
+            image_dsc_init(&dsc, &c, bench_dest, bench_src, bench_mask);
+            image_blend(&c, &dsc, ref);
+        }
+    }
+
+    return (uint32_t)((lv_test_get_time_us() - t_start) / BENCH_ROUND_CNT);
+}
+
+#endif /*BLEND_X86*/
+
+void test_draw_sw_blend_x86_bench(void)
+{
+#if BLEND_X86
+    static const char * dest_names[] = {"rgb565", "argb8888", "xrgb8888", "rgb888"};
+
+    rnd_fill(bench_src, sizeof(bench_src), false);
+    rnd_fill(bench_mask, sizeof(bench_mask), true);
+
+    dest_t dest;
+    for(dest = DEST_RGB565; dest <= DEST_RGB888; dest++) {
+        rnd_fill(bench_dest, sizeof(bench_dest), false);
+
+        TEST_PRINTF("%s fill:            C %d us, %s %d us", dest_names[dest],
+                    (int)bench(dest, LV_COLOR_FORMAT_UNKNOWN, false, LV_OPA_COVER, true),
+                    LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2 ? "AVX2" : "SSE2",
+                    (int)bench(dest, LV_COLOR_FORMAT_UNKNOWN, false, LV_OPA_COVER, false));
+        TEST_PRINTF("%s fill mask opa:   C %d us, %s %d us", dest_names[dest],
+                    (int)bench(dest, LV_COLOR_FORMAT_UNKNOWN, true, LV_OPA_50, true),
+                    LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2 ? "AVX2" : "SSE2",
+                    (int)bench(dest, LV_COLOR_FORMAT_UNKNOWN, true, LV_OPA_50, false));
+        TEST_PRINTF("%s argb image:      C %d us, %s %d us", dest_names[dest],
+                    (int)bench(dest, LV_COLOR_FORMAT_ARGB8888, false, LV_OPA_COVER, true),
+                    LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2 ? "AVX2" : "SSE2",
+                    (int)bench(dest, LV_COLOR_FORMAT_ARGB8888, false, LV_OPA_COVER, false));
+        TEST_PRINTF("%s argb image mask: C %d us, %s %d us", dest_names[dest],
+                    (int)bench(dest, LV_COLOR_FORMAT_ARGB8888, true, LV_OPA_COVER, true),
+                    LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2 ? "AVX2" : "SSE2",
+                    (int)bench(dest, LV_COLOR_FORMAT_ARGB8888, true, LV_OPA_COVER, false));
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
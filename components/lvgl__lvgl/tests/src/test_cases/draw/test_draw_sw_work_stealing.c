@@ -0,0 +1,120 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_init.h"
+
+#include "unity/unity.h"
+
+#define BENCH_FRAME_CNT 20
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+/*Large fills are split into row bands, the shadow and the transformed image are rendered as a whole*/
+static void create_scene(void)
+{
+    LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_set_style_bg_color(scr, lv_palette_lighten(LV_PALETTE_GREY, 4), 0);
+
+    lv_obj_t * obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 360, 400);
+    lv_obj_set_pos(obj, 30, 40);
+    lv_obj_set_style_radius(obj, 40, 0);
+    lv_obj_set_style_shadow_width(obj, 60, 0);
+    lv_obj_set_style_shadow_spread(obj, 10, 0);
+    lv_obj_set_style_shadow_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_bg_grad_color(obj, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_VER, 0);
+
+    obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 300, 440);
+    lv_obj_set_pos(obj, 460, 20);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_GREEN), 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_70, 0);
+
+    lv_obj_t * img = lv_image_create(obj);
+    lv_image_set_src(img, &test_image_cogwheel_argb8888);
+    lv_image_set_rotation(img, 300);
+    lv_image_set_scale(img, 400);
+    lv_obj_center(img);
+}
+
+void test_draw_sw_work_stealing_render(void)
+{
+    create_scene();
+
+    /*Split tasks must render the same pixels as the whole tasks*/
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_work_stealing.png");
+}
+
+/**
+ * Redraw the screen several times
+ * @return  average time of a frame in us
+ */
+static uint32_t frame_time(void)
+{
+    uint64_t t_start = lv_test_get_time_us();
+    uint32_t i;
+    for(i = 0; i < BENCH_FRAME_CNT; i++) {
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(NULL);
+    }
+
+    return (uint32_t)((lv_test_get_time_us() - t_start) / BENCH_FRAME_CNT);
+}
+
+void test_draw_sw_work_stealing_bench(void)
+{
+    create_scene();
+
+#if LV_USE_OS && LV_DRAW_SW_WORK_STEALING
+    /*Scale the number of render threads*/
+    uint32_t thread_cnt;
+    for(thread_cnt = 1; thread_cnt <= LV_DRAW_SW_DRAW_UNIT_CNT; thread_cnt++) {
+        lv_draw_sw_set_thread_cnt(thread_cnt);
+        uint32_t t = frame_time();
+        TEST_PRINTF("%d of %d render threads: %d us/frame", (int)thread_cnt, LV_DRAW_SW_DRAW_UNIT_CNT, (int)t);
+    }
+
+    /*The screen is the same with any number of threads*/
+    lv_draw_sw_set_thread_cnt(1);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_work_stealing.png");
+    lv_draw_sw_set_thread_cnt(LV_DRAW_SW_DRAW_UNIT_CNT);
+
+    lv_draw_sw_reset_thread_stats();
+    frame_time();
+
+    uint32_t i;
+    uint32_t job_sum = 0;
+    uint32_t split_sum = 0;
+    for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
+        lv_draw_sw_thread_stats_t stats;
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_draw_sw_get_thread_stats(i, &stats));
+        TEST_PRINTF("thread %d: jobs %d, splits %d, steals %d, failed steals %d, busy %d ms, idle %d ms",
+                    (int)i, (int)stats.job_cnt, (int)stats.split_cnt, (int)stats.steal_cnt, (int)stats.steal_fail_cnt,
+                    (int)stats.busy_time, (int)stats.idle_time);
+        job_sum += stats.job_cnt;
+        split_sum += stats.split_cnt;
+    }
+
+    TEST_ASSERT_GREATER_THAN(0, split_sum);
+    TEST_ASSERT_GREATER_THAN(split_sum, job_sum);
+
+    lv_draw_sw_thread_stats_t stats;
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_draw_sw_get_thread_stats(LV_DRAW_SW_DRAW_UNIT_CNT, &stats));
+#else
+    TEST_PRINTF("%d SW draw unit(s): %d us/frame", LV_DRAW_SW_DRAW_UNIT_CNT, (int)frame_time());
+#endif
+}
+
+#endif
@@ -0,0 +1,210 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_init.h"
+
+#include "unity/unity.h"
+
+#define BENCH_FRAME_CNT     20
+
+LV_IMAGE_DECLARE(img_benchmark_lvgl_logo_rgb);
+LV_IMAGE_DECLARE(img_benchmark_lvgl_logo_argb);
+LV_IMAGE_DECLARE(test_img_lvgl_logo_png);
+
+void setUp(void)
+{
+    lv_display_set_color_format(NULL, LV_COLOR_FORMAT_RGB565);
+}
+
+void tearDown(void)
+{
+    lv_image_decoder_set_convert_native(false);
+    lv_image_decoder_set_convert_native_variables(false);
+    lv_display_set_color_format(NULL, LV_COLOR_FORMAT_XRGB8888);
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_color_format_t decoded_cf(const void * src)
+{
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, NULL));
+    lv_color_format_t cf = dsc.decoded->header.cf;
+    lv_image_decoder_close(&dsc);
+    return cf;
+}
+
+static void fill(lv_draw_buf_t * draw_buf, lv_color_t color)
+{
+    uint32_t y;
+    for(y = 0; y < draw_buf->header.h; y++) {
+        lv_color32_t * row = (lv_color32_t *)(draw_buf->data + y * draw_buf->header.stride);
+        uint32_t x;
+        for(x = 0; x < draw_buf->header.w; x++) row[x] = lv_color_to_32(color, LV_OPA_COVER);
+    }
+}
+
+/*The same as the `multiple_rgb_images_cb` and `multiple_argb_images_cb` scenes of the benchmark demo*/
+static void images_create(const void * src)
+{
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_clean(scr);
+    lv_obj_set_flex_flow(scr, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_flex_align(scr, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_SPACE_EVENLY);
+
+    int32_t hor_cnt = lv_obj_get_content_width(scr) / 160;
+    int32_t ver_cnt = lv_obj_get_content_height(scr) / 160;
+    int32_t i;
+    for(i = 0; i < hor_cnt * ver_cnt; i++) {
+        lv_obj_t * obj = lv_image_create(scr);
+        lv_image_set_src(obj, src);
+    }
+}
+
+/**
+ * Redraw the screen several times
+ * @return  average time of a frame in us
+ */
+static uint32_t frame_time(void)
+{
+    lv_refr_now(NULL);  /*Decode and cache the images*/
+
+    uint64_t t_start = lv_test_get_time_us();
+    uint32_t i;
+    for(i = 0; i < BENCH_FRAME_CNT; i++) {
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(NULL);
+    }
+
+    return (uint32_t)((lv_test_get_time_us() - t_start) / BENCH_FRAME_CNT);
+}
+
+void test_image_convert_native_cf(void)
+{
+    lv_image_decoder_set_convert_native(true);
+
+    /*The decoded images are converted, the C arrays are drawn directly*/
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_RGB565A8, decoded_cf(&test_img_lvgl_logo_png));
+    TEST_ASSERT_EQUAL(img_benchmark_lvgl_logo_rgb.header.cf, decoded_cf(&img_benchmark_lvgl_logo_rgb));
+    TEST_ASSERT_EQUAL(img_benchmark_lvgl_logo_argb.header.cf, decoded_cf(&img_benchmark_lvgl_logo_argb));
+
+    lv_image_decoder_set_convert_native_variables(true);
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_RGB565, decoded_cf(&img_benchmark_lvgl_logo_rgb));
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_RGB565A8, decoded_cf(&img_benchmark_lvgl_logo_argb));
+
+    /*The cached images keep their format, so drop them when the display changes*/
+    lv_display_set_color_format(NULL, LV_COLOR_FORMAT_RGB565_SWAPPED);
+    lv_image_cache_drop(NULL);
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_RGB565_SWAPPED, decoded_cf(&img_benchmark_lvgl_logo_rgb));
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_RGB565A8, decoded_cf(&img_benchmark_lvgl_logo_argb));
+
+    /*Not converted for other displays*/
+    lv_display_set_color_format(NULL, LV_COLOR_FORMAT_XRGB8888);
+    lv_image_cache_drop(NULL);
+    TEST_ASSERT_EQUAL(img_benchmark_lvgl_logo_rgb.header.cf, decoded_cf(&img_benchmark_lvgl_logo_rgb));
+
+    /*Not converted if not cached*/
+    lv_display_set_color_format(NULL, LV_COLOR_FORMAT_RGB565);
+    lv_image_cache_drop(NULL);
+    lv_image_decoder_args_t args = {.no_cache = true};
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, &img_benchmark_lvgl_logo_rgb, &args));
+    TEST_ASSERT_EQUAL(img_benchmark_lvgl_logo_rgb.header.cf, dsc.decoded->header.cf);
+    lv_image_decoder_close(&dsc);
+
+    lv_image_decoder_set_convert_native(false);
+    TEST_ASSERT_EQUAL(img_benchmark_lvgl_logo_rgb.header.cf, decoded_cf(&img_benchmark_lvgl_logo_rgb));
+}
+
+void test_image_convert_native_variable_change(void)
+{
+    lv_image_decoder_set_convert_native(true);
+
+    /*A variable image in RAM which is changed later*/
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(100, 100, LV_COLOR_FORMAT_XRGB8888, LV_STRIDE_AUTO);
+    lv_image_dsc_t img_dsc;
+    lv_draw_buf_to_image(draw_buf, &img_dsc);
+    img_dsc.header.flags = 0;
+    fill(draw_buf, lv_palette_main(LV_PALETTE_RED));
+
+    /*Drawn directly, so the changes are visible*/
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, &img_dsc, NULL));
+    TEST_ASSERT_EQUAL_PTR(img_dsc.data, dsc.decoded->data);
+    lv_image_decoder_close(&dsc);
+
+    /*Converted to the cache, the changes are visible only after dropping it*/
+    lv_image_decoder_set_convert_native_variables(true);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, &img_dsc, NULL));
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_RGB565, dsc.decoded->header.cf);
+    uint16_t red = lv_color_to_u16(lv_palette_main(LV_PALETTE_RED));
+    TEST_ASSERT_EQUAL_HEX16(red, *(const uint16_t *)dsc.decoded->data);
+    lv_image_decoder_close(&dsc);
+
+    fill(draw_buf, lv_palette_main(LV_PALETTE_BLUE));
+    lv_image_cache_drop(&img_dsc);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, &img_dsc, NULL));
+    uint16_t blue = lv_color_to_u16(lv_palette_main(LV_PALETTE_BLUE));
+    TEST_ASSERT_EQUAL_HEX16(blue, *(const uint16_t *)dsc.decoded->data);
+    lv_image_decoder_close(&dsc);
+
+    lv_image_cache_drop(&img_dsc);
+    lv_draw_buf_destroy(draw_buf);
+}
+
+void test_image_convert_native_draw(void)
+{
+    /*Opaque images are rendered exactly the same way*/
+    images_create(&img_benchmark_lvgl_logo_rgb);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/image_convert_native_rgb.png");
+    lv_image_decoder_set_convert_native(true);
+    lv_image_decoder_set_convert_native_variables(true);
+    lv_obj_invalidate(lv_screen_active());
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/image_convert_native_rgb.png");
+
+    images_create(&img_benchmark_lvgl_logo_argb);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/image_convert_native_argb.png");
+}
+
+void test_image_convert_native_canvas(void)
+{
+    lv_image_decoder_set_convert_native(true);
+    lv_image_decoder_set_convert_native_variables(true);
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(100, 100, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+    lv_obj_center(canvas);
+    lv_canvas_fill_bg(canvas, lv_palette_main(LV_PALETTE_RED), LV_OPA_COVER);
+    lv_refr_now(NULL);
+
+    /*The canvas is drawn directly, so the changes are visible without dropping the cache*/
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_ARGB8888, decoded_cf(draw_buf));
+    lv_canvas_fill_bg(canvas, lv_palette_main(LV_PALETTE_BLUE), LV_OPA_COVER);
+    int32_t i;
+    for(i = 0; i < 100; i++) {
+        lv_canvas_set_px(canvas, i, i, lv_color_white(), LV_OPA_COVER);
+    }
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/image_convert_native_canvas.png");
+
+    lv_obj_delete(canvas);
+    lv_draw_buf_destroy(draw_buf);
+}
+
+void test_image_convert_native_bench(void)
+{
+    const void * srcs[] = {&img_benchmark_lvgl_logo_rgb, &img_benchmark_lvgl_logo_argb};
+    const char * names[] = {"XRGB8888", "ARGB8888"};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        images_create(srcs[i]);
+        lv_image_decoder_set_convert_native(false);
+        uint32_t t_orig = frame_time();
+        lv_image_decoder_set_convert_native(true);
+        lv_image_decoder_set_convert_native_variables(true);
+        uint32_t t_native = frame_time();
+        TEST_PRINTF("%s images on RGB565 display: %d us/frame, converted: %d us/frame",
+                    names[i], (int)t_orig, (int)t_native);
+    }
+}
+
+#endif
@@ -1,9 +1,14 @@
 #if LV_BUILD_TEST
 #include "../lvgl.h"
 #include "../../lvgl_private.h"
+#include "lv_test_init.h"
 
 #include "unity/unity.h"
 
+#if LV_USE_LZ4_INTERNAL
+    #include "../../src/libs/lz4/lz4.h"
+#endif
+
 void setUp(void)
 {
     /* Function run before every test */
@@ -209,4 +214,338 @@ void test_bin_decoder_flush_cache(void)
 #endif
 }
 
+#define ROW_BLOCKS_W            240
+#define ROW_BLOCKS_H            240
+#define ROW_BLOCKS_STRIDE       (ROW_BLOCKS_W * 2)
+#define ROW_BLOCKS_ROWS         18
+#define ROW_BLOCKS_CNT          ((ROW_BLOCKS_H + ROW_BLOCKS_ROWS - 1) / ROW_BLOCKS_ROWS)
+#define ROW_BLOCKS_BENCH_CNT    20
+
+static uint8_t row_blocks_raw[ROW_BLOCKS_H * ROW_BLOCKS_STRIDE];
+static uint8_t row_blocks_data[2 * sizeof(row_blocks_raw)];
+static lv_image_dsc_t row_blocks_dsc;
+
+/*Horizontal bands with steps in them, like a typical UI background*/
+static void row_blocks_raw_create(void)
+{
+    uint16_t * px = (uint16_t *)row_blocks_raw;
+    uint32_t x, y;
+    for(y = 0; y < ROW_BLOCKS_H; y++) {
+        for(x = 0; x < ROW_BLOCKS_W; x++) {
+            *px = (uint16_t)((y / 8) * 2017 + (x / 16) * 31);
+            px++;
+        }
+    }
+}
+
+/*Runs of repeated pixels and literal pixels in the format of `lv_rle_decompress`*/
+static uint32_t rle_compress(const uint8_t * in, uint32_t len, uint8_t * out, uint32_t blk_size)
+{
+    uint32_t rd = 0;
+    uint32_t wr = 0;
+    while(rd < len) {
+        uint32_t repeat = 1;
+        while(repeat < 127 && rd + (repeat + 1) * blk_size <= len &&
+              lv_memcmp(&in[rd], &in[rd + repeat * blk_size], blk_size) == 0) {
+            repeat++;
+        }
+
+        if(repeat >= 4) {
+            out[wr++] = (uint8_t)repeat;
+            lv_memcpy(&out[wr], &in[rd], blk_size);
+            wr += blk_size;
+        }
+        else {
+            out[wr++] = (uint8_t)(0x80 | repeat);
+            lv_memcpy(&out[wr], &in[rd], repeat * blk_size);
+            wr += repeat * blk_size;
+        }
+        rd += repeat * blk_size;
+    }
+
+    return wr;
+}
+
+/**
+ * Compress `row_blocks_raw` in row blocks into `row_blocks_dsc` as LVGLImage.py does
+ * @param method        RLE or LZ4
+ * @param block_rows    number of rows in a block
+ */
+static void row_blocks_create(lv_image_compress_t method, uint32_t block_rows)
+{
+    uint32_t block_cnt = (ROW_BLOCKS_H + block_rows - 1) / block_rows;
+    uint32_t * header = (uint32_t *)row_blocks_data;
+    uint32_t * offsets = header + 3;
+    uint8_t * blocks = (uint8_t *)(offsets + block_cnt + 1);
+    uint32_t i;
+
+    offsets[0] = 0;
+    for(i = 0; i < block_cnt; i++) {
+        const uint8_t * in = &row_blocks_raw[i * block_rows * ROW_BLOCKS_STRIDE];
+        uint32_t rows = LV_MIN(block_rows, ROW_BLOCKS_H - i * block_rows);
+        uint32_t len = 0;
+        if(method == LV_IMAGE_COMPRESS_RLE) {
+            len = rle_compress(in, rows * ROW_BLOCKS_STRIDE, &blocks[offsets[i]], 2);
+        }
+#if LV_USE_LZ4_INTERNAL
+        else {
+            int capacity = (int)(sizeof(row_blocks_data) - (&blocks[offsets[i]] - row_blocks_data));
+            len = LZ4_compress_default((const char *)in, (char *)&blocks[offsets[i]], (int)(rows * ROW_BLOCKS_STRIDE),
+                                       capacity);
+        }
+#endif
+        TEST_ASSERT_GREATER_THAN(0, len);
+        offsets[i + 1] = offsets[i] + len;
+    }
+
+    header[0] = method | (block_rows << 4);
+    header[1] = (block_cnt + 1) * sizeof(uint32_t) + offsets[block_cnt];
+    header[2] = sizeof(row_blocks_raw);
+
+    lv_memzero(&row_blocks_dsc, sizeof(row_blocks_dsc));
+    row_blocks_dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    row_blocks_dsc.header.cf = LV_COLOR_FORMAT_RGB565;
+    row_blocks_dsc.header.flags = LV_IMAGE_FLAGS_COMPRESSED;
+    row_blocks_dsc.header.w = ROW_BLOCKS_W;
+    row_blocks_dsc.header.h = ROW_BLOCKS_H;
+    row_blocks_dsc.header.stride = ROW_BLOCKS_STRIDE;
+    row_blocks_dsc.data = row_blocks_data;
+    row_blocks_dsc.data_size = 3 * sizeof(uint32_t) + header[1];
+}
+
+static void row_blocks_write_file(const char * path, const lv_image_dsc_t * dsc)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_WR));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&f, &dsc->header, sizeof(lv_image_header_t), NULL));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&f, dsc->data, dsc->data_size, NULL));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_close(&f));
+}
+
+/*Decode the rows of `area` and check that only the blocks of those rows are decoded*/
+static void row_blocks_check_area(const void * src, const lv_area_t * area)
+{
+    lv_image_decoder_args_t args;
+    lv_memzero(&args, sizeof(args));
+    args.no_cache = true;
+
+    lv_image_decoder_dsc_t decoder_dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&decoder_dsc, src, &args));
+    TEST_ASSERT_NULL(decoder_dsc.decoded);
+
+    lv_area_t decoded_area;
+    decoded_area.y1 = LV_COORD_MIN;
+    int32_t y_next = area->y1 - area->y1 % ROW_BLOCKS_ROWS;
+    uint32_t block_cnt = 0;
+    while(lv_image_decoder_get_area(&decoder_dsc, area, &decoded_area) == LV_RESULT_OK) {
+        TEST_ASSERT_EQUAL_INT32(y_next, decoded_area.y1);
+        TEST_ASSERT_EQUAL_INT32(0, decoded_area.x1);
+        TEST_ASSERT_EQUAL_INT32(ROW_BLOCKS_W - 1, decoded_area.x2);
+
+        const lv_draw_buf_t * decoded = decoder_dsc.decoded;
+        int32_t y;
+        for(y = decoded_area.y1; y <= decoded_area.y2; y++) {
+            TEST_ASSERT_EQUAL_MEMORY(&row_blocks_raw[y * ROW_BLOCKS_STRIDE],
+                                     lv_draw_buf_goto_xy(decoded, 0, y - decoded_area.y1), ROW_BLOCKS_STRIDE);
+        }
+
+        y_next = decoded_area.y2 + 1;
+        block_cnt++;
+    }
+
+    TEST_ASSERT_EQUAL(area->y2 / ROW_BLOCKS_ROWS - area->y1 / ROW_BLOCKS_ROWS + 1, block_cnt);
+    TEST_ASSERT_EQUAL_INT32(LV_MIN((area->y2 / ROW_BLOCKS_ROWS + 1) * ROW_BLOCKS_ROWS, ROW_BLOCKS_H), y_next);
+    lv_image_decoder_close(&decoder_dsc);
+}
+
+/*Render `src` and compare it with the uncompressed image*/
+static void row_blocks_check_render(const void * src)
+{
+    static lv_image_dsc_t raw_dsc;
+    raw_dsc = row_blocks_dsc;
+    raw_dsc.header.flags = 0;
+    raw_dsc.data = row_blocks_raw;
+    raw_dsc.data_size = sizeof(row_blocks_raw);
+
+    lv_draw_buf_t * draw_buf = lv_display_get_buf_active(NULL);
+    uint32_t buf_size = draw_buf->header.stride * draw_buf->header.h;
+    uint8_t * ref = lv_malloc(buf_size);
+    TEST_ASSERT_NOT_NULL(ref);
+
+    create_image(&raw_dsc);
+    lv_refr_now(NULL);
+    lv_memcpy(ref, draw_buf->data, buf_size);
+    lv_obj_clean(lv_screen_active());
+
+    size_t mem_before = lv_test_get_free_mem();
+    create_image(src);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref, draw_buf->data, buf_size);
+    lv_obj_clean(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 0);
+
+    lv_free(ref);
+}
+
+static void row_blocks(lv_image_compress_t method)
+{
+    static const lv_area_t areas[] = {
+        {0, 0, ROW_BLOCKS_W - 1, ROW_BLOCKS_H - 1},
+        {10, 100, 50, 130},
+        {200, 230, 239, 239},
+        {0, 36, 239, 36},
+    };
+    const char * path = "A:bin_decoder_row_blocks.bin";
+    const char * path_mapped = "B:bin_decoder_row_blocks.bin"; /*The same file mapped to the memory*/
+
+    row_blocks_raw_create();
+    row_blocks_create(method, ROW_BLOCKS_ROWS);
+    row_blocks_write_file(path, &row_blocks_dsc);
+
+    uint32_t i;
+    for(i = 0; i < sizeof(areas) / sizeof(areas[0]); i++) {
+        row_blocks_check_area(&row_blocks_dsc, &areas[i]);
+        row_blocks_check_area(path, &areas[i]);
+        row_blocks_check_area(path_mapped, &areas[i]);
+    }
+
+    row_blocks_check_render(&row_blocks_dsc);
+    row_blocks_check_render(path);
+    row_blocks_check_render(path_mapped);
+
+    /*A corrupted offset table is rejected on open*/
+    uint32_t * offsets = (uint32_t *)row_blocks_data + 3;
+    offsets[ROW_BLOCKS_CNT / 2] = offsets[ROW_BLOCKS_CNT] + 1;
+    lv_image_decoder_args_t args;
+    lv_memzero(&args, sizeof(args));
+    lv_image_decoder_dsc_t decoder_dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_image_decoder_open(&decoder_dsc, &row_blocks_dsc, &args));
+}
+
+void test_bin_decoder_row_blocks_rle(void)
+{
+    row_blocks(LV_IMAGE_COMPRESS_RLE);
+}
+
+void test_bin_decoder_row_blocks_lz4(void)
+{
+#if LV_USE_LZ4_INTERNAL
+    row_blocks(LV_IMAGE_COMPRESS_LZ4);
+#endif
+}
+
+/*Check if the data of a mapped file is aligned so the decoder can use it directly*/
+static bool mapped_data_is_aligned(const char * path)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD));
+    uint32_t map_size;
+    const uint8_t * data = lv_fs_get_mapped_ptr(&f, &map_size);
+    TEST_ASSERT_NOT_NULL(data);
+    data += sizeof(lv_image_header_t);
+    bool aligned = lv_draw_buf_align((void *)data, LV_COLOR_FORMAT_RGB565) == data;
+    lv_fs_close(&f);
+    return aligned;
+}
+
+void test_bin_decoder_mapped_file(void)
+{
+    row_blocks_raw_create();
+    row_blocks_create(LV_IMAGE_COMPRESS_RLE, ROW_BLOCKS_ROWS);
+
+    static lv_image_dsc_t raw_dsc;
+    raw_dsc = row_blocks_dsc;
+    raw_dsc.header.flags = 0;
+    raw_dsc.data = row_blocks_raw;
+    raw_dsc.data_size = sizeof(row_blocks_raw);
+    row_blocks_write_file("A:bin_decoder_mapped.bin", &raw_dsc);
+
+    /*The rows are copied from the mapping*/
+    row_blocks_check_render("B:bin_decoder_mapped.bin");
+
+    lv_image_decoder_args_t args;
+    lv_memzero(&args, sizeof(args));
+    args.no_cache = true;
+    lv_image_decoder_dsc_t decoder_dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&decoder_dsc, "B:bin_decoder_mapped.bin", &args));
+    /*With a large `LV_DRAW_BUF_ALIGN` the data after the header is read to an aligned buffer instead*/
+    bool aligned = mapped_data_is_aligned("B:bin_decoder_mapped.bin");
+    if(aligned) TEST_ASSERT_NOT_NULL(decoder_dsc.decoded);
+    lv_image_decoder_close(&decoder_dsc);
+
+    /*The stride of legacy files is calculated from the width*/
+    raw_dsc.header.stride = 0;
+    row_blocks_write_file("A:bin_decoder_mapped_legacy.bin", &raw_dsc);
+    row_blocks_check_render("B:bin_decoder_mapped_legacy.bin");
+
+    /*A truncated file is rejected instead of reading past the mapping*/
+    raw_dsc.header.stride = ROW_BLOCKS_STRIDE;
+    raw_dsc.data_size = sizeof(row_blocks_raw) - ROW_BLOCKS_STRIDE;
+    row_blocks_write_file("A:bin_decoder_mapped_truncated.bin", &raw_dsc);
+    if(aligned) {
+        TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_image_decoder_open(&decoder_dsc, "B:bin_decoder_mapped_truncated.bin",
+                                                                   &args));
+    }
+}
+
+/**
+ * Decode the whole image `ROW_BLOCKS_BENCH_CNT` times via `get_area_cb` as the draw stripes do
+ * @param name      name of the configuration to print
+ * @param src       image source
+ */
+static void row_blocks_bench(const char * name, const void * src)
+{
+    lv_image_decoder_args_t args;
+    lv_memzero(&args, sizeof(args));
+    args.no_cache = true;
+
+    lv_area_t full_area = {0, 0, ROW_BLOCKS_W - 1, ROW_BLOCKS_H - 1};
+    uint32_t i;
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < ROW_BLOCKS_BENCH_CNT; i++) {
+        lv_image_decoder_dsc_t decoder_dsc;
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&decoder_dsc, src, &args));
+        if(decoder_dsc.decoded == NULL) {
+            lv_area_t decoded_area;
+            decoded_area.y1 = LV_COORD_MIN;
+            while(lv_image_decoder_get_area(&decoder_dsc, &full_area, &decoded_area) == LV_RESULT_OK) {}
+        }
+        lv_image_decoder_close(&decoder_dsc);
+    }
+    uint64_t t = lv_test_get_time_us() - t_start;
+
+    TEST_PRINTF("%s: %d us per %dx%d RGB565 image, %d MB/s", name, (int)(t / ROW_BLOCKS_BENCH_CNT),
+                ROW_BLOCKS_W, ROW_BLOCKS_H, (int)((uint64_t)sizeof(row_blocks_raw) * ROW_BLOCKS_BENCH_CNT / LV_MAX(t, 1)));
+}
+
+void test_bin_decoder_row_blocks_bench(void)
+{
+    row_blocks_raw_create();
+
+    /*Uncompressed image read line by line from file*/
+    row_blocks_create(LV_IMAGE_COMPRESS_RLE, ROW_BLOCKS_ROWS);
+    static lv_image_dsc_t raw_dsc;
+    raw_dsc = row_blocks_dsc;
+    raw_dsc.header.flags = 0;
+    raw_dsc.data = row_blocks_raw;
+    raw_dsc.data_size = sizeof(row_blocks_raw);
+    row_blocks_write_file("A:bin_decoder_row_blocks_raw.bin", &raw_dsc);
+    row_blocks_bench("uncompressed file", "A:bin_decoder_row_blocks_raw.bin");
+    row_blocks_bench("uncompressed file mapped", "B:bin_decoder_row_blocks_raw.bin");
+
+    row_blocks_write_file("A:bin_decoder_row_blocks_rle.bin", &row_blocks_dsc);
+    row_blocks_bench("RLE row blocks variable", &row_blocks_dsc);
+    row_blocks_bench("RLE row blocks file", "A:bin_decoder_row_blocks_rle.bin");
+    row_blocks_bench("RLE row blocks file mapped", "B:bin_decoder_row_blocks_rle.bin");
+
+#if LV_USE_LZ4_INTERNAL
+    row_blocks_create(LV_IMAGE_COMPRESS_LZ4, ROW_BLOCKS_ROWS);
+    row_blocks_write_file("A:bin_decoder_row_blocks_lz4.bin", &row_blocks_dsc);
+    row_blocks_bench("LZ4 row blocks variable", &row_blocks_dsc);
+    row_blocks_bench("LZ4 row blocks file", "A:bin_decoder_row_blocks_lz4.bin");
+    row_blocks_bench("LZ4 row blocks file mapped", "B:bin_decoder_row_blocks_lz4.bin");
+#endif
+}
+
 #endif
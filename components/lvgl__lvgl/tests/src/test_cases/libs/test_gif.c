@@ -0,0 +1,281 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_init.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_GIF
+
+#define BENCH_FRAME_CNT     100
+
+/*A 16x16 GIF with black, red, green and blue colors in its palette and 4 frames:
+ *1. red (0;0) 16x16, keep
+ *2. green (4;4) 8x8, restore to background
+ *3. blue (0;0) 4x4, restore to previous
+ *4. green (12;12) 4x4, keep*/
+static const uint8_t disposal_gif_data[] = {
+    0x47, 0x49, 0x46, 0x38, 0x39, 0x61, 0x10, 0x00, 0x10, 0x00, 0x81, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xff, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0xff, 0x21, 0xf9, 0x04, 0x04, 0x00, 0x00, 0x00,
+    0x00, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x10, 0x00, 0x00, 0x02, 0x0e, 0x8c, 0x8f, 0xa9,
+    0xcb, 0xed, 0x0f, 0xa3, 0x9c, 0xb4, 0xda, 0x8b, 0xb3, 0x3e, 0x05, 0x00, 0x21, 0xf9, 0x04, 0x08,
+    0x00, 0x00, 0x00, 0x00, 0x2c, 0x04, 0x00, 0x04, 0x00, 0x08, 0x00, 0x08, 0x00, 0x00, 0x02, 0x06,
+    0x94, 0x8f, 0xa9, 0xcb, 0xed, 0x5d, 0x00, 0x21, 0xf9, 0x04, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x2c,
+    0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x00, 0x02, 0x04, 0x9c, 0x8f, 0x39, 0x05, 0x00,
+    0x21, 0xf9, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x2c, 0x0c, 0x00, 0x0c, 0x00, 0x04, 0x00, 0x04,
+    0x00, 0x00, 0x02, 0x04, 0x94, 0x8f, 0x29, 0x05, 0x00, 0x3b,
+};
+
+static const lv_image_dsc_t disposal_gif = {
+    .header.magic = LV_IMAGE_HEADER_MAGIC,
+    .header.cf = LV_COLOR_FORMAT_RAW,
+    .header.w = 16,
+    .header.h = 16,
+    .data_size = sizeof(disposal_gif_data),
+    .data = disposal_gif_data,
+};
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_refr_now(NULL);
+}
+
+static void next_frame(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *)obj;
+
+    /*Pretend the delay of the frame has elapsed*/
+    gifobj->last_call = lv_tick_get() - 100000;
+    gifobj->timer->timer_cb(gifobj->timer);
+}
+
+/**
+ * Get the pixels to redraw on the display
+ * @return      the number of invalidated pixels after joining the areas
+ */
+static uint32_t get_inv_pixels(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    uint32_t px_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(disp->inv_area_joined[i] == 0) px_cnt += lv_area_get_size(&disp->inv_areas[i]);
+    }
+    return px_cnt;
+}
+
+static void assert_inv_area(lv_obj_t * obj, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_display_t * disp = lv_display_get_default();
+    lv_area_t a;
+    lv_area_set(&a, obj->coords.x1 + x1, obj->coords.y1 + y1, obj->coords.x1 + x2, obj->coords.y1 + y2);
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_TRUE(lv_area_is_equal(&a, &disp->inv_areas[0]));
+}
+
+static void assert_canvas_rect(lv_obj_t * obj, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t color)
+{
+    lv_gif_t * gifobj = (lv_gif_t *)obj;
+    const lv_image_dsc_t * dsc = &gifobj->imgdsc;
+    int32_t x, y;
+    for(y = y1; y <= y2; y++) {
+        for(x = x1; x <= x2; x++) {
+            if(dsc->header.cf == LV_COLOR_FORMAT_RGB565) {
+                const uint16_t * px = (const uint16_t *)(dsc->data + y * dsc->header.stride) + x;
+                TEST_ASSERT_EQUAL_HEX16(lv_color_to_u16(lv_color_hex(color)), *px);
+            }
+            else {
+                const uint32_t * px = (const uint32_t *)(dsc->data + y * dsc->header.stride) + x;
+                TEST_ASSERT_EQUAL_HEX32(0xff000000 | color, *px);
+            }
+        }
+    }
+}
+
+static void disposal(lv_color_format_t cf)
+{
+    lv_obj_t * obj = lv_gif_create(lv_screen_active());
+    lv_gif_set_color_format(obj, cf);
+    lv_obj_set_pos(obj, 10, 20);
+    lv_gif_set_src(obj, &disposal_gif);
+    TEST_ASSERT_EQUAL(cf, ((lv_gif_t *)obj)->imgdsc.header.cf);
+    lv_refr_now(NULL);
+    assert_canvas_rect(obj, 0, 0, 15, 15, 0xff0000);
+
+    /*Only the frame changes*/
+    next_frame(obj);
+    assert_inv_area(obj, 4, 4, 11, 11);
+    lv_refr_now(NULL);
+    assert_canvas_rect(obj, 0, 0, 15, 3, 0xff0000);
+    assert_canvas_rect(obj, 4, 4, 11, 11, 0x00ff00);
+
+    /*The previous frame is restored to the background too*/
+    next_frame(obj);
+    assert_inv_area(obj, 0, 0, 11, 11);
+    lv_refr_now(NULL);
+    assert_canvas_rect(obj, 0, 0, 3, 3, 0x0000ff);
+    assert_canvas_rect(obj, 4, 4, 11, 11, 0x000000);
+    assert_canvas_rect(obj, 12, 0, 15, 15, 0xff0000);
+
+    /*The canvas under the blue frame is restored*/
+    next_frame(obj);
+    assert_inv_area(obj, 0, 0, 15, 15);
+    lv_refr_now(NULL);
+    assert_canvas_rect(obj, 0, 0, 3, 3, 0xff0000);
+    assert_canvas_rect(obj, 4, 4, 11, 11, 0x000000);
+    assert_canvas_rect(obj, 12, 12, 15, 15, 0x00ff00);
+}
+
+void test_gif_disposal_argb8888(void)
+{
+    disposal(LV_COLOR_FORMAT_ARGB8888);
+}
+
+void test_gif_disposal_rgb565(void)
+{
+    disposal(LV_COLOR_FORMAT_RGB565);
+}
+
+void test_gif_mem_leak(void)
+{
+    disposal(LV_COLOR_FORMAT_ARGB8888);
+    lv_obj_clean(lv_screen_active());
+    lv_refr_now(NULL);
+
+    size_t mem_before = lv_test_get_free_mem();
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        /*The buffer of the frame with "restore to previous" disposal is freed too*/
+        disposal(i % 2 ? LV_COLOR_FORMAT_RGB565 : LV_COLOR_FORMAT_ARGB8888);
+        lv_obj_clean(lv_screen_active());
+        lv_refr_now(NULL);
+    }
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 0);
+}
+
+void test_gif_transformed_invalidates_all(void)
+{
+    lv_obj_t * obj = lv_gif_create(lv_screen_active());
+    lv_gif_set_src(obj, &disposal_gif);
+    lv_image_set_scale(obj, 512);
+    lv_refr_now(NULL);
+
+    next_frame(obj);
+    lv_area_t a;
+    lv_obj_get_coords(obj, &a);
+    TEST_ASSERT_EQUAL(1, lv_display_get_default()->inv_p);
+    TEST_ASSERT_TRUE(lv_area_is_in(&a, &lv_display_get_default()->inv_areas[0], 0));
+}
+
+/**
+ * Play frames of a GIF and print the pixels and time needed per frame
+ * @param path      path to a GIF file
+ * @param cf        color format of the canvas
+ * @param inv_all   true: invalidate the whole widget on every frame as a reference
+ */
+static void bench_gif(const char * path, lv_color_format_t cf, bool inv_all)
+{
+    lv_obj_t * obj = lv_gif_create(lv_screen_active());
+    lv_gif_set_color_format(obj, cf);
+    lv_gif_set_src(obj, path);
+    TEST_ASSERT_TRUE(lv_gif_is_loaded(obj));
+    lv_obj_center(obj);
+    lv_refr_now(NULL);
+
+    uint64_t px_sum = 0;
+    uint64_t t_decode = 0;
+    uint64_t t_render = 0;
+    uint32_t i;
+    for(i = 0; i < BENCH_FRAME_CNT; i++) {
+        uint64_t t_start = lv_test_get_time_us();
+        next_frame(obj);
+        t_decode += lv_test_get_time_us() - t_start;
+
+        if(inv_all) lv_obj_invalidate(obj);
+        px_sum += get_inv_pixels();
+
+        t_start = lv_test_get_time_us();
+        lv_refr_now(NULL);
+        t_render += lv_test_get_time_us() - t_start;
+    }
+
+    if(!inv_all) {
+        /*The partially updated screen is the same as the fully redrawn one*/
+        lv_draw_buf_t * draw_buf = lv_display_get_buf_active(NULL);
+        uint32_t buf_size = draw_buf->header.stride * draw_buf->header.h;
+        uint8_t * partial = lv_malloc(buf_size);
+        TEST_ASSERT_NOT_NULL(partial);
+        lv_memcpy(partial, draw_buf->data, buf_size);
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(NULL);
+        TEST_ASSERT_EQUAL_MEMORY(partial, draw_buf->data, buf_size);
+        lv_free(partial);
+    }
+
+    const lv_image_dsc_t * dsc = &((lv_gif_t *)obj)->imgdsc;
+    uint32_t img_px = dsc->header.w * dsc->header.h;
+    TEST_PRINTF("%s %dx%d %s, %s: %d px per frame (%d%% of the image), decode %d us, render %d us per frame",
+                lv_fs_get_last(path), (int)dsc->header.w, (int)dsc->header.h,
+                cf == LV_COLOR_FORMAT_RGB565 ? "RGB565" : "ARGB8888", inv_all ? "whole widget" : "frame area",
+                (int)(px_sum / BENCH_FRAME_CNT), (int)(px_sum * 100 / BENCH_FRAME_CNT / img_px),
+                (int)(t_decode / BENCH_FRAME_CNT), (int)(t_render / BENCH_FRAME_CNT));
+
+    lv_obj_delete(obj);
+    lv_refr_now(NULL);
+}
+
+void test_gif_bench(void)
+{
+    static const char * paths[] = {
+        "A:src/test_assets/test_img_bulb.gif",
+        "A:src/test_assets/test_img_simple_button.gif",
+        "A:src/test_assets/test_img_button_style.gif",
+    };
+
+    uint32_t i;
+    for(i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        bench_gif(paths[i], LV_COLOR_FORMAT_ARGB8888, true);
+        bench_gif(paths[i], LV_COLOR_FORMAT_ARGB8888, false);
+        bench_gif(paths[i], LV_COLOR_FORMAT_RGB565, false);
+    }
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_gif_disposal_argb8888(void)
+{
+}
+
+void test_gif_disposal_rgb565(void)
+{
+}
+
+void test_gif_mem_leak(void)
+{
+}
+
+void test_gif_transformed_invalidates_all(void)
+{
+}
+
+void test_gif_bench(void)
+{
+}
+
+#endif
+
+#endif
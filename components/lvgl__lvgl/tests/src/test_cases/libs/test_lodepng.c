@@ -1,9 +1,16 @@
 #if LV_BUILD_TEST
 #include "../lvgl.h"
 #include "../../lvgl_private.h"
+#include "lv_test_init.h"
 
 #include "unity/unity.h"
 
+#include "../../src/libs/lodepng/lodepng.h"
+
+#include <stdio.h>
+
+#define BAND_TEST_W     320
+#define BAND_TEST_H     240
 
 void setUp(void)
 {
@@ -76,4 +83,322 @@ void test_lodepng_1(void)
     lv_libpng_init();
 }
 
+/**
+ * Copy a PNG with its image data split into 2 IDAT chunks
+ * @param png       the PNG data, it's freed
+ * @param size      size of the PNG data, updated with the new size
+ * @return          the new PNG data
+ */
+static uint8_t * png_split_idat(uint8_t * png, size_t * size)
+{
+    size_t out_size = 8;
+    uint8_t * out = lv_malloc(out_size);
+    TEST_ASSERT_NOT_NULL(out);
+    lv_memcpy(out, png, out_size);
+
+    const uint8_t * chunk = png + 8;
+    while(chunk < png + *size) {
+        unsigned len = lodepng_chunk_length(chunk);
+        if(lodepng_chunk_type_equals(chunk, "IDAT")) {
+            /*Cut the deflate stream at an arbitrary position*/
+            unsigned len1 = len / 3;
+            TEST_ASSERT_EQUAL(0, lodepng_chunk_create(&out, &out_size, len1, "IDAT", lodepng_chunk_data_const(chunk)));
+            TEST_ASSERT_EQUAL(0, lodepng_chunk_create(&out, &out_size, len - len1, "IDAT",
+                                                      lodepng_chunk_data_const(chunk) + len1));
+        }
+        else {
+            TEST_ASSERT_EQUAL(0, lodepng_chunk_append(&out, &out_size, chunk));
+        }
+
+        if(lodepng_chunk_type_equals(chunk, "IEND")) break;
+        chunk = lodepng_chunk_next_const(chunk, png + *size);
+    }
+
+    lv_free(png);
+    *size = out_size;
+    return out;
+}
+
+/**
+ * Encode a BAND_TEST_W x BAND_TEST_H test image
+ * @param alpha         true: RGBA; false: RGB
+ * @param stored        true: store the image data uncompressed
+ * @param split         true: split the image data into 2 IDAT chunks
+ * @param interlace     true: use Adam7 interlacing
+ * @param size          store the size of the PNG data here
+ * @return              the PNG data, free it with `lv_free`
+ */
+static uint8_t * png_create(bool alpha, bool stored, bool split, bool interlace, size_t * size)
+{
+    uint32_t px_size = alpha ? 4 : 3;
+    uint8_t * pixels = lv_malloc(BAND_TEST_W * BAND_TEST_H * px_size);
+    TEST_ASSERT_NOT_NULL(pixels);
+
+    uint8_t * p = pixels;
+    uint32_t rnd = 1;
+    uint32_t x, y;
+    for(y = 0; y < BAND_TEST_H; y++) {
+        for(x = 0; x < BAND_TEST_W; x++) {
+            rnd = rnd * 1103515245 + 12345;
+            p[0] = (uint8_t)(x * 255 / BAND_TEST_W);
+            p[1] = (uint8_t)(y * 255 / BAND_TEST_H);
+            p[2] = (uint8_t)((x ^ y) & 0xc0) | ((rnd >> 16) & 0x1f);
+            if(alpha) p[3] = (uint8_t)(x + y);
+            p += px_size;
+        }
+    }
+
+    LodePNGState state;
+    lodepng_state_init(&state);
+    state.info_raw.colortype = alpha ? LCT_RGBA : LCT_RGB;
+    state.info_raw.bitdepth = 8;
+    state.info_png.color.colortype = state.info_raw.colortype;
+    state.info_png.color.bitdepth = 8;
+    state.info_png.interlace_method = interlace ? 1 : 0;
+    state.encoder.auto_convert = 0;
+    if(stored) state.encoder.zlibsettings.btype = 0;
+
+    uint8_t * png = NULL;
+    TEST_ASSERT_EQUAL(0, lodepng_encode(&png, size, pixels, BAND_TEST_W, BAND_TEST_H, &state));
+    lodepng_state_cleanup(&state);
+    lv_free(pixels);
+
+    if(split) png = png_split_idat(png, size);
+    return png;
+}
+
+static void png_dsc_init(lv_image_dsc_t * dsc, const uint8_t * png, size_t png_size)
+{
+    lv_memzero(dsc, sizeof(lv_image_dsc_t));
+    dsc->header.magic = LV_IMAGE_HEADER_MAGIC;
+    dsc->header.cf = LV_COLOR_FORMAT_RAW_ALPHA;
+    dsc->header.w = BAND_TEST_W;
+    dsc->header.h = BAND_TEST_H;
+    dsc->data_size = png_size;
+    dsc->data = png;
+}
+
+typedef struct {
+    const uint8_t * data;
+    size_t size;
+} png_stream_t;
+
+/*Read the PNG in small pieces like a file*/
+static size_t png_stream_read_cb(void * user, size_t offset, unsigned char * buf, size_t size)
+{
+    png_stream_t * stream = user;
+    if(offset >= stream->size) return 0;
+    size = LV_MIN(size, stream->size - offset);
+    size = LV_MIN(size, 100);
+    lv_memcpy(buf, stream->data + offset, size);
+    return size;
+}
+
+/*Decode a PNG row by row and compare it with the whole decoded image*/
+static void rows_compare(const uint8_t * png, size_t png_size, bool stream)
+{
+    lv_draw_buf_t * full = NULL;
+    unsigned w, h;
+    TEST_ASSERT_EQUAL(0, lodepng_decode32((unsigned char **)&full, &w, &h, png, png_size));
+
+    LodePNGRowDecoder * rows;
+    png_stream_t png_stream = {png, png_size};
+    if(stream) TEST_ASSERT_EQUAL(0, lodepng_row_decoder_create_stream(&rows, png_stream_read_cb, &png_stream));
+    else TEST_ASSERT_EQUAL(0, lodepng_row_decoder_create(&rows, png, png_size));
+
+    LodePNGColorMode rgba_mode;
+    lodepng_color_mode_init(&rgba_mode);
+    uint8_t * rgba_row = lv_malloc(w * 4);
+    const unsigned char * row;
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        TEST_ASSERT_EQUAL(y, lodepng_row_decoder_get_y(rows));
+        TEST_ASSERT_EQUAL(0, lodepng_row_decoder_next(rows, &row));
+        TEST_ASSERT_EQUAL(0, lodepng_convert(rgba_row, row, &rgba_mode, lodepng_row_decoder_get_color(rows), w, 1));
+        TEST_ASSERT_EQUAL_MEMORY(full->data + y * w * 4, rgba_row, w * 4);
+    }
+
+    /*No more rows*/
+    TEST_ASSERT_NOT_EQUAL(0, lodepng_row_decoder_next(rows, &row));
+
+    TEST_ASSERT_EQUAL(0, lodepng_row_decoder_rewind(rows));
+    TEST_ASSERT_EQUAL(0, lodepng_row_decoder_next(rows, &row));
+    TEST_ASSERT_EQUAL(0, lodepng_convert(rgba_row, row, &rgba_mode, lodepng_row_decoder_get_color(rows), w, 1));
+    TEST_ASSERT_EQUAL_MEMORY(full->data, rgba_row, w * 4);
+
+    lodepng_row_decoder_delete(rows);
+    lv_free(rgba_row);
+    lv_draw_buf_destroy(full);
+}
+
+void test_lodepng_rows(void)
+{
+    size_t mem_before = lv_test_get_free_mem();
+
+    static const char * files[] = {
+        "A:src/test_assets/test_img_lvgl_logo.png",
+        "A:src/test_assets/test_img_lvgl_logo_8bit_palette.png",
+        "A:src/test_assets/test_img_emoji_F600.png",
+        "A:src/test_assets/test_arc_bg.png",
+    };
+
+    uint8_t * png;
+    size_t png_size;
+    uint32_t i;
+    for(i = 0; i < sizeof(files) / sizeof(files[0]); i++) {
+        TEST_ASSERT_EQUAL(0, lodepng_load_file(&png, &png_size, files[i]));
+        rows_compare(png, png_size, false);
+        rows_compare(png, png_size, true);
+        lv_free(png);
+    }
+
+    /*Stored and compressed blocks, split into IDAT chunks or not*/
+    for(i = 0; i < 8; i++) {
+        png = png_create(i & 1, i & 2, i & 4, false, &png_size);
+        rows_compare(png, png_size, false);
+        rows_compare(png, png_size, true);
+        lv_free(png);
+    }
+
+    /*Interlaced images can't be decoded row by row*/
+    LodePNGRowDecoder * rows;
+    png = png_create(true, false, false, true, &png_size);
+    TEST_ASSERT_EQUAL(116, lodepng_row_decoder_create(&rows, png, png_size));
+    lv_free(png);
+
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 32);
+}
+
+void test_lodepng_band_draw(void)
+{
+    lv_libpng_deinit();
+    lv_obj_clean(lv_screen_active());
+
+    size_t png_size;
+    uint8_t * png = png_create(true, false, true, false, &png_size);
+    lv_image_dsc_t dsc;
+    png_dsc_init(&dsc, png, png_size);
+
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, &dsc);
+    lv_obj_center(img);
+
+    /*Without cache the image is decoded in bands*/
+    uint32_t cache_size = lv_cache_get_max_size(LV_GLOBAL_DEFAULT()->img_cache, NULL);
+    lv_image_cache_resize(0, false);
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/png_band.png");
+
+    /*Decoded at once to the cache*/
+    lv_image_cache_resize(cache_size, false);
+    lv_obj_invalidate(img);
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/png_band.png");
+
+    lv_obj_clean(lv_screen_active());
+    lv_image_cache_drop(&dsc);
+    lv_free(png);
+    lv_libpng_init();
+}
+
+void test_lodepng_band_rotated(void)
+{
+    lv_libpng_deinit();
+    lv_obj_clean(lv_screen_active());
+
+    size_t png_size;
+    uint8_t * png = png_create(true, false, true, false, &png_size);
+    lv_image_dsc_t dsc;
+    png_dsc_init(&dsc, png, png_size);
+
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, &dsc);
+    lv_image_set_rotation(img, 300);
+    lv_image_set_scale(img, 200);
+    lv_obj_center(img);
+
+    /*Decoded at once to the cache*/
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/png_band_rotated.png");
+
+    /*Transformed images are sampled from the whole image, so they are not decoded in bands*/
+    uint32_t cache_size = lv_cache_get_max_size(LV_GLOBAL_DEFAULT()->img_cache, NULL);
+    lv_image_cache_resize(0, false);
+    lv_obj_invalidate(img);
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/png_band_rotated.png");
+
+    lv_image_cache_resize(cache_size, false);
+    lv_obj_clean(lv_screen_active());
+    lv_image_cache_drop(&dsc);
+    lv_free(png);
+    lv_libpng_init();
+}
+
+/*Decode an image in bands and return the memory used while decoding*/
+static size_t band_decode(const void * src)
+{
+    lv_image_decoder_args_t args = {
+        .stride_align = LV_DRAW_BUF_STRIDE_ALIGN != 1,
+        .no_cache = true,
+    };
+    lv_image_decoder_dsc_t decoder_dsc;
+    size_t mem_start = lv_test_get_free_mem();
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&decoder_dsc, src, &args));
+    TEST_ASSERT_NULL(decoder_dsc.decoded);
+
+    lv_area_t full_area = {0, 0, BAND_TEST_W - 1, BAND_TEST_H - 1};
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    size_t band_mem = 0;
+    int32_t y = 0;
+    while(lv_image_decoder_get_area(&decoder_dsc, &full_area, &decoded_area) == LV_RESULT_OK) {
+        if(band_mem == 0) band_mem = mem_start - lv_test_get_free_mem();
+        TEST_ASSERT_EQUAL(y, decoded_area.y1);
+        TEST_ASSERT_EQUAL(LV_MIN(LV_LODEPNG_BAND_HEIGHT, BAND_TEST_H - y), lv_area_get_height(&decoded_area));
+        y = decoded_area.y2 + 1;
+    }
+    TEST_ASSERT_EQUAL(BAND_TEST_H, y);
+    lv_image_decoder_close(&decoder_dsc);
+
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_start, 32);
+    return band_mem;
+}
+
+void test_lodepng_band_memory(void)
+{
+    lv_libpng_deinit();
+
+    size_t png_size;
+    uint8_t * png = png_create(true, false, false, false, &png_size);
+    lv_image_dsc_t dsc;
+    png_dsc_init(&dsc, png, png_size);
+    lv_image_decoder_dsc_t decoder_dsc;
+
+    /*Decode the whole image to the cache*/
+    size_t mem_start = lv_test_get_free_mem();
+    uint64_t t_start = lv_test_get_time_us();
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&decoder_dsc, &dsc, NULL));
+    uint32_t full_time = (uint32_t)(lv_test_get_time_us() - t_start);
+    TEST_ASSERT_NOT_NULL(decoder_dsc.decoded);
+    size_t full_mem = mem_start - lv_test_get_free_mem();
+    lv_image_decoder_close(&decoder_dsc);
+    lv_image_cache_drop(&dsc);
+
+    /*Decode in bands of LV_LODEPNG_BAND_HEIGHT rows*/
+    t_start = lv_test_get_time_us();
+    size_t band_mem = band_decode(&dsc);
+    uint32_t band_time = (uint32_t)(lv_test_get_time_us() - t_start);
+
+    /*The file is read piece by piece, not loaded*/
+    TEST_ASSERT_EQUAL(0, lodepng_save_file(png, png_size, "A:png_band_file.png"));
+    size_t file_mem = band_decode("A:png_band_file.png");
+    remove("png_band_file.png");
+
+    TEST_PRINTF("%dx%d RGBA PNG, whole image: %d bytes, %d us", BAND_TEST_W, BAND_TEST_H, (int)full_mem, (int)full_time);
+    TEST_PRINTF("%d rows bands: %d bytes, %d us", LV_LODEPNG_BAND_HEIGHT, (int)band_mem, (int)band_time);
+    TEST_PRINTF("%d rows bands from file: %d bytes (PNG file: %d bytes)", LV_LODEPNG_BAND_HEIGHT, (int)file_mem,
+                (int)png_size);
+    TEST_ASSERT_LESS_THAN(full_mem / 4, band_mem);
+    TEST_ASSERT_LESS_THAN(band_mem + png_size / 2, file_mem);
+
+    lv_free(png);
+    lv_libpng_init();
+}
+
 #endif
@@ -1,6 +1,7 @@
 #if LV_BUILD_TEST
 #include "../lvgl.h"
 #include "../../lvgl_private.h"
+#include "lv_test_init.h"
 
 #include "unity/unity.h"
 
@@ -100,4 +101,124 @@ void test_jdpgd_align_tile(void)
     lv_libjpeg_turbo_init();
 }
 
+#define STRIPE_H            50
+#define BENCH_CYCLE_CNT     20
+
+/**
+ * Decode the MCUs of a stripe of an image
+ * @param dsc       pointer to an opened decoder descriptor
+ * @param y         first row of the stripe
+ * @param sum       the sum of the decoded bytes is added to it
+ * @return          the time of decoding in microseconds
+ */
+static uint32_t decode_stripe(lv_image_decoder_dsc_t * dsc, int32_t y, uint32_t * sum)
+{
+    lv_area_t full_area = {0, y, dsc->header.w - 1, LV_MIN(y + STRIPE_H, dsc->header.h) - 1};
+    lv_area_t decoded_area;
+    decoded_area.y1 = LV_COORD_MIN;
+
+    uint64_t t_start = lv_test_get_time_us();
+    while(lv_image_decoder_get_area(dsc, &full_area, &decoded_area) == LV_RESULT_OK) {
+        const lv_draw_buf_t * decoded = dsc->decoded;
+        TEST_ASSERT_TRUE(lv_area_is_on(&full_area, &decoded_area));
+        uint32_t i;
+        for(i = 0; i < decoded->data_size; i++) *sum += decoded->data[i];
+    }
+    return (uint32_t)(lv_test_get_time_us() - t_start);
+}
+
+void test_tjpgd_stripe_bench(void)
+{
+    /* Temporarily remove libjpeg_turbo decoder */
+    lv_libjpeg_turbo_deinit();
+
+    const char * src = "A:src/test_assets/test_img_flower.jpg";
+    lv_image_decoder_dsc_t dsc;
+    int32_t y;
+    for(y = 0; y < 149; y += STRIPE_H) {
+        uint32_t t_no_index = 0;
+        uint32_t t_index = 0;
+        uint32_t sum_no_index = 0;
+        uint32_t sum_index = 0;
+        uint32_t i;
+        for(i = 0; i < BENCH_CYCLE_CNT; i++) {
+            /*Without the index every stripe is decoded from the top of the image*/
+            lv_tjpgd_deinit();
+            lv_tjpgd_init();
+            TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, NULL));
+            t_no_index += decode_stripe(&dsc, y, &sum_no_index);
+            lv_image_decoder_close(&dsc);
+
+            /*Now the MCU rows above the stripe are indexed*/
+            TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, NULL));
+            t_index += decode_stripe(&dsc, y, &sum_index);
+            lv_image_decoder_close(&dsc);
+        }
+
+        TEST_ASSERT_EQUAL_UINT32(sum_no_index, sum_index);
+        TEST_PRINTF("tjpgd %dx%d, rows %d..%d: %d us without and %d us with the MCU row index",
+                    (int)dsc.header.w, (int)dsc.header.h, (int)y, (int)LV_MIN(y + STRIPE_H, dsc.header.h) - 1,
+                    (int)(t_no_index / BENCH_CYCLE_CNT), (int)(t_index / BENCH_CYCLE_CNT));
+    }
+
+    /* Re-add libjpeg_turbo decoder */
+    lv_libjpeg_turbo_init();
+}
+
+void test_tjpgd_many_sessions(void)
+{
+    /* Temporarily remove libjpeg_turbo decoder */
+    lv_libjpeg_turbo_deinit();
+
+    /*More images than the number of kept MCU row indexes. The index is kept per path.*/
+    const char * srcs[] = {
+        "A:src/test_assets/test_img_flower.jpg",
+        "A:src/test_assets/./test_img_flower.jpg",
+        "A:src/./test_assets/test_img_flower.jpg",
+        "A:./src/test_assets/test_img_flower.jpg",
+        "A:src/test_assets/test_img_lvgl_logo.jpg",
+        "A:src/test_assets/./test_img_lvgl_logo.jpg",
+    };
+    const uint32_t src_cnt = sizeof(srcs) / sizeof(srcs[0]);
+    lv_image_decoder_dsc_t dscs[sizeof(srcs) / sizeof(srcs[0])];
+    uint32_t sums_ref[sizeof(srcs) / sizeof(srcs[0])];
+    uint32_t sums[sizeof(srcs) / sizeof(srcs[0])];
+    uint32_t i;
+    int32_t y;
+
+    /*Decode the images one by one*/
+    for(i = 0; i < src_cnt; i++) {
+        sums_ref[i] = 0;
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dscs[i], srcs[i], NULL));
+        for(y = 0; y < (int32_t)dscs[i].header.h; y += STRIPE_H) decode_stripe(&dscs[i], y, &sums_ref[i]);
+        lv_image_decoder_close(&dscs[i]);
+    }
+
+    size_t mem_before = lv_test_get_free_mem();
+
+    /*Keep all of them open and decode them stripe by stripe in turns.
+     *The indexes in use must not be deleted when the others are added.*/
+    for(i = 0; i < src_cnt; i++) {
+        sums[i] = 0;
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dscs[i], srcs[i], NULL));
+    }
+
+    for(y = 0; y < 200; y += STRIPE_H) {
+        for(i = 0; i < src_cnt; i++) {
+            if(y < (int32_t)dscs[i].header.h) decode_stripe(&dscs[i], y, &sums[i]);
+        }
+    }
+
+    for(i = 0; i < src_cnt; i++) {
+        lv_image_decoder_close(&dscs[i]);
+        TEST_ASSERT_EQUAL_UINT32(sums_ref[i], sums[i]);
+    }
+
+    /*The extra indexes are deleted when they are not used anymore*/
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 32);
+
+    /* Re-add libjpeg_turbo decoder */
+    lv_libjpeg_turbo_init();
+}
+
 #endif
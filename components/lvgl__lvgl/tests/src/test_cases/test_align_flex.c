@@ -170,5 +170,40 @@ void test_flex_hide_items(void)
     TEST_ASSERT_EQUAL_SCREENSHOT("flex_hide_items.png");
 }
 
+void test_flex_measure_changed(void)
+{
+    lv_obj_t * cont = create_row(LV_FLEX_ALIGN_START, 3);
+    lv_obj_t * child1 = lv_obj_get_child(cont, 1);
+    lv_obj_t * child2 = lv_obj_get_child(cont, 2);
+    lv_obj_set_style_pad_column(cont, 0, 0);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(80, lv_obj_get_x(child2));
+
+    /*The measured values of the changed children can't be used anymore*/
+    lv_obj_set_style_margin_left(child1, 10, 0);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(50, lv_obj_get_x(child1));
+    TEST_ASSERT_EQUAL_INT32(90, lv_obj_get_x(child2));
+
+    lv_obj_set_flex_grow(child2, 1);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(lv_obj_get_content_width(cont) - 90, lv_obj_get_width(child2));
+
+    /*The container's style is used too*/
+    lv_obj_set_style_pad_column(cont, 5, 0);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(100, lv_obj_get_x(child2));
+
+    /*A new child at the address of a deleted one must be measured too*/
+    lv_obj_delete(child1);
+    lv_obj_t * child = lv_obj_create(cont);
+    lv_obj_set_size(child, 40, 40);
+    lv_obj_move_to_index(child, 1);
+    simple_style(child);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(45, lv_obj_get_x(child));
+    TEST_ASSERT_EQUAL_INT32(90, lv_obj_get_x(child2));
+}
+
 
 #endif
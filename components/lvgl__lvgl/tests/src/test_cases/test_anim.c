@@ -1,9 +1,16 @@
 #if LV_BUILD_TEST
 #include "../lvgl.h"
 #include "../../lvgl_private.h"
+#include "lv_test_init.h"
 
 #include "unity/unity.h"
 
+#define MANY_ANIM_CNT       64
+#define BENCH_ANIM_CNT      600
+#define BENCH_ROUND_CNT     20
+
+static lv_anim_t * anim_to_delete;
+
 
 void setUp(void)
 {
@@ -29,6 +36,32 @@ static void custom_exec_cb(lv_anim_t * a, int32_t v)
     *var_i32 = v;
 }
 
+static void exec_2_cb(void * var, int32_t v)
+{
+    int32_t * var_i32 = var;
+    *var_i32 = -v;
+}
+
+static void delete_other_completed_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    if(anim_to_delete) {
+        lv_anim_delete(anim_to_delete->var, NULL);
+        anim_to_delete = NULL;
+    }
+}
+
+static lv_anim_t * start_anim(int32_t * var, lv_anim_exec_xcb_t cb, uint32_t duration)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, var);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_exec_cb(&a, cb);
+    lv_anim_set_duration(&a, duration);
+    return lv_anim_start(&a);
+}
+
 void test_anim_delete(void)
 {
     int32_t var;
@@ -193,4 +226,149 @@ void test_scroll_anim_delete(void)
     TEST_ASSERT_EQUAL(1, var);
 }
 
+void test_anim_many_vars(void)
+{
+    static int32_t vars[MANY_ANIM_CNT];
+    lv_anim_t * anims[MANY_ANIM_CNT];
+    uint32_t i;
+    for(i = 0; i < MANY_ANIM_CNT; i++) {
+        anims[i] = start_anim(&vars[i], exec_cb, 100);
+        start_anim(&vars[i], exec_2_cb, 100);
+    }
+    TEST_ASSERT_EQUAL(2 * MANY_ANIM_CNT, lv_anim_count_running());
+
+    /*Starting the same `var` and `exec_cb` again replaces the animation*/
+    for(i = 0; i < MANY_ANIM_CNT; i += 2) {
+        anims[i] = start_anim(&vars[i], exec_cb, 200);
+    }
+    TEST_ASSERT_EQUAL(2 * MANY_ANIM_CNT, lv_anim_count_running());
+
+    for(i = 0; i < MANY_ANIM_CNT; i++) {
+        TEST_ASSERT_EQUAL_PTR(anims[i], lv_anim_get(&vars[i], exec_cb));
+        TEST_ASSERT_NOT_NULL(lv_anim_get(&vars[i], exec_2_cb));
+    }
+
+    /*Delete by `var` only the given animations*/
+    for(i = 0; i < MANY_ANIM_CNT; i += 4) {
+        TEST_ASSERT_TRUE(lv_anim_delete(&vars[i], NULL));
+        TEST_ASSERT_FALSE(lv_anim_delete(&vars[i], NULL));
+    }
+    for(i = 1; i < MANY_ANIM_CNT; i += 4) {
+        TEST_ASSERT_TRUE(lv_anim_delete(&vars[i], exec_2_cb));
+    }
+    TEST_ASSERT_EQUAL(2 * MANY_ANIM_CNT - 2 * MANY_ANIM_CNT / 4 - MANY_ANIM_CNT / 4, lv_anim_count_running());
+    for(i = 0; i < MANY_ANIM_CNT; i++) {
+        TEST_ASSERT_EQUAL(i % 4 != 0, lv_anim_get(&vars[i], exec_cb) != NULL);
+        TEST_ASSERT_EQUAL(i % 4 > 1, lv_anim_get(&vars[i], exec_2_cb) != NULL);
+    }
+
+    /*The short animations are completed, the long ones are still running*/
+    lv_test_wait(150);
+    for(i = 0; i < MANY_ANIM_CNT; i++) {
+        if(i % 4 == 0) continue;
+        if(i % 2) TEST_ASSERT_NULL(lv_anim_get(&vars[i], exec_cb));
+        else TEST_ASSERT_NOT_NULL(lv_anim_get(&vars[i], exec_cb));
+    }
+
+    lv_test_wait(100);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+}
+
+void test_anim_delete_in_completed_cb(void)
+{
+    int32_t var1 = 0;
+    int32_t var2 = 0;
+    int32_t var3 = 0;
+    int32_t var4 = 0;
+
+    /*When `var1` is completed it deletes the animation of `var2` which is handled right after it.
+     *The other animations should still run normally.*/
+    start_anim(&var4, exec_cb, 100);
+    start_anim(&var3, exec_cb, 100);
+    anim_to_delete = start_anim(&var2, exec_cb, 100);
+    lv_anim_t * a1 = start_anim(&var1, exec_cb, 50);
+    lv_anim_set_completed_cb(a1, delete_other_completed_cb);
+
+    lv_test_wait(60);
+    TEST_ASSERT_EQUAL(100, var1);
+    TEST_ASSERT_NULL(anim_to_delete);
+    TEST_ASSERT_NULL(lv_anim_get(&var2, NULL));
+    int32_t var2_deleted = var2;
+
+    lv_test_wait(60);
+    TEST_ASSERT_EQUAL(var2_deleted, var2);
+    TEST_ASSERT_EQUAL(100, var3);
+    TEST_ASSERT_EQUAL(100, var4);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+}
+
+void test_anim_set_var_running(void)
+{
+    int32_t var1 = 0;
+    int32_t var2 = 0;
+
+    lv_anim_t * a = start_anim(&var1, exec_cb, 100);
+    lv_anim_set_var(a, &var2);
+
+    /*The running animation has to be found by its new `var`*/
+    TEST_ASSERT_NULL(lv_anim_get(&var1, exec_cb));
+    TEST_ASSERT_EQUAL_PTR(a, lv_anim_get(&var2, exec_cb));
+
+    /*Starting it again for the new `var` replaces it*/
+    lv_anim_t * a2 = start_anim(&var2, exec_cb, 100);
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+    TEST_ASSERT_EQUAL_PTR(a2, lv_anim_get(&var2, exec_cb));
+
+    /*A descriptor which is not running is just updated*/
+    lv_anim_t local;
+    lv_anim_init(&local);
+    lv_anim_set_var(&local, &var1);
+    TEST_ASSERT_EQUAL_PTR(&var1, local.var);
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+
+    TEST_ASSERT_TRUE(lv_anim_delete(&var2, exec_cb));
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+}
+
+void test_anim_bench(void)
+{
+    static int32_t vars[BENCH_ANIM_CNT];
+    uint32_t i;
+    uint32_t r;
+
+    /*Start staggered list entry like animations, each of them checks the concurrent animations*/
+    uint64_t t_start = lv_test_get_time_us();
+    for(r = 0; r < BENCH_ROUND_CNT; r++) {
+        for(i = 0; i < BENCH_ANIM_CNT; i++) {
+            lv_anim_t a;
+            lv_anim_init(&a);
+            lv_anim_set_var(&a, &vars[i]);
+            lv_anim_set_values(&a, 0, 1000);
+            lv_anim_set_exec_cb(&a, exec_cb);
+            lv_anim_set_path_cb(&a, i % 2 ? lv_anim_path_ease_out : lv_anim_path_linear);
+            lv_anim_set_duration(&a, 300);
+            lv_anim_set_delay(&a, i % 50);
+            lv_anim_start(&a);
+        }
+    }
+    uint64_t t_create = lv_test_get_time_us() - t_start;
+    TEST_ASSERT_EQUAL(BENCH_ANIM_CNT, lv_anim_count_running());
+
+    /*Run until all of them are completed (duration + max. delay)*/
+    uint32_t round_cnt = (300 + 50) / LV_DEF_REFR_PERIOD + 1;
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < round_cnt; i++) {
+        lv_tick_inc(LV_DEF_REFR_PERIOD);
+        lv_anim_refr_now();
+    }
+    uint64_t t_run = lv_test_get_time_us() - t_start;
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_EQUAL(1000, vars[0]);
+    TEST_ASSERT_EQUAL(1000, vars[BENCH_ANIM_CNT - 1]);
+
+    TEST_PRINTF("hash index %d, %d anims: start %d ns, anim timer %d us/round",
+                LV_ANIM_HASH_INDEX, BENCH_ANIM_CNT, (int)(t_create * 1000 / (BENCH_ROUND_CNT * BENCH_ANIM_CNT)),
+                (int)(t_run / round_cnt));
+}
+
 #endif
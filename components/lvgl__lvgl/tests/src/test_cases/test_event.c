@@ -1,9 +1,13 @@
 #if LV_BUILD_TEST
 #include "../lvgl.h"
 #include "../../lvgl_private.h"
+#include "lv_test_init.h"
 
 #include "unity/unity.h"
 
+#define BENCH_OBJ_CNT       1000
+#define BENCH_ROUND_CNT     100
+
 static void event_object_deletion_cb(const lv_obj_class_t * cls, lv_event_t * e)
 {
     LV_UNUSED(cls);
@@ -142,4 +146,105 @@ void test_event_delete_obj_in_recursive_event_call(void)
     lv_test_mouse_click_at(30, 30);
 }
 
+static uint32_t filter_cnt;
+static void event_count_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    filter_cnt++;
+}
+
+void test_event_filter_mask(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_event_list_t * list;
+    uint32_t custom_code = lv_event_register_id();
+
+    filter_cnt = 0;
+    lv_event_dsc_t * dsc_clicked = lv_obj_add_event_cb(obj, event_count_cb, LV_EVENT_CLICKED, NULL);
+    lv_event_dsc_t * dsc_custom = lv_obj_add_event_cb(obj, event_count_cb, (lv_event_code_t)custom_code, NULL);
+    list = &obj->spec_attr->event_list;
+    TEST_ASSERT_FALSE(list->has_preprocess);
+
+    lv_obj_send_event(obj, LV_EVENT_READY, NULL);
+    lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    TEST_ASSERT_EQUAL(0, filter_cnt);
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, NULL);
+    lv_obj_send_event(obj, (lv_event_code_t)custom_code, NULL);
+    TEST_ASSERT_EQUAL(2, filter_cnt);
+
+    /*A callback for all events receives everything*/
+    lv_event_dsc_t * dsc_all = lv_obj_add_event_cb(obj, event_count_cb, LV_EVENT_ALL | LV_EVENT_PREPROCESS, NULL);
+    TEST_ASSERT_TRUE(list->has_preprocess);
+    filter_cnt = 0;
+    lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, NULL);
+    TEST_ASSERT_EQUAL(3, filter_cnt);
+
+    /*The mask is rebuilt when a callback is removed*/
+    lv_obj_remove_event_dsc(obj, dsc_all);
+    TEST_ASSERT_FALSE(list->has_preprocess);
+    TEST_ASSERT_NOT_EQUAL(UINT64_MAX, list->code_mask);
+    filter_cnt = 0;
+    lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, NULL);
+    TEST_ASSERT_EQUAL(1, filter_cnt);
+
+    lv_obj_remove_event_dsc(obj, dsc_clicked);
+    lv_obj_remove_event_dsc(obj, dsc_custom);
+    TEST_ASSERT_EQUAL(0, list->code_mask);
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, NULL);
+    TEST_ASSERT_EQUAL(1, filter_cnt);
+
+    lv_obj_delete(obj);
+}
+
+void test_event_bench(void)
+{
+    /*Buttons with a click callback as in a typical UI*/
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    uint32_t i;
+    for(i = 0; i < BENCH_OBJ_CNT; i++) {
+        lv_obj_t * btn = lv_button_create(cont);
+        lv_obj_set_size(btn, 20, 20);
+        lv_obj_add_event_cb(btn, event_count_cb, LV_EVENT_CLICKED, NULL);
+    }
+    lv_obj_update_layout(cont);
+
+    /*The user callbacks are checked twice (preprocess and normal) for the events sent to
+     *every object in every frame. Send only to the event lists to measure this part of the dispatch
+     *without the class event handlers.*/
+    static const lv_event_code_t codes[] = {LV_EVENT_COVER_CHECK, LV_EVENT_REFR_EXT_DRAW_SIZE, LV_EVENT_DRAW_MAIN_BEGIN,
+                                            LV_EVENT_DRAW_MAIN, LV_EVENT_DRAW_MAIN_END, LV_EVENT_DRAW_POST_BEGIN,
+                                            LV_EVENT_DRAW_POST, LV_EVENT_DRAW_POST_END
+                                           };
+    lv_event_t e;
+    lv_memzero(&e, sizeof(e));
+    filter_cnt = 0;
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_ROUND_CNT; i++) {
+        uint32_t j;
+        for(j = 0; j < BENCH_OBJ_CNT; j++) {
+            lv_obj_t * btn = cont->spec_attr->children[j];
+            e.current_target = btn;
+            e.original_target = btn;
+            uint32_t k;
+            for(k = 0; k < sizeof(codes) / sizeof(codes[0]); k++) {
+                e.code = codes[k];
+                lv_event_send(&btn->spec_attr->event_list, &e, true);
+                lv_event_send(&btn->spec_attr->event_list, &e, false);
+            }
+        }
+    }
+    uint64_t t = lv_test_get_time_us() - t_start;
+    TEST_ASSERT_EQUAL(0, filter_cnt);
+
+    uint32_t event_cnt = BENCH_OBJ_CNT * sizeof(codes) / sizeof(codes[0]);
+    TEST_PRINTF("%d buttons with a click callback: %d us per frame to dispatch %d events to the callbacks",
+                BENCH_OBJ_CNT, (int)(t / BENCH_ROUND_CNT), (int)event_cnt);
+
+    lv_obj_delete(cont);
+}
+
 #endif
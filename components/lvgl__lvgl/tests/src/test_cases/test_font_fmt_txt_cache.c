@@ -0,0 +1,251 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_init.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_CACHE_SIZE > 0 && LV_FONT_MONTSERRAT_28_COMPRESSED && LV_FONT_MONTSERRAT_28
+
+#define BENCH_ROUND_CNT 20
+
+/*A speed readout and some text*/
+static const char * digits = "0123456789";
+static const char * bench_texts[] = {"87.5 km/h", "88.1 km/h", "88.9 km/h", "89.4 km/h", "90.0 km/h", "Speed"};
+
+void setUp(void)
+{
+    lv_font_fmt_txt_cache_drop(NULL);
+    lv_font_fmt_txt_cache_resize(LV_FONT_FMT_TXT_CACHE_SIZE);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_font_fmt_txt_cache_drop(NULL);
+    lv_font_fmt_txt_cache_resize(LV_FONT_FMT_TXT_CACHE_SIZE);
+}
+
+/*Get the bitmap of a letter into `draw_buf`, return its size in bytes*/
+static uint32_t get_bitmap(const lv_font_t * font, uint32_t letter, lv_draw_buf_t * draw_buf)
+{
+    lv_font_glyph_dsc_t g_dsc;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g_dsc, letter, 0));
+    lv_memzero(draw_buf->data, draw_buf->data_size);
+    TEST_ASSERT_EQUAL_PTR(draw_buf, lv_font_get_glyph_bitmap(&g_dsc, draw_buf));
+    return lv_draw_buf_width_to_stride(g_dsc.box_w, LV_COLOR_FORMAT_A8) * g_dsc.box_h;
+}
+
+void test_font_fmt_txt_cache_bitmap(void)
+{
+    const lv_font_t * font = &lv_font_montserrat_28_compressed;
+    lv_draw_buf_t * ref_buf = lv_draw_buf_create(64, 64, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    lv_draw_buf_t * buf = lv_draw_buf_create(64, 64, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+
+    lv_font_fmt_txt_cache_info_t info_start;
+    lv_font_fmt_txt_cache_get_info(&info_start);
+
+    const char * letters = "0123456789AbgW@%";
+    uint32_t i;
+    for(i = 0; letters[i]; i++) {
+        /*Without the cache*/
+        lv_font_fmt_txt_cache_resize(0);
+        uint32_t size = get_bitmap(font, letters[i], ref_buf);
+
+        /*Decompressed into the cache and copied from there*/
+        lv_font_fmt_txt_cache_resize(LV_FONT_FMT_TXT_CACHE_SIZE);
+        TEST_ASSERT_EQUAL(size, get_bitmap(font, letters[i], buf));
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf->data, buf->data, size);
+
+        TEST_ASSERT_EQUAL(size, get_bitmap(font, letters[i], buf));
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf->data, buf->data, size);
+    }
+
+    /*Every letter was decompressed once into the cache and found there once*/
+    lv_font_fmt_txt_cache_info_t info;
+    lv_font_fmt_txt_cache_get_info(&info);
+    TEST_ASSERT_EQUAL(i, info.miss_cnt - info_start.miss_cnt);
+    TEST_ASSERT_EQUAL(i, info.hit_cnt - info_start.hit_cnt);
+    TEST_ASSERT_GREATER_THAN(0, info.size);
+    TEST_ASSERT_LESS_OR_EQUAL(LV_FONT_FMT_TXT_CACHE_SIZE, info.size);
+
+    /*The uncompressed font is not cached*/
+    get_bitmap(&lv_font_montserrat_28, 'A', buf);
+    lv_font_fmt_txt_cache_info_t info_plain;
+    lv_font_fmt_txt_cache_get_info(&info_plain);
+    TEST_ASSERT_EQUAL(info.miss_cnt, info_plain.miss_cnt);
+    TEST_ASSERT_EQUAL(info.hit_cnt, info_plain.hit_cnt);
+
+    /*Dropping the font frees its glyphs*/
+    lv_font_fmt_txt_cache_drop(font);
+    lv_font_fmt_txt_cache_get_info(&info);
+    TEST_ASSERT_EQUAL(0, info.size);
+
+    lv_draw_buf_destroy(ref_buf);
+    lv_draw_buf_destroy(buf);
+}
+
+void test_font_fmt_txt_cache_warm_up_and_evict(void)
+{
+    const lv_font_t * font = &lv_font_montserrat_28_compressed;
+
+    TEST_ASSERT_EQUAL(10, lv_font_fmt_txt_cache_warm_up(font, digits));
+    /*Space has no bitmap and the font has no Cyrillic letters*/
+    TEST_ASSERT_EQUAL(2, lv_font_fmt_txt_cache_warm_up(font, "a bж"));
+    TEST_ASSERT_EQUAL(0, lv_font_fmt_txt_cache_warm_up(&lv_font_montserrat_28, digits));
+
+    lv_font_fmt_txt_cache_info_t info_start;
+    lv_font_fmt_txt_cache_get_info(&info_start);
+
+    /*The warmed up digits are not decompressed again*/
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text(label, "9876543210");
+    lv_refr_now(NULL);
+
+    lv_font_fmt_txt_cache_info_t info;
+    lv_font_fmt_txt_cache_get_info(&info);
+    TEST_ASSERT_EQUAL(info_start.miss_cnt, info.miss_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(info_start.hit_cnt + 10, info.hit_cnt);
+
+    /*The least recently used glyphs are evicted when the cache is shrunk*/
+    lv_font_fmt_txt_cache_resize(info.size / 2);
+    lv_font_fmt_txt_cache_get_info(&info);
+    TEST_ASSERT_LESS_OR_EQUAL(info.max_size, info.size);
+    TEST_ASSERT_GREATER_THAN(0, info.size);
+
+    /*The screen is the same with or without the cache*/
+    lv_obj_invalidate(label);
+    lv_refr_now(NULL);
+    lv_font_fmt_txt_cache_resize(0);
+    lv_obj_invalidate(label);
+    lv_refr_now(NULL);
+    lv_font_fmt_txt_cache_get_info(&info);
+    TEST_ASSERT_EQUAL(0, info.size);
+}
+
+#if LV_USE_OS == LV_OS_PTHREAD
+
+#include <pthread.h>
+
+#define THREAD_CNT          4
+#define THREAD_ROUND_CNT    200
+
+static void * thread_cb(void * arg)
+{
+    LV_UNUSED(arg);
+    lv_draw_buf_t * buf = lv_draw_buf_create(64, 64, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    uint32_t round;
+    for(round = 0; round < THREAD_ROUND_CNT; round++) {
+        uint32_t i;
+        for(i = 0; digits[i]; i++) get_bitmap(&lv_font_montserrat_28_compressed, digits[i], buf);
+    }
+
+    lv_draw_buf_destroy(buf);
+    return NULL;
+}
+
+void test_font_fmt_txt_cache_threads(void)
+{
+    lv_cache_t * cache = LV_GLOBAL_DEFAULT()->font_fmt_txt_cache.cache;
+    TEST_ASSERT_NOT_NULL(cache);
+
+    lv_font_fmt_txt_cache_info_t info_start;
+    lv_font_fmt_txt_cache_get_info(&info_start);
+
+    pthread_t threads[THREAD_CNT];
+    uint32_t i;
+    for(i = 0; i < THREAD_CNT; i++) pthread_create(&threads[i], NULL, thread_cb, NULL);
+    for(i = 0; i < THREAD_CNT; i++) pthread_join(threads[i], NULL);
+
+    /*Each glyph was counted once, as a hit or as a miss, and the cache created in `lv_init` was used*/
+    lv_font_fmt_txt_cache_info_t info;
+    lv_font_fmt_txt_cache_get_info(&info);
+    uint32_t digit_cnt = lv_strlen(digits);
+    TEST_ASSERT_EQUAL(digit_cnt, info.miss_cnt - info_start.miss_cnt);
+    TEST_ASSERT_EQUAL(THREAD_CNT * THREAD_ROUND_CNT * digit_cnt,
+                      (info.hit_cnt - info_start.hit_cnt) + (info.miss_cnt - info_start.miss_cnt));
+    TEST_ASSERT_EQUAL_PTR(cache, LV_GLOBAL_DEFAULT()->font_fmt_txt_cache.cache);
+}
+
+#else
+
+void test_font_fmt_txt_cache_threads(void)
+{
+}
+
+#endif
+
+static uint64_t bench_font(const lv_font_t * font)
+{
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_obj_center(label);
+
+    uint32_t text_cnt = sizeof(bench_texts) / sizeof(bench_texts[0]);
+    uint32_t i;
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_ROUND_CNT * text_cnt; i++) {
+        lv_label_set_text_static(label, bench_texts[i % text_cnt]);
+        lv_refr_now(NULL);
+    }
+    uint64_t t = lv_test_get_time_us() - t_start;
+
+    lv_obj_delete(label);
+    return t / (BENCH_ROUND_CNT * text_cnt);
+}
+
+void test_font_fmt_txt_cache_bench(void)
+{
+    uint64_t t_plain = bench_font(&lv_font_montserrat_28);
+
+    lv_font_fmt_txt_cache_resize(0);
+    uint64_t t_compressed = bench_font(&lv_font_montserrat_28_compressed);
+
+    lv_font_fmt_txt_cache_resize(LV_FONT_FMT_TXT_CACHE_SIZE);
+    lv_font_fmt_txt_cache_info_t info_start;
+    lv_font_fmt_txt_cache_get_info(&info_start);
+    uint64_t t_cached = bench_font(&lv_font_montserrat_28_compressed);
+
+    lv_font_fmt_txt_cache_info_t info;
+    lv_font_fmt_txt_cache_get_info(&info);
+    uint32_t hit_cnt = info.hit_cnt - info_start.hit_cnt;
+    uint32_t miss_cnt = info.miss_cnt - info_start.miss_cnt;
+    TEST_ASSERT_GREATER_THAN(miss_cnt, hit_cnt);
+
+    TEST_PRINTF("montserrat 28 label refresh: uncompressed %d us, compressed %d us, compressed + %d byte cache %d us "
+                "(%d hits, %d misses)", (int)t_plain, (int)t_compressed, LV_FONT_FMT_TXT_CACHE_SIZE, (int)t_cached,
+                (int)hit_cnt, (int)miss_cnt);
+}
+
+#else
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_font_fmt_txt_cache_bitmap(void)
+{
+}
+
+void test_font_fmt_txt_cache_warm_up_and_evict(void)
+{
+}
+
+void test_font_fmt_txt_cache_bench(void)
+{
+}
+
+void test_font_fmt_txt_cache_threads(void)
+{
+}
+
+#endif
+
+#endif
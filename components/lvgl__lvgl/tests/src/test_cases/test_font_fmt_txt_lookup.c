@@ -0,0 +1,219 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_init.h"
+
+#include "unity/unity.h"
+
+#if LV_FONT_FMT_TXT_LOOKUP_TABLE && LV_FONT_MONTSERRAT_14 && LV_FONT_DEJAVU_16_PERSIAN_HEBREW \
+    && LV_FONT_SOURCE_HAN_SANS_SC_16_CJK
+
+#define LETTER_CNT          0x10100
+#define BENCH_ROUND_CNT     2000
+
+extern lv_font_t test_font_1;
+
+static uint32_t ref_gids[LETTER_CNT];
+
+static const char * bench_ascii = "The quick brown fox jumps over the lazy dog 0123456789";
+static const char * bench_latin1 = "Größe, Fußgänger, déjà vu, señor, Ærøskøbing";
+static const char * bench_hebrew = "שלום עולם, ברוכים הבאים";
+static const char * bench_cjk = "我们的键盘上有一个按钮，请按下它以继续操作。";
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+typedef struct {
+    lv_font_t font;
+    lv_font_fmt_txt_dsc_t dsc;
+} font_copy_t;
+
+/*The lookup tables are attached to the font's descriptor, so use a copy of the constant fonts*/
+static lv_font_t * font_copy(font_copy_t * copy, const lv_font_t * font)
+{
+    copy->font = *font;
+    copy->dsc = *(const lv_font_fmt_txt_dsc_t *)font->dsc;
+    copy->font.dsc = &copy->dsc;
+    return &copy->font;
+}
+
+static uint32_t get_gid(const lv_font_t * font, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g_dsc;
+    lv_memzero(&g_dsc, sizeof(g_dsc));
+    if(!lv_font_get_glyph_dsc(font, &g_dsc, letter, 0)) return 0;
+    if(g_dsc.is_placeholder || g_dsc.resolved_font != font) return 0;
+    return g_dsc.gid.index;
+}
+
+static void check_glyph_ids(const lv_font_t * font_const)
+{
+    font_copy_t copy;
+    lv_font_t * font = font_copy(&copy, font_const);
+
+    uint32_t letter;
+    for(letter = 0; letter < LETTER_CNT; letter++) {
+        ref_gids[letter] = get_gid(font, letter);
+    }
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_font_fmt_txt_lookup_create(font));
+    TEST_ASSERT_NOT_NULL(copy.dsc.lookup);
+    for(letter = 0; letter < LETTER_CNT; letter++) {
+        TEST_ASSERT_EQUAL(ref_gids[letter], get_gid(font, letter));
+    }
+
+    lv_font_fmt_txt_lookup_delete(font);
+    TEST_ASSERT_NULL(copy.dsc.lookup);
+}
+
+void test_font_fmt_txt_lookup_glyph_ids(void)
+{
+    check_glyph_ids(&lv_font_montserrat_14);
+    check_glyph_ids(&lv_font_dejavu_16_persian_hebrew);
+    check_glyph_ids(&lv_font_source_han_sans_sc_16_cjk);
+    check_glyph_ids(&test_font_1);
+
+    /*Only fonts in lvgl's native format can be indexed*/
+    font_copy_t copy;
+    lv_font_t * font = font_copy(&copy, &lv_font_montserrat_14);
+    font->get_glyph_dsc = NULL;
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_font_fmt_txt_lookup_create(font));
+    TEST_ASSERT_NULL(copy.dsc.lookup);
+}
+
+void test_font_fmt_txt_lookup_kern_pairs(void)
+{
+    /*Make a font with kerning pairs from the kerning classes of Montserrat*/
+    const lv_font_t * font_classes = &lv_font_montserrat_14;
+    const lv_font_fmt_txt_dsc_t * dsc_classes = font_classes->dsc;
+    const lv_font_fmt_txt_kern_classes_t * kern_classes = dsc_classes->kern_dsc;
+
+    uint32_t pair_cnt = 0;
+    uint8_t * glyph_ids = lv_malloc(95 * 95 * 2);
+    int8_t * values = lv_malloc(95 * 95);
+    uint32_t gid_left;
+    uint32_t gid_right;
+    for(gid_left = 1; gid_left <= 95; gid_left++) {
+        for(gid_right = 1; gid_right <= 95; gid_right++) {
+            uint8_t left_class = kern_classes->left_class_mapping[gid_left];
+            uint8_t right_class = kern_classes->right_class_mapping[gid_right];
+            if(left_class == 0 || right_class == 0) continue;
+
+            int8_t value = kern_classes->class_pair_values[(left_class - 1) * kern_classes->right_class_cnt + right_class - 1];
+            if(value == 0) continue;
+
+            glyph_ids[pair_cnt * 2] = (uint8_t)gid_left;
+            glyph_ids[pair_cnt * 2 + 1] = (uint8_t)gid_right;
+            values[pair_cnt] = value;
+            pair_cnt++;
+        }
+    }
+    TEST_ASSERT_GREATER_THAN(100, pair_cnt);
+
+    lv_font_fmt_txt_kern_pair_t kern_pairs = {
+        .glyph_ids = glyph_ids,
+        .values = values,
+        .pair_cnt = pair_cnt,
+        .glyph_ids_size = 0,
+    };
+
+    lv_font_fmt_txt_dsc_t dsc_pairs = *dsc_classes;
+    dsc_pairs.kern_dsc = &kern_pairs;
+    dsc_pairs.kern_classes = 0;
+
+    lv_font_t font_pairs = *font_classes;
+    font_pairs.dsc = &dsc_pairs;
+
+    /*The kerning is the same with the classes, the pairs and the classes made from the pairs*/
+    uint32_t round;
+    for(round = 0; round < 2; round++) {
+        if(round == 1) TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_font_fmt_txt_lookup_create(&font_pairs));
+
+        uint32_t letter;
+        uint32_t letter_next;
+        for(letter = 0x20; letter < 0x7F; letter++) {
+            for(letter_next = 0x20; letter_next < 0x7F; letter_next++) {
+                lv_font_glyph_dsc_t g_dsc_classes;
+                lv_font_glyph_dsc_t g_dsc_pairs;
+                lv_font_get_glyph_dsc(font_classes, &g_dsc_classes, letter, letter_next);
+                lv_font_get_glyph_dsc(&font_pairs, &g_dsc_pairs, letter, letter_next);
+                TEST_ASSERT_EQUAL(g_dsc_classes.adv_w, g_dsc_pairs.adv_w);
+            }
+        }
+    }
+
+    lv_font_fmt_txt_lookup_delete(&font_pairs);
+    lv_free(glyph_ids);
+    lv_free(values);
+}
+
+static uint32_t bench_text(const lv_font_t * font, const char * text)
+{
+    uint32_t len = lv_strlen(text);
+    volatile int32_t w = 0;
+    uint32_t i;
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_ROUND_CNT; i++) {
+        w += lv_text_get_width(text, len, font, 0);
+    }
+    uint64_t t = lv_test_get_time_us() - t_start;
+    TEST_ASSERT_GREATER_THAN(0, w);
+
+    /*ns per letter*/
+    return (uint32_t)(t * 1000 / (BENCH_ROUND_CNT * lv_text_get_encoded_length(text)));
+}
+
+static void bench_font(const char * name, const lv_font_t * font_const, const char * text)
+{
+    font_copy_t copy;
+    lv_font_t * font = font_copy(&copy, font_const);
+
+    uint32_t t_search = bench_text(font, text);
+    lv_font_fmt_txt_lookup_create(font);
+    uint32_t t_lookup = bench_text(font, text);
+    lv_font_fmt_txt_lookup_delete(font);
+
+    TEST_PRINTF("%s: %d ns/letter with search, %d ns/letter with lookup tables", name, (int)t_search, (int)t_lookup);
+}
+
+void test_font_fmt_txt_lookup_bench(void)
+{
+    bench_font("ASCII (Montserrat 14)", &lv_font_montserrat_14, bench_ascii);
+    /*None of the bundled fonts have Latin-1 letters, so they are searched and not found*/
+    bench_font("Latin-1 (Montserrat 14)", &lv_font_montserrat_14, bench_latin1);
+    bench_font("Hebrew (DejaVu 16)", &lv_font_dejavu_16_persian_hebrew, bench_hebrew);
+    bench_font("CJK (Source Han Sans SC 16)", &lv_font_source_han_sans_sc_16_cjk, bench_cjk);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_font_fmt_txt_lookup_glyph_ids(void)
+{
+}
+
+void test_font_fmt_txt_lookup_kern_pairs(void)
+{
+}
+
+void test_font_fmt_txt_lookup_bench(void)
+{
+}
+
+#endif
+
+#endif
@@ -9,6 +9,7 @@
 
 #if LV_BUILD_TEST
 #include "../../lvgl.h"
+#include "lv_test_init.h"
 
 #include "unity/unity.h"
 
@@ -16,6 +17,8 @@
  *      DEFINES
  *********************/
 
+#define BENCH_CYCLE_CNT     100
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -145,6 +148,48 @@ void test_font_loader_from_buffer(void)
     common();
 }
 
+/**
+ * Load and free a font many times and measure the RAM it uses
+ * @param name      name of the configuration to print
+ * @param path      path to the font file
+ */
+static void font_loader_bench(const char * name, const char * path)
+{
+    uint32_t i;
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_CYCLE_CNT; i++) {
+        lv_font_t * font = lv_binfont_create(path);
+        TEST_ASSERT_NOT_NULL(font);
+        lv_binfont_destroy(font);
+    }
+    uint64_t t = lv_test_get_time_us() - t_start;
+
+    size_t mem_before = lv_test_get_free_mem();
+    lv_font_t * font = lv_binfont_create(path);
+    size_t mem_used = mem_before - lv_test_get_free_mem();
+    compare_fonts(&test_font_2, font);
+
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_center(label);
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text(label, "The quick brown fox jumped over the lazy dog");
+    TEST_ASSERT_EQUAL_SCREENSHOT("font_loader_2.png");
+    lv_obj_delete(label);
+    lv_binfont_destroy(font);
+
+    TEST_PRINTF("%s: %d us per load, %d bytes of RAM used", name, (int)(t / BENCH_CYCLE_CNT), (int)mem_used);
+}
+
+void test_font_loader_mapped_bench(void)
+{
+    /*The glyph bitmaps are read to RAM from 'A' and used from the mapped file with 'B'
+     *if they start on whole bytes. In `test_font_2_aligned.fnt` the glyph headers are padded to whole bytes.*/
+    font_loader_bench("read", "A:src/test_assets/test_font_2.fnt");
+    font_loader_bench("read, aligned", "A:src/test_assets/test_font_2_aligned.fnt");
+    font_loader_bench("mapped, not aligned", "B:src/test_assets/test_font_2.fnt");
+    font_loader_bench("mapped, aligned", "B:src/test_assets/test_font_2_aligned.fnt");
+}
+
 void test_font_loader_reload(void)
 {
     /*Reload a font which is being used by a label*/
@@ -2,9 +2,16 @@
 #include "../lvgl.h"
 #include "../../lvgl_private.h"
 
+#include "lv_test_init.h"
+
 #include "unity/unity.h"
 #include <string.h>
 
+#define TRACE_MAX_CNT       8192
+#define BENCH_CYCLE_CNT     20
+#define BENCH_IMG_W         120
+#define BENCH_IMG_H         120
+
 const char * read_exp =
     "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Etiam sed maximus orci. Morbi massa nisi, varius eu convallis ac, venenatis at metus. In in nibh id urna pretium feugiat vitae eu libero. Ut eget fringilla eros. Nunc ullamcorper lectus mauris, vel rhoncus velit volutpat et. Phasellus sed molestie massa. Maecenas quis dui sollicitudin, vulputate nunc ut, dictum quam. Nam a congue lorem. Nulla non facilisis sapien. Ut luctus nulla nibh, sed finibus urna porta non. Duis aliquet augue id urna euismod auctor. Integer pellentesque vulputate enim non mattis. Donec finibus mattis dolor, et feugiat nisi pharetra porta. Mauris ullamcorper cursus magna. Orci varius natoque penatibus et magnis dis parturient montes, nascetur ridiculus mus.";
 
@@ -12,6 +19,21 @@ static void read_range(lv_fs_file_t * f, uint32_t from, uint32_t to);
 
 static void read_random_drv(char drv_letter, uint32_t cache_size);
 
+/*A read of `len` bytes from `pos` with `br` bytes read, or a reopen of the file if `len` is 0*/
+typedef struct {
+    uint32_t pos;
+    uint32_t len;
+    uint32_t br;
+} fs_access_t;
+
+static lv_fs_drv_t trace_drv;
+static fs_access_t trace[TRACE_MAX_CNT];
+static uint32_t trace_cnt;
+static bool trace_recording;
+static uint32_t trace_pos;
+static uint32_t trace_read_cnt;
+static uint32_t trace_seek_cnt;
+
 void setUp(void)
 {
     /* Function run before every test */
@@ -275,4 +297,256 @@ void test_write_read_random(void)
     drv->cache_size = original_cache_size;
 }
 
+void test_mapped_ptr(void)
+{
+    lv_fs_res_t res;
+    uint32_t size;
+    const uint8_t * map;
+
+    /*'A' can't map files*/
+    lv_fs_file_t fa;
+    res = lv_fs_open(&fa, "A:src/test_files/readtest.txt", LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_NULL(lv_fs_get_mapped_ptr(&fa, &size));
+    TEST_ASSERT_EQUAL_UINT32(0, size);
+    lv_fs_close(&fa);
+
+    /*'B' maps files opened for reading*/
+    lv_fs_file_t fb;
+    res = lv_fs_open(&fb, "B:src/test_files/readtest.txt", LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    map = lv_fs_get_mapped_ptr(&fb, &size);
+    TEST_ASSERT_NOT_NULL(map);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(strlen(read_exp), size);
+    TEST_ASSERT_EQUAL_MEMORY(read_exp, map, strlen(read_exp));
+
+    /*The same mapping is returned again and reading still works*/
+    TEST_ASSERT_EQUAL_PTR(map, lv_fs_get_mapped_ptr(&fb, NULL));
+    uint8_t buf[16];
+    uint32_t br;
+    res = lv_fs_seek(&fb, 6, LV_FS_SEEK_SET);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_read(&fb, buf, sizeof(buf), &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_EQUAL_MEMORY(read_exp + 6, buf, sizeof(buf));
+    lv_fs_close(&fb);
+
+    /*Files opened for writing are not mapped*/
+    res = lv_fs_open(&fb, "B:fs_mapped_ptr_test.bin", LV_FS_MODE_WR | LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_write(&fb, read_exp, 16, NULL);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_NULL(lv_fs_get_mapped_ptr(&fb, &size));
+    lv_fs_close(&fb);
+
+    /*Files from buffers are in the memory already*/
+    lv_fs_path_ex_t path;
+    lv_fs_make_path_from_buffer(&path, 'M', read_exp, 100);
+    lv_fs_file_t fm;
+    res = lv_fs_open(&fm, (const char *)&path, LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_EQUAL_PTR(read_exp, lv_fs_get_mapped_ptr(&fm, &size));
+    TEST_ASSERT_EQUAL_UINT32(100, size);
+    lv_fs_close(&fm);
+}
+
+/*A driver on top of 'A' which records the accesses and counts the calls*/
+static void * trace_open_cb(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+    lv_fs_drv_t * stdio_drv = lv_fs_get_drv('A');
+    if(trace_recording) {
+        TEST_ASSERT_LESS_THAN_UINT32(TRACE_MAX_CNT, trace_cnt);
+        lv_memzero(&trace[trace_cnt], sizeof(fs_access_t));
+        trace_cnt++;
+    }
+
+    trace_pos = 0;
+    return stdio_drv->open_cb(stdio_drv, path, mode);
+}
+
+static lv_fs_res_t trace_close_cb(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+    lv_fs_drv_t * stdio_drv = lv_fs_get_drv('A');
+    return stdio_drv->close_cb(stdio_drv, file_p);
+}
+
+static lv_fs_res_t trace_read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+    lv_fs_drv_t * stdio_drv = lv_fs_get_drv('A');
+    lv_fs_res_t res = stdio_drv->read_cb(stdio_drv, file_p, buf, btr, br);
+    if(trace_recording) {
+        TEST_ASSERT_LESS_THAN_UINT32(TRACE_MAX_CNT, trace_cnt);
+        trace[trace_cnt].pos = trace_pos;
+        trace[trace_cnt].len = btr;
+        trace[trace_cnt].br = *br;
+        trace_cnt++;
+    }
+
+    trace_pos += *br;
+    trace_read_cnt++;
+    return res;
+}
+
+static lv_fs_res_t trace_seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+    lv_fs_drv_t * stdio_drv = lv_fs_get_drv('A');
+    lv_fs_res_t res = stdio_drv->seek_cb(stdio_drv, file_p, pos, whence);
+    stdio_drv->tell_cb(stdio_drv, file_p, &trace_pos);
+    trace_seek_cnt++;
+    return res;
+}
+
+static lv_fs_res_t trace_tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+    lv_fs_drv_t * stdio_drv = lv_fs_get_drv('A');
+    return stdio_drv->tell_cb(stdio_drv, file_p, pos_p);
+}
+
+static void trace_drv_init(void)
+{
+    if(lv_fs_get_drv('T')) return;
+
+    lv_fs_drv_init(&trace_drv);
+    trace_drv.letter = 'T';
+    trace_drv.open_cb = trace_open_cb;
+    trace_drv.close_cb = trace_close_cb;
+    trace_drv.read_cb = trace_read_cb;
+    trace_drv.seek_cb = trace_seek_cb;
+    trace_drv.tell_cb = trace_tell_cb;
+    lv_fs_drv_register(&trace_drv);
+}
+
+/**
+ * Read a file in the same order as recorded and print the timing and the number of driver calls
+ * @param name          name of the access pattern and cache configuration to print
+ * @param path          path to the file with 'T' driver letter
+ * @param cache_size    size of the cached blocks
+ * @param block_cnt     number of cached blocks per file
+ */
+static void trace_replay(const char * name, const char * path, uint32_t cache_size, uint32_t block_cnt)
+{
+    static uint8_t buf[8192];
+
+    trace_drv.cache_size = cache_size;
+    trace_drv.cache_block_cnt = block_cnt;
+    trace_read_cnt = 0;
+    trace_seek_cnt = 0;
+
+    lv_fs_cache_stat_t stat_sum;
+    lv_fs_cache_stat_t stat;
+    lv_memzero(&stat_sum, sizeof(stat_sum));
+
+    lv_fs_file_t f;
+    bool opened = false;
+    uint32_t i;
+    uint32_t c;
+    uint64_t t_start = lv_test_get_time_us();
+    for(c = 0; c < BENCH_CYCLE_CNT; c++) {
+        for(i = 0; i < trace_cnt; i++) {
+            if(trace[i].len == 0) {
+                if(opened) {
+                    lv_fs_get_cache_stat(&f, &stat);
+                    stat_sum.hit_cnt += stat.hit_cnt;
+                    stat_sum.miss_cnt += stat.miss_cnt;
+                    stat_sum.read_ahead_cnt += stat.read_ahead_cnt;
+                    lv_fs_close(&f);
+                }
+                TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD));
+                opened = true;
+                continue;
+            }
+
+            uint32_t br;
+            TEST_ASSERT_LESS_OR_EQUAL_UINT32(sizeof(buf), trace[i].len);
+            TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, trace[i].pos, LV_FS_SEEK_SET));
+            TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, trace[i].len, &br));
+            TEST_ASSERT_EQUAL_UINT32(trace[i].br, br);
+        }
+    }
+    uint64_t t = lv_test_get_time_us() - t_start;
+    if(opened) {
+        lv_fs_get_cache_stat(&f, &stat);
+        stat_sum.hit_cnt += stat.hit_cnt;
+        stat_sum.miss_cnt += stat.miss_cnt;
+        stat_sum.read_ahead_cnt += stat.read_ahead_cnt;
+        lv_fs_close(&f);
+    }
+
+    TEST_PRINTF("%s: %d us, %d driver reads, %d driver seeks, %d hits, %d misses, %d blocks read ahead",
+                name, (int)(t / BENCH_CYCLE_CNT), (int)(trace_read_cnt / BENCH_CYCLE_CNT),
+                (int)(trace_seek_cnt / BENCH_CYCLE_CNT), (int)(stat_sum.hit_cnt / BENCH_CYCLE_CNT),
+                (int)(stat_sum.miss_cnt / BENCH_CYCLE_CNT), (int)(stat_sum.read_ahead_cnt / BENCH_CYCLE_CNT));
+}
+
+/**
+ * Replay the recorded accesses with different cache configurations
+ * @param name      name of the access pattern to print
+ * @param path      path to the file with 'T' driver letter
+ */
+static void trace_bench(const char * name, const char * path)
+{
+    char buf[128];
+    lv_snprintf(buf, sizeof(buf), "%s, %d reads, no cache", name, (int)trace_cnt);
+    trace_replay(buf, path, 0, 0);
+    lv_snprintf(buf, sizeof(buf), "%s, 1 x 512 bytes cache", name);
+    trace_replay(buf, path, 512, 1);
+    lv_snprintf(buf, sizeof(buf), "%s, 4 x 128 bytes cache", name);
+    trace_replay(buf, path, 128, 4);
+    lv_snprintf(buf, sizeof(buf), "%s, 4 x 512 bytes cache", name);
+    trace_replay(buf, path, 512, 4);
+    trace_drv.cache_size = 0;
+}
+
+void test_cache_bench(void)
+{
+    trace_drv_init();
+
+    /*Record how a binary font is loaded*/
+    trace_cnt = 0;
+    trace_recording = true;
+    lv_font_t * font = lv_binfont_create("T:src/test_assets/test_font_2.fnt");
+    trace_recording = false;
+    TEST_ASSERT_NOT_NULL(font);
+    lv_binfont_destroy(font);
+    trace_bench("binfont", "T:src/test_assets/test_font_2.fnt");
+
+    /*Record how two ARGB8888 images are drawn from a file by the binary image decoder*/
+    static uint32_t pixels[BENCH_IMG_W * BENCH_IMG_H];
+    uint32_t i;
+    for(i = 0; i < BENCH_IMG_W * BENCH_IMG_H; i++) pixels[i] = 0xff000000 | (i * 2654435761u >> 8);
+
+    lv_image_header_t header;
+    lv_memzero(&header, sizeof(header));
+    header.magic = LV_IMAGE_HEADER_MAGIC;
+    header.cf = LV_COLOR_FORMAT_ARGB8888;
+    header.w = BENCH_IMG_W;
+    header.h = BENCH_IMG_H;
+    header.stride = BENCH_IMG_W * 4;
+
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "A:fs_cache_bench_img.bin", LV_FS_MODE_WR));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&f, &header, sizeof(header), NULL));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&f, pixels, sizeof(pixels), NULL));
+    lv_fs_close(&f);
+
+    lv_obj_t * img1 = lv_image_create(lv_screen_active());
+    lv_obj_t * img2 = lv_image_create(lv_screen_active());
+    lv_obj_set_pos(img2, 200, 100);
+
+    trace_cnt = 0;
+    trace_recording = true;
+    lv_image_set_src(img1, "T:fs_cache_bench_img.bin");
+    lv_image_set_src(img2, "T:fs_cache_bench_img.bin");
+    lv_refr_now(NULL);
+    trace_recording = false;
+    trace_bench("bin_decoder", "T:fs_cache_bench_img.bin");
+
+    lv_obj_clean(lv_screen_active());
+}
+
 #endif
@@ -1,9 +1,14 @@
 #if LV_BUILD_TEST
 #include "../lvgl.h"
 #include "../../lvgl_private.h"
+#include "lv_test_init.h"
 
 #include "unity/unity.h"
 
+#define BENCH_COL_CNT       8
+#define BENCH_ROW_CNT       125
+#define BENCH_ROUND_CNT     20
+
 void setUp(void)
 {
     /* Function run before every test */
@@ -86,4 +91,159 @@ void test_subgrid_col(void)
     TEST_ASSERT_EQUAL_SCREENSHOT("subgrid_col.png");
 }
 
+void test_grid_content_tracks(void)
+{
+    static const int32_t col_dsc[] = {LV_GRID_CONTENT, 50, LV_GRID_CONTENT, LV_GRID_TEMPLATE_LAST};
+    static const int32_t row_dsc[] = {LV_GRID_CONTENT, LV_GRID_CONTENT, LV_GRID_TEMPLATE_LAST};
+
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_set_style_pad_all(cont, 0, 0);
+    lv_obj_set_style_pad_gap(cont, 0, 0);
+    lv_obj_set_style_border_width(cont, 0, 0);
+    lv_obj_set_grid_dsc_array(cont, col_dsc, row_dsc);
+
+    /*Content tracks take the size of their largest item, spanning and ignored items don't count*/
+    lv_obj_t * obj;
+    obj = lv_obj_create(cont);
+    lv_obj_set_size(obj, 30, 10);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 0, 1, LV_GRID_ALIGN_START, 0, 1);
+    obj = lv_obj_create(cont);
+    lv_obj_set_size(obj, 40, 20);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 0, 1, LV_GRID_ALIGN_START, 1, 1);
+    obj = lv_obj_create(cont);
+    lv_obj_set_size(obj, 100, 25);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 0, 3, LV_GRID_ALIGN_START, 0, 2);
+    obj = lv_obj_create(cont);
+    lv_obj_set_size(obj, 300, 300);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_START, 2, 1, LV_GRID_ALIGN_START, 1, 1);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    obj = lv_obj_create(cont);
+    lv_obj_set_size(obj, 25, 15);
+    lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_END, 2, 1, LV_GRID_ALIGN_END, 1, 1);
+
+    lv_obj_update_layout(cont);
+
+    /*Columns: 40, 50, 25; rows: 10, 20*/
+    TEST_ASSERT_EQUAL_INT32(115, lv_obj_get_width(cont));
+    TEST_ASSERT_EQUAL_INT32(30, lv_obj_get_height(cont));
+    TEST_ASSERT_EQUAL_INT32(90, lv_obj_get_x(obj));
+    TEST_ASSERT_EQUAL_INT32(15, lv_obj_get_y(obj));
+}
+
+void test_grid_tracks_changed(void)
+{
+    static int32_t col_dsc[] = {LV_GRID_CONTENT, LV_GRID_CONTENT, LV_GRID_TEMPLATE_LAST};
+    static const int32_t row_dsc[] = {LV_GRID_CONTENT, LV_GRID_TEMPLATE_LAST};
+
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_set_style_pad_all(cont, 0, 0);
+    lv_obj_set_style_pad_gap(cont, 0, 0);
+    lv_obj_set_style_border_width(cont, 0, 0);
+    lv_obj_set_grid_dsc_array(cont, col_dsc, row_dsc);
+
+    lv_obj_t * obj1 = lv_obj_create(cont);
+    lv_obj_set_size(obj1, 30, 10);
+    lv_obj_set_grid_cell(obj1, LV_GRID_ALIGN_START, 0, 1, LV_GRID_ALIGN_START, 0, 1);
+    lv_obj_t * obj2 = lv_obj_create(cont);
+    lv_obj_set_size(obj2, 20, 10);
+    lv_obj_set_grid_cell(obj2, LV_GRID_ALIGN_START, 1, 1, LV_GRID_ALIGN_START, 0, 1);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(30, lv_obj_get_x(obj2));
+
+    /*Moving the grid keeps the tracks*/
+    lv_obj_set_pos(cont, 10, 10);
+    lv_obj_mark_layout_as_dirty(cont);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(30, lv_obj_get_x(obj2));
+
+    /*The size of the items*/
+    lv_obj_set_width(obj1, 40);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(40, lv_obj_get_x(obj2));
+
+    /*The style of the items*/
+    lv_obj_set_grid_cell(obj2, LV_GRID_ALIGN_END, 0, 1, LV_GRID_ALIGN_START, 0, 1);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(20, lv_obj_get_x(obj2));
+    lv_obj_set_grid_cell(obj2, LV_GRID_ALIGN_START, 1, 1, LV_GRID_ALIGN_START, 0, 1);
+
+    /*The flags of the items*/
+    lv_obj_add_flag(obj1, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_x(obj2));
+    lv_obj_remove_flag(obj1, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(40, lv_obj_get_x(obj2));
+
+    /*The template modified in place*/
+    col_dsc[0] = 50;
+    lv_obj_mark_layout_as_dirty(cont);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(50, lv_obj_get_x(obj2));
+    col_dsc[0] = LV_GRID_CONTENT;
+
+    /*The style of the container*/
+    lv_obj_set_style_pad_column(cont, 5, 0);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(45, lv_obj_get_x(obj2));
+
+    /*The deleted items*/
+    lv_obj_t * obj3 = lv_obj_create(cont);
+    lv_obj_set_size(obj3, 60, 10);
+    lv_obj_set_grid_cell(obj3, LV_GRID_ALIGN_START, 1, 1, LV_GRID_ALIGN_START, 0, 1);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(105, lv_obj_get_width(cont));
+    lv_obj_delete(obj3);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(65, lv_obj_get_width(cont));
+}
+
+void test_grid_bench(void)
+{
+    static int32_t col_dsc[BENCH_COL_CNT + 1];
+    static int32_t row_dsc[BENCH_ROW_CNT + 1];
+    uint32_t i;
+    for(i = 0; i < BENCH_COL_CNT; i++) col_dsc[i] = LV_GRID_CONTENT;
+    col_dsc[BENCH_COL_CNT] = LV_GRID_TEMPLATE_LAST;
+    for(i = 0; i < BENCH_ROW_CNT; i++) row_dsc[i] = LV_GRID_CONTENT;
+    row_dsc[BENCH_ROW_CNT] = LV_GRID_TEMPLATE_LAST;
+
+    /*A table of 1000 labels with content sized rows and columns*/
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_grid_dsc_array(cont, col_dsc, row_dsc);
+    for(i = 0; i < BENCH_COL_CNT * BENCH_ROW_CNT; i++) {
+        lv_obj_t * label = lv_label_create(cont);
+        lv_label_set_text_fmt(label, "Cell %d", (int)i);
+        lv_obj_set_grid_cell(label, LV_GRID_ALIGN_START, i % BENCH_COL_CNT, 1, LV_GRID_ALIGN_CENTER, i / BENCH_COL_CNT, 1);
+    }
+    lv_obj_update_layout(cont);
+
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_ROUND_CNT; i++) {
+        lv_obj_t * label = lv_obj_get_child(cont, (int32_t)((i * 97) % (BENCH_COL_CNT * BENCH_ROW_CNT)));
+        lv_label_set_text(label, i % 2 ? "Changed" : "Changed text");
+        lv_obj_update_layout(cont);
+    }
+    uint64_t t = lv_test_get_time_us() - t_start;
+
+    TEST_PRINTF("grid of %d x %d labels: %d us per cell change", BENCH_COL_CNT, BENCH_ROW_CNT,
+                (int)(t / BENCH_ROUND_CNT));
+
+    /*The same text doesn't change the tracks*/
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_ROUND_CNT; i++) {
+        lv_obj_t * label = lv_obj_get_child(cont, (int32_t)((i * 97) % (BENCH_COL_CNT * BENCH_ROW_CNT)));
+        lv_label_set_text(label, lv_label_get_text(label));
+        lv_obj_mark_layout_as_dirty(cont);
+        lv_obj_update_layout(cont);
+    }
+    t = lv_test_get_time_us() - t_start;
+
+    TEST_PRINTF("grid of %d x %d labels: %d us per same size cell change", BENCH_COL_CNT, BENCH_ROW_CNT,
+                (int)(t / BENCH_ROUND_CNT));
+}
+
 #endif
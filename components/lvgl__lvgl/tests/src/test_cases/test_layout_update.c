@@ -0,0 +1,148 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_init.h"
+
+#include "unity/unity.h"
+
+#define ROW_CNT             200
+#define LABEL_PER_ROW       4
+#define BENCH_ROUND_CNT     200
+
+static lv_obj_t * list;
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+/*A column of rows, each row is a content sized row of labels: 1000 objects*/
+static void create_list(void)
+{
+    list = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(list, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t i;
+    for(i = 0; i < ROW_CNT; i++) {
+        lv_obj_t * row = lv_obj_create(list);
+        lv_obj_set_size(row, LV_PCT(100), LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+
+        uint32_t j;
+        for(j = 0; j < LABEL_PER_ROW; j++) {
+            lv_obj_t * label = lv_label_create(row);
+            lv_label_set_text_fmt(label, "Item %d.%d", (int)i, (int)j);
+        }
+    }
+
+    lv_obj_update_layout(list);
+}
+
+static lv_obj_t * get_label(uint32_t row, uint32_t col)
+{
+    return lv_obj_get_child(lv_obj_get_child(list, (int32_t)row), (int32_t)col);
+}
+
+static uint32_t update_layout_get_visit_cnt(void)
+{
+    uint32_t visit_cnt = LV_GLOBAL_DEFAULT()->layout_visit_cnt;
+    lv_obj_update_layout(list);
+    return LV_GLOBAL_DEFAULT()->layout_visit_cnt - visit_cnt;
+}
+
+static lv_obj_tree_walk_res_t mark_dirty_cb(lv_obj_t * obj, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_obj_mark_layout_as_dirty(obj);
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+void test_layout_update_visits_only_dirty_subtrees(void)
+{
+    create_list();
+
+    /*Nothing to do*/
+    TEST_ASSERT_EQUAL(0, update_layout_get_visit_cnt());
+
+    /*A wider label moves the labels after it in its row only. The ancestors and the
+     *siblings of the ancestors are checked, but not the other rows' labels*/
+    lv_obj_t * label = get_label(ROW_CNT / 2, 1);
+    lv_obj_t * label_next = get_label(ROW_CNT / 2, 2);
+    int32_t x_next = lv_obj_get_x(label_next);
+    lv_label_set_text(label, "A much longer text");
+    uint32_t visit_cnt = update_layout_get_visit_cnt();
+    TEST_ASSERT_GREATER_THAN(0, visit_cnt);
+    TEST_ASSERT_LESS_THAN(ROW_CNT / 2, visit_cnt);
+    TEST_ASSERT_GREATER_THAN(x_next, lv_obj_get_x(label_next));
+
+    /*A taller label makes its row taller and moves the rows after it*/
+    lv_obj_t * row_next = lv_obj_get_child(list, ROW_CNT / 2 + 1);
+    int32_t y_next = lv_obj_get_y(row_next);
+    lv_label_set_text(label, "Two\nlines");
+    visit_cnt = update_layout_get_visit_cnt();
+    TEST_ASSERT_LESS_THAN(ROW_CNT / 2, visit_cnt);
+    TEST_ASSERT_GREATER_THAN(y_next, lv_obj_get_y(row_next));
+
+    /*Updating every object gives the same coordinates*/
+    static lv_area_t coords[ROW_CNT * LABEL_PER_ROW];
+    uint32_t i;
+    for(i = 0; i < ROW_CNT * LABEL_PER_ROW; i++) {
+        lv_obj_get_coords(get_label(i / LABEL_PER_ROW, i % LABEL_PER_ROW), &coords[i]);
+    }
+
+    lv_obj_tree_walk(list, mark_dirty_cb, NULL);
+    TEST_ASSERT_GREATER_OR_EQUAL(ROW_CNT * (LABEL_PER_ROW + 1), update_layout_get_visit_cnt());
+
+    for(i = 0; i < ROW_CNT * LABEL_PER_ROW; i++) {
+        lv_area_t a;
+        lv_obj_get_coords(get_label(i / LABEL_PER_ROW, i % LABEL_PER_ROW), &a);
+        TEST_ASSERT_EQUAL_INT32(coords[i].x1, a.x1);
+        TEST_ASSERT_EQUAL_INT32(coords[i].y1, a.y1);
+        TEST_ASSERT_EQUAL_INT32(coords[i].x2, a.x2);
+        TEST_ASSERT_EQUAL_INT32(coords[i].y2, a.y2);
+    }
+}
+
+void test_layout_update_moved_dirty_child(void)
+{
+    lv_obj_t * cont1 = lv_obj_create(lv_screen_active());
+    lv_obj_t * cont2 = lv_obj_create(lv_screen_active());
+    lv_obj_t * cont3 = lv_obj_create(cont2);
+    lv_obj_set_flex_flow(cont3, LV_FLEX_FLOW_COLUMN);
+    lv_obj_t * obj1 = lv_obj_create(cont3);
+    lv_obj_t * obj2 = lv_obj_create(cont3);
+    lv_obj_update_layout(cont1);
+
+    /*`cont3` is swapped with a clean object while its children are dirty*/
+    lv_obj_set_height(obj1, 100);
+    lv_obj_swap(cont3, cont1);
+    lv_obj_update_layout(cont1);
+    TEST_ASSERT_EQUAL_INT32(100, lv_obj_get_height(obj1));
+    TEST_ASSERT_GREATER_OR_EQUAL(100, lv_obj_get_y(obj2));
+}
+
+void test_layout_update_bench(void)
+{
+    create_list();
+
+    uint32_t visit_cnt = 0;
+    uint32_t i;
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_ROUND_CNT; i++) {
+        lv_obj_t * label = get_label((i * 37) % ROW_CNT, i % LABEL_PER_ROW);
+        lv_label_set_text(label, i % 2 ? "Changed" : "Changed text");
+        visit_cnt += update_layout_get_visit_cnt();
+    }
+    uint64_t t = lv_test_get_time_us() - t_start;
+
+    TEST_PRINTF("%d objects in a flex list: %d us and %d visited objects per label change",
+                (int)(ROW_CNT * (LABEL_PER_ROW + 1)), (int)(t / BENCH_ROUND_CNT), (int)(visit_cnt / BENCH_ROUND_CNT));
+}
+
+#endif
@@ -1,9 +1,37 @@
 #if LV_BUILD_TEST
 #include "../lvgl.h"
 #include "../../lvgl_private.h"
+#include "lv_test_init.h"
 
 #include "unity/unity.h"
 
+#define TRACE_STEP_CNT  20000
+#define TRACE_LIVE_MAX  2048
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    #define SIZE_CLASS_CACHE_CNT    LV_MEM_SIZE_CLASS_CACHE_CNT
+#else
+    #define SIZE_CLASS_CACHE_CNT    0
+#endif
+
+/*An allocation of the trace. Freed if `free` is set.*/
+typedef struct {
+    uint32_t id : 31;
+    uint32_t free : 1;
+    uint32_t size;
+} trace_op_t;
+
+/*Typical allocations of a UI: what is allocated and for how many steps it lives*/
+typedef struct {
+    uint32_t weight;
+    uint32_t size;
+    uint32_t life_min;
+    uint32_t life_max;
+} trace_kind_t;
+
+static trace_op_t trace_ops[TRACE_STEP_CNT * 2];
+static void * trace_ptrs[TRACE_STEP_CNT];
+
 void setUp(void)
 {
     /* Function run before every test */
@@ -14,6 +42,108 @@ void tearDown(void)
     /* Function run after every test */
 }
 
+static uint32_t trace_rand(uint32_t * seed, uint32_t max)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return ((*seed >> 16) & 0x7FFF) % max;
+}
+
+/**
+ * Make a deterministic allocation trace from the sizes of the draw tasks, event descriptors,
+ * style values, timers, animations, widgets and a few draw buffers
+ * @return      number of operations
+ */
+static uint32_t trace_create(void)
+{
+    const trace_kind_t kinds[] = {
+        {30, sizeof(lv_draw_task_t) + sizeof(lv_draw_fill_dsc_t), 1, 8},
+        {20, sizeof(lv_draw_task_t) + sizeof(lv_draw_label_dsc_t), 1, 8},
+        {15, sizeof(lv_event_dsc_t), 1, 200},
+        {10, 4 * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t)), 50, 2000},
+        {5, sizeof(lv_timer_t), 20, 2000},
+        {10, sizeof(lv_anim_t), 10, 300},
+        {7, sizeof(lv_obj_t), 100, 5000},
+        {3, 2048, 1, 4},
+    };
+
+    static uint32_t live_ids[TRACE_LIVE_MAX];
+    static uint32_t live_expire[TRACE_LIVE_MAX];
+    uint32_t live_cnt = 0;
+    uint32_t op_cnt = 0;
+    uint32_t seed = 1;
+    uint32_t step;
+    for(step = 0; step < TRACE_STEP_CNT; step++) {
+        uint32_t i = 0;
+        while(i < live_cnt) {
+            if(live_expire[i] <= step) {
+                trace_ops[op_cnt++] = (trace_op_t) {.id = live_ids[i], .free = 1};
+                live_cnt--;
+                live_ids[i] = live_ids[live_cnt];
+                live_expire[i] = live_expire[live_cnt];
+            }
+            else i++;
+        }
+
+        uint32_t r = trace_rand(&seed, 100);
+        const trace_kind_t * kind = kinds;
+        while(r >= kind->weight) {
+            r -= kind->weight;
+            kind++;
+        }
+
+        uint32_t size = kind->size;
+        if(size == 2048) size *= 1 + trace_rand(&seed, 4);
+        trace_ops[op_cnt++] = (trace_op_t) {.id = step, .size = size};
+
+        TEST_ASSERT_LESS_THAN(TRACE_LIVE_MAX, live_cnt);
+        live_ids[live_cnt] = step;
+        live_expire[live_cnt] = step + kind->life_min + trace_rand(&seed, kind->life_max - kind->life_min + 1);
+        live_cnt++;
+    }
+
+    return op_cnt;
+}
+
+/**
+ * Run the operations of the trace and free the blocks still alive at the end
+ * @param op_cnt    number of operations
+ * @param core      true: call `lv_malloc_core()` and `lv_free_core()` directly
+ * @param mon       store the state of the memory at the end of the trace here
+ * @return          the time of the trace in microseconds
+ */
+static uint64_t trace_replay(uint32_t op_cnt, bool core, lv_mem_monitor_t * mon)
+{
+    uint32_t i;
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < op_cnt; i++) {
+        const trace_op_t * op = &trace_ops[i];
+        if(op->free) {
+            if(core) lv_free_core(trace_ptrs[op->id]);
+            else lv_free(trace_ptrs[op->id]);
+        }
+        else {
+            trace_ptrs[op->id] = core ? lv_malloc_core(op->size) : lv_malloc(op->size);
+            TEST_ASSERT_NOT_NULL(trace_ptrs[op->id]);
+        }
+    }
+    uint64_t t = lv_test_get_time_us() - t_start;
+
+    lv_mem_monitor(mon);
+
+    static bool freed[TRACE_STEP_CNT];
+    lv_memzero(freed, sizeof(freed));
+    for(i = 0; i < op_cnt; i++) {
+        if(trace_ops[i].free) freed[trace_ops[i].id] = true;
+    }
+    for(i = 0; i < TRACE_STEP_CNT; i++) {
+        if(freed[i]) continue;
+        if(core) lv_free_core(trace_ptrs[i]);
+        else lv_free(trace_ptrs[i]);
+    }
+
+    return t;
+}
+
 /* #3324 */
 void test_mem_buf_realloc(void)
 {
@@ -50,4 +180,181 @@ void test_memcpy_unaligned(void)
     }
 }
 
+void test_mem_size_class_cache(void)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_SIZE_CLASS_CACHE_CNT
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    void * p[16];
+    uint32_t i;
+    for(i = 0; i < 16; i++) p[i] = lv_malloc_core(40);
+
+    /*TLSF might give a larger block if the rest is too small to split.
+     *Such a block is kept in the class of its real size.
+     *The blocks above the limit of the class are returned to TLSF.*/
+    void * cached[16];
+    uint32_t cached_cnt = 0;
+    for(i = 0; i < 16; i++) {
+        if(lv_tlsf_block_size(p[i]) < 64 && cached_cnt < SIZE_CLASS_CACHE_CNT) cached[cached_cnt++] = p[i];
+        lv_free_core(p[i]);
+    }
+    TEST_ASSERT_GREATER_THAN(0, cached_cnt);
+
+    /*The freed blocks are reused for the same size class, the last freed first*/
+    void * q[16];
+    for(i = 0; i < cached_cnt; i++) {
+        q[i] = lv_malloc_core(40 - i % 4);
+        TEST_ASSERT_EQUAL_PTR(cached[cached_cnt - 1 - i], q[i]);
+    }
+    for(i = 0; i < cached_cnt; i++) lv_free_core(q[i]);
+
+    /*The monitor sees the cached blocks as free memory*/
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL(mon_start.free_size, mon.free_size);
+    TEST_ASSERT_EQUAL(mon_start.used_cnt, mon.used_cnt);
+#endif
+}
+
+void test_mem_stats(void)
+{
+#if LV_USE_MEM_STATS
+    lv_mem_stats_t stats_start;
+    lv_mem_stats_t stats;
+    lv_mem_get_stats(&stats_start);
+
+    lv_mem_tag_t tag_prev = lv_mem_set_tag(LV_MEM_TAG_USER);
+    void * p1 = lv_malloc(10);
+    void * p2 = lv_malloc_zeroed(100);
+    void * p3 = lv_malloc(10000);
+    lv_mem_set_tag(tag_prev);
+
+    lv_mem_get_stats(&stats);
+    const lv_mem_tag_stats_t * user_start = &stats_start.tags[LV_MEM_TAG_USER];
+    const lv_mem_tag_stats_t * user = &stats.tags[LV_MEM_TAG_USER];
+    TEST_ASSERT_EQUAL(user_start->live_size + 10110, user->live_size);
+    TEST_ASSERT_EQUAL(user_start->live_cnt + 3, user->live_cnt);
+    TEST_ASSERT_EQUAL(user_start->alloc_cnt + 3, user->alloc_cnt);
+    TEST_ASSERT_EQUAL(stats_start.size_hist[0] + 1, stats.size_hist[0]);
+    TEST_ASSERT_EQUAL(stats_start.size_hist[3] + 1, stats.size_hist[3]);
+    TEST_ASSERT_EQUAL(stats_start.size_hist[LV_MEM_SIZE_HIST_CNT - 1] + 1, stats.size_hist[LV_MEM_SIZE_HIST_CNT - 1]);
+
+    /*Reallocation keeps the tag, the peak remains after free*/
+    p1 = lv_realloc(p1, 50);
+    lv_free(p3);
+    lv_mem_get_stats(&stats);
+    TEST_ASSERT_EQUAL(user_start->live_size + 150, user->live_size);
+    TEST_ASSERT_EQUAL(user_start->live_cnt + 2, user->live_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(user_start->live_size + 10150, user->peak_size);
+
+    lv_mem_reset_peaks();
+    lv_mem_get_stats(&stats);
+    TEST_ASSERT_EQUAL(user->live_size, user->peak_size);
+
+    lv_free(p1);
+    lv_free(p2);
+    lv_mem_get_stats(&stats);
+    TEST_ASSERT_EQUAL(user_start->live_size, user->live_size);
+    TEST_ASSERT_EQUAL(user_start->live_cnt, user->live_cnt);
+
+    /*The allocations of the modules are counted for their tags.
+     *Create a screen to not allocate the children array of the active screen.*/
+    lv_mem_get_stats(&stats_start);
+    lv_obj_t * obj = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0xff0000), 0);
+    lv_obj_add_event_cb(obj, NULL, LV_EVENT_CLICKED, NULL);
+    lv_timer_t * timer = lv_timer_create_basic();
+
+    lv_mem_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(stats_start.tags[LV_MEM_TAG_OBJ].live_size, stats.tags[LV_MEM_TAG_OBJ].live_size);
+    TEST_ASSERT_GREATER_THAN(stats_start.tags[LV_MEM_TAG_STYLE].live_size, stats.tags[LV_MEM_TAG_STYLE].live_size);
+    TEST_ASSERT_GREATER_THAN(stats_start.tags[LV_MEM_TAG_EVENT].live_size, stats.tags[LV_MEM_TAG_EVENT].live_size);
+    TEST_ASSERT_GREATER_THAN(stats_start.tags[LV_MEM_TAG_TIMER].live_size, stats.tags[LV_MEM_TAG_TIMER].live_size);
+    lv_mem_dump_stats();
+
+    lv_timer_delete(timer);
+    lv_obj_delete(obj);
+    lv_mem_get_stats(&stats);
+    TEST_ASSERT_EQUAL(stats_start.tags[LV_MEM_TAG_OBJ].live_size, stats.tags[LV_MEM_TAG_OBJ].live_size);
+    TEST_ASSERT_EQUAL(stats_start.tags[LV_MEM_TAG_STYLE].live_size, stats.tags[LV_MEM_TAG_STYLE].live_size);
+    TEST_ASSERT_EQUAL(stats_start.tags[LV_MEM_TAG_EVENT].live_size, stats.tags[LV_MEM_TAG_EVENT].live_size);
+    TEST_ASSERT_EQUAL(stats_start.tags[LV_MEM_TAG_TIMER].live_size, stats.tags[LV_MEM_TAG_TIMER].live_size);
+#endif
+}
+
+#if LV_USE_MEM_STATS && LV_USE_OS
+#define STATS_THREAD_ALLOC_CNT  10000
+
+static void stats_thread_cb(void * user_data)
+{
+    /*The tag of the main thread doesn't apply here*/
+    lv_mem_tag_t tag_prev = lv_mem_set_tag((lv_mem_tag_t)(lv_uintptr_t)user_data);
+    uint32_t i;
+    for(i = 0; i < STATS_THREAD_ALLOC_CNT; i++) {
+        lv_free(lv_malloc(16 + i % 64));
+    }
+    lv_mem_set_tag(tag_prev);
+}
+#endif
+
+void test_mem_stats_threads(void)
+{
+#if LV_USE_MEM_STATS && LV_USE_OS
+    lv_mem_stats_t stats_start;
+    lv_mem_stats_t stats;
+    lv_mem_get_stats(&stats_start);
+
+    lv_thread_t threads[2];
+    lv_mem_tag_t mem_tag_prev;
+    LV_MEM_STATS_TAG_BEGIN(LV_MEM_TAG_USER, mem_tag_prev);
+    lv_thread_init(&threads[0], "mem_stats_1", LV_THREAD_PRIO_MID, stats_thread_cb, 64 * 1024,
+                   (void *)(lv_uintptr_t)(LV_MEM_TAG_USER + 1));
+    lv_thread_init(&threads[1], "mem_stats_2", LV_THREAD_PRIO_MID, stats_thread_cb, 64 * 1024,
+                   (void *)(lv_uintptr_t)(LV_MEM_TAG_USER + 1));
+    uint32_t i;
+    for(i = 0; i < STATS_THREAD_ALLOC_CNT; i++) {
+        lv_free(lv_malloc(16 + i % 64));
+    }
+    lv_thread_delete(&threads[0]);
+    lv_thread_delete(&threads[1]);
+    LV_MEM_STATS_TAG_END(mem_tag_prev);
+
+    /*Each thread counted its allocations for its own tag and no update was lost*/
+    lv_mem_get_stats(&stats);
+    const lv_mem_tag_stats_t * main_tag_start = &stats_start.tags[LV_MEM_TAG_USER];
+    const lv_mem_tag_stats_t * main_tag = &stats.tags[LV_MEM_TAG_USER];
+    const lv_mem_tag_stats_t * thread_tag_start = &stats_start.tags[LV_MEM_TAG_USER + 1];
+    const lv_mem_tag_stats_t * thread_tag = &stats.tags[LV_MEM_TAG_USER + 1];
+    TEST_ASSERT_EQUAL(main_tag_start->alloc_cnt + STATS_THREAD_ALLOC_CNT, main_tag->alloc_cnt);
+    TEST_ASSERT_EQUAL(thread_tag_start->alloc_cnt + 2 * STATS_THREAD_ALLOC_CNT, thread_tag->alloc_cnt);
+    TEST_ASSERT_EQUAL(main_tag_start->live_size, main_tag->live_size);
+    TEST_ASSERT_EQUAL(thread_tag_start->live_size, thread_tag->live_size);
+    TEST_ASSERT_EQUAL(thread_tag_start->live_cnt, thread_tag->live_cnt);
+#endif
+}
+
+void test_mem_trace_bench(void)
+{
+    uint32_t op_cnt = trace_create();
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon_start);
+
+    /*`lv_malloc()` and `lv_free()` with their logs, asserts and stats*/
+    uint64_t t = trace_replay(op_cnt, false, &mon);
+    TEST_PRINTF("size class cache %d, mem stats %d: %d allocs and frees in %d us (%d ns/op), %d blocks used, frag. %d%%",
+                SIZE_CLASS_CACHE_CNT, LV_USE_MEM_STATS, (int)TRACE_STEP_CNT, (int)t, (int)(t * 1000 / op_cnt),
+                (int)(mon.used_cnt - mon_start.used_cnt), (int)mon.frag_pct);
+
+    /*Only the allocator*/
+    t = trace_replay(op_cnt, true, &mon);
+    TEST_PRINTF("size class cache %d: %d allocs and frees in %d us (%d ns/op) with lv_malloc_core()",
+                SIZE_CLASS_CACHE_CNT, (int)TRACE_STEP_CNT, (int)t, (int)(t * 1000 / op_cnt));
+
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL(mon_start.used_cnt, mon.used_cnt);
+}
+
 #endif
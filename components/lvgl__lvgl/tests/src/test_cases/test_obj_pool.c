@@ -0,0 +1,161 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_init.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_OBJ_POOL
+
+#define BENCH_CYCLE_CNT     10000
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_obj_class_set_pool_size(&lv_obj_class, 0);
+    lv_obj_class_set_pool_size(&lv_button_class, 0);
+    lv_obj_class_set_pool_size(&lv_label_class, 0);
+}
+
+static void event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+}
+
+void test_obj_pool_reuse(void)
+{
+    lv_obj_class_set_pool_size(&lv_button_class, 4);
+
+    lv_obj_t * button = lv_button_create(lv_screen_active());
+    lv_label_create(button);
+    lv_obj_add_state(button, LV_STATE_CHECKED);
+    lv_obj_add_flag(button, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_set_user_data(button, (void *)1);
+    lv_obj_set_style_bg_color(button, lv_color_hex(0xff0000), 0);
+    lv_obj_add_event_cb(button, event_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_set_ext_click_area(button, 10);
+    lv_obj_set_scroll_dir(button, LV_DIR_HOR);
+    lv_obj_delete(button);
+    TEST_ASSERT_EQUAL(1, lv_obj_class_get_pool_cnt(&lv_button_class));
+
+    /*The same memory is reused, but it's like a new button*/
+    lv_obj_t * button_reused = lv_button_create(lv_screen_active());
+    TEST_ASSERT_EQUAL_PTR(button, button_reused);
+    TEST_ASSERT_EQUAL(0, lv_obj_class_get_pool_cnt(&lv_button_class));
+
+    lv_obj_t * button_new = lv_button_create(lv_screen_active());
+    TEST_ASSERT_EQUAL_PTR(&lv_button_class, lv_obj_get_class(button_reused));
+    TEST_ASSERT_EQUAL_PTR(lv_screen_active(), lv_obj_get_parent(button_reused));
+    TEST_ASSERT_EQUAL(lv_obj_get_state(button_new), lv_obj_get_state(button_reused));
+    TEST_ASSERT_FALSE(lv_obj_has_flag(button_reused, LV_OBJ_FLAG_HIDDEN));
+    TEST_ASSERT_NULL(lv_obj_get_user_data(button_reused));
+    TEST_ASSERT_EQUAL_COLOR(lv_obj_get_style_bg_color(button_new, 0), lv_obj_get_style_bg_color(button_reused, 0));
+    TEST_ASSERT_EQUAL(0, lv_obj_get_child_count(button_reused));
+    TEST_ASSERT_EQUAL(0, lv_obj_get_event_count(button_reused));
+    TEST_ASSERT_EQUAL(LV_DIR_ALL, lv_obj_get_scroll_dir(button_reused));
+    TEST_ASSERT_EQUAL(lv_obj_get_width(button_new), lv_obj_get_width(button_reused));
+
+    /*Other classes are not kept*/
+    lv_obj_t * label = lv_label_create(button_reused);
+    lv_obj_delete(label);
+    TEST_ASSERT_EQUAL(0, lv_obj_class_get_pool_cnt(&lv_label_class));
+}
+
+void test_obj_pool_size(void)
+{
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    lv_obj_class_set_pool_size(&lv_obj_class, 2);
+    lv_obj_class_set_pool_size(&lv_label_class, 10);
+
+    /*Nested objects and screens go to their pools too*/
+    lv_obj_t * screen = lv_obj_create(NULL);
+    lv_obj_t * cont = lv_obj_create(screen);
+    lv_label_create(cont);
+    lv_label_create(cont);
+    lv_label_create(lv_obj_create(screen));
+    lv_obj_delete(screen);
+    TEST_ASSERT_EQUAL(2, lv_obj_class_get_pool_cnt(&lv_obj_class));
+    TEST_ASSERT_EQUAL(3, lv_obj_class_get_pool_cnt(&lv_label_class));
+
+    /*Reducing the size frees the extra objects*/
+    lv_obj_class_set_pool_size(&lv_label_class, 1);
+    TEST_ASSERT_EQUAL(1, lv_obj_class_get_pool_cnt(&lv_label_class));
+
+    lv_obj_class_set_pool_size(&lv_obj_class, 0);
+    lv_obj_class_set_pool_size(&lv_label_class, 0);
+    TEST_ASSERT_EQUAL(0, lv_obj_class_get_pool_cnt(&lv_obj_class));
+    TEST_ASSERT_EQUAL(0, lv_obj_class_get_pool_cnt(&lv_label_class));
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL(mon_start.used_cnt, mon.used_cnt);
+}
+
+/**
+ * Create and delete a button with a label many times
+ * @param name      name of the configuration to print
+ */
+static void bench_churn(const char * name)
+{
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    uint32_t i;
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_CYCLE_CNT; i++) {
+        lv_obj_t * button = lv_button_create(lv_screen_active());
+        lv_obj_t * label = lv_label_create(button);
+        lv_label_set_text_static(label, "Button");
+        lv_obj_delete(button);
+    }
+    uint64_t t = lv_test_get_time_us() - t_start;
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+
+    TEST_PRINTF("%s: %d ns per created and deleted object, %d new blocks used, frag. %d%% after %d cycles",
+                name, (int)(t * 1000 / (BENCH_CYCLE_CNT * 2)), (int)(mon.used_cnt - mon_start.used_cnt),
+                (int)mon.frag_pct, BENCH_CYCLE_CNT);
+}
+
+void test_obj_pool_bench(void)
+{
+    bench_churn("no pool");
+
+    lv_obj_class_set_pool_size(&lv_button_class, 8);
+    lv_obj_class_set_pool_size(&lv_label_class, 8);
+    bench_churn("button and label pools");
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_obj_pool_reuse(void)
+{
+}
+
+void test_obj_pool_size(void)
+{
+}
+
+void test_obj_pool_bench(void)
+{
+}
+
+#endif
+
+#endif
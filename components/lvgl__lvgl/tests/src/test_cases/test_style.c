@@ -141,4 +141,66 @@ void test_style_has_prop(void)
     lv_style_reset(&style);
 }
 
+
+void test_style_value_invalidation(void)
+{
+    /*The style values might be cached, check that they are updated on every kind of change*/
+    lv_style_t style_checked;
+    lv_style_init(&style_checked);
+    lv_style_set_text_color(&style_checked, lv_color_hex(0x00ff00));
+
+    lv_obj_t * parent1 = lv_obj_create(lv_screen_active());
+    lv_obj_t * parent2 = lv_obj_create(lv_screen_active());
+    lv_obj_t * child = lv_obj_create(parent1);
+    lv_obj_remove_style_all(child);     /*Inherit the text color*/
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0xff0000), LV_PART_MAIN);
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x0000ff), LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    /*Local style of the parent*/
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0xff00ff), LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff00ff), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    /*State of the parent*/
+    lv_obj_add_style(parent1, &style_checked, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff00ff), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+    lv_obj_add_state(parent1, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    /*Style modified and reported*/
+    lv_style_set_text_color(&style_checked, lv_color_hex(0x00ffff));
+    lv_obj_report_style_change(&style_checked);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ffff), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    /*Style modified and reported while refreshing is disabled*/
+    lv_obj_enable_style_refresh(false);
+    lv_style_set_text_color(&style_checked, lv_color_hex(0xffff00));
+    lv_obj_report_style_change(&style_checked);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xffff00), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+    lv_obj_enable_style_refresh(true);
+
+    /*Parent changed*/
+    lv_obj_set_parent(child, parent2);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    /*Style removed*/
+    lv_obj_set_parent(child, parent1);
+    lv_obj_remove_style(parent1, &style_checked, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff00ff), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    /*Local style removed*/
+    lv_obj_remove_local_style_prop(parent1, LV_STYLE_TEXT_COLOR, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_obj_get_style_text_color(lv_screen_active(), LV_PART_MAIN),
+                            lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    /*Another part of the same object*/
+    lv_obj_set_style_text_color(child, lv_color_hex(0x123456), LV_PART_SCROLLBAR);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x123456), lv_obj_get_style_text_color(child, LV_PART_SCROLLBAR));
+    TEST_ASSERT_EQUAL_COLOR(lv_obj_get_style_text_color(lv_screen_active(), LV_PART_MAIN),
+                            lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    lv_obj_delete(child);
+    lv_style_reset(&style_checked);
+}
+
 #endif
@@ -0,0 +1,178 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_init.h"
+
+#include "unity/unity.h"
+
+#define BENCH_INSERT_CNT 2000
+#define BENCH_LOOKUP_CNT 500
+
+/*Props of a typical theme style, in the order they are usually set*/
+static const lv_style_prop_t theme_props[] = {
+    LV_STYLE_BG_COLOR, LV_STYLE_BG_OPA, LV_STYLE_BORDER_COLOR, LV_STYLE_BORDER_WIDTH, LV_STYLE_BORDER_OPA,
+    LV_STYLE_RADIUS, LV_STYLE_PAD_TOP, LV_STYLE_PAD_BOTTOM, LV_STYLE_PAD_LEFT, LV_STYLE_PAD_RIGHT,
+    LV_STYLE_PAD_ROW, LV_STYLE_PAD_COLUMN, LV_STYLE_TEXT_COLOR, LV_STYLE_TEXT_FONT, LV_STYLE_TEXT_LINE_SPACE,
+    LV_STYLE_SHADOW_WIDTH, LV_STYLE_SHADOW_COLOR, LV_STYLE_SHADOW_OPA, LV_STYLE_SHADOW_OFFSET_Y, LV_STYLE_OUTLINE_WIDTH,
+    LV_STYLE_OUTLINE_COLOR, LV_STYLE_OUTLINE_PAD, LV_STYLE_LINE_COLOR, LV_STYLE_LINE_WIDTH, LV_STYLE_ARC_COLOR,
+    LV_STYLE_ARC_WIDTH, LV_STYLE_TRANSITION, LV_STYLE_ANIM_DURATION, LV_STYLE_WIDTH, LV_STYLE_HEIGHT,
+};
+
+#define THEME_PROP_CNT (sizeof(theme_props) / sizeof(theme_props[0]))
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+static void set_theme_props(lv_style_t * style)
+{
+    uint32_t i;
+    for(i = 0; i < THEME_PROP_CNT; i++) {
+        lv_style_value_t v = { .num = (int32_t)theme_props[i] * 10 };
+        lv_style_set_prop(style, theme_props[i], v);
+    }
+}
+
+/*Reference for the benchmark: the linear search used without `LV_STYLE_SORTED_PROPS`*/
+static lv_style_res_t linear_get_prop(const lv_style_t * style, lv_style_prop_t prop, lv_style_value_t * value)
+{
+    lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    uint32_t i;
+    for(i = 0; i < style->prop_cnt; i++) {
+        if(props[i] == prop) {
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            *value = values[i];
+            return LV_STYLE_RES_FOUND;
+        }
+    }
+    return LV_STYLE_RES_NOT_FOUND;
+}
+
+void test_style_props_set_get_remove(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    set_theme_props(&style);
+    TEST_ASSERT_EQUAL(THEME_PROP_CNT, style.prop_cnt);
+
+    /*Every built-in prop is either found with its value or not found at all*/
+    lv_style_prop_t p;
+    for(p = 1; p < LV_STYLE_NUM_BUILT_IN_PROPS; p++) {
+        lv_style_value_t v = { .num = -1 };
+        lv_style_value_t v_ref = { .num = -1 };
+        lv_style_res_t res = lv_style_get_prop(&style, p, &v);
+        TEST_ASSERT_EQUAL(linear_get_prop(&style, p, &v_ref), res);
+        if(res == LV_STYLE_RES_FOUND) TEST_ASSERT_EQUAL(p * 10, v.num);
+        else TEST_ASSERT_EQUAL(-1, v.num);
+    }
+
+#if LV_STYLE_SORTED_PROPS
+    lv_style_prop_t * props = (lv_style_prop_t *)style.values_and_props + style.prop_cnt * sizeof(lv_style_value_t);
+    uint32_t i;
+    for(i = 1; i < style.prop_cnt; i++) {
+        TEST_ASSERT_LESS_THAN(props[i], props[i - 1]);
+    }
+#endif
+
+    /*Overwriting doesn't add a new prop*/
+    lv_style_set_radius(&style, 123);
+    TEST_ASSERT_EQUAL(THEME_PROP_CNT, style.prop_cnt);
+    lv_style_value_t v;
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_RADIUS, &v));
+    TEST_ASSERT_EQUAL(123, v.num);
+
+    /*Remove the first, the last and some from the middle*/
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, LV_STYLE_WIDTH));
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, LV_STYLE_ANIM_DURATION));
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, LV_STYLE_TEXT_FONT));
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, LV_STYLE_BG_OPA));
+    TEST_ASSERT_FALSE(lv_style_remove_prop(&style, LV_STYLE_BG_OPA));
+    TEST_ASSERT_EQUAL(THEME_PROP_CNT - 4, style.prop_cnt);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, LV_STYLE_WIDTH, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, LV_STYLE_TEXT_FONT, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_HEIGHT, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_HEIGHT * 10, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_TRANSITION, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_TRANSITION * 10, v.num);
+
+    /*A copy has the same props*/
+    lv_style_t style_copy;
+    lv_style_init(&style_copy);
+    lv_style_copy(&style_copy, &style);
+    TEST_ASSERT_EQUAL(style.prop_cnt, style_copy.prop_cnt);
+    for(p = 1; p < LV_STYLE_NUM_BUILT_IN_PROPS; p++) {
+        lv_style_value_t v1;
+        lv_style_value_t v2;
+        lv_style_res_t res = lv_style_get_prop(&style, p, &v1);
+        TEST_ASSERT_EQUAL(res, lv_style_get_prop(&style_copy, p, &v2));
+        if(res == LV_STYLE_RES_FOUND) TEST_ASSERT_EQUAL(v1.num, v2.num);
+    }
+
+    /*Removing all props makes the style empty*/
+    while(style.prop_cnt) {
+        lv_style_prop_t * act_props = (lv_style_prop_t *)style.values_and_props + style.prop_cnt * sizeof(lv_style_value_t);
+        TEST_ASSERT_TRUE(lv_style_remove_prop(&style, act_props[style.prop_cnt / 2]));
+    }
+    TEST_ASSERT_TRUE(lv_style_is_empty(&style));
+    lv_style_set_bg_color(&style, lv_color_hex(0x112233));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_BG_COLOR, &v));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x112233), v.color);
+
+    lv_style_reset(&style);
+    lv_style_reset(&style_copy);
+}
+
+void test_style_props_bench(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+
+    /*Insert: build and free a theme style*/
+    uint32_t i;
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_INSERT_CNT; i++) {
+        set_theme_props(&style);
+        lv_style_reset(&style);
+    }
+    uint64_t t_insert = lv_test_get_time_us() - t_start;
+
+    /*Lookup: query every built-in prop, most of them are missing as in a real style chain*/
+    set_theme_props(&style);
+    volatile int32_t sum = 0;
+    lv_style_prop_t p;
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_LOOKUP_CNT; i++) {
+        for(p = 1; p < LV_STYLE_NUM_BUILT_IN_PROPS; p++) {
+            lv_style_value_t v;
+            if(lv_style_get_prop_inlined(&style, p, &v) == LV_STYLE_RES_FOUND) sum += v.num;
+        }
+    }
+    uint64_t t_lookup = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_LOOKUP_CNT; i++) {
+        for(p = 1; p < LV_STYLE_NUM_BUILT_IN_PROPS; p++) {
+            lv_style_value_t v;
+            if(linear_get_prop(&style, p, &v) == LV_STYLE_RES_FOUND) sum -= v.num;
+        }
+    }
+    uint64_t t_lookup_linear = lv_test_get_time_us() - t_start;
+
+    TEST_ASSERT_EQUAL(0, sum);
+
+    uint32_t lookup_cnt = BENCH_LOOKUP_CNT * (LV_STYLE_NUM_BUILT_IN_PROPS - 1);
+    TEST_PRINTF("sorted props %d, %d props: insert %d ns/prop, lookup %d ns, linear lookup %d ns",
+                LV_STYLE_SORTED_PROPS, (int)THEME_PROP_CNT,
+                (int)(t_insert * 1000 / (BENCH_INSERT_CNT * THEME_PROP_CNT)),
+                (int)(t_lookup * 1000 / lookup_cnt), (int)(t_lookup_linear * 1000 / lookup_cnt));
+
+    lv_style_reset(&style);
+}
+
+#endif
@@ -0,0 +1,278 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_init.h"
+
+#include "unity/unity.h"
+
+#define BENCH_TIMER_CNT     1000
+#define BENCH_HANDLER_CNT   2000
+
+#define LOG_SIZE 64
+
+static uint32_t log_buf[LOG_SIZE];
+static uint32_t log_cnt;
+static lv_timer_t * timer_to_delete;
+static lv_timer_t * timer_created;
+static uint32_t bench_cnt;
+static lv_timer_t * other_timers[16];
+static uint32_t other_timer_cnt;
+
+void setUp(void)
+{
+    log_cnt = 0;
+    timer_to_delete = NULL;
+    timer_created = NULL;
+
+    /*Pause the display, input device, etc timers to test only the timers created here*/
+    other_timer_cnt = 0;
+    lv_timer_t * timer = NULL;
+    while((timer = lv_timer_get_next(timer)) != NULL) {
+        if(!lv_timer_get_paused(timer) && other_timer_cnt < 16) {
+            other_timers[other_timer_cnt++] = timer;
+            lv_timer_pause(timer);
+        }
+    }
+}
+
+void tearDown(void)
+{
+    uint32_t i;
+    for(i = 0; i < other_timer_cnt; i++) {
+        lv_timer_resume(other_timers[i]);
+    }
+}
+
+/*Save the ID of the timer (its user_data) when it runs*/
+static void log_cb(lv_timer_t * timer)
+{
+    if(log_cnt < LOG_SIZE) log_buf[log_cnt++] = (uint32_t)(lv_uintptr_t)lv_timer_get_user_data(timer);
+}
+
+static void delete_other_cb(lv_timer_t * timer)
+{
+    log_cb(timer);
+    if(timer_to_delete) {
+        lv_timer_delete(timer_to_delete);
+        timer_to_delete = NULL;
+    }
+}
+
+static void create_other_cb(lv_timer_t * timer)
+{
+    log_cb(timer);
+    if(timer_created == NULL) timer_created = lv_timer_create(log_cb, 0, (void *)100);
+}
+
+static void delete_self_cb(lv_timer_t * timer)
+{
+    log_cb(timer);
+    lv_timer_delete(timer);
+}
+
+static void bench_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    bench_cnt++;
+}
+
+static lv_timer_t * create_logged(uint32_t period, uint32_t id)
+{
+    return lv_timer_create(log_cb, period, (void *)(lv_uintptr_t)id);
+}
+
+void test_timer_order(void)
+{
+    lv_timer_t * t1 = create_logged(30, 1);
+    lv_timer_t * t2 = create_logged(10, 2);
+    lv_timer_t * t3 = create_logged(20, 3);
+    lv_timer_t * t4 = create_logged(20, 4);
+
+    lv_tick_inc(9);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(0, log_cnt);
+
+    /*All of them are ready: the timers with the earliest deadline run first,
+     *the newer first if the deadlines are the same*/
+    lv_tick_inc(30);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(4, log_cnt);
+#if LV_TIMER_DEADLINE_HEAP
+    TEST_ASSERT_EQUAL(2, log_buf[0]);
+    TEST_ASSERT_EQUAL(4, log_buf[1]);
+    TEST_ASSERT_EQUAL(3, log_buf[2]);
+    TEST_ASSERT_EQUAL(1, log_buf[3]);
+#endif
+
+    /*Every timer runs at most once in a call*/
+    log_cnt = 0;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(0, log_cnt);
+
+    /*The next call is when the first timer is ready*/
+    TEST_ASSERT_EQUAL(10, lv_timer_handler());
+
+    lv_timer_delete(t1);
+    lv_timer_delete(t2);
+    lv_timer_delete(t3);
+    lv_timer_delete(t4);
+}
+
+void test_timer_pause_resume_ready(void)
+{
+    lv_timer_t * t1 = create_logged(10, 1);
+    lv_timer_t * t2 = create_logged(50, 2);
+
+    lv_timer_pause(t1);
+    TEST_ASSERT_TRUE(lv_timer_get_paused(t1));
+    lv_tick_inc(20);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(0, log_cnt);
+
+    lv_timer_resume(t1);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(1, log_cnt);
+    TEST_ASSERT_EQUAL(1, log_buf[0]);
+
+    /*Run a timer before its deadline*/
+    lv_timer_ready(t2);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, log_cnt);
+    TEST_ASSERT_EQUAL(2, log_buf[1]);
+
+    /*Reset postpones the deadline*/
+    lv_tick_inc(5);
+    lv_timer_reset(t1);
+    lv_tick_inc(5);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, log_cnt);
+    lv_tick_inc(5);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(3, log_cnt);
+
+    /*A shorter period makes it ready earlier*/
+    lv_timer_set_period(t2, 4);
+    lv_tick_inc(5);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(4, log_cnt);
+    TEST_ASSERT_EQUAL(2, log_buf[3]);
+
+    /*Paused timers don't affect the time until the next call*/
+    TEST_ASSERT_EQUAL(4, lv_timer_handler());
+    lv_timer_pause(t2);
+    TEST_ASSERT_EQUAL(5, lv_timer_handler());
+    lv_timer_pause(t1);
+    TEST_ASSERT_EQUAL(LV_NO_TIMER_READY, lv_timer_handler());
+
+    lv_timer_delete(t1);
+    lv_timer_delete(t2);
+}
+
+void test_timer_repeat_count(void)
+{
+    lv_timer_t * t1 = create_logged(10, 1);
+    lv_timer_set_repeat_count(t1, 2);
+
+    lv_timer_t * t2 = create_logged(10, 2);
+    lv_timer_set_repeat_count(t2, 1);
+    lv_timer_set_auto_delete(t2, false);
+
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_tick_inc(10);
+        lv_timer_handler();
+    }
+
+    /*`t1` ran twice and was deleted, `t2` ran once and was paused*/
+    TEST_ASSERT_EQUAL(3, log_cnt);
+    lv_timer_t * timer = NULL;
+    while((timer = lv_timer_get_next(timer)) != NULL) {
+        TEST_ASSERT_NOT_EQUAL(t1, timer);
+    }
+    TEST_ASSERT_TRUE(lv_timer_get_paused(t2));
+
+    /*Setting a repeat count of 0 deletes the timer without running it*/
+    lv_timer_t * t3 = create_logged(1000, 3);
+    lv_timer_set_repeat_count(t3, 0);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(3, log_cnt);
+    while((timer = lv_timer_get_next(timer)) != NULL) {
+        TEST_ASSERT_NOT_EQUAL(t3, timer);
+    }
+
+    lv_timer_delete(t2);
+}
+
+void test_timer_create_delete_in_cb(void)
+{
+    lv_timer_t * t1 = lv_timer_create(delete_other_cb, 10, (void *)1);
+    lv_timer_t * t2 = create_logged(10, 2);
+    lv_timer_t * t3 = lv_timer_create(create_other_cb, 10, (void *)3);
+    lv_timer_create(delete_self_cb, 10, (void *)4);
+    lv_timer_t * t5 = create_logged(10, 5);
+
+    /*`t3` creates a timer, `t1` deletes `t2`, `t4` deletes itself*/
+    timer_to_delete = t2;
+    lv_tick_inc(10);
+    lv_timer_handler();
+
+    bool ran[6] = {false};
+    uint32_t i;
+    for(i = 0; i < log_cnt; i++) {
+        /*Without the heap the new timer might run in the same call too*/
+        if(log_buf[i] == 100) continue;
+        TEST_ASSERT_LESS_THAN(6, log_buf[i]);
+        TEST_ASSERT_FALSE(ran[log_buf[i]]);
+        ran[log_buf[i]] = true;
+    }
+    TEST_ASSERT_TRUE(ran[1]);
+    TEST_ASSERT_TRUE(ran[3]);
+    TEST_ASSERT_TRUE(ran[4]);
+    TEST_ASSERT_TRUE(ran[5]);
+    TEST_ASSERT_NOT_NULL(timer_created);
+
+    /*The new timer runs in the next call, the deleted ones don't*/
+    log_cnt = 0;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(1, log_cnt);
+    TEST_ASSERT_EQUAL(100, log_buf[0]);
+
+    lv_timer_delete(t1);
+    lv_timer_delete(t3);
+    lv_timer_delete(t5);
+    lv_timer_delete(timer_created);
+}
+
+void test_timer_bench(void)
+{
+    static lv_timer_t * timers[BENCH_TIMER_CNT];
+
+    /*Periods of spinners, label scrolls, frame timers and slow monitors*/
+    uint32_t i;
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_TIMER_CNT; i++) {
+        timers[i] = lv_timer_create(bench_cb, 10 + (i * 37) % 1000, NULL);
+    }
+    uint64_t t_create = lv_test_get_time_us() - t_start;
+
+    bench_cnt = 0;
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_HANDLER_CNT; i++) {
+        lv_tick_inc(5);
+        lv_timer_handler();
+    }
+    uint64_t t_handler = lv_test_get_time_us() - t_start;
+
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < BENCH_TIMER_CNT; i++) {
+        lv_timer_delete(timers[i]);
+    }
+    uint64_t t_delete = lv_test_get_time_us() - t_start;
+
+    TEST_ASSERT_GREATER_THAN(BENCH_TIMER_CNT, bench_cnt);
+    TEST_PRINTF("deadline heap %d, %d timers: create %d ns, lv_timer_handler %d us, delete %d ns, %d callbacks",
+                LV_TIMER_DEADLINE_HEAP, BENCH_TIMER_CNT, (int)(t_create * 1000 / BENCH_TIMER_CNT),
+                (int)(t_handler / BENCH_HANDLER_CNT), (int)(t_delete * 1000 / BENCH_TIMER_CNT), (int)bench_cnt);
+}
+
+#endif
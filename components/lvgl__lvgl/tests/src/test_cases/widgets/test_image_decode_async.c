@@ -0,0 +1,157 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "lv_test_init.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_IMAGE_DECODER_ASYNC
+
+#include <unistd.h>
+
+#define IMG_SRC             "A:src/test_assets/test_img_lvgl_logo.png"
+#define WAIT_MAX_MS         5000
+
+LV_IMAGE_DECLARE(test_image_caret_down);
+
+static uint32_t cache_size_ori;
+
+void setUp(void)
+{
+    /*The decoded images are passed in the image cache*/
+    cache_size_ori = lv_cache_get_max_size(LV_GLOBAL_DEFAULT()->img_cache, NULL);
+    lv_image_cache_resize(1024 * 1024, false);
+    lv_image_cache_drop(NULL);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_image_cache_drop(NULL);
+    lv_image_cache_resize(cache_size_ori, true);
+}
+
+/**
+ * Run the timers until the background decoding of an image is finished
+ * @param img       pointer to an image object
+ * @return          true: finished in time
+ */
+static bool wait_decoded(lv_obj_t * img)
+{
+    uint32_t i;
+    for(i = 0; i < WAIT_MAX_MS && lv_image_is_decode_pending(img); i++) {
+        usleep(1000);
+        lv_test_fast_forward(1);
+    }
+
+    return !lv_image_is_decode_pending(img);
+}
+
+static lv_obj_t * image_create(bool async)
+{
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_decode_async(img, async);
+    lv_image_set_placeholder(img, &test_image_caret_down);
+    lv_image_set_src(img, IMG_SRC);
+    lv_obj_center(img);
+
+    return img;
+}
+
+void test_image_decode_async_placeholder(void)
+{
+    lv_obj_t * img = image_create(true);
+    TEST_ASSERT_TRUE(lv_image_get_decode_async(img));
+    TEST_ASSERT_EQUAL_PTR(&test_image_caret_down, lv_image_get_placeholder(img));
+
+    /*The first frame requests the image and draws the placeholder scaled to the size of the image*/
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(lv_image_is_decode_pending(img));
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/image_decode_async_placeholder.png");
+
+    TEST_ASSERT_TRUE(wait_decoded(img));
+    TEST_ASSERT_TRUE(lv_image_cache_contains(IMG_SRC));
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/image_decode_async.png");
+
+    /*Decoded again if it's evicted*/
+    lv_image_cache_drop(IMG_SRC);
+    lv_obj_invalidate(img);
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(lv_image_is_decode_pending(img));
+    TEST_ASSERT_TRUE(wait_decoded(img));
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/image_decode_async.png");
+}
+
+void test_image_decode_async_same_as_sync(void)
+{
+    image_create(false);
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/image_decode_async.png");
+}
+
+void test_image_decode_async_cancel(void)
+{
+    lv_obj_t * img = image_create(true);
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(lv_image_is_decode_pending(img));
+
+    /*The callback of the finished request is not called for the deleted image*/
+    lv_obj_delete(img);
+    lv_test_wait(100);
+
+    img = image_create(true);
+    lv_refr_now(NULL);
+    lv_image_set_src(img, &test_image_caret_down);
+    TEST_ASSERT_FALSE(lv_image_is_decode_pending(img));
+    lv_test_wait(100);
+}
+
+void test_image_decode_async_bench(void)
+{
+    /*Time of the first frame after creating the image*/
+    lv_obj_t * img = image_create(false);
+    uint64_t t_start = lv_test_get_time_us();
+    lv_refr_now(NULL);
+    uint64_t t_sync = lv_test_get_time_us() - t_start;
+    lv_obj_delete(img);
+    lv_image_cache_drop(NULL);
+
+    img = image_create(true);
+    t_start = lv_test_get_time_us();
+    lv_refr_now(NULL);
+    uint64_t t_async = lv_test_get_time_us() - t_start;
+    TEST_ASSERT_TRUE(wait_decoded(img));
+    uint64_t t_ready = lv_test_get_time_us() - t_start;
+
+    TEST_PRINTF("first frame: %d us decoding while drawing, %d us with placeholder (image ready after %d us)",
+                (int)t_sync, (int)t_async, (int)t_ready);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_image_decode_async_placeholder(void)
+{
+}
+
+void test_image_decode_async_same_as_sync(void)
+{
+}
+
+void test_image_decode_async_cancel(void)
+{
+}
+
+void test_image_decode_async_bench(void)
+{
+}
+
+#endif
+
+#endif
@@ -1,6 +1,7 @@
 #if LV_BUILD_TEST
 #include "../lvgl.h"
 #include "../../lvgl_private.h"
+#include "lv_test_init.h"
 
 #include "unity/unity.h"
 #include <string.h>
@@ -691,4 +692,121 @@ void test_label_long_mode_clip(void)
     TEST_ASSERT_EQUAL_SCREENSHOT(buf);
 }
 
+#if LV_LABEL_LINE_CACHE
+static void check_lines(lv_obj_t * obj)
+{
+    lv_label_t * lbl = (lv_label_t *)obj;
+    const lv_draw_label_lines_t * lines = &lbl->lines;
+    TEST_ASSERT_NOT_NULL(lines->text);
+    TEST_ASSERT_EQUAL_PTR(lbl->text, lines->text);
+    TEST_ASSERT_EQUAL_PTR(lv_obj_get_style_text_font(obj, LV_PART_MAIN), lines->font);
+    TEST_ASSERT_EQUAL(lv_obj_get_content_width(obj), lines->max_width);
+
+    /*The lines are the same as wrapping the text again*/
+    uint32_t line_start = 0;
+    uint32_t i;
+    for(i = 0; i < lines->cnt; i++) {
+        uint32_t len = lv_text_get_next_line(&lines->text[line_start], LV_TEXT_LEN_MAX, lines->font, lines->letter_space,
+                                             lines->max_width, NULL, lines->flag);
+        TEST_ASSERT_EQUAL(line_start, lines->starts[i]);
+        TEST_ASSERT_EQUAL(lv_text_get_width_with_flags(&lines->text[line_start], len, lines->font, lines->letter_space,
+                                                       lines->flag), lines->widths[i]);
+        line_start += len;
+    }
+    TEST_ASSERT_EQUAL(line_start, lines->starts[lines->cnt]);
+    TEST_ASSERT_EQUAL('\0', lines->text[line_start]);
+}
+#endif
+
+void test_label_line_cache_update(void)
+{
+#if LV_LABEL_LINE_CACHE
+    lv_obj_t * obj = lv_label_create(active_screen);
+    lv_label_set_text(obj, long_text_multiline);
+    lv_obj_set_width(obj, 150);
+    lv_refr_now(NULL);
+    check_lines(obj);
+    uint32_t cnt_orig = ((lv_label_t *)obj)->lines.cnt;
+
+    /*Narrower label, more lines*/
+    lv_obj_set_width(obj, 100);
+    lv_refr_now(NULL);
+    check_lines(obj);
+    TEST_ASSERT_GREATER_THAN(cnt_orig, ((lv_label_t *)obj)->lines.cnt);
+
+    lv_obj_set_style_text_font(obj, &lv_font_montserrat_24, 0);
+    lv_refr_now(NULL);
+    check_lines(obj);
+
+    lv_obj_set_style_text_letter_space(obj, 3, 0);
+    lv_refr_now(NULL);
+    check_lines(obj);
+    TEST_ASSERT_EQUAL(3, ((lv_label_t *)obj)->lines.letter_space);
+
+    lv_label_set_text(obj, long_text);
+    lv_refr_now(NULL);
+    check_lines(obj);
+
+    /*Changing the text in place makes the lines invalid too*/
+    lv_label_cut_text(obj, 0, 30);
+    TEST_ASSERT_NULL(((lv_label_t *)obj)->lines.text);
+    lv_refr_now(NULL);
+    check_lines(obj);
+
+    lv_label_set_text(obj, empty_text);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, ((lv_label_t *)obj)->lines.cnt);
+
+    /*The not wrapped texts use the same width when drawn, even if the draw tasks are sent as events*/
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_set_width(obj, LV_SIZE_CONTENT);
+    lv_label_set_text(obj, long_text_multiline);
+    lv_refr_now(NULL);
+    check_lines(obj);
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_label_line_cache_bench(void)
+{
+    static char txt[8192];
+    uint32_t i;
+    txt[0] = '\0';
+    for(i = 0; i < 60; i++) {
+        lv_strlcpy(txt + lv_strlen(txt), long_text, sizeof(txt) - lv_strlen(txt));
+        lv_strlcpy(txt + lv_strlen(txt), i % 3 == 2 ? "\n\n" : " ", sizeof(txt) - lv_strlen(txt));
+    }
+
+    /*A screen sized label and a long one scrolled to its end*/
+    lv_obj_clean(active_screen);
+    lv_obj_t * obj = lv_label_create(active_screen);
+    lv_obj_set_width(obj, lv_pct(100));
+    lv_label_set_text_static(obj, txt);
+    lv_obj_set_style_text_align(obj, LV_TEXT_ALIGN_CENTER, 0);
+    lv_refr_now(NULL);
+
+    uint64_t t_start = lv_test_get_time_us();
+    for(i = 0; i < 20; i++) {
+        lv_obj_invalidate(obj);
+        lv_refr_now(NULL);
+    }
+    uint64_t t_screen = lv_test_get_time_us() - t_start;
+
+    lv_obj_set_width(obj, 300);
+    lv_obj_update_layout(obj);
+    lv_obj_scroll_to_y(active_screen, lv_obj_get_height(obj) - lv_obj_get_height(active_screen), LV_ANIM_OFF);
+    lv_refr_now(NULL);
+
+    t_start = lv_test_get_time_us();
+    for(i = 0; i < 20; i++) {
+        lv_obj_invalidate(obj);
+        lv_refr_now(NULL);
+    }
+    uint64_t t_scrolled = lv_test_get_time_us() - t_start;
+
+    TEST_PRINTF("line cache %d: screen sized text %d us/frame, end of a %d px high text %d us/frame",
+                LV_LABEL_LINE_CACHE, (int)(t_screen / 20), (int)lv_obj_get_height(obj), (int)(t_scrolled / 20));
+}
+
 #endif
@@ -0,0 +1,60 @@
+/**
+* @file lv_test_blend_ref.h
+*
+*/
+#if LV_BUILD_TEST
+
+#ifndef LV_TEST_BLEND_REF_H
+#define LV_TEST_BLEND_REF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../../lvgl.h"
+#include "../../../../src/draw/sw/blend/lv_draw_sw_blend_private.h"
+#include "../../../../src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#include "../../../../src/draw/sw/blend/lv_draw_sw_blend_to_argb8888.h"
+#include "../../../../src/draw/sw/blend/lv_draw_sw_blend_to_rgb888.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/*
+ * The C implementation of `lv_draw_sw_blend_color/image_to_*()` compiled without the x86 kernels.
+ * The x86 kernels have to produce exactly the same pixels.
+ */
+void lv_test_blend_ref_color_to_rgb565(lv_draw_sw_blend_fill_dsc_t * dsc);
+void lv_test_blend_ref_image_to_rgb565(lv_draw_sw_blend_image_dsc_t * dsc);
+void lv_test_blend_ref_color_to_argb8888(lv_draw_sw_blend_fill_dsc_t * dsc);
+void lv_test_blend_ref_image_to_argb8888(lv_draw_sw_blend_image_dsc_t * dsc);
+void lv_test_blend_ref_color_to_rgb888(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size);
+void lv_test_blend_ref_image_to_rgb888(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_TEST_BLEND_REF_H*/
+
+#endif /*LV_BUILD_TEST*/
@@ -0,0 +1,27 @@
+/**
+* @file lv_test_blend_ref_rgb888.c
+*
+* Compile `lv_draw_sw_blend_to_rgb888.c` once more without the x86 kernels
+* to have a reference for them.
+*/
+#if LV_BUILD_TEST
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_test_blend_ref.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+
+/*Without an ASM backend all the blend hooks fall back to the C implementation*/
+#undef LV_USE_DRAW_SW_ASM
+#define LV_USE_DRAW_SW_ASM  LV_DRAW_SW_ASM_NONE
+
+#define lv_draw_sw_blend_color_to_rgb888    lv_test_blend_ref_color_to_rgb888
+#define lv_draw_sw_blend_image_to_rgb888    lv_test_blend_ref_image_to_rgb888
+
+#include "../../../../src/draw/sw/blend/lv_draw_sw_blend_to_rgb888.c"
+
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 || LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2*/
+
+#endif /*LV_BUILD_TEST*/